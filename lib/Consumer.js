@@ -22,7 +22,8 @@ class Consumer extends EnhancedEventEmitter
 	 * @emits @close
 	 * @emits @producerclose
 	 */
-	constructor({ internal, data, channel, appData, paused, producerPaused, score })
+	constructor(
+		{ internal, data, channel, appData, paused, producerPaused, priority, score })
 	{
 		super(logger);
 
@@ -63,6 +64,10 @@ class Consumer extends EnhancedEventEmitter
 		// @type {Boolean}
 		this._producerPaused = producerPaused;
 
+		// Priority.
+		// @type {Number}
+		this._priority = priority;
+
 		// Score with producer and consumer keys.
 		// @type {Object}
 		this._score = score;
@@ -125,9 +130,9 @@ class Consumer extends EnhancedEventEmitter
 	}
 
 	/**
-	 * Associated Producer type.
+	 * Associated Producer type, or 'broadcast' for broadcast Consumers.
 	 *
-	 * @returns {String} - It can be 'simple', 'simulcast' or 'svc'.
+	 * @returns {String} - It can be 'simple', 'simulcast', 'svc' or 'broadcast'.
 	 */
 	get type()
 	{
@@ -154,6 +159,16 @@ class Consumer extends EnhancedEventEmitter
 		return this._producerPaused;
 	}
 
+	/**
+	 * Priority.
+	 *
+	 * @returns {Number}
+	 */
+	get priority()
+	{
+		return this._priority;
+	}
+
 	/**
 	 * Consumer score with producer and consumer keys.
 	 *
@@ -216,6 +231,29 @@ class Consumer extends EnhancedEventEmitter
 		this.safeEmit('observer:close');
 	}
 
+	/**
+	 * Closed along with other Consumers by transport.closeConsumers().
+	 *
+	 * @private
+	 */
+	closedInBatch()
+	{
+		if (this._closed)
+			return;
+
+		logger.debug('closedInBatch()');
+
+		this._closed = true;
+
+		// Remove notification subscriptions.
+		this._channel.removeAllListeners(this._internal.consumerId);
+
+		this.emit('@close');
+
+		// Emit observer event.
+		this.safeEmit('observer:close');
+	}
+
 	/**
 	 * Transport was closed.
 	 *
@@ -320,6 +358,25 @@ class Consumer extends EnhancedEventEmitter
 			'consumer.setPreferredLayers', this._internal, reqData);
 	}
 
+	/**
+	 * Set priority.
+	 *
+	 * @param {Number} priority - From 1 to 255.
+	 *
+	 * @async
+	 */
+	async setPriority(priority)
+	{
+		logger.debug('setPriority()');
+
+		const reqData = { priority };
+
+		const status = await this._channel.request(
+			'consumer.setPriority', this._internal, reqData);
+
+		this._priority = status.priority;
+	}
+
 	/**
 	 * Request a key frame to the Producer.
 	 *
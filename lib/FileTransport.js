@@ -0,0 +1,82 @@
+const Logger = require('./Logger');
+const Transport = require('./Transport');
+
+const logger = new Logger('FileTransport');
+
+class FileTransport extends Transport
+{
+	/**
+	 * @private
+	 *
+	 * @emits {error: Error} recordingerror
+	 * @emits {error: Error} observer:recordingerror
+	 */
+	constructor({ data, ...params })
+	{
+		super(params);
+
+		logger.debug('constructor()');
+
+		// FileTransport data.
+		// @type {Object}
+		// - .path
+		this._data =
+		{
+			path : data.path
+		};
+	}
+
+	/**
+	 * Path of the rtpdump file in which Consumers are recorded.
+	 *
+	 * @returns {String}
+	 */
+	get path()
+	{
+		return this._data.path;
+	}
+
+	/**
+	 * A FileTransport is always connected.
+	 *
+	 * @async
+	 * @override
+	 */
+	async connect()
+	{
+		logger.debug('connect()');
+	}
+
+	/**
+	 * @private
+	 * @override
+	 */
+	_handleWorkerNotifications()
+	{
+		this._channel.on(this._internal.transportId, (event, data) =>
+		{
+			switch (event)
+			{
+				// Recording of the file (or its index) stopped.
+				case 'recordingerror':
+				{
+					const error = new Error(`${data.path}: ${data.error}`);
+
+					this.safeEmit('recordingerror', error);
+
+					// Emit observer event.
+					this.safeEmit('observer:recordingerror', error);
+
+					break;
+				}
+
+				default:
+				{
+					logger.error('ignoring unknown event "%s"', event);
+				}
+			}
+		});
+	}
+}
+
+module.exports = FileTransport;
@@ -2,7 +2,6 @@ const uuidv4 = require('uuid/v4');
 const Logger = require('./Logger');
 const ortc = require('./ortc');
 const Transport = require('./Transport');
-const Consumer = require('./Consumer');
 
 const logger = new Logger('PipeTransport');
 
@@ -75,6 +74,21 @@ class PipeTransport extends Transport
 	{
 		logger.debug('consume()');
 
+		// This may throw.
+		const entry = this._getConsumeEntry({ producerId, appData });
+
+		const status = await this._channel.request(
+			'transport.consume', entry.internal, entry.reqData);
+
+		return this._addConsumer(entry, status);
+	}
+
+	/**
+	 * @private
+	 * @override
+	 */
+	_getConsumeEntry({ producerId, appData = {} })
+	{
 		if (!producerId || typeof producerId !== 'string')
 			throw new TypeError('missing producerId');
 		else if (appData && typeof appData !== 'object')
@@ -97,30 +111,19 @@ class PipeTransport extends Transport
 			type                   : 'pipe',
 			consumableRtpEncodings : producer.consumableRtpParameters.encodings
 		};
-
-		const status =
-			await this._channel.request('transport.consume', internal, reqData);
-
 		const data = { kind: producer.kind, rtpParameters, type: 'pipe' };
 
-		const consumer = new Consumer(
-			{
-				internal,
-				data,
-				channel        : this._channel,
-				appData,
-				paused         : status.paused,
-				producerPaused : status.producerPaused
-			});
-
-		this._consumers.set(consumer.id, consumer);
-		consumer.on('@close', () => this._consumers.delete(consumer.id));
-		consumer.on('@producerclose', () => this._consumers.delete(consumer.id));
-
-		// Emit observer event.
-		this.safeEmit('observer:newconsumer', consumer);
+		return { internal, reqData, data, appData };
+	}
 
-		return consumer;
+	/**
+	 * @private
+	 * @override
+	 */
+	_addConsumer(entry, status)
+	{
+		// Pipe Consumers have no score.
+		return super._addConsumer(entry, { ...status, score: undefined });
 	}
 
 	/**
@@ -78,6 +78,43 @@ class PlainRtpTransport extends Transport
 		this._data.rtcpTuple = data.rtcpTuple;
 	}
 
+	/**
+	 * Add a remote destination that will receive the same RTP and RTCP sent to
+	 * the connected tuple. Requires rtcpMux.
+	 *
+	 * @param {String} ip - Remote IP.
+	 * @param {Number} port - Remote port.
+	 *
+	 * @async
+	 */
+	async addDestination({ ip, port } = {})
+	{
+		logger.debug('addDestination()');
+
+		const reqData = { ip, port };
+
+		await this._channel.request(
+			'transport.addDestination', this._internal, reqData);
+	}
+
+	/**
+	 * Remove a remote destination previously added.
+	 *
+	 * @param {String} ip - Remote IP.
+	 * @param {Number} port - Remote port.
+	 *
+	 * @async
+	 */
+	async removeDestination({ ip, port } = {})
+	{
+		logger.debug('removeDestination()');
+
+		const reqData = { ip, port };
+
+		await this._channel.request(
+			'transport.removeDestination', this._internal, reqData);
+	}
+
 	/**
 	 * Override Transport.consume() method to reject it if multiSource is set.
 	 *
@@ -5,16 +5,24 @@ const ortc = require('./ortc');
 const WebRtcTransport = require('./WebRtcTransport');
 const PlainRtpTransport = require('./PlainRtpTransport');
 const PipeTransport = require('./PipeTransport');
+const FileTransport = require('./FileTransport');
 const AudioLevelObserver = require('./AudioLevelObserver');
 
 const logger = new Logger('Router');
 
+// Max number of ids in each page of router.dump().
+const DUMP_PAGE_LIMIT = 500;
+
+// Max number of entities in each page of router.getStats().
+const STATS_PAGE_LIMIT = 1000;
+
 class Router extends EnhancedEventEmitter
 {
 	/**
 	 * @private
 	 *
 	 * @emits workerclose
+	 * @emits {stats: Object} stats
 	 * @emits observer:close
 	 * @emits {transport: Transport} observer:newtransport
 	 * @emits @close
@@ -61,6 +69,12 @@ class Router extends EnhancedEventEmitter
 		// Map of other Routers and their respective local and remote PipeTransports.
 		// @type {Map<Router, Array<PipeTransport>}
 		this._mapRouterPipeTransports = new Map();
+
+		// Stats received in previous parts of the current "stats" event.
+		// @type {Object}
+		this._pendingStats = null;
+
+		this._handleWorkerNotifications();
 	}
 
 	/**
@@ -105,6 +119,9 @@ class Router extends EnhancedEventEmitter
 
 		this._closed = true;
 
+		// Remove notification subscriptions.
+		this._channel.removeAllListeners(this._internal.routerId);
+
 		this._channel.request('router.close', this._internal)
 			.catch(() => {});
 
@@ -148,6 +165,9 @@ class Router extends EnhancedEventEmitter
 
 		this._closed = true;
 
+		// Remove notification subscriptions.
+		this._channel.removeAllListeners(this._internal.routerId);
+
 		// Close every Transport.
 		for (const transport of this._transports.values())
 		{
@@ -185,7 +205,103 @@ class Router extends EnhancedEventEmitter
 	{
 		logger.debug('dump()');
 
-		return this._channel.request('router.dump', this._internal);
+		const dump =
+		{
+			transportIds             : [],
+			rtpObserverIds           : [],
+			mapProducerIdConsumerIds : {},
+			mapConsumerIdProducerId  : {},
+			mapProducerIdObserverIds : {}
+		};
+		let cursor;
+
+		// Request the dump in pages so the worker is never blocked for long.
+		do
+		{
+			const page = await this._channel.request(
+				'router.dump', this._internal, { limit: DUMP_PAGE_LIMIT, cursor });
+
+			dump.id = page.id;
+			dump.transportIds.push(...page.transportIds);
+			dump.rtpObserverIds.push(...page.rtpObserverIds);
+
+			// Consumer ids of a Producer may come in many pages.
+			for (const producerId of Object.keys(page.mapProducerIdConsumerIds))
+			{
+				if (!dump.mapProducerIdConsumerIds[producerId])
+					dump.mapProducerIdConsumerIds[producerId] = [];
+
+				dump.mapProducerIdConsumerIds[producerId].push(
+					...page.mapProducerIdConsumerIds[producerId]);
+			}
+
+			Object.assign(dump.mapConsumerIdProducerId, page.mapConsumerIdProducerId);
+			Object.assign(dump.mapProducerIdObserverIds, page.mapProducerIdObserverIds);
+
+			cursor = page.nextCursor;
+		}
+		while (cursor);
+
+		return dump;
+	}
+
+	/**
+	 * Get stats of all the Transports, Producers and Consumers in the Router.
+	 *
+	 * Stats are returned in columnar form, this is, for each entity type an
+	 * Object with "fields" (column names) and "rows" (Arrays of values).
+	 *
+	 * @async
+	 * @param {Array<String>} [fields] - Only include these fields (all if unset).
+	 *
+	 * @returns {Object}
+	 */
+	async getStats({ fields } = {})
+	{
+		logger.debug('getStats()');
+
+		let stats;
+		let cursor;
+
+		// Request the stats in pages so no response exceeds the channel limit.
+		do
+		{
+			const page = await this._channel.request(
+				'router.getStats',
+				this._internal,
+				{ fields, limit: STATS_PAGE_LIMIT, cursor });
+
+			cursor = page.nextCursor;
+			delete page.nextCursor;
+
+			if (!stats)
+				stats = page;
+			else
+				mergeStats(stats, page);
+		}
+		while (cursor);
+
+		return stats;
+	}
+
+	/**
+	 * Make the Router periodically emit "stats" events. Each event contains,
+	 * for each entity type, the "fields" and the rows that changed since the
+	 * previous event in sparse form: [ id, column, value, column, value, ... ],
+	 * being column the index of the field in "fields". Rows of RTP streams
+	 * always include the ssrc column.
+	 *
+	 * @async
+	 * @param {Number} interval - Interval in ms (0 disables stats events).
+	 * @param {Array<String>} [fields] - Only include these fields (all if unset).
+	 */
+	async setStatsInterval({ interval, fields } = {})
+	{
+		logger.debug('setStatsInterval() [interval:%s]', interval);
+
+		const reqData = { interval, fields };
+
+		await this._channel.request('router.setStatsInterval', this._internal, reqData);
 	}
 
 	/**
@@ -198,6 +314,10 @@ class Router extends EnhancedEventEmitter
 	 * @param {Boolean} [enableTcp=false] - Enable TCP.
 	 * @param {Boolean} [preferUdp=false] - Prefer UDP.
 	 * @param {Boolean} [preferTcp=false] - Prefer TCP.
+	 * @param {Number} [udpRecvBufferSize] - Kernel receive buffer size (in bytes)
+	 *   of the UDP sockets. Defaults to the Worker udpRecvBufferSize setting.
+	 * @param {Number} [udpSendBufferSize] - Kernel send buffer size (in bytes) of
+	 *   the UDP sockets. Defaults to the Worker udpSendBufferSize setting.
 	 * @param {Object} [appData={}] - Custom app data.
    *
 	 * @async
@@ -210,6 +330,8 @@ class Router extends EnhancedEventEmitter
 			enableTcp = false,
 			preferUdp = false,
 			preferTcp = false,
+			udpRecvBufferSize,
+			udpSendBufferSize,
 			appData = {}
 		} = {}
 	)
@@ -241,7 +363,16 @@ class Router extends EnhancedEventEmitter
 		});
 
 		const internal = { ...this._internal, transportId: uuidv4() };
-		const reqData = { listenIps, enableUdp, enableTcp, preferUdp, preferTcp };
+		const reqData =
+		{
+			listenIps,
+			enableUdp,
+			enableTcp,
+			preferUdp,
+			preferTcp,
+			udpRecvBufferSize,
+			udpSendBufferSize
+		};
 
 		const data =
 			await this._channel.request('router.createWebRtcTransport', internal, reqData);
@@ -279,6 +410,10 @@ class Router extends EnhancedEventEmitter
 	 * @param {Boolean} [multiSource=false] - Whether RTP/RTCP from different remote
 	 *   IPs:ports is allowed. If set, the transport will just be valid for receiving
 	 *   media (consume() cannot be called on it) and connect() must not be called.
+	 * @param {Number} [udpRecvBufferSize] - Kernel receive buffer size (in bytes)
+	 *   of the UDP sockets. Defaults to the Worker udpRecvBufferSize setting.
+	 * @param {Number} [udpSendBufferSize] - Kernel send buffer size (in bytes) of
+	 *   the UDP sockets. Defaults to the Worker udpSendBufferSize setting.
 	 * @param {Object} [appData={}] - Custom app data.
    *
 	 * @async
@@ -290,6 +425,8 @@ class Router extends EnhancedEventEmitter
 			rtcpMux = true,
 			comedia = false,
 			multiSource = false,
+			udpRecvBufferSize,
+			udpSendBufferSize,
 			appData = {}
 		} = {}
 	)
@@ -319,7 +456,8 @@ class Router extends EnhancedEventEmitter
 		}
 
 		const internal = { ...this._internal, transportId: uuidv4() };
-		const reqData = { listenIp, rtcpMux, comedia, multiSource };
+		const reqData =
+			{ listenIp, rtcpMux, comedia, multiSource, udpRecvBufferSize, udpSendBufferSize };
 
 		const data =
 			await this._channel.request('router.createPlainRtpTransport', internal, reqData);
@@ -350,12 +488,17 @@ class Router extends EnhancedEventEmitter
 	 *
 	 * @param {String|Object} listenIp - Listen IP string or an object with ip and optional
 	 *   announcedIp string.
+	 * @param {Number} [udpRecvBufferSize] - Kernel receive buffer size (in bytes)
+	 *   of the UDP sockets. Defaults to the Worker udpRecvBufferSize setting.
+	 * @param {Number} [udpSendBufferSize] - Kernel send buffer size (in bytes) of
+	 *   the UDP sockets. Defaults to the Worker udpSendBufferSize setting.
 	 * @param {Object} [appData={}] - Custom app data.
    *
 	 * @async
 	 * @returns {PipeTransport}
 	 */
-	async createPipeTransport({ listenIp, appData = {} } = {})
+	async createPipeTransport(
+		{ listenIp, udpRecvBufferSize, udpSendBufferSize, appData = {} } = {})
 	{
 		logger.debug('createPipeTransport()');
 
@@ -382,7 +525,7 @@ class Router extends EnhancedEventEmitter
 		}
 
 		const internal = { ...this._internal, transportId: uuidv4() };
-		const reqData = { listenIp };
+		const reqData = { listenIp, udpRecvBufferSize, udpSendBufferSize };
 
 		const data =
 			await this._channel.request('router.createPipeTransport', internal, reqData);
@@ -408,6 +551,82 @@ class Router extends EnhancedEventEmitter
 		return transport;
 	}
 
+	/**
+	 * Create a FileTransport that records its Consumers into a rtpdump file.
+	 *
+	 * @param {String} path - Path of the file (truncated if it exists). A seek
+	 *   index is written into the same path with ".idx" suffix.
+	 * @param {Object} [appData={}] - Custom app data.
+   *
+	 * @async
+	 * @returns {FileTransport}
+	 */
+	async createFileTransport({ path, appData = {} } = {})
+	{
+		logger.debug('createFileTransport()');
+
+		if (!path || typeof path !== 'string')
+			throw new TypeError('missing path');
+		else if (appData && typeof appData !== 'object')
+			throw new TypeError('if given, appData must be an object');
+
+		const internal = { ...this._internal, transportId: uuidv4() };
+		const reqData = { path };
+
+		// Files are opened asynchronously, so a notification (such as a file that
+		// cannot be opened) may arrive before the FileTransport exists.
+		const earlyNotifications = [];
+		const onEarlyNotification = (event, data) =>
+		{
+			earlyNotifications.push({ event, data });
+		};
+
+		this._channel.on(internal.transportId, onEarlyNotification);
+
+		let data;
+
+		try
+		{
+			data = await this._channel.request(
+				'router.createFileTransport', internal, reqData);
+		}
+		finally
+		{
+			this._channel.removeListener(internal.transportId, onEarlyNotification);
+		}
+
+		const transport = new FileTransport(
+			{
+				internal,
+				data,
+				channel                  : this._channel,
+				appData,
+				getRouterRtpCapabilities : () => this._data.rtpCapabilities,
+				getProducerById          : (producerId) => this._producers.get(producerId)
+			});
+
+		this._transports.set(transport.id, transport);
+		transport.on('@close', () => this._transports.delete(transport.id));
+
+		// Emit observer event.
+		this.safeEmit('observer:newtransport', transport);
+
+		// Deliver them once the caller had the chance to listen to them. Nothing is
+		// delivered if the transport is closed meanwhile.
+		if (earlyNotifications.length > 0)
+		{
+			setImmediate(() =>
+			{
+				for (const { event, data: notificationData } of earlyNotifications)
+				{
+					this._channel.emit(internal.transportId, event, notificationData);
+				}
+			});
+		}
+
+		return transport;
+	}
+
 	/**
 	 * Pipes the given Producer into another Router in same host.
 	 *
@@ -621,6 +840,56 @@ class Router extends EnhancedEventEmitter
 			return false;
 		}
 	}
+
+	_handleWorkerNotifications()
+	{
+		this._channel.on(this._internal.routerId, (event, data) =>
+		{
+			switch (event)
+			{
+				case 'stats':
+				{
+					// Stats of a large Router come in many parts.
+					if (!this._pendingStats)
+						this._pendingStats = data;
+					else
+						mergeStats(this._pendingStats, data);
+
+					if (data.more)
+						break;
+
+					const stats = this._pendingStats;
+
+					delete stats.more;
+					this._pendingStats = null;
+
+					this.safeEmit('stats', stats);
+
+					break;
+				}
+
+				default:
+				{
+					logger.error('ignoring unknown event "%s"', event);
+				}
+			}
+		});
+	}
+}
+
+// Appends the rows of each table in the given part to the given stats.
+function mergeStats(stats, part)
+{
+	for (const table of [ 'transports', 'producers', 'consumers' ])
+	{
+		if (!part[table])
+			continue;
+
+		if (!stats[table])
+			stats[table] = part[table];
+		else
+			stats[table].rows.push(...part[table].rows);
+	}
 }
 
 module.exports = Router;
@@ -7,6 +7,12 @@ const Consumer = require('./Consumer');
 
 const logger = new Logger('Transport');
 
+// Max length of the Consumers data in each transport.consumeMany request.
+const CONSUME_MANY_MAX_LENGTH = 60000;
+
+// Max number of ids in each transport.closeConsumers request.
+const CLOSE_CONSUMERS_MAX_IDS = 1000;
+
 class Transport extends EnhancedEventEmitter
 {
 	/**
@@ -225,6 +231,67 @@ class Transport extends EnhancedEventEmitter
 		return this._channel.request('transport.getStats', this._internal);
 	}
 
+	/**
+	 * Start capturing the clear RTP and RTCP packets received and sent by the
+	 * Transport into a ring of fixed size. Any previous capture is discarded.
+	 *
+	 * @param {Number} [snapLength=96] - Bytes captured of each packet.
+	 * @param {Number} [maxPackets=10000] - Packets kept (oldest are overwritten).
+	 *
+	 * @async
+	 */
+	async startCapture({ snapLength = undefined, maxPackets = undefined } = {})
+	{
+		logger.debug('startCapture()');
+
+		const reqData = { snapLength, maxPackets };
+
+		await this._channel.request('transport.startCapture', this._internal, reqData);
+	}
+
+	/**
+	 * Stop capturing packets. Captured packets can still be fetched.
+	 *
+	 * @async
+	 */
+	async stopCapture()
+	{
+		logger.debug('stopCapture()');
+
+		await this._channel.request('transport.stopCapture', this._internal);
+	}
+
+	/**
+	 * Get the captured packets in pcapng format, with synthetic IPv4/UDP headers.
+	 *
+	 * @async
+	 * @returns {Buffer}
+	 */
+	async getCapture()
+	{
+		logger.debug('getCapture()');
+
+		const chunks = [];
+		let offset = 0;
+		let size;
+
+		// The capture is fetched in chunks that fit into Channel messages.
+		do
+		{
+			const data = await this._channel.request(
+				'transport.getCapture', this._internal, { offset });
+
+			const chunk = Buffer.from(data.data, 'base64');
+
+			chunks.push(chunk);
+			offset += chunk.length;
+			size = data.size;
+		}
+		while (offset < size);
+
+		return Buffer.concat(chunks);
+	}
+
 	/**
 	 * Provide the Transport remote parameters.
 	 *
@@ -346,6 +413,16 @@ class Transport extends EnhancedEventEmitter
 	 * @param {String} producerId
 	 * @param {RTCRtpCapabilities} rtpCapabilities - Remote RTP capabilities.
 	 * @param {Boolean} [paused=false] - Whether the Consumer must start paused.
+	 * @param {Boolean} [broadcast=false] - Create a lightweight Consumer for a
+	 *   passive viewer of a single stream Producer. It shares the retransmission
+	 *   buffer and stats with other broadcast Consumers of the Producer and does
+	 *   not emit 'score' events.
+	 * @param {Number} [silenceThreshold] - Audio level (dBov, from -127 to 0)
+	 *   below which audio packets without the voice flag are not forwarded
+	 *   (requires the ssrc-audio-level header extension). Just for audio.
+	 * @param {Number} [priority=1] - Priority (from 1 to 255) of the Consumer
+	 *   when distributing the available outgoing bitrate of the Transport among
+	 *   its simulcast Consumers.
 	 * @param {Object} [appData={}] - Custom app data.
    *
 	 * @async
@@ -357,12 +434,161 @@ class Transport extends EnhancedEventEmitter
 			producerId,
 			rtpCapabilities,
 			paused = false,
+			broadcast = false,
+			silenceThreshold,
+			priority,
 			appData = {}
 		} = {}
 	)
 	{
 		logger.debug('consume()');
 
+		// This may throw.
+		const entry = this._getConsumeEntry(
+			{
+				producerId,
+				rtpCapabilities,
+				paused,
+				broadcast,
+				silenceThreshold,
+				priority,
+				appData
+			});
+
+		const status = await this._channel.request(
+			'transport.consume', entry.internal, entry.reqData);
+
+		return this._addConsumer(entry, status);
+	}
+
+	/**
+	 * Create many Consumers with a minimum number of requests to the worker.
+	 *
+	 * @param {Array<Object>} consumers - Each entry has the same parameters given
+	 *   to consume() (producerId, rtpCapabilities, paused, broadcast,
+	 *   silenceThreshold, priority and appData).
+	 *
+	 * If any request fails, the Consumers created by previous requests are
+	 * closed before rejecting, so either all the Consumers are created or none.
+	 *
+	 * @async
+	 * @returns {Array<Consumer>} Consumers in the same order as given.
+	 */
+	async consumeMany(consumers)
+	{
+		logger.debug('consumeMany()');
+
+		if (!Array.isArray(consumers))
+			throw new TypeError('consumers must be an Array');
+
+		// This may throw.
+		const entries = consumers.map((params) => this._getConsumeEntry(params || {}));
+		const batches = [];
+		let batch = [];
+		let batchLength = 0;
+
+		// Split entries into requests fitting into a channel message.
+		for (const entry of entries)
+		{
+			entry.item =
+			{
+				consumerId : entry.internal.consumerId,
+				producerId : entry.internal.producerId,
+				...entry.reqData
+			};
+
+			const length = Buffer.byteLength(JSON.stringify(entry.item));
+
+			if (batch.length > 0 && batchLength + length > CONSUME_MANY_MAX_LENGTH)
+			{
+				batches.push(batch);
+				batch = [];
+				batchLength = 0;
+			}
+
+			batch.push(entry);
+			batchLength += length + 1;
+		}
+
+		if (batch.length > 0)
+			batches.push(batch);
+
+		const result = [];
+
+		try
+		{
+			for (const entries2 of batches)
+			{
+				const reqData = { consumers: entries2.map((entry) => entry.item) };
+
+				const statuses =
+					await this._channel.request('transport.consumeMany', this._internal, reqData);
+
+				entries2.forEach((entry, idx) => result.push(this._addConsumer(entry, statuses[idx])));
+			}
+		}
+		catch (error)
+		{
+			// Close the Consumers created by previous requests.
+			this.closeConsumers(result);
+
+			throw error;
+		}
+
+		return result;
+	}
+
+	/**
+	 * Close many Consumers of this Transport with a single request to the worker.
+	 *
+	 * @param {Array<Consumer>} consumers
+	 */
+	closeConsumers(consumers)
+	{
+		logger.debug('closeConsumers()');
+
+		if (!Array.isArray(consumers))
+			throw new TypeError('consumers must be an Array');
+
+		const consumerIds = [];
+
+		for (const consumer of consumers)
+		{
+			if (consumer.closed || this._consumers.get(consumer.id) !== consumer)
+				continue;
+
+			consumerIds.push(consumer.id);
+			consumer.closedInBatch();
+		}
+
+		for (let idx = 0; idx < consumerIds.length; idx += CLOSE_CONSUMERS_MAX_IDS)
+		{
+			const reqData =
+				{ consumerIds: consumerIds.slice(idx, idx + CLOSE_CONSUMERS_MAX_IDS) };
+
+			this._channel.request('transport.closeConsumers', this._internal, reqData)
+				.catch(() => {});
+		}
+	}
+
+	/**
+	 * Validate consume() parameters and build the request for the worker.
+	 *
+	 * @private
+	 *
+	 * @returns {Object}
+	 */
+	_getConsumeEntry(
+		{
+			producerId,
+			rtpCapabilities,
+			paused = false,
+			broadcast = false,
+			silenceThreshold,
+			priority,
+			appData = {}
+		})
+	{
 		if (!producerId || typeof producerId !== 'string')
 			throw new TypeError('missing producerId');
 		else if (typeof rtpCapabilities !== 'object')
@@ -374,26 +600,68 @@ class Transport extends EnhancedEventEmitter
 
 		if (!producer)
 			throw Error(`Producer with id "${producerId}" not found`);
+		else if (broadcast && producer.type !== 'simple')
+			throw new TypeError('broadcast just supported for simple Producers');
+
+		if (silenceThreshold !== undefined)
+		{
+			if (
+				!Number.isInteger(silenceThreshold) ||
+				silenceThreshold < -127 ||
+				silenceThreshold > 0
+			)
+			{
+				throw new TypeError('wrong silenceThreshold');
+			}
+			else if (producer.kind !== 'audio' || broadcast)
+			{
+				throw new TypeError('silenceThreshold just supported for non broadcast audio');
+			}
+		}
+
+		if (
+			priority !== undefined &&
+			(!Number.isInteger(priority) || priority < 1 || priority > 255)
+		)
+		{
+			throw new TypeError('wrong priority');
+		}
 
 		// This may throw.
 		const rtpParameters = ortc.getConsumerRtpParameters(
 			producer.consumableRtpParameters, rtpCapabilities);
 
 		const internal = { ...this._internal, consumerId: uuidv4(), producerId };
+		const type = broadcast ? 'broadcast' : producer.type;
 		const reqData =
 		{
 			kind                   : producer.kind,
 			rtpParameters,
-			type                   : producer.type,
+			type,
 			consumableRtpEncodings : producer.consumableRtpParameters.encodings,
 			paused
 		};
 
-		const status =
-			await this._channel.request('transport.consume', internal, reqData);
+		if (silenceThreshold !== undefined)
+			reqData.silenceThreshold = silenceThreshold;
+
+		if (priority !== undefined)
+			reqData.priority = priority;
 
-		const data = { kind: producer.kind, rtpParameters, type: producer.type };
+		const data = { kind: producer.kind, rtpParameters, type };
+
+		return { internal, reqData, data, appData };
+	}
 
+	/**
+	 * Create a Consumer once the worker has created it.
+	 *
+	 * @private
+	 *
+	 * @returns {Consumer}
+	 */
+	_addConsumer({ internal, data, appData }, status)
+	{
 		const consumer = new Consumer(
 			{
 				internal,
@@ -402,6 +670,7 @@ class Transport extends EnhancedEventEmitter
 				appData,
 				paused         : status.paused,
 				producerPaused : status.producerPaused,
+				priority       : status.priority,
 				score          : status.score
 			});
 
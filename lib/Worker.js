@@ -20,12 +20,17 @@ const workerBin = process.env.MEDIASOUP_WORKER_BIN
 
 const logger = new Logger('Worker');
 
+// Max number of ids in each page of worker.dump().
+const DUMP_PAGE_LIMIT = 500;
+
 class Worker extends EnhancedEventEmitter
 {
 	/**
 	 * @private
 	 *
 	 * @emits died
+	 * @emits {lag: Number} looplag
+	 * @emits {level: String} overload
 	 * @emits observer:close
 	 * @emits {router: Router} observer:newrouter
 	 * @emits @succeed
@@ -39,7 +44,13 @@ class Worker extends EnhancedEventEmitter
 			rtcMinPort,
 			rtcMaxPort,
 			dtlsCertificateFile,
-			dtlsPrivateKeyFile
+			dtlsPrivateKeyFile,
+			loopLagThreshold,
+			overloadLagThreshold,
+			udpBackend,
+			udpRecvBufferSize,
+			udpSendBufferSize,
+			udpRecvTimestamps
 		})
 	{
 		logger.debug('constructor()');
@@ -69,6 +80,24 @@ class Worker extends EnhancedEventEmitter
 		if (typeof dtlsPrivateKeyFile === 'string' && dtlsPrivateKeyFile)
 			workerArgs.push(`--dtlsPrivateKeyFile=${dtlsPrivateKeyFile}`);
 
+		if (typeof loopLagThreshold === 'number')
+			workerArgs.push(`--loopLagThreshold=${loopLagThreshold}`);
+
+		if (typeof overloadLagThreshold === 'number')
+			workerArgs.push(`--overloadLagThreshold=${overloadLagThreshold}`);
+
+		if (typeof udpBackend === 'string' && udpBackend)
+			workerArgs.push(`--udpBackend=${udpBackend}`);
+
+		if (typeof udpRecvBufferSize === 'number')
+			workerArgs.push(`--udpRecvBufferSize=${udpRecvBufferSize}`);
+
+		if (typeof udpSendBufferSize === 'number')
+			workerArgs.push(`--udpSendBufferSize=${udpSendBufferSize}`);
+
+		if (typeof udpRecvTimestamps === 'boolean')
+			workerArgs.push(`--udpRecvTimestamps=${udpRecvTimestamps}`);
+
 		logger.debug(
 			'spawning worker process: %s %s', workerBin, workerArgs.join(' '));
 
@@ -130,6 +159,8 @@ class Worker extends EnhancedEventEmitter
 
 				logger.debug('worker process running [pid:%s]', this._pid);
 
+				this._handleWorkerNotifications();
+
 				this.emit('@success');
 			}
 		});
@@ -285,7 +316,42 @@ class Worker extends EnhancedEventEmitter
 	{
 		logger.debug('dump()');
 
-		return this._channel.request('worker.dump');
+		const dump = { routerIds: [] };
+		let cursor;
+
+		// Request the dump in pages so the worker is never blocked for long.
+		do
+		{
+			const page = await this._channel.request(
+				'worker.dump', undefined, { limit: DUMP_PAGE_LIMIT, cursor });
+
+			dump.pid = page.pid;
+			dump.routerIds.push(...page.routerIds);
+
+			cursor = page.nextCursor;
+		}
+		while (cursor);
+
+		return dump;
+	}
+
+	/**
+	 * Get event loop stats: iterations, callbacks, maxCallbacksPerIteration
+	 * (since the previous call), pollTime and busyTime (accumulated, in ms) and
+	 * lagP50, lagP90, lagP99 and lagMax (during the last 10 seconds, in ms),
+	 * recvDelayP50, recvDelayP99 and recvDelayMax (time the last received
+	 * datagrams waited in their sockets before being processed, in ms).
+	 * Also the current overloadLevel and the number of overloadLevelChanges, and
+	 * ioUring counters if the io_uring UDP backend is in use.
+	 *
+	 * @async
+	 * @returns {Object}
+	 */
+	async getLoopStats()
+	{
+		logger.debug('getLoopStats()');
+
+		return this._channel.request('worker.getLoopStats');
 	}
 
 	/**
@@ -293,14 +359,17 @@ class Worker extends EnhancedEventEmitter
 	 *
 	 * @param {String} [logLevel]
    * @param {Array<String>} [logTags]
+	 * @param {Number} [loopLagThreshold]
+	 * @param {Number} [overloadLagThreshold]
    *
 	 * @async
 	 */
-	async updateSettings({ logLevel, logTags } = {})
+	async updateSettings(
+		{ logLevel, logTags, loopLagThreshold, overloadLagThreshold } = {})
 	{
 		logger.debug('updateSettings()');
 
-		const reqData = { logLevel, logTags };
+		const reqData = { logLevel, logTags, loopLagThreshold, overloadLagThreshold };
 
 		return this._channel.request('worker.updateSettings', null, reqData);
 	}
@@ -340,6 +409,38 @@ class Worker extends EnhancedEventEmitter
 
 		return router;
 	}
+
+	_handleWorkerNotifications()
+	{
+		this._channel.on(String(this._pid), (event, data) =>
+		{
+			switch (event)
+			{
+				case 'looplag':
+				{
+					const { lag } = data;
+
+					this.safeEmit('looplag', lag);
+
+					break;
+				}
+
+				case 'overload':
+				{
+					const { level } = data;
+
+					this.safeEmit('overload', level);
+
+					break;
+				}
+
+				default:
+				{
+					logger.error('ignoring unknown event "%s"', event);
+				}
+			}
+		});
+	}
 }
 
 module.exports = Worker;
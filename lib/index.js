@@ -24,6 +24,19 @@ exports.version = version;
  * @param {Number} [rtcMaxPort=59999] - Maximum port for ICE/DTLS/RTP/RTCP.
  * @param {String} [dtlsCertificateFile] - Path to DTLS certificate.
  * @param {String} [dtlsPrivateKeyFile] - Path to DTLS private key.
+ * @param {Number} [loopLagThreshold=0] - Loop lag (in ms) above which the
+ *   Worker emits "looplag" (0 means disabled).
+ * @param {Number} [overloadLagThreshold=0] - Loop lag (in ms) above which the
+ *   Worker progressively sheds work and emits "overload" (0 means disabled).
+ * @param {String} [udpBackend='libuv'] - 'libuv'/'io_uring'. io_uring requires
+ *   Linux >= 6.0 and falls back to libuv if not available.
+ * @param {Number} [udpRecvBufferSize=0] - Kernel receive buffer size (in bytes)
+ *   of UDP sockets (0 means system default).
+ * @param {Number} [udpSendBufferSize=0] - Kernel send buffer size (in bytes) of
+ *   UDP sockets (0 means system default).
+ * @param {Boolean} [udpRecvTimestamps=false] - Use kernel receive timestamps
+ *   of UDP datagrams with the libuv backend (it costs a syscall per datagram).
+ *   io_uring always uses them.
  *
  * @async
  * @returns {Worker}
@@ -37,7 +50,13 @@ exports.createWorker = async function(
 		rtcMinPort = 10000,
 		rtcMaxPort = 59999,
 		dtlsCertificateFile,
-		dtlsPrivateKeyFile
+		dtlsPrivateKeyFile,
+		loopLagThreshold,
+		overloadLagThreshold,
+		udpBackend = 'libuv',
+		udpRecvBufferSize,
+		udpSendBufferSize,
+		udpRecvTimestamps = false
 	} = {}
 )
 {
@@ -50,7 +69,13 @@ exports.createWorker = async function(
 			rtcMinPort,
 			rtcMaxPort,
 			dtlsCertificateFile,
-			dtlsPrivateKeyFile
+			dtlsPrivateKeyFile,
+			loopLagThreshold,
+			overloadLagThreshold,
+			udpBackend,
+			udpRecvBufferSize,
+			udpSendBufferSize,
+			udpRecvTimestamps
 		});
 
 	return new Promise((resolve, reject) =>
@@ -80,8 +80,8 @@ exports.generateRouterRtpCapabilities = function(mediaCodecs)
 		// Append to the codec list.
 		caps.codecs.push(codec);
 
-		// Add a RTX video codec if video.
-		if (codec.kind === 'video')
+		// Add a RTX video codec if video (but not for FlexFEC).
+		if (codec.kind === 'video' && !isRedundancyCodec(codec))
 		{
 			const pt = DYNAMIC_PAYLOAD_TYPES[dynamicPayloadTypeIdx++];
 
@@ -311,6 +311,10 @@ exports.getConsumableRtpParameters = function(kind, params, caps, rtpMapping)
 
 		if (/.+\/rtx$/i.test(codec.mimeType))
 			continue;
+		// FEC and RED packets sent by the Producer are not relayed, the Router
+		// generates its own ones for each Consumer.
+		else if (isRedundancyCodec(codec))
+			continue;
 
 		const consumableCodecPt = rtpMapping.codecs
 			.find((entry) => entry.payloadType === codec.payloadType)
@@ -359,6 +363,41 @@ exports.getConsumableRtpParameters = function(kind, params, caps, rtpMapping)
 		}
 	}
 
+	const consumableMediaCodec = consumableParams.codecs[0];
+	const consumableCapRedundancyCodecs = caps.codecs
+		.filter((capCodec) => (
+			capCodec.kind === kind &&
+			isRedundancyCodec(capCodec) &&
+			// RED is only generated for Opus.
+			(
+				!/^audio\/red$/i.test(capCodec.mimeType) ||
+				(
+					consumableMediaCodec &&
+					/^audio\/opus$/i.test(consumableMediaCodec.mimeType) &&
+					capCodec.clockRate === consumableMediaCodec.clockRate &&
+					capCodec.channels === consumableMediaCodec.channels
+				)
+			)
+		));
+
+	for (const capCodec of consumableCapRedundancyCodecs)
+	{
+		const consumableRedundancyCodec =
+		{
+			mimeType     : capCodec.mimeType,
+			clockRate    : capCodec.clockRate,
+			payloadType  : capCodec.preferredPayloadType,
+			channels     : capCodec.channels,
+			rtcpFeedback : capCodec.rtcpFeedback,
+			parameters   : capCodec.parameters
+		};
+
+		if (!consumableRedundancyCodec.channels)
+			delete consumableRedundancyCodec.channels;
+
+		consumableParams.codecs.push(consumableRedundancyCodec);
+	}
+
 	for (const capExt of caps.headerExtensions)
 	{
 		if (
@@ -391,6 +430,7 @@ exports.getConsumableRtpParameters = function(kind, params, caps, rtpMapping)
 		// Remove useless fields.
 		delete consumableEncoding.rid;
 		delete consumableEncoding.rtx;
+		delete consumableEncoding.fec;
 		delete consumableEncoding.codecPayloadType;
 
 		// Set the mapped ssrc.
@@ -441,7 +481,8 @@ exports.canConsume = function(consumableParams, caps)
 	// Ensure there is at least one media codec.
 	if (
 		matchingCodecs.length === 0 ||
-		/.+\/rtx$/i.test(matchingCodecs[0].mimeType)
+		/.+\/rtx$/i.test(matchingCodecs[0].mimeType) ||
+		isRedundancyCodec(matchingCodecs[0])
 	)
 	{
 		return false;
@@ -455,7 +496,7 @@ exports.canConsume = function(consumableParams, caps)
  *
  * It reduces encodings to just one and takes into account given RTP capabilities
  * to reduce codecs, codecs' RTCP feedback and header extensions, and also enables
- * or disabled RTX.
+ * or disabled RTX, FlexFEC and RED.
  *
  * @param {RTCRtpParameters} consumableParams - Consumable RTP parameters.
  * @param {RTCRtpCapabilities} caps - Remote RTP capabilities.
@@ -481,6 +522,7 @@ exports.getConsumerRtpParameters = function(consumableParams, caps)
 
 	const consumableCodecs = utils.clone(consumableParams.codecs || []);
 	let rtxSupported = false;
+	let fecSupported = false;
 
 	for (const codec of consumableCodecs)
 	{
@@ -497,12 +539,15 @@ exports.getConsumerRtpParameters = function(consumableParams, caps)
 
 		if (!rtxSupported && /.+\/rtx$/i.test(codec.mimeType))
 			rtxSupported = true;
+		else if (!fecSupported && /^video\/flexfec-03$/i.test(codec.mimeType))
+			fecSupported = true;
 	}
 
 	// Ensure there is at least one media codec.
 	if (
 		consumerParams.codecs.length === 0 ||
-		/.+\/rtx$/i.test(consumerParams.codecs[0].mimeType)
+		/.+\/rtx$/i.test(consumerParams.codecs[0].mimeType) ||
+		isRedundancyCodec(consumerParams.codecs[0])
 	)
 	{
 		throw new UnsupportedError('no compatible media codecs');
@@ -522,6 +567,9 @@ exports.getConsumerRtpParameters = function(consumableParams, caps)
 	if (rtxSupported)
 		consumerEncoding.rtx = { ssrc: utils.generateRandomNumber() };
 
+	if (fecSupported)
+		consumerEncoding.fec = { ssrc: utils.generateRandomNumber() };
+
 	consumerParams.encodings.push(consumerEncoding);
 
 	// Copy verbatim.
@@ -557,6 +605,9 @@ exports.getPipeConsumerRtpParameters = function(consumableParams)
 	{
 		if (/.+\/rtx$/i.test(codec.mimeType))
 			continue;
+		// The receiving Router generates its own FEC and RED packets.
+		else if (isRedundancyCodec(codec))
+			continue;
 
 		// Reduce RTCP feedbacks by removing NACK support and other features.
 		codec.rtcpFeedback = codec.rtcpFeedback.filter((fb) => (
@@ -578,6 +629,7 @@ exports.getPipeConsumerRtpParameters = function(consumableParams)
 	for (const encoding of consumableEncodings)
 	{
 		delete encoding.rtx;
+		delete encoding.fec;
 
 		consumerParams.encodings.push(encoding);
 	}
@@ -658,6 +710,15 @@ function matchCodecs(aCodec, bCodec)
 	return true;
 }
 
+// FlexFEC and RED codecs protect media codecs but are not media codecs.
+function isRedundancyCodec(codec)
+{
+	return (
+		/^video\/flexfec-03$/i.test(codec.mimeType) ||
+		/^audio\/red$/i.test(codec.mimeType)
+	);
+}
+
 function matchHeaderExtensions(aExt, bExt)
 {
 	if (aExt.kind && bExt.kind && aExt.kind !== bExt.kind)
@@ -99,6 +99,12 @@ const supportedRtpCapabilities =
 			clockRate            : 32000,
 			channels             : 1
 		},
+		{
+			kind      : 'audio',
+			mimeType  : 'audio/red',
+			clockRate : 48000,
+			channels  : 2
+		},
 		{
 			kind      : 'audio',
 			mimeType  : 'audio/telephone-event',
@@ -259,6 +265,15 @@ const supportedRtpCapabilities =
 				{ type: 'ccm', parameter: 'fir' },
 				{ type: 'goog-remb' }
 			]
+		},
+		{
+			kind       : 'video',
+			mimeType   : 'video/flexfec-03',
+			clockRate  : 90000,
+			parameters :
+			{
+				'repair-window' : 10000000
+			}
 		}
 	],
 	headerExtensions :
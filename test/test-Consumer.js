@@ -666,6 +666,24 @@ test('Consumer emits "producerpause" and "producerresume"', async () =>
 	expect(audioConsumer.producerPaused).toBe(false);
 }, 2000);
 
+test('consumer.setPriority() succeeds', async () =>
+{
+	expect(videoConsumer.priority).toBe(1);
+
+	await videoConsumer.setPriority(3);
+	expect(videoConsumer.priority).toBe(3);
+
+	await expect(videoConsumer.dump())
+		.resolves
+		.toMatchObject({ priority: 3 });
+
+	await expect(videoConsumer.setPriority(0))
+		.rejects
+		.toThrow(TypeError);
+
+	expect(videoConsumer.priority).toBe(3);
+}, 2000);
+
 test('Consumer emits "score"', async () =>
 {
 	// Private API.
@@ -732,11 +750,297 @@ test('Consumer methods reject if closed', async () =>
 		.rejects
 		.toThrow(Error);
 
+	await expect(audioConsumer.setPriority(2))
+		.rejects
+		.toThrow(Error);
+
 	await expect(audioConsumer.requestKeyFrame())
 		.rejects
 		.toThrow(Error);
 }, 2000);
 
+test('transport.consumeMany() and transport.closeConsumers() succeed', async () =>
+{
+	const transport3 = await router.createWebRtcTransport(
+		{
+			listenIps : [ '127.0.0.1' ]
+		});
+	const onObserverNewConsumer = jest.fn();
+
+	transport3.on('observer:newconsumer', onObserverNewConsumer);
+
+	const consumers = await transport3.consumeMany(
+		[
+			{
+				producerId      : audioProducer.id,
+				rtpCapabilities : consumerDeviceCapabilities,
+				appData         : { baz: 'LOL' }
+			},
+			{
+				producerId      : videoProducer.id,
+				rtpCapabilities : consumerDeviceCapabilities,
+				paused          : true
+			}
+		]);
+
+	expect(onObserverNewConsumer).toHaveBeenCalledTimes(2);
+	expect(consumers.length).toBe(2);
+	expect(consumers[0].producerId).toBe(audioProducer.id);
+	expect(consumers[0].kind).toBe('audio');
+	expect(consumers[0].paused).toBe(false);
+	expect(consumers[0].appData).toEqual({ baz: 'LOL' });
+	expect(consumers[1].producerId).toBe(videoProducer.id);
+	expect(consumers[1].kind).toBe('video');
+	expect(consumers[1].paused).toBe(true);
+	expect(consumers[1].producerPaused).toBe(true);
+
+	await expect(transport3.dump())
+		.resolves
+		.toMatchObject(
+			{
+				consumerIds : expect.arrayContaining(
+					[ consumers[0].id, consumers[1].id ])
+			});
+
+	const onObserverClose = jest.fn();
+
+	consumers[0].once('observer:close', onObserverClose);
+	transport3.closeConsumers(consumers);
+
+	expect(onObserverClose).toHaveBeenCalledTimes(1);
+	expect(consumers[0].closed).toBe(true);
+	expect(consumers[1].closed).toBe(true);
+
+	await expect(transport3.dump())
+		.resolves
+		.toMatchObject(
+			{
+				consumerIds : []
+			});
+
+	// Nothing is created if any entry is wrong.
+	await expect(transport3.consumeMany(
+		[
+			{
+				producerId      : audioProducer.id,
+				rtpCapabilities : consumerDeviceCapabilities
+			},
+			{
+				producerId      : 'foo',
+				rtpCapabilities : consumerDeviceCapabilities
+			}
+		]))
+		.rejects
+		.toThrow(Error);
+
+	await expect(transport3.dump())
+		.resolves
+		.toMatchObject(
+			{
+				consumerIds : []
+			});
+
+	// Consumers created by previous requests are closed if a later one fails.
+	const producer2 = await transport1.produce(
+		{
+			...audioProducerParameters,
+			rtpParameters :
+			{
+				...audioProducerParameters.rtpParameters,
+				mid       : 'AUDIO2',
+				encodings : [ { ssrc: 55555555 } ]
+			}
+		});
+	const entries = Array.from({ length: 300 }, () => (
+		{
+			producerId      : audioProducer.id,
+			rtpCapabilities : consumerDeviceCapabilities
+		}));
+
+	entries.push({ producerId: producer2.id, rtpCapabilities: consumerDeviceCapabilities });
+	onObserverNewConsumer.mockClear();
+
+	// Entries do not fit into a single request, and producer2 is closed once
+	// the first one is sent so the last one fails.
+	const promise = transport3.consumeMany(entries);
+
+	producer2.close();
+
+	await expect(promise)
+		.rejects
+		.toThrow(Error);
+
+	expect(onObserverNewConsumer).toHaveBeenCalled();
+
+	await expect(transport3.dump())
+		.resolves
+		.toMatchObject(
+			{
+				consumerIds : []
+			});
+
+	transport3.close();
+}, 5000);
+
+test('router.dump() succeeds with many Consumers of the same Producer', async () =>
+{
+	const transport3 = await router.createWebRtcTransport(
+		{
+			listenIps : [ '127.0.0.1' ]
+		});
+
+	// Their ids do not fit into a single channel message.
+	const consumers = await transport3.consumeMany(
+		Array.from({ length: 2000 }, () => (
+			{
+				producerId      : audioProducer.id,
+				rtpCapabilities : consumerDeviceCapabilities
+			})));
+
+	const consumerIds = consumers.map((consumer) => consumer.id);
+	const dump = await router.dump();
+
+	expect(dump.mapProducerIdConsumerIds[audioProducer.id])
+		.toEqual(expect.arrayContaining(consumerIds));
+	expect(new Set(dump.mapProducerIdConsumerIds[audioProducer.id]).size)
+		.toBe(dump.mapProducerIdConsumerIds[audioProducer.id].length);
+
+	for (const consumerId of consumerIds)
+	{
+		expect(dump.mapConsumerIdProducerId[consumerId]).toBe(audioProducer.id);
+	}
+
+	transport3.close();
+}, 10000);
+
+test('router.getStats() succeeds with many Consumers', async () =>
+{
+	const transport3 = await router.createWebRtcTransport(
+		{
+			listenIps : [ '127.0.0.1' ]
+		});
+
+	// Their stats do not fit into a single channel message.
+	const consumers = await transport3.consumeMany(
+		Array.from({ length: 1000 }, () => (
+			{
+				producerId      : audioProducer.id,
+				rtpCapabilities : consumerDeviceCapabilities
+			})));
+
+	const stats = await router.getStats();
+	const consumerIds = stats.consumers.rows.map((row) => row[0]);
+
+	expect(stats.nextCursor).toBe(undefined);
+	expect(stats.transports.rows.map((row) => row[0])).toContain(transport3.id);
+	expect(consumerIds).toEqual(
+		expect.arrayContaining(consumers.map((consumer) => consumer.id)));
+	expect(new Set(consumerIds).size).toBe(consumerIds.length);
+
+	transport3.close();
+}, 10000);
+
+test('transport.consume() with broadcast succeeds', async () =>
+{
+	const transport3 = await router.createWebRtcTransport(
+		{
+			listenIps : [ '127.0.0.1' ]
+		});
+
+	const consumer = await transport3.consume(
+		{
+			producerId      : audioProducer.id,
+			rtpCapabilities : consumerDeviceCapabilities,
+			broadcast       : true
+		});
+
+	expect(consumer.producerId).toBe(audioProducer.id);
+	expect(consumer.kind).toBe('audio');
+	expect(consumer.type).toBe('broadcast');
+	expect(consumer.score).toEqual({ producer: 0, consumer: 10 });
+
+	await expect(consumer.dump())
+		.resolves
+		.toMatchObject(
+			{
+				id   : consumer.id,
+				type : 'broadcast'
+			});
+
+	await expect(consumer.getStats())
+		.resolves
+		.toEqual(
+			[
+				expect.objectContaining(
+					{
+						type     : 'outbound-rtp',
+						kind     : 'audio',
+						mimeType : 'audio/opus',
+						ssrc     : consumer.rtpParameters.encodings[0].ssrc
+					})
+			]);
+
+	// Just for simple Producers.
+	await expect(transport3.consume(
+		{
+			producerId      : videoProducer.id,
+			rtpCapabilities : consumerDeviceCapabilities,
+			broadcast       : true
+		}))
+		.rejects
+		.toThrow(TypeError);
+
+	transport3.close();
+}, 2000);
+
+test('transport.consume() with silenceThreshold succeeds', async () =>
+{
+	const transport3 = await router.createWebRtcTransport(
+		{
+			listenIps : [ '127.0.0.1' ]
+		});
+
+	const consumer = await transport3.consume(
+		{
+			producerId       : audioProducer.id,
+			rtpCapabilities  : consumerDeviceCapabilities,
+			silenceThreshold : -50
+		});
+
+	expect(consumer.type).toBe('simple');
+
+	await expect(consumer.dump())
+		.resolves
+		.toMatchObject(
+			{
+				id                       : consumer.id,
+				silenceThreshold         : -50,
+				silencePacketsSuppressed : 0
+			});
+
+	// Just for audio.
+	await expect(transport3.consume(
+		{
+			producerId       : videoProducer.id,
+			rtpCapabilities  : consumerDeviceCapabilities,
+			silenceThreshold : -50
+		}))
+		.rejects
+		.toThrow(TypeError);
+
+	// Out of range.
+	await expect(transport3.consume(
+		{
+			producerId       : audioProducer.id,
+			rtpCapabilities  : consumerDeviceCapabilities,
+			silenceThreshold : 10
+		}))
+		.rejects
+		.toThrow(TypeError);
+
+	transport3.close();
+}, 2000);
+
 test('Consumer emits "producerclose" if Producer is closed', async () =>
 {
 	audioConsumer = await transport2.consume(
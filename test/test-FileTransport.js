@@ -0,0 +1,175 @@
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { toBeType } = require('jest-tobetype');
+const mediasoup = require('../');
+const { createWorker } = mediasoup;
+
+expect.extend({ toBeType });
+
+let worker;
+let router;
+let transport;
+
+const mediaCodecs =
+[
+	{
+		kind      : 'audio',
+		mimeType  : 'audio/opus',
+		clockRate : 48000,
+		channels  : 2
+	},
+	{
+		kind      : 'video',
+		mimeType  : 'video/VP8',
+		clockRate : 90000
+	}
+];
+
+const filePath = path.join(os.tmpdir(), `mediasoup-test-${process.pid}.rtpdump`);
+
+beforeAll(async () =>
+{
+	worker = await createWorker();
+	router = await worker.createRouter({ mediaCodecs });
+});
+
+afterAll(() =>
+{
+	worker.close();
+
+	for (const file of [ filePath, `${filePath}.idx` ])
+	{
+		if (fs.existsSync(file))
+			fs.unlinkSync(file);
+	}
+});
+
+beforeEach(async () =>
+{
+	transport = await router.createFileTransport({ path: filePath });
+});
+
+afterEach(() => transport.close());
+
+test('router.createFileTransport() succeeds', async () =>
+{
+	await expect(router.dump())
+		.resolves
+		.toMatchObject({ transportIds: [ transport.id ] });
+
+	expect(transport.id).toBeType('string');
+	expect(transport.closed).toBe(false);
+	expect(transport.appData).toEqual({});
+	expect(transport.path).toBe(filePath);
+
+	const data = await transport.dump();
+
+	expect(data.id).toBe(transport.id);
+	expect(data.path).toBe(filePath);
+	expect(data.producerIds).toEqual([]);
+	expect(data.consumerIds).toEqual([]);
+}, 2000);
+
+test('router.createFileTransport() with wrong arguments rejects with TypeError', async () =>
+{
+	await expect(router.createFileTransport())
+		.rejects
+		.toThrow(TypeError);
+
+	await expect(router.createFileTransport({ path: 1234 }))
+		.rejects
+		.toThrow(TypeError);
+
+	await expect(router.createFileTransport({ path: filePath, appData: 'NOT-AN-OBJECT' }))
+		.rejects
+		.toThrow(TypeError);
+}, 2000);
+
+test('router.createFileTransport() with non writable path emits "recordingerror"', async () =>
+{
+	const transport2 =
+		await router.createFileTransport({ path: '/non-existent-dir/file.rtpdump' });
+
+	// The file is opened asynchronously.
+	const error =
+		await new Promise((resolve) => transport2.once('recordingerror', resolve));
+
+	expect(error).toBeType('object');
+	expect(error.message.startsWith('/non-existent-dir/file.rtpdump')).toBe(true);
+	expect(error.message.includes('uv_fs_open() failed')).toBe(true);
+
+	transport2.close();
+}, 2000);
+
+test('fileTransport.getStats() succeeds', async () =>
+{
+	const data = await transport.getStats();
+
+	expect(data).toBeType('array');
+	expect(data.length).toBe(1);
+	expect(data[0].type).toBe('transport');
+	expect(data[0].transportId).toBeType('string');
+	expect(data[0].timestamp).toBeType('number');
+	expect(data[0].bytesReceived).toBe(0);
+	expect(data[0].bytesSent).toBe(0);
+	expect(data[0].recordedPackets).toBe(0);
+	expect(data[0].droppedPackets).toBe(0);
+	expect(data[0].writeErrors).toBe(0);
+}, 2000);
+
+test('fileTransport.produce() rejects with Error', async () =>
+{
+	await expect(transport.produce(
+		{
+			kind          : 'audio',
+			rtpParameters :
+			{
+				codecs :
+				[
+					{
+						mimeType    : 'audio/opus',
+						payloadType : 111,
+						clockRate   : 48000,
+						channels    : 2
+					}
+				],
+				encodings : [ { ssrc: 11111111 } ]
+			}
+		}))
+		.rejects
+		.toThrow(Error);
+}, 2000);
+
+test('FileTransport writes the rtpdump header into the file', async () =>
+{
+	transport.close();
+
+	// Let the worker write and close the file.
+	await new Promise((resolve) => setTimeout(resolve, 200));
+
+	const buffer = fs.readFileSync(filePath);
+	const preamble = '#!rtpplay1.0 0.0.0.0/0\n';
+
+	expect(buffer.length).toBe(preamble.length + 16);
+	expect(buffer.toString('ascii', 0, preamble.length)).toBe(preamble);
+}, 2000);
+
+test('FileTransport methods reject if closed', async () =>
+{
+	const onObserverClose = jest.fn();
+
+	transport.once('observer:close', onObserverClose);
+	transport.close();
+
+	expect(onObserverClose).toHaveBeenCalledTimes(1);
+	expect(transport.closed).toBe(true);
+
+	await expect(transport.dump())
+		.rejects
+		.toThrow(Error);
+
+	await expect(transport.getStats())
+		.rejects
+		.toThrow(Error);
+}, 2000);
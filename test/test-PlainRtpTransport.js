@@ -1,3 +1,4 @@
+const dgram = require('dgram');
 const { toBeType } = require('jest-tobetype');
 const mediasoup = require('../');
 const { createWorker } = mediasoup;
@@ -174,6 +175,77 @@ test('plaintRtpTransport.getStats() succeeds', async () =>
 	expect(data[0].bytesSent).toBe(0);
 	expect(data[0].tuple).toBe(undefined);
 	expect(data[0].rtcpTuple).toBe(undefined);
+	expect(data[0].udpRecvBufferSize).toBeType('number');
+	expect(data[0].udpSendBufferSize).toBeType('number');
+	expect(data[0].udpRecvDrops).toBe(0);
+	expect(data[0].udpSendEagains).toBe(0);
+}, 2000);
+
+test('router.createPlainRtpTransport() with UDP buffer sizes succeeds', async () =>
+{
+	const transport2 = await router.createPlainRtpTransport(
+		{
+			listenIp          : '127.0.0.1',
+			rtcpMux           : true,
+			udpRecvBufferSize : 65536,
+			udpSendBufferSize : 65536
+		});
+
+	const data = await transport2.getStats();
+
+	// Linux doubles the given value to account for bookkeeping overhead.
+	expect(data[0].udpRecvBufferSize).toBeGreaterThanOrEqual(65536);
+	expect(data[0].udpSendBufferSize).toBeGreaterThanOrEqual(65536);
+
+	transport2.close();
+
+	await expect(router.createPlainRtpTransport(
+		{
+			listenIp          : '127.0.0.1',
+			udpRecvBufferSize : 'foo'
+		}))
+		.rejects
+		.toThrow(TypeError);
+}, 2000);
+
+test('plaintRtpTransport.startCapture() and getCapture() succeed', async () =>
+{
+	await expect(transport.getCapture())
+		.rejects
+		.toThrow(Error);
+
+	await expect(transport.startCapture({ snapLength: 0 }))
+		.rejects
+		.toThrow(TypeError);
+
+	await expect(transport.startCapture({ snapLength: 128, maxPackets: 1000 }))
+		.resolves
+		.toBe(undefined);
+
+	await expect(transport.dump())
+		.resolves
+		.toMatchObject(
+			{
+				capture :
+				{
+					snapLength  : 128,
+					maxPackets  : 1000,
+					packetCount : 0,
+					capturing   : true
+				}
+			});
+
+	await expect(transport.stopCapture())
+		.resolves
+		.toBe(undefined);
+
+	const capture = await transport.getCapture();
+
+	// Just the Section Header Block and the Interface Description Block.
+	expect(capture.length).toBe(48);
+	expect(capture.readUInt32LE(0)).toBe(0x0A0D0D0A);
+	expect(capture.readUInt32LE(8)).toBe(0x1A2B3C4D);
+	expect(capture.readUInt32LE(28)).toBe(1);
 }, 2000);
 
 test('plaintRtpTransport.connect() succeeds', async () =>
@@ -195,6 +267,105 @@ test('plaintRtpTransport.connect() succeeds', async () =>
 	expect(transport.rtcpTuple.protocol).toBe('udp');
 }, 2000);
 
+test('comedia plainRtpTransport delivers media to Consumers created before connecting', async () =>
+{
+	// Creates a RTP packet with Opus payload type.
+	function createRtpPacket(ssrc, seq)
+	{
+		const packet = Buffer.alloc(12 + 20, 0xAA);
+
+		packet.writeUInt8(0x80, 0);
+		packet.writeUInt8(100, 1);
+		packet.writeUInt16BE(seq, 2);
+		packet.writeUInt32BE(seq * 960, 4);
+		packet.writeUInt32BE(ssrc, 8);
+
+		return packet;
+	}
+
+	const sendTransport = await router.createPlainRtpTransport(
+		{
+			listenIp : '127.0.0.1',
+			comedia  : true
+		});
+	const recvTransport = await router.createPlainRtpTransport(
+		{
+			listenIp : '127.0.0.1',
+			comedia  : true
+		});
+
+	const producer = await sendTransport.produce(
+		{
+			kind          : 'audio',
+			rtpParameters :
+			{
+				codecs :
+				[
+					{
+						mimeType    : 'audio/opus',
+						payloadType : 100,
+						clockRate   : 48000,
+						channels    : 2
+					}
+				],
+				encodings : [ { ssrc: 11111111 } ]
+			}
+		});
+
+	// The Consumer exists before the Transport gets connected.
+	const consumer = await recvTransport.consume(
+		{
+			producerId      : producer.id,
+			rtpCapabilities : router.rtpCapabilities
+		});
+
+	const sendSocket = dgram.createSocket('udp4');
+	const recvSocket = dgram.createSocket('udp4');
+	let seq = 1;
+
+	await new Promise((resolve) => sendSocket.bind(0, '127.0.0.1', resolve));
+	await new Promise((resolve) => recvSocket.bind(0, '127.0.0.1', resolve));
+
+	const received = new Promise((resolve) =>
+	{
+		recvSocket.on('message', (message) =>
+		{
+			// Ignore RTCP.
+			if ((message.readUInt8(1) & 0x7F) === consumer.rtpParameters.codecs[0].payloadType)
+				resolve(message);
+		});
+	});
+
+	// The first packet received by the comedia Transport connects it.
+	recvSocket.send(
+		createRtpPacket(99999999, 1),
+		recvTransport.tuple.localPort,
+		'127.0.0.1');
+
+	const interval = setInterval(() =>
+	{
+		sendSocket.send(
+			createRtpPacket(11111111, seq++),
+			sendTransport.tuple.localPort,
+			'127.0.0.1');
+	}, 10);
+
+	try
+	{
+		const message = await received;
+
+		expect(message.readUInt32BE(8)).toBe(consumer.rtpParameters.encodings[0].ssrc);
+	}
+	finally
+	{
+		clearInterval(interval);
+		sendSocket.close();
+		recvSocket.close();
+		sendTransport.close();
+		recvTransport.close();
+	}
+}, 2000);
+
 test('plaintRtpTransport.connect() with wrong arguments rejects with TypeError', async () =>
 {
 	await expect(transport.connect())
@@ -214,6 +385,79 @@ test('plaintRtpTransport.connect() with wrong arguments rejects with TypeError',
 		.toThrow(TypeError);
 }, 2000);
 
+test('plaintRtpTransport.addDestination() and removeDestination() succeed', async () =>
+{
+	const transport2 = await router.createPlainRtpTransport(
+		{
+			listenIp : '127.0.0.1',
+			rtcpMux  : true
+		});
+
+	// Must fail if not connected.
+	await expect(transport2.addDestination({ ip: '1.2.3.4', port: 2000 }))
+		.rejects
+		.toThrow(Error);
+
+	await transport2.connect({ ip: '1.2.3.4', port: 1234 });
+
+	await expect(transport2.addDestination({ ip: '1.2.3.4', port: 2000 }))
+		.resolves
+		.toBe(undefined);
+
+	await expect(transport2.addDestination({ ip: '5.6.7.8', port: 2001 }))
+		.resolves
+		.toBe(undefined);
+
+	// Must fail if the IP family does not match.
+	await expect(transport2.addDestination({ ip: '::1', port: 2002 }))
+		.rejects
+		.toThrow(Error);
+
+	// Must fail if it already exists.
+	await expect(transport2.addDestination({ ip: '1.2.3.4', port: 1234 }))
+		.rejects
+		.toThrow(Error);
+
+	await expect(transport2.addDestination({ ip: '1.2.3.4' }))
+		.rejects
+		.toThrow(TypeError);
+
+	let data = await transport2.dump();
+
+	expect(data.destinations.length).toBe(2);
+	expect(data.destinations[0].ip).toBe('1.2.3.4');
+	expect(data.destinations[0].port).toBe(2000);
+	expect(data.destinations[1].ip).toBe('5.6.7.8');
+
+	const stats = await transport2.getStats();
+
+	expect(stats[0].destinations.length).toBe(2);
+	expect(stats[0].destinations[0].packetsSent).toBe(0);
+
+	await expect(transport2.removeDestination({ ip: '1.2.3.4', port: 2000 }))
+		.resolves
+		.toBe(undefined);
+
+	// Must fail if it does not exist.
+	await expect(transport2.removeDestination({ ip: '1.2.3.4', port: 2000 }))
+		.rejects
+		.toThrow(Error);
+
+	data = await transport2.dump();
+
+	expect(data.destinations.length).toBe(1);
+	expect(data.destinations[0].ip).toBe('5.6.7.8');
+
+	// Must fail with rtcpMux disabled.
+	await transport.connect({ ip: '1.2.3.4', port: 1234, rtcpPort: 1235 });
+
+	await expect(transport.addDestination({ ip: '1.2.3.4', port: 2000 }))
+		.rejects
+		.toThrow(Error);
+
+	transport2.close();
+}, 2000);
+
 test('PlaintRtpTransport methods reject if closed', async () =>
 {
 	const onObserverClose = jest.fn();
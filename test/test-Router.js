@@ -124,6 +124,60 @@ test('router.close() succeeds', async () =>
 	expect(router.closed).toBe(true);
 }, 2000);
 
+test('router.getStats() succeeds', async () =>
+{
+	worker = await createWorker();
+
+	const router = await worker.createRouter({ mediaCodecs });
+
+	await router.createWebRtcTransport(
+		{
+			listenIps : [ '127.0.0.1' ]
+		});
+
+	const stats = await router.getStats({ fields: [ 'bytesReceived', 'score' ] });
+
+	expect(typeof stats.timestamp).toBe('number');
+	expect(stats.transports.fields).toEqual([ 'id', 'bytesReceived' ]);
+	expect(stats.transports.rows.length).toBe(1);
+	expect(stats.transports.rows[0][1]).toBe(0);
+	expect(stats.producers.fields).toEqual([ 'id', 'ssrc', 'score' ]);
+	expect(stats.producers.rows).toEqual([]);
+	expect(stats.consumers.rows).toEqual([]);
+
+	await expect(router.getStats({ fields: [ 'foo' ] }))
+		.rejects
+		.toThrow(TypeError);
+
+	worker.close();
+}, 2000);
+
+test('router.setStatsInterval() makes Router emit "stats"', async () =>
+{
+	worker = await createWorker();
+
+	const router = await worker.createRouter({ mediaCodecs });
+	const transport = await router.createWebRtcTransport(
+		{
+			listenIps : [ '127.0.0.1' ]
+		});
+
+	await router.setStatsInterval({ interval: 100, fields: [ 'bytesSent' ] });
+
+	const stats = await new Promise((resolve) => router.once('stats', resolve));
+
+	expect(stats.transports.fields).toEqual([ 'id', 'bytesSent' ]);
+	expect(stats.transports.rows).toEqual([ [ transport.id, 1, 0 ] ]);
+
+	await router.setStatsInterval({ interval: 0 });
+
+	await expect(router.setStatsInterval())
+		.rejects
+		.toThrow(TypeError);
+
+	worker.close();
+}, 2000);
+
 test('Router emits "workerclose" if Worker is closed', async () =>
 {
 	worker = await createWorker();
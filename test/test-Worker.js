@@ -114,6 +114,86 @@ test('worker.dump() succeeds', async () =>
 	worker.close();
 }, 2000);
 
+test('createWorker() with udpBackend io_uring succeeds', async () =>
+{
+	worker = await createWorker({ udpBackend: 'io_uring' });
+
+	expect(worker.pid).toBeType('number');
+
+	worker.close();
+}, 2000);
+
+test('createWorker() with wrong udpBackend rejects with TypeError', async () =>
+{
+	await expect(createWorker({ udpBackend: 'foo' }))
+		.rejects
+		.toThrow(TypeError);
+}, 2000);
+
+test('createWorker() with UDP buffer sizes succeeds', async () =>
+{
+	worker = await createWorker({ udpRecvBufferSize: 65536, udpSendBufferSize: 65536 });
+
+	expect(worker.pid).toBeType('number');
+
+	worker.close();
+}, 2000);
+
+test('createWorker() with udpRecvTimestamps succeeds', async () =>
+{
+	worker = await createWorker({ udpRecvTimestamps: true });
+
+	expect(worker.pid).toBeType('number');
+
+	worker.close();
+}, 2000);
+
+test('worker.getLoopStats() succeeds', async () =>
+{
+	worker = await createWorker();
+
+	const stats = await worker.getLoopStats();
+
+	expect(stats.iterations).toBeType('number');
+	expect(stats.callbacks).toBeType('number');
+	expect(stats.maxCallbacksPerIteration).toBeType('number');
+	expect(stats.pollTime).toBeType('number');
+	expect(stats.busyTime).toBeType('number');
+	expect(stats.lagP50).toBeType('number');
+	expect(stats.lagP90).toBeType('number');
+	expect(stats.lagP99).toBeType('number');
+	expect(stats.lagMax).toBeType('number');
+	expect(stats.recvDelayP50).toBeType('number');
+	expect(stats.recvDelayP99).toBeType('number');
+	expect(stats.recvDelayMax).toBeType('number');
+	expect(stats.overloadLevel).toBe('none');
+	expect(stats.overloadLevelChanges).toBeType('number');
+
+	worker.close();
+}, 2000);
+
+test('worker.updateSettings() with loopLagThreshold succeeds', async () =>
+{
+	worker = await createWorker();
+
+	await expect(worker.updateSettings({ loopLagThreshold: 100 }))
+		.resolves
+		.toBeUndefined();
+
+	worker.close();
+}, 2000);
+
+test('worker.updateSettings() with overloadLagThreshold succeeds', async () =>
+{
+	worker = await createWorker();
+
+	await expect(worker.updateSettings({ overloadLagThreshold: 40 }))
+		.resolves
+		.toBeUndefined();
+
+	worker.close();
+}, 2000);
+
 test('worker.dump() rejects with InvalidStateError if closed', async () =>
 {
 	worker = await createWorker();
@@ -701,3 +701,198 @@ test('getProducerRtpParametersMapping() with incompatible params throws Unsuppor
 		() => ortc.getProducerRtpParametersMapping(rtpParameters, routerRtpCapabilities))
 		.toThrow(UnsupportedError);
 });
+
+test('getConsumerRtpParameters() with FlexFEC capability enables FEC', () =>
+{
+	const mediaCodecs =
+	[
+		{
+			kind      : 'video',
+			mimeType  : 'video/VP8',
+			clockRate : 90000
+		},
+		{
+			kind      : 'video',
+			mimeType  : 'video/flexfec-03',
+			clockRate : 90000
+		}
+	];
+
+	const routerRtpCapabilities = ortc.generateRouterRtpCapabilities(mediaCodecs);
+
+	// VP8, VP8 RTX and FlexFEC (without RTX).
+	expect(routerRtpCapabilities.codecs.length).toBe(3);
+	expect(routerRtpCapabilities.codecs[2].mimeType).toBe('video/flexfec-03');
+	expect(routerRtpCapabilities.codecs[2].preferredPayloadType).toBe(102);
+
+	const rtpParameters =
+	{
+		codecs :
+		[
+			{
+				mimeType    : 'video/VP8',
+				payloadType : 96,
+				clockRate   : 90000
+			}
+		],
+		headerExtensions : [],
+		encodings        : [ { ssrc: 11111111 } ],
+		rtcp             :
+		{
+			cname : 'qwerty1234'
+		}
+	};
+
+	const rtpMapping =
+		ortc.getProducerRtpParametersMapping(rtpParameters, routerRtpCapabilities);
+	const consumableRtpParameters = ortc.getConsumableRtpParameters(
+		'video', rtpParameters, routerRtpCapabilities, rtpMapping);
+
+	expect(consumableRtpParameters.codecs.length).toBe(3);
+	expect(consumableRtpParameters.codecs[2].mimeType).toBe('video/flexfec-03');
+
+	let consumerRtpParameters =
+		ortc.getConsumerRtpParameters(consumableRtpParameters, routerRtpCapabilities);
+
+	expect(consumerRtpParameters.codecs.length).toBe(3);
+	expect(consumerRtpParameters.encodings[0].fec).toBeType('object');
+	expect(consumerRtpParameters.encodings[0].fec.ssrc).toBeType('number');
+
+	// Without FlexFEC in the remote capabilities.
+	const remoteRtpCapabilities =
+	{
+		codecs : routerRtpCapabilities.codecs.slice(0, 2)
+	};
+
+	consumerRtpParameters =
+		ortc.getConsumerRtpParameters(consumableRtpParameters, remoteRtpCapabilities);
+
+	expect(consumerRtpParameters.codecs.length).toBe(2);
+	expect(consumerRtpParameters.encodings[0].fec).toBe(undefined);
+
+	const pipeConsumerRtpParameters =
+		ortc.getPipeConsumerRtpParameters(consumableRtpParameters);
+
+	expect(pipeConsumerRtpParameters.codecs.length).toBe(1);
+	expect(pipeConsumerRtpParameters.encodings[0].fec).toBe(undefined);
+});
+
+test('getConsumerRtpParameters() with RED capability keeps the RED codec', () =>
+{
+	const mediaCodecs =
+	[
+		{
+			kind      : 'audio',
+			mimeType  : 'audio/opus',
+			clockRate : 48000,
+			channels  : 2
+		},
+		{
+			kind      : 'audio',
+			mimeType  : 'audio/red',
+			clockRate : 48000,
+			channels  : 2
+		}
+	];
+
+	const routerRtpCapabilities = ortc.generateRouterRtpCapabilities(mediaCodecs);
+
+	expect(routerRtpCapabilities.codecs.length).toBe(2);
+	expect(routerRtpCapabilities.codecs[1].mimeType).toBe('audio/red');
+
+	const rtpParameters =
+	{
+		codecs :
+		[
+			{
+				mimeType    : 'audio/opus',
+				payloadType : 111,
+				clockRate   : 48000,
+				channels    : 2
+			}
+		],
+		headerExtensions : [],
+		encodings        : [ { ssrc: 11111111 } ],
+		rtcp             :
+		{
+			cname : 'qwerty1234'
+		}
+	};
+
+	const rtpMapping =
+		ortc.getProducerRtpParametersMapping(rtpParameters, routerRtpCapabilities);
+	const consumableRtpParameters = ortc.getConsumableRtpParameters(
+		'audio', rtpParameters, routerRtpCapabilities, rtpMapping);
+
+	expect(consumableRtpParameters.codecs.length).toBe(2);
+	expect(consumableRtpParameters.codecs[1].mimeType).toBe('audio/red');
+	expect(consumableRtpParameters.codecs[1].payloadType).toBe(101);
+
+	const consumerRtpParameters =
+		ortc.getConsumerRtpParameters(consumableRtpParameters, routerRtpCapabilities);
+
+	expect(consumerRtpParameters.codecs.length).toBe(2);
+	expect(consumerRtpParameters.codecs[0].mimeType).toBe('audio/opus');
+	expect(consumerRtpParameters.codecs[1].mimeType).toBe('audio/red');
+
+	// RED alone is not enough.
+	expect(ortc.canConsume(
+		consumableRtpParameters, { codecs: [ routerRtpCapabilities.codecs[1] ] }))
+		.toBe(false);
+
+	const pipeConsumerRtpParameters =
+		ortc.getPipeConsumerRtpParameters(consumableRtpParameters);
+
+	expect(pipeConsumerRtpParameters.codecs.length).toBe(1);
+});
+
+test('getConsumableRtpParameters() does not add RED for non Opus codecs', () =>
+{
+	const mediaCodecs =
+	[
+		{
+			kind      : 'audio',
+			mimeType  : 'audio/PCMU',
+			clockRate : 8000
+		},
+		{
+			kind      : 'audio',
+			mimeType  : 'audio/red',
+			clockRate : 48000,
+			channels  : 2
+		}
+	];
+
+	const routerRtpCapabilities = ortc.generateRouterRtpCapabilities(mediaCodecs);
+
+	const rtpParameters =
+	{
+		codecs :
+		[
+			{
+				mimeType    : 'audio/PCMU',
+				payloadType : 0,
+				clockRate   : 8000
+			}
+		],
+		headerExtensions : [],
+		encodings        : [ { ssrc: 11111111 } ],
+		rtcp             :
+		{
+			cname : 'qwerty1234'
+		}
+	};
+
+	const rtpMapping =
+		ortc.getProducerRtpParametersMapping(rtpParameters, routerRtpCapabilities);
+	const consumableRtpParameters = ortc.getConsumableRtpParameters(
+		'audio', rtpParameters, routerRtpCapabilities, rtpMapping);
+
+	expect(consumableRtpParameters.codecs.length).toBe(1);
+	expect(consumableRtpParameters.codecs[0].mimeType).toBe('audio/PCMU');
+
+	const consumerRtpParameters =
+		ortc.getConsumerRtpParameters(consumableRtpParameters, routerRtpCapabilities);
+
+	expect(consumerRtpParameters.codecs.length).toBe(1);
+});
@@ -0,0 +1,75 @@
+#ifndef MS_CHANNEL_DUMP_PAGER_HPP
+#define MS_CHANNEL_DUMP_PAGER_HPP
+
+#include "common.hpp"
+#include "json.hpp"
+#include <map>
+#include <string>
+
+using json = nlohmann::json;
+
+namespace Channel
+{
+	// Splits a dump of many entities into pages of at most 'limit' items and
+	// about MaxPageSize bytes, so no response exceeds the Channel message limit.
+	// A dump is made of ordered sections (i.e. transports, producers...) whose
+	// items are kept sorted by id by their owner, so a page just looks up the
+	// opaque cursor ("<section>:<lastId>") of the previous one and goes on from
+	// there. The cursor remains valid even if entities are created or closed
+	// before the next page is requested.
+	//
+	// If the request has no limit all the items are returned in a single page.
+	class DumpPager
+	{
+	public:
+		static constexpr size_t MaxPageSize{ 32768 };
+
+	public:
+		DumpPager() = default;
+		explicit DumpPager(json& data);
+
+	public:
+		bool IsPaginated() const;
+		template<typename T>
+		typename std::map<std::string, T>::const_iterator Begin(
+		  uint8_t section, const std::map<std::string, T>& items) const;
+		bool Add(uint8_t section, const std::string& id, size_t pageSize);
+		void AppendNextCursor(std::string& buffer) const;
+
+	private:
+		// Passed by argument.
+		size_t limit{ 0 };
+		uint8_t cursorSection{ 0 };
+		std::string cursorId;
+		bool hasCursor{ false };
+		// Others.
+		size_t count{ 0 };
+		bool hasMore{ false };
+		uint8_t lastSection{ 0 };
+		std::string lastId;
+	};
+
+	/* Inline instance methods. */
+
+	inline bool DumpPager::IsPaginated() const
+	{
+		return this->limit != 0;
+	}
+
+	// First item of the section not dumped in previous pages.
+	template<typename T>
+	typename std::map<std::string, T>::const_iterator DumpPager::Begin(
+	  uint8_t section, const std::map<std::string, T>& items) const
+	{
+		if (!this->hasCursor || section > this->cursorSection)
+			return items.begin();
+
+		// Section already dumped in previous pages.
+		if (section < this->cursorSection)
+			return items.end();
+
+		return items.upper_bound(this->cursorId);
+	}
+} // namespace Channel
+
+#endif
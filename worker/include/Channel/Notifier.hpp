@@ -14,6 +14,8 @@ namespace Channel
 		static void ClassInit(Channel::UnixStreamSocket* channel);
 		static void Emit(const std::string& targetId, const char* event);
 		static void Emit(const std::string& targetId, const char* event, json& data);
+		// Given data must be an already serialized JSON value.
+		static void Emit(const std::string& targetId, const char* event, const std::string& data);
 
 	public:
 		// Passed by argument.
@@ -20,13 +20,17 @@ namespace Channel
 		enum class MethodId
 		{
 			WORKER_DUMP = 1,
+			WORKER_GET_LOOP_STATS,
 			WORKER_UPDATE_SETTINGS,
 			WORKER_CREATE_ROUTER,
 			ROUTER_CLOSE,
 			ROUTER_DUMP,
+			ROUTER_GET_STATS,
+			ROUTER_SET_STATS_INTERVAL,
 			ROUTER_CREATE_WEBRTC_TRANSPORT,
 			ROUTER_CREATE_PLAIN_RTP_TRANSPORT,
 			ROUTER_CREATE_PIPE_TRANSPORT,
+			ROUTER_CREATE_FILE_TRANSPORT,
 			ROUTER_CREATE_AUDIO_LEVEL_OBSERVER,
 			TRANSPORT_CLOSE,
 			TRANSPORT_DUMP,
@@ -36,6 +40,13 @@ namespace Channel
 			TRANSPORT_RESTART_ICE,
 			TRANSPORT_PRODUCE,
 			TRANSPORT_CONSUME,
+			TRANSPORT_CONSUME_MANY,
+			TRANSPORT_CLOSE_CONSUMERS,
+			TRANSPORT_START_CAPTURE,
+			TRANSPORT_STOP_CAPTURE,
+			TRANSPORT_GET_CAPTURE,
+			TRANSPORT_ADD_DESTINATION,
+			TRANSPORT_REMOVE_DESTINATION,
 			PRODUCER_CLOSE,
 			PRODUCER_DUMP,
 			PRODUCER_GET_STATS,
@@ -47,6 +58,7 @@ namespace Channel
 			CONSUMER_PAUSE,
 			CONSUMER_RESUME,
 			CONSUMER_SET_PREFERRED_LAYERS,
+			CONSUMER_SET_PRIORITY,
 			CONSUMER_REQUEST_KEY_FRAME,
 			RTP_OBSERVER_CLOSE,
 			RTP_OBSERVER_PAUSE,
@@ -64,6 +76,8 @@ namespace Channel
 
 		void Accept();
 		void Accept(json& data);
+		// Given data must be an already serialized JSON object.
+		void Accept(const std::string& data);
 		void Error(const char* reason = nullptr);
 		void TypeError(const char* reason = nullptr);
 
@@ -18,12 +18,17 @@ namespace Channel
 			virtual void OnChannelRemotelyClosed(Channel::UnixStreamSocket* channel) = 0;
 		};
 
+	public:
+		// netstring payload max length.
+		static constexpr size_t NsPayloadMaxLen{ 65536 };
+
 	public:
 		explicit UnixStreamSocket(int fd);
 
 	public:
 		void SetListener(Listener* listener);
 		void Send(json& jsonMessage);
+		void Send(const std::string& nsPayload);
 		void SendLog(char* nsPayload, size_t nsPayloadLen);
 		void SendBinary(const uint8_t* nsPayload, size_t nsPayloadLen);
 
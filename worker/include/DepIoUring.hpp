@@ -0,0 +1,126 @@
+#ifndef MS_DEP_IO_URING_HPP
+#define MS_DEP_IO_URING_HPP
+
+#include "common.hpp"
+#include <uv.h>
+#include <unordered_map>
+#include <vector>
+#ifdef MS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/socket.h>
+#endif
+
+class UdpSocket;
+
+// io_uring backend for UDP sockets (Linux >= 6.0). Each socket gets a
+// multishot recvmsg that receives into a shared ring of provided buffers and
+// datagrams are sent with sendmsg submissions that are batched until the end
+// of the loop iteration. Completions are signaled to the libuv loop via an
+// eventfd.
+class DepIoUring
+{
+public:
+	struct Stats
+	{
+		uint64_t submits{ 0 };
+		uint64_t recvCompletions{ 0 };
+		uint64_t sendCompletions{ 0 };
+		uint64_t sendFallbacks{ 0 };
+		uint64_t recvRearms{ 0 };
+	};
+
+#ifdef MS_IO_URING
+private:
+	struct RecvEntry
+	{
+		UdpSocket* socket{ nullptr };
+		int fd{ -1 };
+		struct msghdr msg;
+	};
+
+	struct SendSlot
+	{
+		struct msghdr msg;
+		struct iovec iov;
+		struct sockaddr_storage addr;
+		uint8_t data[2048];
+	};
+#endif
+
+public:
+	static void ClassInit();
+	static void ClassDestroy();
+	static bool IsActive();
+	static uint64_t StartRecv(UdpSocket* socket, int fd);
+	static void StopRecv(uint64_t recvId);
+	static bool Send(int fd, const uint8_t* data, size_t len, const struct sockaddr* addr);
+	static void Flush();
+	static const Stats& GetStats();
+
+	/* Callbacks fired by UV events. */
+public:
+	static void OnEventFd();
+
+#ifdef MS_IO_URING
+private:
+	static bool Setup();
+	static void Teardown();
+	static struct io_uring_sqe* GetSqe();
+	static void ArmRecv(uint64_t recvId, RecvEntry& entry);
+	static void ProcessCompletions();
+	static void ProcessRecvCompletion(uint64_t recvId, int32_t res, uint32_t flags);
+	static void RecycleBuffer(uint16_t bufferId);
+
+private:
+	static bool active;
+	static int ringFd;
+	static int eventFd;
+	static uv_poll_t eventFdHandle;
+	static uv_prepare_t prepareHandle;
+	static uv_check_t checkHandle;
+	// Submission and completion rings (single mmap).
+	static void* rings;
+	static size_t ringsSize;
+	static struct io_uring_sqe* sqes;
+	static size_t sqesSize;
+	static uint32_t* sqHead;
+	static uint32_t* sqTail;
+	static uint32_t* sqFlags;
+	static uint32_t sqMask;
+	static uint32_t sqEntries;
+	static uint32_t sqLocalTail;
+	static uint32_t* cqHead;
+	static uint32_t* cqTail;
+	static uint32_t cqMask;
+	static struct io_uring_cqe* cqes;
+	// Provided buffers ring.
+	static struct io_uring_buf_ring* bufRing;
+	static size_t bufRingSize;
+	static uint8_t* buffers;
+	static uint16_t bufRingTail;
+	// Receivers and send slots.
+	static std::unordered_map<uint64_t, RecvEntry> mapRecvEntries;
+	static uint64_t nextRecvId;
+	static SendSlot* sendSlots;
+	static std::vector<uint16_t> freeSendSlots;
+#endif
+	static Stats stats;
+};
+
+/* Inline static methods. */
+
+inline bool DepIoUring::IsActive()
+{
+#ifdef MS_IO_URING
+	return DepIoUring::active;
+#else
+	return false;
+#endif
+}
+
+inline const DepIoUring::Stats& DepIoUring::GetStats()
+{
+	return DepIoUring::stats;
+}
+
+#endif
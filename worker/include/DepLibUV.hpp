@@ -3,9 +3,39 @@
 
 #include "common.hpp"
 #include <uv.h>
+#include <vector>
 
 class DepLibUV
 {
+public:
+	class LoopMonitorListener
+	{
+	public:
+		virtual void OnLoopLag(uint64_t lagUs) = 0;
+	};
+
+public:
+	// Loop activity measured by the loop monitor. Time values are in
+	// microseconds.
+	struct LoopStats
+	{
+		uint64_t iterations{ 0 };
+		uint64_t callbacks{ 0 };
+		// Time blocked in the I/O poll phase (including I/O callbacks).
+		uint64_t pollTime{ 0 };
+		// Time running timers and other callbacks out of the I/O poll phase.
+		uint64_t busyTime{ 0 };
+		uint64_t maxCallbacksPerIteration{ 0 };
+		uint64_t lagP50{ 0 };
+		uint64_t lagP90{ 0 };
+		uint64_t lagP99{ 0 };
+		uint64_t lagMax{ 0 };
+		// Time received datagrams wait in the socket before being processed.
+		uint64_t recvDelayP50{ 0 };
+		uint64_t recvDelayP99{ 0 };
+		uint64_t recvDelayMax{ 0 };
+	};
+
 public:
 	static void ClassInit();
 	static void ClassDestroy();
@@ -13,9 +43,33 @@ public:
 	static void RunLoop();
 	static uv_loop_t* GetLoop();
 	static uint64_t GetTime();
+	static void StartLoopMonitor(LoopMonitorListener* listener);
+	static void StopLoopMonitor();
+	static void CountCallback();
+	static void AddRecvDelay(uint64_t delayUs);
+	static void GetLoopStats(LoopStats& stats);
+
+	/* Callbacks fired by UV events. */
+public:
+	static void OnLoopPrepare();
+	static void OnLoopCheck();
+	static void OnLagProbe();
 
 private:
 	static uv_loop_t* loop;
+	static uv_prepare_t* prepareHandle;
+	static uv_check_t* checkHandle;
+	static uv_timer_t* lagProbeHandle;
+	static LoopMonitorListener* loopMonitorListener;
+	static LoopStats loopStats;
+	static uint64_t lastPrepareAt;
+	static uint64_t lastCheckAt;
+	static uint64_t lastLagProbeAt;
+	static uint64_t iterationCallbacks;
+	static std::vector<uint64_t> lagSamples;
+	static size_t lagSamplesIdx;
+	static std::vector<uint64_t> recvDelaySamples;
+	static size_t recvDelaySamplesIdx;
 };
 
 /* Inline static methods. */
@@ -30,4 +84,9 @@ inline uint64_t DepLibUV::GetTime()
 	return uv_now(DepLibUV::loop);
 }
 
+inline void DepLibUV::CountCallback()
+{
+	++DepLibUV::loopStats.callbacks;
+}
+
 #endif
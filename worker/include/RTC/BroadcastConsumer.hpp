@@ -0,0 +1,76 @@
+#ifndef MS_RTC_BROADCAST_CONSUMER_HPP
+#define MS_RTC_BROADCAST_CONSUMER_HPP
+
+#include "RTC/BroadcastStore.hpp"
+#include "RTC/Consumer.hpp"
+#include "RTC/RetransmissionBudget.hpp"
+
+namespace RTC
+{
+	// Consumer for passive viewers of a single stream Producer. Unlike the
+	// SimpleConsumer it has no RtpStreamSend: it just keeps seq/timestamp offsets
+	// and counters, and the retransmission store and aggregated stats are shared
+	// by all the BroadcastConsumers of the Producer (see BroadcastStore). RTP
+	// payloads are never rewritten and no score events are emitted.
+	class BroadcastConsumer : public RTC::Consumer
+	{
+	public:
+		BroadcastConsumer(const std::string& id, RTC::Consumer::Listener* listener, json& data);
+		~BroadcastConsumer() override;
+
+	public:
+		void FillJsonStats(json& jsonArray) const override;
+		void FillJsonScore(json& jsonObject) const override;
+		void WriteStats(RTC::StatsWriter& writer) const override;
+		void HandleRequest(Channel::Request* request) override;
+		void ProducerNewRtpStream(RTC::RtpStream* rtpStream, uint32_t mappedSsrc) override;
+		void ProducerRtpStreamScore(RTC::RtpStream* rtpStream, uint8_t score) override;
+		void SendRtpPacket(const RTC::RtpPacket* packet) override;
+		void GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t now) override;
+		void NeedWorstRemoteFractionLost(uint32_t mappedSsrc, uint8_t& worstRemoteFractionLost) override;
+		void ReceiveNack(RTC::RTCP::FeedbackRtpNackPacket* nackPacket) override;
+		void ReceiveKeyFrameRequest(RTC::RTCP::FeedbackPs::MessageType messageType) override;
+		void ReceiveRtcpReceiverReport(RTC::RTCP::ReceiverReport* report) override;
+		uint32_t GetTransmissionRate(uint64_t now) override;
+		float GetLossPercentage() const override;
+
+	private:
+		void Paused(bool wasProducer) override;
+		void Resumed(bool wasProducer) override;
+		void UserOnTransportConnected() override;
+		const RTC::RtpPacket* GetStoredPacket(uint16_t seq, uint64_t now) const;
+		void RetransmitPacket(uint16_t seq, const RTC::RtpPacket* packet);
+		void RequestKeyFrame();
+		uint8_t GetScore() const;
+
+	private:
+		// Shared with other BroadcastConsumers.
+		RTC::BroadcastStore* store{ nullptr };
+		// Others.
+		RTC::RtpStream* producerRtpStream{ nullptr };
+		uint32_t clockRate{ 0 };
+		bool useNack{ false };
+		bool keyFrameSupported{ false };
+		bool syncRequired{ true };
+		uint16_t seqOffset{ 0 };
+		uint16_t syncBaseSeq{ 0 };
+		uint16_t maxSeq{ 0 };
+		uint16_t rtxSeq{ 0 };
+		uint32_t timestampOffset{ 0 };
+		uint32_t maxTimestamp{ 0 };
+		uint64_t maxPacketMs{ 0 };
+		RTC::RetransmissionBudget retransmissionBudget;
+		// Counters.
+		uint32_t packetCount{ 0 };
+		uint64_t byteCount{ 0 };
+		uint32_t packetsRepaired{ 0 };
+		uint32_t nackCount{ 0 };
+		uint32_t nackRtpPacketCount{ 0 };
+		uint32_t pliCount{ 0 };
+		uint32_t firCount{ 0 };
+		uint32_t packetsLost{ 0 };
+		uint8_t fractionLost{ 0 };
+	};
+} // namespace RTC
+
+#endif
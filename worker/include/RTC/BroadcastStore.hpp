@@ -0,0 +1,90 @@
+#ifndef MS_RTC_BROADCAST_STORE_HPP
+#define MS_RTC_BROADCAST_STORE_HPP
+
+#include "common.hpp"
+#include "json.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/RtpStream.hpp"
+#include <unordered_map>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace RTC
+{
+	// State shared by all the BroadcastConsumers of the same Producer stream: a
+	// single retransmission store (packets are stored once, with their original
+	// sequence numbers) and the send stats aggregated over all of them.
+	class BroadcastStore
+	{
+	public:
+		// Must be a power of 2 (and a divisor of 65536) so a stored packet is given
+		// by its sequence number.
+		static constexpr size_t BufferSize{ 512 };
+
+	public:
+		struct Stats
+		{
+			uint64_t packetCount{ 0 };
+			uint64_t byteCount{ 0 };
+			uint64_t packetsRepaired{ 0 };
+			uint64_t nackCount{ 0 };
+			uint64_t nackRtpPacketCount{ 0 };
+			uint64_t pliCount{ 0 };
+			uint64_t firCount{ 0 };
+		};
+
+	private:
+		struct StorageItem
+		{
+			uint8_t store[RTC::MtuSize];
+		};
+
+	private:
+		struct BufferItem
+		{
+			uint64_t storedAt{ 0 };
+			RTC::RtpPacket* packet{ nullptr };
+		};
+
+	public:
+		static RTC::BroadcastStore* Acquire(const RTC::RtpStream* producerRtpStream);
+		static void Release(RTC::BroadcastStore* store);
+
+	private:
+		static std::unordered_map<const RTC::RtpStream*, RTC::BroadcastStore*>
+		  mapProducerRtpStreamStore;
+
+	public:
+		explicit BroadcastStore(const RTC::RtpStream* producerRtpStream);
+		~BroadcastStore();
+
+	public:
+		void FillJsonStats(json& jsonObject) const;
+		void StorePacket(const RTC::RtpPacket* packet, uint64_t now);
+		const RTC::RtpPacket* GetPacket(uint16_t seq, uint64_t now) const;
+		size_t GetNumConsumers() const;
+
+	public:
+		// Send stats aggregated over all the BroadcastConsumers.
+		Stats stats;
+
+	private:
+		// Passed by argument.
+		const RTC::RtpStream* producerRtpStream{ nullptr };
+		// Others.
+		size_t numConsumers{ 0 };
+		// Allocated once the first packet is stored.
+		std::vector<StorageItem> storage;
+		std::vector<BufferItem> buffer;
+	};
+
+	/* Inline methods. */
+
+	inline size_t BroadcastStore::GetNumConsumers() const
+	{
+		return this->numConsumers;
+	}
+} // namespace RTC
+
+#endif
@@ -45,7 +45,6 @@ namespace RTC
 			public:
 				void Dump() const;
 				bool Encode(RTC::Codecs::EncodingContext* context, uint8_t* data);
-				void Restore(uint8_t* data);
 				bool IsKeyFrame() const;
 
 			private:
@@ -65,10 +64,6 @@ namespace RTC
 			return true;
 		};
 
-		inline void H264::PayloadDescriptorHandler::Restore(uint8_t* /*data*/)
-		{
-		}
-
 		inline bool H264::PayloadDescriptorHandler::IsKeyFrame() const
 		{
 			return this->payloadDescriptor->isKeyFrame;
@@ -44,7 +44,6 @@ namespace RTC
 		public:
 			virtual void Dump() const                                                 = 0;
 			virtual bool Encode(RTC::Codecs::EncodingContext* context, uint8_t* data) = 0;
-			virtual void Restore(uint8_t* data)                                       = 0;
 			virtual bool IsKeyFrame() const                                           = 0;
 
 		public:
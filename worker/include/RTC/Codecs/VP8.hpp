@@ -44,7 +44,6 @@ namespace RTC
 
 				// Rewrite the buffer with the given pictureId and tl0PictureIndex values.
 				void Encode(uint8_t* data, uint16_t pictureId, uint8_t tl0PictureIndex) const;
-				void Restore(uint8_t* data) const;
 
 				// mandatory fields.
 				uint8_t extended : 1;
@@ -100,7 +99,6 @@ namespace RTC
 			public:
 				void Dump() const;
 				bool Encode(RTC::Codecs::EncodingContext* encodingContext, uint8_t* data);
-				void Restore(uint8_t* data);
 				bool IsKeyFrame() const;
 
 			private:
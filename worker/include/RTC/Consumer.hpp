@@ -10,7 +10,9 @@
 #include "RTC/RTCP/ReceiverReport.hpp"
 #include "RTC/RtpDictionaries.hpp"
 #include "RTC/RtpPacket.hpp"
+#include "RTC/RtpPacketOverlay.hpp"
 #include "RTC/RtpStream.hpp"
+#include "RTC/StatsWriter.hpp"
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -23,8 +25,10 @@ namespace RTC
 		class Listener
 		{
 		public:
-			virtual void OnConsumerSendRtpPacket(RTC::Consumer* consumer, RTC::RtpPacket* packet)  = 0;
+			virtual void OnConsumerSendRtpPacket(
+			  RTC::Consumer* consumer, const RTC::RtpPacketOverlay& overlay) = 0;
 			virtual void OnConsumerKeyFrameRequested(RTC::Consumer* consumer, uint32_t mappedSsrc) = 0;
+			virtual void OnConsumerSubscriptionChanged(RTC::Consumer* consumer)                    = 0;
 			virtual void onConsumerProducerClosed(RTC::Consumer* consumer)                         = 0;
 		};
 
@@ -40,20 +44,29 @@ namespace RTC
 		virtual void FillJson(json& jsonObject) const;
 		virtual void FillJsonStats(json& jsonArray) const  = 0;
 		virtual void FillJsonScore(json& jsonObject) const = 0;
+		virtual void WriteStats(RTC::StatsWriter& writer) const = 0;
 		virtual void HandleRequest(Channel::Request* request);
 		RTC::Media::Kind GetKind() const;
 		RTC::RtpParameters::Type GetType() const;
+		uint8_t GetPriority() const;
 		const std::vector<uint32_t>& GetMediaSsrcs() const;
 		bool IsActive() const;
 		bool IsPaused() const;
 		bool IsProducerPaused() const; // This is needed by the Transport.
-		virtual void TransportConnected() = 0;
+		bool IsTransportConnected() const;
+		void TransportConnected();
+		void TransportDisconnected();
 		void ProducerPaused();
 		void ProducerResumed();
 		virtual void ProducerNewRtpStream(RTC::RtpStream* rtpStream, uint32_t mappedSsrc) = 0;
 		virtual void ProducerRtpStreamScore(RTC::RtpStream* rtpStream, uint8_t score)     = 0;
 		void ProducerClosed();
-		virtual void SendRtpPacket(RTC::RtpPacket* packet)                    = 0;
+		// Fills the mapped SSRCs of the Producer streams whose RTP packets are
+		// needed. Returns false if packets of all the streams are needed.
+		virtual bool GetSubscribedMappedSsrcs(std::vector<uint32_t>& mappedSsrcs) const;
+		// The packet is shared by all the Consumers of the Producer so it must not
+		// be modified. Rewritten fields go into a RtpPacketOverlay instead.
+		virtual void SendRtpPacket(const RTC::RtpPacket* packet)              = 0;
 		virtual void GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t now) = 0;
 		virtual void NeedWorstRemoteFractionLost(uint32_t mappedSsrc, uint8_t& worstRemoteFractionLost) = 0;
 		virtual void ReceiveNack(RTC::RTCP::FeedbackRtpNackPacket* nackPacket)              = 0;
@@ -61,10 +74,15 @@ namespace RTC
 		virtual void ReceiveRtcpReceiverReport(RTC::RTCP::ReceiverReport* report)           = 0;
 		virtual uint32_t GetTransmissionRate(uint64_t now)                                  = 0;
 		virtual float GetLossPercentage() const                                             = 0;
+		// Given the outgoing bitrate left for this Consumer, returns the bitrate it
+		// is going to use. If canPause is true it may stop sending if the bitrate
+		// is not enough for its lowest quality.
+		virtual uint32_t UseAvailableBitrate(uint32_t bitrate, bool canPause);
 
 	protected:
 		virtual void Paused(bool wasProducer)  = 0;
 		virtual void Resumed(bool wasProducer) = 0;
+		virtual void UserOnTransportConnected() = 0;
 
 	public:
 		// Passed by argument.
@@ -88,6 +106,8 @@ namespace RTC
 		bool paused{ false };
 		bool producerPaused{ false };
 		bool producerClosed{ false };
+		bool transportConnected{ false };
+		uint8_t priority{ 1 };
 	};
 
 	/* Inline methods. */
@@ -102,6 +122,11 @@ namespace RTC
 		return this->type;
 	}
 
+	inline uint8_t Consumer::GetPriority() const
+	{
+		return this->priority;
+	}
+
 	inline const std::vector<uint32_t>& Consumer::GetMediaSsrcs() const
 	{
 		return this->mediaSsrcs;
@@ -121,6 +146,11 @@ namespace RTC
 	{
 		return this->producerPaused;
 	}
+
+	inline bool Consumer::IsTransportConnected() const
+	{
+		return this->transportConnected;
+	}
 } // namespace RTC
 
 #endif
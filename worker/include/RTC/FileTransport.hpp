@@ -0,0 +1,63 @@
+#ifndef MS_RTC_FILE_TRANSPORT_HPP
+#define MS_RTC_FILE_TRANSPORT_HPP
+
+#include "RTC/Transport.hpp"
+#include "handles/FileWriter.hpp"
+
+namespace RTC
+{
+	// Transport that records the RTP and RTCP packets sent by its Consumers into
+	// a file in rtpdump format ("rtpplay1.0"). A seek index with an entry per
+	// IndexInterval is written into a sidecar file with ".idx" suffix.
+	// If a file cannot be opened or written its recording stops and
+	// "recordingerror" is emitted.
+	class FileTransport : public RTC::Transport, public FileWriter::Listener
+	{
+	public:
+		// Memory used for pending writes is bounded to MaxBlocks blocks.
+		static constexpr size_t MaxBlocks{ 32 };
+		static constexpr uint64_t IndexInterval{ 1000 };
+		// rtpdump packet header: length, RTP length and time offset in ms.
+		static constexpr size_t RecordHeaderSize{ 8 };
+		// Index entry: time offset in ms and file offset.
+		static constexpr size_t IndexEntrySize{ 12 };
+
+	public:
+		FileTransport(const std::string& id, RTC::Transport::Listener* listener, json& data);
+		~FileTransport() override;
+
+	public:
+		void FillJson(json& jsonObject) const override;
+		void FillJsonStats(json& jsonArray) const override;
+		void HandleRequest(Channel::Request* request) override;
+
+	private:
+		bool IsConnected() const override;
+		size_t GetRecvBytes() const override;
+		size_t GetSentBytes() const override;
+		void SendRtpPacket(const RTC::RtpPacketOverlay& overlay) override;
+		void SendRtcpPacket(RTC::RTCP::Packet* packet) override;
+		void SendRtcpCompoundPacket(RTC::RTCP::CompoundPacket* packet) override;
+		void WriteFileHeader();
+		void WriteRecord(uv_buf_t* buffers, size_t count, size_t len, bool isRtp);
+
+		/* Pure virtual methods inherited from FileWriter::Listener. */
+	public:
+		void OnFileWriterError(FileWriter* fileWriter, const std::string& error) override;
+
+	private:
+		// Allocated by this.
+		FileWriter* fileWriter{ nullptr };
+		FileWriter* indexWriter{ nullptr };
+		// Others.
+		std::string path;
+		uint64_t startTime{ 0 };
+		uint64_t lastIndexTime{ 0 };
+		bool hasIndexEntry{ false };
+		size_t recordedPackets{ 0 };
+		size_t recordedBytes{ 0 };
+		size_t droppedPackets{ 0 };
+	};
+} // namespace RTC
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef MS_RTC_FLEX_FEC_ENCODER_HPP
+#define MS_RTC_FLEX_FEC_ENCODER_HPP
+
+#include "common.hpp"
+#include "json.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/RtpPacketOverlay.hpp"
+
+using json = nlohmann::json;
+
+namespace RTC
+{
+	// Generates FlexFEC (draft-ietf-payload-flexible-fec-scheme-03) repair
+	// packets for a sent stream. Each repair packet is the XOR of a group of
+	// consecutive media packets and is sent in a separate stream with its own
+	// SSRC. The group size depends on the fraction lost reported by the receiver.
+	class FlexFecEncoder
+	{
+	public:
+		// Packets protected by a repair packet (fits into the 15 bits mask).
+		static constexpr size_t MaxGroupSize{ 15 };
+		// RTP header plus FlexFEC header with a single SSRC and 15 bits mask.
+		static constexpr size_t HeaderSize{ 12 + 20 };
+
+	public:
+		FlexFecEncoder(uint8_t payloadType, uint32_t ssrc, uint32_t protectedSsrc);
+		~FlexFecEncoder();
+
+	public:
+		void FillJson(json& jsonObject) const;
+		void SetFractionLost(uint8_t fractionLost);
+		size_t GetGroupSize() const;
+		// Protects the given sent media packet. Returns a repair packet to be sent
+		// now (valid until the next call) or nullptr.
+		const RTC::RtpPacket* AddPacket(const RTC::RtpPacketOverlay& overlay);
+		void Reset();
+
+	private:
+		RTC::RtpPacket* CreateFecPacket();
+
+	private:
+		// Passed by argument.
+		uint8_t payloadType{ 0 };
+		uint32_t ssrc{ 0 };
+		uint32_t protectedSsrc{ 0 };
+		// Allocated by this.
+		RTC::RtpPacket* fecPacket{ nullptr };
+		// Others.
+		uint8_t buffer[RTC::MtuSize + HeaderSize];
+		size_t groupSize{ 0 };
+		uint16_t seq{ 0 };
+		// Current group.
+		size_t numPackets{ 0 };
+		uint16_t seqBase{ 0 };
+		uint16_t mask{ 0 };
+		uint32_t timestamp{ 0 };
+		size_t maxPayloadLength{ 0 };
+		size_t packetsSent{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline size_t FlexFecEncoder::GetGroupSize() const
+	{
+		return this->groupSize;
+	}
+} // namespace RTC
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef MS_RTC_OVERLOAD_CONTROLLER_HPP
+#define MS_RTC_OVERLOAD_CONTROLLER_HPP
+
+#include "common.hpp"
+#include <string>
+#include <vector>
+
+namespace RTC
+{
+	// Sheds work when the loop falls behind. Lag samples are aggregated in
+	// periods and the median lag of each period is compared against the
+	// configured overloadLagThreshold: the level is raised one step for each
+	// overloaded period and lowered one step after several calm periods in a
+	// row, so load is restored gradually.
+	class OverloadController
+	{
+	public:
+		// Levels are cumulative: each one also applies the previous ones.
+		enum class Level : uint8_t
+		{
+			NONE = 0,
+			NO_RETRANSMISSIONS,
+			LOWER_SPATIAL_LAYERS,
+			LOWER_TEMPORAL_LAYERS,
+			STRETCH_RTCP
+		};
+
+	public:
+		static bool ProcessLagSample(uint64_t lagUs, uint64_t now);
+		static Level GetLevel();
+		static bool IsLevelReached(Level level);
+		static const std::string& GetLevelString();
+		static uint64_t GetLevelChanges();
+		static void Reset();
+
+	private:
+		static bool SetLevel(Level level);
+
+	private:
+		static Level level;
+		static uint64_t levelChanges;
+		static uint64_t periodStartedAt;
+		static size_t calmPeriods;
+		static std::vector<uint64_t> periodSamples;
+		static std::vector<std::string> level2String;
+	};
+
+	/* Inline static methods. */
+
+	inline OverloadController::Level OverloadController::GetLevel()
+	{
+		return OverloadController::level;
+	}
+
+	inline bool OverloadController::IsLevelReached(Level level)
+	{
+		return OverloadController::level >= level;
+	}
+
+	inline const std::string& OverloadController::GetLevelString()
+	{
+		return OverloadController::level2String[static_cast<uint8_t>(OverloadController::level)];
+	}
+
+	inline uint64_t OverloadController::GetLevelChanges()
+	{
+		return OverloadController::levelChanges;
+	}
+} // namespace RTC
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef MS_RTC_PACKET_CAPTURE_HPP
+#define MS_RTC_PACKET_CAPTURE_HPP
+
+#include "common.hpp"
+#include "json.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <uv.h>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace RTC
+{
+	// Fixed size ring with the last maxPackets RTP and RTCP packets (up to
+	// snapLength bytes each) seen by a Transport in clear text (after SRTP
+	// decryption and before SRTP encryption). Everything is allocated upfront
+	// and the oldest packets are overwritten. It is only used from the worker
+	// thread so no locking is needed.
+	class PacketCapture
+	{
+	public:
+		enum class Direction : uint8_t
+		{
+			IN = 1,
+			OUT
+		};
+
+	public:
+		static constexpr size_t MaxSnapLength{ RTC::MtuSize };
+		static constexpr size_t MaxBufferSize{ 16 * 1024 * 1024 };
+		// Synthetic IPv4 and UDP headers prepended to each packet.
+		static constexpr size_t IpUdpHeaderSize{ 28 };
+
+	private:
+		struct Entry
+		{
+			uint64_t time{ 0 };
+			uint32_t length{ 0 };
+			uint16_t capturedLength{ 0 };
+			Direction direction{ Direction::IN };
+		};
+
+	public:
+		PacketCapture(size_t snapLength, size_t maxPackets);
+
+	public:
+		void FillJson(json& jsonObject) const;
+		void Add(Direction direction, const uint8_t* data, size_t len);
+		void Add(Direction direction, const uv_buf_t* buffers, size_t count);
+		size_t GetPacketCount() const;
+		// Writes the captured packets (oldest first) in pcapng format.
+		void Serialize(std::vector<uint8_t>& buffer) const;
+
+	private:
+		uint8_t* Append(Direction direction, size_t len);
+
+	private:
+		// Passed by argument.
+		size_t snapLength{ 0 };
+		size_t maxPackets{ 0 };
+		// Allocated by this.
+		std::vector<Entry> entries;
+		std::vector<uint8_t> storage;
+		// Others.
+		size_t next{ 0 };
+		size_t packetCount{ 0 };
+		size_t overwrittenPackets{ 0 };
+		// Offset (in us) from uv_hrtime() to Unix time.
+		uint64_t timeOffset{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline size_t PacketCapture::GetPacketCount() const
+	{
+		return this->packetCount;
+	}
+} // namespace RTC
+
+#endif
@@ -16,11 +16,11 @@ namespace RTC
 		void FillJson(json& jsonObject) const override;
 		void FillJsonStats(json& jsonArray) const override;
 		void FillJsonScore(json& jsonObject) const override;
+		void WriteStats(RTC::StatsWriter& writer) const override;
 		void HandleRequest(Channel::Request* request) override;
-		void TransportConnected() override;
 		void ProducerNewRtpStream(RTC::RtpStream* rtpStream, uint32_t mappedSsrc) override;
 		void ProducerRtpStreamScore(RTC::RtpStream* rtpStream, uint8_t score) override;
-		void SendRtpPacket(RTC::RtpPacket* packet) override;
+		void SendRtpPacket(const RTC::RtpPacket* packet) override;
 		void GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t now) override;
 		void NeedWorstRemoteFractionLost(uint32_t mappedSsrc, uint8_t& worstRemoteFractionLost) override;
 		void ReceiveNack(RTC::RTCP::FeedbackRtpNackPacket* nackPacket) override;
@@ -32,6 +32,7 @@ namespace RTC
 	private:
 		void Paused(bool wasProducer) override;
 		void Resumed(bool wasProducer) override;
+		void UserOnTransportConnected() override;
 		void CreateRtpStreams();
 		void RequestKeyFrame();
 
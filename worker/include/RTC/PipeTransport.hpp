@@ -27,7 +27,9 @@ namespace RTC
 
 	private:
 		bool IsConnected() const override;
-		void SendRtpPacket(RTC::RtpPacket* packet) override;
+		size_t GetRecvBytes() const override;
+		size_t GetSentBytes() const override;
+		void SendRtpPacket(const RTC::RtpPacketOverlay& overlay) override;
 		void SendRtcpPacket(RTC::RTCP::Packet* packet) override;
 		void SendRtcpCompoundPacket(RTC::RTCP::CompoundPacket* packet) override;
 		void OnPacketRecv(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
@@ -37,7 +39,11 @@ namespace RTC
 		/* Pure virtual methods inherited from RTC::UdpSocket::Listener. */
 	public:
 		void OnPacketRecv(
-		  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr) override;
+		  RTC::UdpSocket* socket,
+		  const uint8_t* data,
+		  size_t len,
+		  const struct sockaddr* remoteAddr,
+		  uint64_t arrivalTime) override;
 
 	private:
 		// Allocated by this.
@@ -4,6 +4,7 @@
 #include "RTC/Transport.hpp"
 #include "RTC/TransportTuple.hpp"
 #include "RTC/UdpSocket.hpp"
+#include <vector>
 
 namespace RTC
 {
@@ -16,6 +17,20 @@ namespace RTC
 			std::string announcedIp;
 		};
 
+		// Additional remote endpoint that receives everything sent to the tuple.
+		struct Destination
+		{
+			std::string ip;
+			uint16_t port{ 0 };
+			struct sockaddr_storage addrStorage;
+			size_t packetsSent{ 0 };
+			size_t bytesSent{ 0 };
+			size_t rtcpPacketsReceived{ 0 };
+		};
+
+	public:
+		static constexpr size_t MaxDestinations{ 32 };
+
 	public:
 		PlainRtpTransport(const std::string& id, RTC::Transport::Listener* listener, json& data);
 		~PlainRtpTransport() override;
@@ -27,17 +42,26 @@ namespace RTC
 
 	private:
 		bool IsConnected() const override;
-		void SendRtpPacket(RTC::RtpPacket* packet) override;
+		size_t GetRecvBytes() const override;
+		size_t GetSentBytes() const override;
+		void SendRtpPacket(const RTC::RtpPacketOverlay& overlay) override;
 		void SendRtcpPacket(RTC::RTCP::Packet* packet) override;
 		void SendRtcpCompoundPacket(RTC::RTCP::CompoundPacket* packet) override;
 		void OnPacketRecv(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnRtpDataRecv(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnRtcpDataRecv(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
+		void Send(const uv_buf_t* buffers, size_t count);
+		Destination* GetDestination(const struct sockaddr* addr);
+		void FillJsonDestinations(json& jsonArray) const;
 
 		/* Pure virtual methods inherited from RTC::UdpSocket::Listener. */
 	public:
 		void OnPacketRecv(
-		  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr) override;
+		  RTC::UdpSocket* socket,
+		  const uint8_t* data,
+		  size_t len,
+		  const struct sockaddr* remoteAddr,
+		  uint64_t arrivalTime) override;
 
 	private:
 		// Allocated by this.
@@ -52,6 +76,7 @@ namespace RTC
 		bool multiSource{ false };
 		struct sockaddr_storage remoteAddrStorage;
 		struct sockaddr_storage rtcpRemoteAddrStorage;
+		std::vector<Destination> destinations;
 	};
 } // namespace RTC
 
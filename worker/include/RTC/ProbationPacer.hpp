@@ -0,0 +1,62 @@
+#ifndef MS_RTC_PROBATION_PACER_HPP
+#define MS_RTC_PROBATION_PACER_HPP
+
+#include "common.hpp"
+
+namespace RTC
+{
+	// Decides how many probation bytes to send along with each media packet so
+	// the outgoing bitrate reaches the one of a higher layer for a while, thus
+	// letting the bandwidth estimator know whether that layer would fit.
+	class ProbationPacer
+	{
+	public:
+		// Probe during this time at most once per interval (ms).
+		static constexpr uint64_t Interval{ 5000u };
+		static constexpr uint64_t Duration{ 1000u };
+		// Limit the probation packets sent along with each media packet.
+		static constexpr size_t MaxPacketsPerMediaPacket{ 4 };
+
+	public:
+		ProbationPacer() = default;
+
+	public:
+		// Bitrate (bps) to add to the media one. Zero stops probing.
+		void SetBitrate(uint32_t bitrate);
+		uint32_t GetBitrate() const;
+		// Adds the credit for the given sent media packet.
+		void AddMediaPacket(size_t size, uint32_t mediaBitrate, uint64_t now);
+		size_t GetAvailableBytes() const;
+		void Consume(size_t size);
+		void Clear();
+
+	private:
+		uint32_t bitrate{ 0 };
+		uint64_t startedAt{ 0 };
+		uint64_t credit{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline uint32_t ProbationPacer::GetBitrate() const
+	{
+		return this->bitrate;
+	}
+
+	inline size_t ProbationPacer::GetAvailableBytes() const
+	{
+		return static_cast<size_t>(this->credit);
+	}
+
+	inline void ProbationPacer::Consume(size_t size)
+	{
+		this->credit -= std::min(uint64_t{ size }, this->credit);
+	}
+
+	inline void ProbationPacer::Clear()
+	{
+		this->credit = 0u;
+	}
+} // namespace RTC
+
+#endif
@@ -13,6 +13,7 @@
 #include "RTC/RtpPacket.hpp"
 #include "RTC/RtpStream.hpp"
 #include "RTC/RtpStreamRecv.hpp"
+#include "RTC/StatsWriter.hpp"
 #include <map>
 #include <string>
 #include <vector>
@@ -68,6 +69,7 @@ namespace RTC
 	public:
 		void FillJson(json& jsonObject) const;
 		void FillJsonStats(json& jsonArray) const;
+		void WriteStats(RTC::StatsWriter& writer) const;
 		void HandleRequest(Channel::Request* request);
 		const RTC::RtpParameters& GetRtpParameters() const;
 		RTC::Media::Kind GetKind() const;
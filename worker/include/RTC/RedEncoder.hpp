@@ -0,0 +1,71 @@
+#ifndef MS_RTC_RED_ENCODER_HPP
+#define MS_RTC_RED_ENCODER_HPP
+
+#include "common.hpp"
+#include "json.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/RtpPacketOverlay.hpp"
+
+using json = nlohmann::json;
+
+namespace RTC
+{
+	// Encapsulates sent audio packets into RED (RFC 2198) packets carrying the
+	// payloads of the previous packets as redundant blocks. The number of
+	// redundant blocks depends on the fraction lost reported by the receiver.
+	class RedEncoder
+	{
+	public:
+		// Previous payloads carried in a RED packet.
+		static constexpr size_t MaxDistance{ 2 };
+		// Limits of the 10 bits length and 14 bits timestamp offset fields.
+		static constexpr size_t MaxBlockLength{ 1023 };
+		static constexpr uint32_t MaxTimestampOffset{ 16383 };
+
+	private:
+		struct Block
+		{
+			uint32_t timestamp{ 0 };
+			uint8_t payloadType{ 0 };
+			size_t length{ 0 };
+			uint8_t data[MaxBlockLength];
+		};
+
+	public:
+		explicit RedEncoder(uint8_t payloadType);
+		~RedEncoder();
+
+	public:
+		void FillJson(json& jsonObject) const;
+		void SetFractionLost(uint8_t fractionLost);
+		size_t GetDistance() const;
+		// Returns a RED packet (valid until the next call) to be sent instead of
+		// the given one, or nullptr if the given one must be sent as is.
+		const RTC::RtpPacket* Encode(const RTC::RtpPacketOverlay& overlay);
+
+	private:
+		void StoreBlock(uint32_t timestamp, uint8_t payloadType, const uint8_t* data, size_t length);
+
+	private:
+		// Passed by argument.
+		uint8_t payloadType{ 0 };
+		// Allocated by this.
+		RTC::RtpPacket* redPacket{ nullptr };
+		// Others.
+		uint8_t buffer[RTC::MtuSize];
+		// Payloads of the last sent packets.
+		Block blocks[MaxDistance];
+		size_t lastBlockIdx{ 0 };
+		size_t distance{ 0 };
+		size_t packetsSent{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline size_t RedEncoder::GetDistance() const
+	{
+		return this->distance;
+	}
+} // namespace RTC
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef MS_RTC_RETRANSMISSION_BUDGET_HPP
+#define MS_RTC_RETRANSMISSION_BUDGET_HPP
+
+#include "common.hpp"
+
+namespace RTC
+{
+	// Token bucket limiting the bitrate spent in retransmissions to a fraction
+	// of the media bitrate, so a receiver sending continuous NACKs cannot make
+	// us retransmit at several times the media bitrate.
+	class RetransmissionBudget
+	{
+	public:
+		// Fraction of the media bitrate allowed for retransmissions.
+		static constexpr float MediaBitrateFactor{ 0.5f };
+		// Allowed bitrate (bps) for low bitrate streams.
+		static constexpr uint32_t MinBitrate{ 100000u };
+		// The bucket holds the budget for this time (ms).
+		static constexpr uint64_t Window{ 1000u };
+
+	public:
+		RetransmissionBudget() = default;
+
+	public:
+		// Adds the budget for the time elapsed since the last call.
+		void Update(uint32_t mediaBitrate, uint64_t now);
+		size_t GetAvailableBytes() const;
+		// Returns false (and accounts it as dropped) if the packet does not fit
+		// into the budget.
+		bool Consume(size_t size);
+		void Drop(size_t count);
+		size_t GetDroppedPackets() const;
+
+	private:
+		uint64_t updatedAt{ 0 };
+		uint64_t availableBytes{ 0 };
+		size_t droppedPackets{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline size_t RetransmissionBudget::GetAvailableBytes() const
+	{
+		return static_cast<size_t>(this->availableBytes);
+	}
+
+	inline void RetransmissionBudget::Drop(size_t count)
+	{
+		this->droppedPackets += count;
+	}
+
+	inline size_t RetransmissionBudget::GetDroppedPackets() const
+	{
+		return this->droppedPackets;
+	}
+} // namespace RTC
+
+#endif
@@ -3,13 +3,18 @@
 
 #include "common.hpp"
 #include "json.hpp"
+#include "Channel/DumpPager.hpp"
 #include "Channel/Request.hpp"
 #include "RTC/Consumer.hpp"
 #include "RTC/Producer.hpp"
+#include "RTC/RtpFanOut.hpp"
 #include "RTC/RtpObserver.hpp"
 #include "RTC/RtpPacket.hpp"
 #include "RTC/RtpStream.hpp"
+#include "RTC/StatsWriter.hpp"
 #include "RTC/Transport.hpp"
+#include "handles/Timer.hpp"
+#include <map>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -18,14 +23,27 @@ using json = nlohmann::json;
 
 namespace RTC
 {
-	class Router : public RTC::Transport::Listener
+	class Router : public RTC::Transport::Listener,
+	               public RTC::StatsWriter::Listener,
+	               public Timer::Listener
 	{
+	private:
+		// Sections of a paginated dump, in cursor order.
+		struct DumpSection
+		{
+			static constexpr uint8_t TRANSPORTS{ 0 };
+			static constexpr uint8_t RTP_OBSERVERS{ 1 };
+			static constexpr uint8_t PRODUCERS{ 2 };
+			static constexpr uint8_t CONSUMERS{ 3 };
+		};
+
 	public:
 		explicit Router(const std::string& id);
 		virtual ~Router();
 
 	public:
-		void FillJson(json& jsonObject) const;
+		void FillJson(std::string& buffer, Channel::DumpPager& pager) const;
+		void FillStats(RTC::StatsWriter& writer, Channel::DumpPager& pager) const;
 		void HandleRequest(Channel::Request* request);
 
 	private:
@@ -34,6 +52,7 @@ namespace RTC
 		void SetNewRtpObserverIdFromRequest(Channel::Request* request, std::string& rtpObserverId) const;
 		RTC::RtpObserver* GetRtpObserverFromRequest(Channel::Request* request) const;
 		RTC::Producer* GetProducerFromRequest(Channel::Request* request) const;
+		void SetStatsInterval(Channel::Request* request);
 
 		/* Pure virtual methods inherited from RTC::Transport::Listener. */
 	public:
@@ -64,6 +83,16 @@ namespace RTC
 		void OnTransportConsumerProducerClosed(RTC::Transport* transport, RTC::Consumer* consumer) override;
 		void OnTransportConsumerKeyFrameRequested(
 		  RTC::Transport* transport, RTC::Consumer* consumer, uint32_t mappedSsrc) override;
+		void OnTransportConsumerSubscriptionChanged(
+		  RTC::Transport* transport, RTC::Consumer* consumer) override;
+
+		/* Pure virtual methods inherited from RTC::StatsWriter::Listener. */
+	public:
+		void OnStatsWriterChunk(RTC::StatsWriter* writer, const std::string& chunk) override;
+
+		/* Pure virtual methods inherited from Timer::Listener. */
+	public:
+		void OnTimer(Timer* timer) override;
 
 	public:
 		// Passed by argument.
@@ -71,13 +100,19 @@ namespace RTC
 
 	private:
 		// Allocated by this.
-		std::unordered_map<std::string, RTC::Transport*> mapTransports;
-		std::unordered_map<std::string, RTC::RtpObserver*> mapRtpObservers;
+		// Maps by id are sorted so paginated dumps can be resumed.
+		std::map<std::string, RTC::Transport*> mapTransports;
+		std::map<std::string, RTC::RtpObserver*> mapRtpObservers;
+		Timer* statsTimer{ nullptr };
 		// Others.
 		std::unordered_map<RTC::Producer*, std::unordered_set<RTC::Consumer*>> mapProducerConsumers;
 		std::unordered_map<RTC::Consumer*, RTC::Producer*> mapConsumerProducer;
+		std::unordered_map<RTC::Producer*, RTC::RtpFanOut> mapProducerRtpFanOut;
 		std::unordered_map<RTC::Producer*, std::unordered_set<RTC::RtpObserver*>> mapProducerRtpObservers;
-		std::unordered_map<std::string, RTC::Producer*> mapProducers;
+		std::map<std::string, RTC::Producer*> mapProducers;
+		std::map<std::string, RTC::Consumer*> mapConsumers;
+		uint32_t statsFieldMask{ 0 };
+		RTC::StatsWriter::Snapshot statsSnapshot;
 	};
 } // namespace RTC
 
@@ -4,20 +4,27 @@
 #include "common.hpp"
 #include "DepLibUV.hpp"
 #include "RTC/RtpPacket.hpp"
+#include <algorithm> // std::fill()
 
 namespace RTC
 {
 	// It is considered that the time source increases monotonically.
 	// ie: the current timestamp can never be minor than a timestamp in the past.
+	//
+	// The time window is split into items of itemSize ms. Data is accounted in
+	// the item covering its time and removed once the whole item leaves the time
+	// window. The rate is computed over the time actually covered by the items.
 	class RateCalculator
 	{
 	public:
 		static constexpr float BpsScale{ 8000.0f };
 		static constexpr float BpsScale2{ 1000.0f };
 		static constexpr size_t DefaultWindowSize{ 1000 };
+		static constexpr size_t DefaultItemSize{ 1 };
 
 	public:
-		explicit RateCalculator(size_t windowSize = DefaultWindowSize, float scale = BpsScale);
+		explicit RateCalculator(
+		  size_t windowSize = DefaultWindowSize, float scale = BpsScale, size_t itemSize = DefaultItemSize);
 		void Update(size_t size, uint64_t now);
 		uint32_t GetRate(uint64_t now);
 		void Reset();
@@ -29,13 +36,13 @@ namespace RTC
 	private:
 		struct BufferItem
 		{
-			size_t count{ 0 };
+			uint32_t count{ 0 };
 		};
 
 	private:
 		std::unique_ptr<BufferItem[]> buffer;
 
-		// Time (in milliseconds) for oldest item in the time window.
+		// Time (in items) for oldest item in the time window.
 		uint64_t oldestTime{ 0 };
 		// Index for the oldest item in the time window.
 		uint32_t oldestIndex{ 0 };
@@ -45,6 +52,10 @@ namespace RTC
 		size_t windowSize{ DefaultWindowSize };
 		// Scale in which the rate is represented.
 		const float scale{ BpsScale };
+		// Item Size (in milliseconds).
+		size_t itemSize{ DefaultItemSize };
+		// Number of items in the time window.
+		size_t windowItems{ DefaultWindowSize / DefaultItemSize };
 	};
 
 	class RtpDataCounter
@@ -53,22 +64,40 @@ namespace RTC
 		RtpDataCounter() = default;
 
 	public:
-		void Update(RTC::RtpPacket* packet);
+		void Update(size_t size);
 		uint32_t GetRate(uint64_t now);
 		size_t GetPacketCount() const;
 		size_t GetBytes() const;
 
 	private:
-		RateCalculator rate;
+		static constexpr size_t ItemSize{ 100 };
+
+	private:
+		// Use 100 ms items since exact millisecond precision is not needed here
+		// and there are many RtpDataCounter instances.
+		RateCalculator rate{ RateCalculator::DefaultWindowSize, RateCalculator::BpsScale, ItemSize };
 		size_t packets{ 0 };
 		size_t bytes{ 0 };
 	};
 
 	/* Inline instance methods. */
 
-	inline RateCalculator::RateCalculator(size_t windowSize, float scale)
-	  : windowSize(windowSize), scale(scale)
+	inline RateCalculator::RateCalculator(size_t windowSize, float scale, size_t itemSize)
+	  : windowSize(windowSize), scale(scale), itemSize(itemSize)
 	{
+		if (this->itemSize == 0)
+			this->itemSize = 1;
+
+		this->windowItems = this->windowSize / this->itemSize;
+
+		if (this->windowItems == 0)
+			this->windowItems = 1;
+
+		// Make the window size a multiple of the item size.
+		this->windowSize = this->windowItems * this->itemSize;
+
+		this->buffer.reset(new BufferItem[this->windowItems]);
+
 		Reset();
 	}
 
@@ -81,10 +110,11 @@ namespace RTC
 
 	inline void RateCalculator::Reset(uint64_t now)
 	{
-		this->buffer.reset(new BufferItem[windowSize]);
+		std::fill(this->buffer.get(), this->buffer.get() + this->windowItems, BufferItem());
+
 		this->totalCount  = 0;
 		this->oldestIndex = 0;
-		this->oldestTime  = now - this->windowSize;
+		this->oldestTime  = now / this->itemSize - this->windowItems;
 	}
 
 	inline uint32_t RtpDataCounter::GetRate(uint64_t now)
@@ -69,7 +69,8 @@ namespace RTC
 			ULPFEC,
 			X_ULPFECUC,
 			FLEXFEC,
-			RED
+			RED,
+			FLEXFEC_03
 		};
 
 	public:
@@ -187,6 +188,18 @@ namespace RTC
 		uint32_t ssrc{ 0 };
 	};
 
+	class RtpFecParameters
+	{
+	public:
+		RtpFecParameters(){};
+		explicit RtpFecParameters(json& data);
+
+		void FillJson(json& jsonObject) const;
+
+	public:
+		uint32_t ssrc{ 0 };
+	};
+
 	class RtpEncodingParameters
 	{
 	public:
@@ -202,6 +215,8 @@ namespace RTC
 		bool hasCodecPayloadType{ false };
 		RtpRtxParameters rtx;
 		bool hasRtx{ false };
+		RtpFecParameters fec;
+		bool hasFec{ false };
 		uint32_t maxBitrate{ 0 };
 		double maxFramerate{ 0 };
 	};
@@ -244,7 +259,8 @@ namespace RTC
 			SIMPLE,
 			SIMULCAST,
 			SVC,
-			PIPE
+			PIPE,
+			BROADCAST
 		};
 
 	public:
@@ -263,8 +279,11 @@ namespace RTC
 		explicit RtpParameters(const RtpParameters* rtpParameters);
 
 		void FillJson(json& jsonObject) const;
-		const RTC::RtpCodecParameters* GetCodecForEncoding(RtpEncodingParameters& encoding) const;
-		const RTC::RtpCodecParameters* GetRtxCodecForEncoding(RtpEncodingParameters& encoding) const;
+		const RTC::RtpCodecParameters* GetCodecForEncoding(const RtpEncodingParameters& encoding) const;
+		const RTC::RtpCodecParameters* GetRtxCodecForEncoding(
+		  const RtpEncodingParameters& encoding) const;
+		const RTC::RtpCodecParameters* GetFecCodec() const;
+		const RTC::RtpCodecParameters* GetRedCodec() const;
 
 	private:
 		void ValidateCodecs();
@@ -0,0 +1,40 @@
+#ifndef MS_RTC_RTP_FAN_OUT_HPP
+#define MS_RTC_RTP_FAN_OUT_HPP
+
+#include "common.hpp"
+#include "RTC/Consumer.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <unordered_map>
+#include <vector>
+
+namespace RTC
+{
+	// Dispatches the RTP packets of a Producer to its Consumers. Consumers that
+	// just need some streams of the Producer (given by their subscribed mapped
+	// SSRCs) are indexed by mapped SSRC so they only get packets of those streams.
+	class RtpFanOut
+	{
+	public:
+		void AddConsumer(RTC::Consumer* consumer);
+		void RemoveConsumer(RTC::Consumer* consumer);
+		void UpdateConsumer(RTC::Consumer* consumer);
+		void SendRtpPacket(const RTC::RtpPacket* packet);
+		size_t GetNumConsumers(uint32_t mappedSsrc) const;
+
+	private:
+		void Subscribe(RTC::Consumer* consumer);
+		void Unsubscribe(RTC::Consumer* consumer);
+
+	private:
+		// Consumers that need packets of all the streams.
+		std::vector<RTC::Consumer*> allStreamsConsumers;
+		// Consumers indexed by the mapped SSRC of the streams they need.
+		std::unordered_map<uint32_t, std::vector<RTC::Consumer*>> mapMappedSsrcConsumers;
+		std::unordered_map<RTC::Consumer*, std::vector<uint32_t>> mapConsumerMappedSsrcs;
+		// Subscription changes are deferred while dispatching a packet.
+		bool dispatching{ false };
+		std::vector<RTC::Consumer*> pendingUpdates;
+	};
+} // namespace RTC
+
+#endif
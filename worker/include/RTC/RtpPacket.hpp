@@ -117,6 +117,7 @@ namespace RTC
 		bool ReadAudioLevel(uint8_t& volume, bool& voice) const;
 		bool ReadVideoOrientation(bool& camera, bool& flip, uint16_t& rotation) const;
 		bool ReadAbsSendTime(uint32_t& time) const;
+		bool UpdateAbsSendTime(uint64_t ms);
 		bool ReadMid(std::string& mid) const;
 		bool ReadRid(std::string& rid) const;
 		uint8_t* GetExtension(uint8_t id, uint8_t& len) const;
@@ -128,8 +129,8 @@ namespace RTC
 		void RtxEncode(uint8_t payloadType, uint32_t ssrc, uint16_t seq);
 		bool RtxDecode(uint8_t payloadType, uint32_t ssrc);
 		void SetPayloadDescriptorHandler(RTC::Codecs::PayloadDescriptorHandler* payloadDescriptorHandler);
-		bool EncodePayload(RTC::Codecs::EncodingContext* context);
-		void RestorePayload();
+		// Rewrites the payload descriptor into the given copy of the payload start.
+		bool EncodePayload(RTC::Codecs::EncodingContext* context, uint8_t* data) const;
 		void ShiftPayload(size_t payloadOffset, size_t shift, bool expand = true);
 
 	private:
@@ -389,6 +390,22 @@ namespace RTC
 		return true;
 	}
 
+	inline bool RtpPacket::UpdateAbsSendTime(uint64_t ms)
+	{
+		uint8_t extenLen;
+		uint8_t* extenValue = GetExtension(this->absSendTimeExtensionId, extenLen);
+
+		if (!extenValue || extenLen != 3)
+			return false;
+
+		// 6.18 fixed point seconds.
+		auto time = static_cast<uint32_t>(((ms << 18) / 1000) & 0x00FFFFFF);
+
+		Utils::Byte::Set3Bytes(extenValue, 0, time);
+
+		return true;
+	}
+
 	inline bool RtpPacket::ReadMid(std::string& mid) const
 	{
 		uint8_t extenLen;
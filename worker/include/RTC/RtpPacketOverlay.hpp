@@ -0,0 +1,111 @@
+#ifndef MS_RTC_RTP_PACKET_OVERLAY_HPP
+#define MS_RTC_RTP_PACKET_OVERLAY_HPP
+
+#include "common.hpp"
+#include "RTC/Codecs/PayloadDescriptorHandler.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <uv.h>
+
+namespace RTC
+{
+	// Fields of an RTP packet rewritten for a specific Consumer (fixed header and
+	// payload descriptor) on top of a packet that is not modified. They are just
+	// combined with the rest of the packet when sending it.
+	class RtpPacketOverlay
+	{
+	public:
+		// Enough for the payload descriptors rewritten by codecs (VP8: 6 bytes).
+		static constexpr size_t MaxPayloadPrefixSize{ 8 };
+		// Fixed header, CSRCs and extensions, payload prefix, rest of payload.
+		static constexpr size_t MaxBuffers{ 4 };
+
+	public:
+		explicit RtpPacketOverlay(const RTC::RtpPacket* packet);
+
+	public:
+		const RTC::RtpPacket* GetPacket() const;
+		uint8_t GetPayloadType() const;
+		uint16_t GetSequenceNumber() const;
+		void SetSequenceNumber(uint16_t seq);
+		uint32_t GetTimestamp() const;
+		void SetTimestamp(uint32_t timestamp);
+		uint32_t GetSsrc() const;
+		void SetSsrc(uint32_t ssrc);
+		size_t GetSize() const;
+		bool IsKeyFrame() const;
+		// Rewrites the payload descriptor (if any) into the overlay. Returns false
+		// if the packet must be dropped.
+		bool EncodePayload(RTC::Codecs::EncodingContext* context);
+		// Writes the resulting packet into the given buffer, which must have room
+		// for GetSize() bytes.
+		void Serialize(uint8_t* buffer) const;
+		// Fills the given buffers (MaxBuffers at least) with the parts of the
+		// resulting packet. Returns the number of filled buffers.
+		size_t FillBuffers(uv_buf_t* buffers) const;
+		// Writes the resulting packet into the given buffer and returns a new
+		// RtpPacket on it.
+		RTC::RtpPacket* Clone(const uint8_t* buffer) const;
+
+	private:
+		// Passed by argument.
+		const RTC::RtpPacket* packet{ nullptr };
+		// Others.
+		RTC::RtpPacket::Header header;
+		uint8_t payloadPrefix[MaxPayloadPrefixSize];
+		size_t payloadPrefixSize{ 0 };
+	};
+
+	/* Inline instance methods. */
+
+	inline const RTC::RtpPacket* RtpPacketOverlay::GetPacket() const
+	{
+		return this->packet;
+	}
+
+	inline uint8_t RtpPacketOverlay::GetPayloadType() const
+	{
+		return this->header.payloadType;
+	}
+
+	inline uint16_t RtpPacketOverlay::GetSequenceNumber() const
+	{
+		return uint16_t{ ntohs(this->header.sequenceNumber) };
+	}
+
+	inline void RtpPacketOverlay::SetSequenceNumber(uint16_t seq)
+	{
+		this->header.sequenceNumber = uint16_t{ htons(seq) };
+	}
+
+	inline uint32_t RtpPacketOverlay::GetTimestamp() const
+	{
+		return uint32_t{ ntohl(this->header.timestamp) };
+	}
+
+	inline void RtpPacketOverlay::SetTimestamp(uint32_t timestamp)
+	{
+		this->header.timestamp = uint32_t{ htonl(timestamp) };
+	}
+
+	inline uint32_t RtpPacketOverlay::GetSsrc() const
+	{
+		return uint32_t{ ntohl(this->header.ssrc) };
+	}
+
+	inline void RtpPacketOverlay::SetSsrc(uint32_t ssrc)
+	{
+		this->header.ssrc = uint32_t{ htonl(ssrc) };
+	}
+
+	inline size_t RtpPacketOverlay::GetSize() const
+	{
+		return this->packet->GetSize();
+	}
+
+	inline bool RtpPacketOverlay::IsKeyFrame() const
+	{
+		return this->packet->IsKeyFrame();
+	}
+} // namespace RTC
+
+#endif
@@ -14,6 +14,7 @@
 #include "RTC/RtpDataCounter.hpp"
 #include "RTC/RtpDictionaries.hpp"
 #include "RTC/RtpPacket.hpp"
+#include "RTC/StatsWriter.hpp"
 #include <string>
 #include <vector>
 
@@ -55,6 +56,7 @@ namespace RTC
 
 		void FillJson(json& jsonObject) const;
 		virtual void FillJsonStats(json& jsonObject);
+		void WriteStats(RTC::StatsWriter& writer);
 		uint32_t GetSsrc() const;
 		uint8_t GetPayloadType() const;
 		const RTC::RtpCodecMimeType& GetMimeType() const;
@@ -76,7 +78,8 @@ namespace RTC
 		uint8_t GetScore() const;
 
 	protected:
-		bool UpdateSeq(RTC::RtpPacket* packet);
+		bool ReceivePacketFields(uint16_t seq, uint32_t timestamp, size_t size);
+		bool UpdateSeq(uint16_t seq, uint32_t timestamp);
 		void UpdateScore(uint8_t score);
 		void ResetScore();
 		void PacketRetransmitted(RTC::RtpPacket* packet);
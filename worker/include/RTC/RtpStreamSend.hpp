@@ -2,6 +2,8 @@
 #define MS_RTC_RTP_STREAM_SEND_HPP
 
 #include "Utils.hpp"
+#include "RTC/RetransmissionBudget.hpp"
+#include "RTC/RtpPacketOverlay.hpp"
 #include "RTC/RtpStream.hpp"
 #include <list>
 #include <vector>
@@ -40,6 +42,7 @@ namespace RTC
 		void FillJsonStats(json& jsonObject) override;
 		void SetRtx(uint8_t payloadType, uint32_t ssrc) override;
 		bool ReceivePacket(RTC::RtpPacket* packet) override;
+		bool ReceivePacket(const RTC::RtpPacketOverlay& overlay);
 		void ReceiveNack(RTC::RTCP::FeedbackRtpNackPacket* nackPacket);
 		void ReceiveKeyFrameRequest(RTC::RTCP::FeedbackPs::MessageType messageType);
 		void ReceiveRtcpReceiverReport(RTC::RTCP::ReceiverReport* report);
@@ -48,9 +51,12 @@ namespace RTC
 		void Pause() override;
 		void Resume() override;
 		void RetransmitPacket(RTC::RtpPacket* packet);
+		// Sends a RTX copy of the last sent packet to probe the available bitrate.
+		// Returns its size or 0 if none was sent.
+		size_t SendProbationPacket(uint64_t now);
 
 	private:
-		void StorePacket(RTC::RtpPacket* packet);
+		void StorePacket(const RTC::RtpPacketOverlay& overlay);
 		void ClearRetransmissionBuffer();
 		void FillRetransmissionContainer(uint16_t seq, uint16_t bitmask);
 		void UpdateScore(RTC::RTCP::ReceiverReport* report);
@@ -62,6 +68,8 @@ namespace RTC
 		std::list<BufferItem> buffer;
 		float rtt{ 0 };
 		uint16_t rtxSeq{ 0 };
+		size_t probationPacketsSent{ 0 };
+		RTC::RetransmissionBudget retransmissionBudget;
 	};
 
 	inline void RtpStreamSend::SetRtx(uint8_t payloadType, uint32_t ssrc)
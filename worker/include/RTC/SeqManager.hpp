@@ -2,8 +2,8 @@
 #define RTC_SEQ_MANAGER_HPP
 
 #include "common.hpp"
+#include <bitset>
 #include <limits> // std::numeric_limits
-#include <set>
 
 namespace RTC
 {
@@ -12,6 +12,8 @@ namespace RTC
 	{
 	public:
 		static constexpr T MaxValue = std::numeric_limits<T>::max();
+		// Number of input values covered by the dropped inputs window.
+		static constexpr size_t DropWindowSize = MaxValue / 4 + 1 < 1024 ? MaxValue / 4 + 1 : 1024;
 
 	public:
 		struct SeqLowerThan
@@ -43,11 +45,18 @@ namespace RTC
 		T GetMaxInput() const;
 		T GetMaxOutput() const;
 
+	private:
+		void SlideDropWindow(T start);
+
 	private:
 		T base{ 0 };
 		T maxOutput{ 0 };
 		T maxInput{ 0 };
-		std::set<T, SeqLowerThan> dropped;
+		// Dropped inputs are tracked in a sliding bitmap in which bit N represents
+		// input dropWindowStart + N. Dropped inputs that leave the window (because
+		// a much higher input is dropped or received) are accounted in base.
+		T dropWindowStart{ 1 };
+		std::bitset<DropWindowSize> dropped;
 	};
 } // namespace RTC
 
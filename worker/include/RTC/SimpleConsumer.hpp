@@ -3,6 +3,9 @@
 
 #include "RTC/Codecs/PayloadDescriptorHandler.hpp"
 #include "RTC/Consumer.hpp"
+#include "RTC/FlexFecEncoder.hpp"
+#include "RTC/OverloadController.hpp"
+#include "RTC/RedEncoder.hpp"
 #include "RTC/RtpStreamSend.hpp"
 #include "RTC/SeqManager.hpp"
 
@@ -18,11 +21,11 @@ namespace RTC
 		void FillJson(json& jsonObject) const override;
 		void FillJsonStats(json& jsonArray) const override;
 		void FillJsonScore(json& jsonObject) const override;
+		void WriteStats(RTC::StatsWriter& writer) const override;
 		void HandleRequest(Channel::Request* request) override;
-		void TransportConnected() override;
 		void ProducerNewRtpStream(RTC::RtpStream* rtpStream, uint32_t mappedSsrc) override;
 		void ProducerRtpStreamScore(RTC::RtpStream* rtpStream, uint8_t score) override;
-		void SendRtpPacket(RTC::RtpPacket* packet) override;
+		void SendRtpPacket(const RTC::RtpPacket* packet) override;
 		void GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t now) override;
 		void NeedWorstRemoteFractionLost(uint32_t mappedSsrc, uint8_t& worstRemoteFractionLost) override;
 		void ReceiveNack(RTC::RTCP::FeedbackRtpNackPacket* nackPacket) override;
@@ -34,9 +37,12 @@ namespace RTC
 	private:
 		void Paused(bool wasProducer) override;
 		void Resumed(bool wasProducer) override;
+		void UserOnTransportConnected() override;
 		void CreateRtpStream();
 		void RequestKeyFrame();
 		void EmitScore() const;
+		void ApplyOverloadLevel();
+		bool IsSilentPacket(const RTC::RtpPacket* packet) const;
 
 		/* Pure virtual methods inherited from RtpStreamSend::Listener. */
 	public:
@@ -46,13 +52,20 @@ namespace RTC
 	private:
 		// Allocated by this.
 		RTC::RtpStreamSend* rtpStream{ nullptr };
+		RTC::FlexFecEncoder* fecEncoder{ nullptr };
+		RTC::RedEncoder* redEncoder{ nullptr };
 		// Others.
 		bool keyFrameSupported{ false };
 		bool syncRequired{ true };
 		RTC::SeqManager<uint16_t> rtpSeqManager;
 		RTC::SeqManager<uint32_t> rtpTimestampManager;
 		std::unique_ptr<RTC::Codecs::EncodingContext> encodingContext;
+		RTC::OverloadController::Level overloadLevel{ RTC::OverloadController::Level::NONE };
 		RTC::RtpStream* producerRtpStream{ nullptr };
+		// Audio packets with a lower level (and no voice flag) are not forwarded.
+		bool silenceSuppression{ false };
+		int8_t silenceThreshold{ -127 }; // dBov.
+		uint32_t silencePacketsSuppressed{ 0 };
 	};
 } // namespace RTC
 
@@ -3,8 +3,12 @@
 
 #include "RTC/Codecs/PayloadDescriptorHandler.hpp"
 #include "RTC/Consumer.hpp"
+#include "RTC/FlexFecEncoder.hpp"
+#include "RTC/OverloadController.hpp"
+#include "RTC/ProbationPacer.hpp"
 #include "RTC/RtpStreamSend.hpp"
 #include "RTC/SeqManager.hpp"
+#include <limits>
 
 namespace RTC
 {
@@ -18,11 +22,12 @@ namespace RTC
 		void FillJson(json& jsonObject) const override;
 		void FillJsonStats(json& jsonArray) const override;
 		void FillJsonScore(json& jsonObject) const override;
+		void WriteStats(RTC::StatsWriter& writer) const override;
 		void HandleRequest(Channel::Request* request) override;
-		void TransportConnected() override;
 		void ProducerNewRtpStream(RTC::RtpStream* rtpStream, uint32_t mappedSsrc) override;
 		void ProducerRtpStreamScore(RTC::RtpStream* rtpStream, uint8_t score) override;
-		void SendRtpPacket(RTC::RtpPacket* packet) override;
+		bool GetSubscribedMappedSsrcs(std::vector<uint32_t>& mappedSsrcs) const override;
+		void SendRtpPacket(const RTC::RtpPacket* packet) override;
 		void GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t now) override;
 		void NeedWorstRemoteFractionLost(uint32_t mappedSsrc, uint8_t& worstRemoteFractionLost) override;
 		void ReceiveNack(RTC::RTCP::FeedbackRtpNackPacket* nackPacket) override;
@@ -30,16 +35,21 @@ namespace RTC
 		void ReceiveRtcpReceiverReport(RTC::RTCP::ReceiverReport* report) override;
 		uint32_t GetTransmissionRate(uint64_t now) override;
 		float GetLossPercentage() const override;
+		uint32_t UseAvailableBitrate(uint32_t bitrate, bool canPause) override;
 
 	private:
 		void Paused(bool wasProducer) override;
 		void Resumed(bool wasProducer) override;
+		void UserOnTransportConnected() override;
 		void CreateRtpStream();
 		void RequestKeyFrame();
 		void RetransmitRtpPacket(RTC::RtpPacket* packet);
 		void EmitScore() const;
+		void ApplyOverloadLevel();
+		void UpdateEncodingPreferences();
 		void SetCurrentSpatialLayer(int16_t spatialLayer);
 		void RecalculateTargetSpatialLayer(bool force = false);
+		void SendProbationPackets(size_t size);
 		RTC::RtpStream* GetProducerCurrentRtpStream() const;
 		RTC::RtpStream* GetProducerTargetRtpStream() const;
 
@@ -51,6 +61,7 @@ namespace RTC
 	private:
 		// Allocated by this.
 		RTC::RtpStreamSend* rtpStream{ nullptr };
+		RTC::FlexFecEncoder* fecEncoder{ nullptr };
 		std::unordered_map<uint32_t, int16_t> mapMappedSsrcSpatialLayer;
 		std::vector<RTC::RtpStream*> producerRtpStreams; // Indexed by spatial layer.
 		// Others.
@@ -59,9 +70,20 @@ namespace RTC
 		RTC::SeqManager<uint16_t> rtpSeqManager;
 		RTC::SeqManager<uint32_t> rtpTimestampManager;
 		std::unique_ptr<RTC::Codecs::EncodingContext> encodingContext;
+		RTC::OverloadController::Level overloadLevel{ RTC::OverloadController::Level::NONE };
 		int16_t preferredSpatialLayer{ -1 };
 		int16_t targetSpatialLayer{ -1 };
 		int16_t currentSpatialLayer{ -1 };
+		// No limit until the remote tells it.
+		uint32_t availableBitrate{ std::numeric_limits<uint32_t>::max() };
+		// Whether it may stop sending if no spatial layer fits into the available
+		// bitrate (given by the Transport depending on the priority).
+		bool canPauseForBitrate{ false };
+		bool bitrateExceeded{ false };
+		// Bitrate probation for the next spatial layer above the target one when
+		// it does not fit into the available bitrate.
+		int16_t probationSpatialLayer{ -1 };
+		RTC::ProbationPacer probationPacer;
 	};
 } // namespace RTC
 
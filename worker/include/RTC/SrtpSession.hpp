@@ -2,6 +2,7 @@
 #define MS_RTC_SRTP_SESSION_HPP
 
 #include "common.hpp"
+#include "RTC/RtpPacketOverlay.hpp"
 #include <srtp.h>
 
 namespace RTC
@@ -35,11 +36,17 @@ namespace RTC
 
 	public:
 		bool EncryptRtp(const uint8_t** data, size_t* len);
+		// Writes the resulting packet of the overlay directly into the encrypt
+		// buffer so the original packet is not copied twice.
+		bool EncryptRtp(const RTC::RtpPacketOverlay& overlay, const uint8_t** data, size_t* len);
 		bool DecryptSrtp(const uint8_t* data, size_t* len);
 		bool EncryptRtcp(const uint8_t** data, size_t* len);
 		bool DecryptSrtcp(const uint8_t* data, size_t* len);
 		void RemoveStream(uint32_t ssrc);
 
+	private:
+		bool ProtectRtp(const uint8_t** data, size_t* len);
+
 	private:
 		// Allocated by this.
 		srtp_t session{ nullptr };
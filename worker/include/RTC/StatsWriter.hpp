@@ -0,0 +1,167 @@
+#ifndef MS_RTC_STATS_WRITER_HPP
+#define MS_RTC_STATS_WRITER_HPP
+
+#include "common.hpp"
+#include "json.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace RTC
+{
+	// Serializes stats of many entities into a single compact JSON string without
+	// building intermediate json trees. Each table is written in columnar form:
+	//   "transports": { "fields": [ "id", "bytesReceived", ... ], "rows": [ [ ... ] ] }
+	// Values must be added in the same order in which fields are declared.
+	//
+	// If a Snapshot is given, only values that changed since the previous write
+	// with the same Snapshot are written, and rows are written in sparse form:
+	//   [ id, column, value, column, value, ... ]
+	// where column is the index of the field in "fields". RtpStream rows always
+	// include the ssrc column. Rows without changes are omitted.
+	//
+	// If a Listener is given, the output is split into chunks of about
+	// MaxChunkSize bytes which are given to the Listener as they are completed.
+	// Each chunk is a complete JSON object with the timestamp and the tables
+	// (or parts of them) it contains, and all but the last one have
+	// "more": true.
+	class StatsWriter
+	{
+	public:
+		class Listener
+		{
+		public:
+			virtual void OnStatsWriterChunk(RTC::StatsWriter* writer, const std::string& chunk) = 0;
+		};
+
+	public:
+		static constexpr size_t MaxChunkSize{ 32768 };
+
+	public:
+		class Snapshot
+		{
+		public:
+			struct Entry
+			{
+				uint32_t generation{ 0 };
+				std::vector<uint64_t> values;
+			};
+
+		public:
+			void Clear();
+
+		public:
+			std::unordered_map<std::string, Entry> entries;
+			uint32_t generation{ 0 };
+		};
+
+	public:
+		enum class Table : uint8_t
+		{
+			TRANSPORTS = 0,
+			PRODUCERS,
+			CONSUMERS
+		};
+
+	public:
+		enum class Field : uint8_t
+		{
+			// Transport fields.
+			BYTES_RECEIVED = 0,
+			BYTES_SENT,
+			AVAILABLE_INCOMING_BITRATE,
+			AVAILABLE_OUTGOING_BITRATE,
+			// RtpStream fields.
+			SSRC,
+			PACKET_COUNT,
+			BYTE_COUNT,
+			BITRATE,
+			PACKETS_LOST,
+			FRACTION_LOST,
+			PACKETS_DISCARDED,
+			PACKETS_REPAIRED,
+			NACK_COUNT,
+			NACK_RTP_PACKET_COUNT,
+			PLI_COUNT,
+			FIR_COUNT,
+			SCORE,
+			MAX
+		};
+
+	public:
+		static uint32_t GetFieldMask(json& data);
+		static const std::string& GetFieldName(Field field);
+
+	private:
+		static std::unordered_map<std::string, Field> string2Field;
+		static std::unordered_map<uint8_t, std::string> field2String;
+
+	public:
+		StatsWriter(
+		  uint32_t fieldMask, uint64_t now, Snapshot* snapshot = nullptr, Listener* listener = nullptr);
+
+	public:
+		uint64_t GetTimestamp() const;
+		bool HasField(Field field) const;
+		void BeginTable(Table table);
+		void EndTable();
+		void BeginRow(const std::string& id);
+		void AddValue(Field field, uint64_t value);
+		void EndRow();
+		const std::string& Close();
+		size_t GetRowCount() const;
+		size_t GetSize() const;
+
+	private:
+		void WriteDeltaRow();
+		void MayFlushChunk();
+
+	private:
+		// Passed by argument.
+		uint32_t fieldMask{ 0 };
+		uint64_t now{ 0 };
+		Snapshot* snapshot{ nullptr };
+		Listener* listener{ nullptr };
+		// Others.
+		std::string buffer;
+		char table{ 0 };
+		// Written when a table starts (again in a new chunk).
+		std::string tableHeader;
+		bool firstRow{ true };
+		bool closed{ false };
+		size_t rowCount{ 0 };
+		std::string rowId;
+		std::vector<uint64_t> rowValues;
+	};
+
+	/* Inline instance methods. */
+
+	inline void StatsWriter::Snapshot::Clear()
+	{
+		this->entries.clear();
+	}
+
+	inline uint64_t StatsWriter::GetTimestamp() const
+	{
+		return this->now;
+	}
+
+	inline bool StatsWriter::HasField(Field field) const
+	{
+		return (this->fieldMask & (1u << static_cast<uint8_t>(field))) != 0u;
+	}
+
+	inline size_t StatsWriter::GetRowCount() const
+	{
+		return this->rowCount;
+	}
+
+	inline size_t StatsWriter::GetSize() const
+	{
+		return this->buffer.length();
+	}
+} // namespace RTC
+
+#endif
@@ -20,6 +20,7 @@ namespace RTC
 
 	public:
 		void Send(const uint8_t* data, size_t len);
+		void Send(const uv_buf_t* buffers, size_t count);
 		size_t GetRecvBytes() const;
 		size_t GetSentBytes() const;
 
@@ -5,15 +5,19 @@
 #include "json.hpp"
 #include "Channel/Request.hpp"
 #include "RTC/Consumer.hpp"
+#include "RTC/PacketCapture.hpp"
 #include "RTC/Producer.hpp"
 #include "RTC/RTCP/CompoundPacket.hpp"
 #include "RTC/RTCP/Packet.hpp"
 #include "RTC/RtpHeaderExtensionIds.hpp"
 #include "RTC/RtpListener.hpp"
 #include "RTC/RtpPacket.hpp"
+#include "RTC/RtpPacketOverlay.hpp"
+#include "RTC/StatsWriter.hpp"
 #include "handles/Timer.hpp"
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 using json = nlohmann::json;
 
@@ -55,8 +59,16 @@ namespace RTC
 			  RTC::Transport* transport, RTC::Consumer* consumer) = 0;
 			virtual void OnTransportConsumerKeyFrameRequested(
 			  RTC::Transport* transport, RTC::Consumer* consumer, uint32_t mappedSsrc) = 0;
+			virtual void OnTransportConsumerSubscriptionChanged(
+			  RTC::Transport* transport, RTC::Consumer* consumer) = 0;
 		};
 
+	public:
+		// Distributes the given outgoing bitrate among the given Consumers in
+		// priority order. Returns the bitrate left.
+		static uint32_t DistributeBitrate(
+		  uint32_t bitrate, const std::vector<RTC::Consumer*>& consumers);
+
 	public:
 		Transport(const std::string& id, Listener* listener);
 		virtual ~Transport();
@@ -66,25 +78,41 @@ namespace RTC
 		// Subclasses must also invoke the parent Close().
 		virtual void FillJson(json& jsonObject) const;
 		virtual void FillJsonStats(json& jsonArray) const = 0;
+		void WriteStats(RTC::StatsWriter& writer) const;
 		// Subclasses must implement this method and call the parent's one to
 		// handle common requests.
 		virtual void HandleRequest(Channel::Request* request);
 
+	protected:
+		// Reads the optional udpRecvBufferSize and udpSendBufferSize options.
+		static void ReadUdpBufferSizes(json& data, uint32_t& recvBufferSize, uint32_t& sendBufferSize);
+
 	protected:
 		// Must be called from the subclass.
 		void Connected();
 		// Must be called from the subclass.
 		void Disconnected();
 		void ReceiveRtcpPacket(RTC::RTCP::Packet* packet);
+		// To be called with clear RTP and RTCP packets received and sent.
+		void CapturePacket(RTC::PacketCapture::Direction direction, const uint8_t* data, size_t len);
+		void CapturePacket(
+		  RTC::PacketCapture::Direction direction, const RTC::RtpPacketOverlay& overlay);
 
 	private:
 		void SetNewProducerIdFromRequest(Channel::Request* request, std::string& producerId) const;
 		RTC::Producer* GetProducerFromRequest(Channel::Request* request) const;
 		void SetNewConsumerIdFromRequest(Channel::Request* request, std::string& consumerId) const;
 		RTC::Consumer* GetConsumerFromRequest(Channel::Request* request) const;
+		RTC::Consumer* CreateConsumer(const std::string& consumerId, std::string& producerId, json& data);
+		void CloseConsumer(RTC::Consumer* consumer);
+		void FillJsonConsumerStatus(RTC::Consumer* consumer, json& jsonObject) const;
 		RTC::Consumer* GetConsumerByMediaSsrc(uint32_t ssrc) const;
-		virtual bool IsConnected() const                   = 0;
-		virtual void SendRtpPacket(RTC::RtpPacket* packet) = 0;
+		void DistributeAvailableOutgoingBitrate();
+		void FillCaptureChunk(size_t offset, json& data);
+		virtual bool IsConnected() const                                 = 0;
+		virtual size_t GetRecvBytes() const                              = 0;
+		virtual size_t GetSentBytes() const                              = 0;
+		virtual void SendRtpPacket(const RTC::RtpPacketOverlay& overlay) = 0;
 		void SendRtcp(uint64_t now);
 		virtual void SendRtcpPacket(RTC::RTCP::Packet* packet)                 = 0;
 		virtual void SendRtcpCompoundPacket(RTC::RTCP::CompoundPacket* packet) = 0;
@@ -104,8 +132,10 @@ namespace RTC
 
 		/* Pure virtual methods inherited from RTC::Consumer::Listener. */
 	public:
-		void OnConsumerSendRtpPacket(RTC::Consumer* consumer, RTC::RtpPacket* packet) override;
+		void OnConsumerSendRtpPacket(
+		  RTC::Consumer* consumer, const RTC::RtpPacketOverlay& overlay) override;
 		void OnConsumerKeyFrameRequested(RTC::Consumer* consumer, uint32_t mappedSsrc) override;
+		void OnConsumerSubscriptionChanged(RTC::Consumer* consumer) override;
 		void onConsumerProducerClosed(RTC::Consumer* consumer) override;
 
 		/* Pure virtual methods inherited from Timer::Listener. */
@@ -132,7 +162,34 @@ namespace RTC
 		// Allocated by this.
 		std::unordered_map<uint32_t, RTC::Consumer*> mapSsrcConsumer;
 		Timer* rtcpTimer{ nullptr };
+		RTC::PacketCapture* packetCapture{ nullptr };
+		// Others.
+		bool connected{ false };
+		bool capturing{ false };
+		// pcapng capture being fetched.
+		std::vector<uint8_t> captureSnapshot;
 	};
+
+	/* Inline instance methods. */
+
+	inline void Transport::CapturePacket(
+	  RTC::PacketCapture::Direction direction, const uint8_t* data, size_t len)
+	{
+		if (this->capturing)
+			this->packetCapture->Add(direction, data, len);
+	}
+
+	inline void Transport::CapturePacket(
+	  RTC::PacketCapture::Direction direction, const RTC::RtpPacketOverlay& overlay)
+	{
+		if (!this->capturing)
+			return;
+
+		uv_buf_t buffers[RTC::RtpPacketOverlay::MaxBuffers];
+		size_t count = overlay.FillBuffers(buffers);
+
+		this->packetCapture->Add(direction, buffers, count);
+	}
 } // namespace RTC
 
 #endif
@@ -31,6 +31,7 @@ namespace RTC
 		bool Compare(const TransportTuple* tuple) const;
 		void SetLocalAnnouncedIp(std::string& localAnnouncedIp);
 		void Send(const uint8_t* data, size_t len);
+		void Send(const uv_buf_t* buffers, size_t count);
 		Protocol GetProtocol() const;
 		const struct sockaddr* GetLocalAddress() const;
 		const struct sockaddr* GetRemoteAddress() const;
@@ -113,6 +114,14 @@ namespace RTC
 			this->tcpConnection->Send(data, len);
 	}
 
+	inline void TransportTuple::Send(const uv_buf_t* buffers, size_t count)
+	{
+		if (this->protocol == Protocol::UDP)
+			this->udpSocket->Send(buffers, count, this->udpRemoteAddr);
+		else
+			this->tcpConnection->Send(buffers, count);
+	}
+
 	inline const struct sockaddr* TransportTuple::GetLocalAddress() const
 	{
 		if (this->protocol == Protocol::UDP)
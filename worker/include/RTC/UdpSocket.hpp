@@ -14,16 +14,23 @@ namespace RTC
 		{
 		public:
 			virtual void OnPacketRecv(
-			  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr) = 0;
+			  RTC::UdpSocket* socket,
+			  const uint8_t* data,
+			  size_t len,
+			  const struct sockaddr* remoteAddr,
+			  uint64_t arrivalTime) = 0;
 		};
 
 	public:
-		UdpSocket(Listener* listener, std::string& ip);
+		// Buffer sizes default to the Settings ones if 0.
+		UdpSocket(
+		  Listener* listener, std::string& ip, uint32_t recvBufferSize, uint32_t sendBufferSize);
 		~UdpSocket() override;
 
 		/* Pure virtual methods inherited from ::UdpSocket. */
 	public:
-		void UserOnUdpDatagramRecv(const uint8_t* data, size_t len, const struct sockaddr* addr) override;
+		void UserOnUdpDatagramRecv(
+		  const uint8_t* data, size_t len, const struct sockaddr* addr, uint64_t arrivalTime) override;
 
 	private:
 		// Passed by argument.
@@ -42,20 +42,28 @@ namespace RTC
 
 	private:
 		bool IsConnected() const override;
+		size_t GetRecvBytes() const override;
+		size_t GetSentBytes() const override;
 		void MayRunDtlsTransport();
-		void SendRtpPacket(RTC::RtpPacket* packet) override;
+		void SendRtpPacket(const RTC::RtpPacketOverlay& overlay) override;
 		void SendRtcpPacket(RTC::RTCP::Packet* packet) override;
 		void SendRtcpCompoundPacket(RTC::RTCP::CompoundPacket* packet) override;
-		void OnPacketRecv(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
+		void OnPacketRecv(
+		  RTC::TransportTuple* tuple, const uint8_t* data, size_t len, uint64_t arrivalTime);
 		void OnStunDataRecv(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 		void OnDtlsDataRecv(const RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
-		void OnRtpDataRecv(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
+		void OnRtpDataRecv(
+		  RTC::TransportTuple* tuple, const uint8_t* data, size_t len, uint64_t arrivalTime);
 		void OnRtcpDataRecv(RTC::TransportTuple* tuple, const uint8_t* data, size_t len);
 
 		/* Pure virtual methods inherited from RTC::UdpSocket::Listener. */
 	public:
 		void OnPacketRecv(
-		  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr) override;
+		  RTC::UdpSocket* socket,
+		  const uint8_t* data,
+		  size_t len,
+		  const struct sockaddr* remoteAddr,
+		  uint64_t arrivalTime) override;
 
 		/* Pure virtual methods inherited from RTC::TcpServer::Listener. */
 	public:
@@ -34,6 +34,19 @@ public:
 		uint16_t rtcMaxPort{ 59999 };
 		std::string dtlsCertificateFile;
 		std::string dtlsPrivateKeyFile;
+		// Loop lag (in ms) above which a notification is sent (0 means disabled).
+		uint32_t loopLagThreshold{ 0 };
+		// Loop lag (in ms) above which work is shed (0 means disabled).
+		uint32_t overloadLagThreshold{ 0 };
+		// Backend for UDP sockets ("libuv" or "io_uring").
+		std::string udpBackend{ "libuv" };
+		// Kernel buffer sizes (in bytes) of UDP sockets (0 means system default).
+		uint32_t udpRecvBufferSize{ 0 };
+		uint32_t udpSendBufferSize{ 0 };
+		// Whether UDP sockets using the libuv backend fetch the kernel receive
+		// timestamp of each datagram (one extra syscall per datagram). The
+		// io_uring backend always gets them along with the datagram.
+		bool udpRecvTimestamps{ false };
 	};
 
 public:
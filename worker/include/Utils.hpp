@@ -2,6 +2,7 @@
 #define MS_UTILS_HPP
 
 #include "common.hpp"
+#include <openssl/evp.h>
 #include <openssl/hmac.h>
 #include <cstring> // std::memcmp(), std::memcpy()
 #include <string>
@@ -278,6 +279,7 @@ namespace Utils
 	{
 	public:
 		static void ToLowerCase(std::string& str);
+		static std::string Base64Encode(const uint8_t* data, size_t len);
 	};
 
 	inline void String::ToLowerCase(std::string& str)
@@ -285,6 +287,25 @@ namespace Utils
 		std::transform(str.begin(), str.end(), str.begin(), ::tolower);
 	}
 
+	inline std::string String::Base64Encode(const uint8_t* data, size_t len)
+	{
+		// 4 characters per 3 bytes plus the null termination.
+		std::string encoded(((len + 2) / 3) * 4 + 1, '\0');
+
+		int size = EVP_EncodeBlock(
+		  reinterpret_cast<unsigned char*>(&encoded[0]), data, static_cast<int>(len));
+
+		encoded.resize(static_cast<size_t>(size));
+
+		return encoded;
+	}
+
+	class Json
+	{
+	public:
+		static void AppendString(std::string& buffer, const std::string& value);
+	};
+
 	class Time
 	{
 		// Seconds from Jan 1, 1900 to Jan 1, 1970.
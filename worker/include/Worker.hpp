@@ -3,16 +3,20 @@
 
 #include "common.hpp"
 #include "json.hpp"
+#include "DepLibUV.hpp"
+#include "Channel/DumpPager.hpp"
 #include "Channel/Request.hpp"
 #include "Channel/UnixStreamSocket.hpp"
 #include "RTC/Router.hpp"
 #include "handles/SignalsHandler.hpp"
 #include <string>
-#include <unordered_map>
+#include <map>
 
 using json = nlohmann::json;
 
-class Worker : public Channel::UnixStreamSocket::Listener, public SignalsHandler::Listener
+class Worker : public Channel::UnixStreamSocket::Listener,
+               public SignalsHandler::Listener,
+               public DepLibUV::LoopMonitorListener
 {
 public:
 	explicit Worker(Channel::UnixStreamSocket* channel);
@@ -20,7 +24,8 @@ public:
 
 private:
 	void Close();
-	void FillJson(json& jsonObject) const;
+	void FillJson(std::string& buffer, Channel::DumpPager& pager) const;
+	void FillJsonLoopStats(json& jsonObject) const;
 	void SetNewRouterIdFromRequest(Channel::Request* request, std::string& routerId) const;
 	RTC::Router* GetRouterFromRequest(Channel::Request* request) const;
 
@@ -33,6 +38,10 @@ public:
 public:
 	void OnSignal(SignalsHandler* signalsHandler, int signum) override;
 
+	/* Methods inherited from DepLibUV::LoopMonitorListener. */
+public:
+	void OnLoopLag(uint64_t lagUs) override;
+
 private:
 	// Passed by argument.
 	Channel::UnixStreamSocket* channel{ nullptr };
@@ -40,7 +49,9 @@ private:
 	SignalsHandler* signalsHandler{ nullptr };
 	// Others.
 	bool closed{ false };
-	std::unordered_map<std::string, RTC::Router*> mapRouters;
+	uint64_t lastLoopLagNotificationAt{ 0 };
+	// Sorted by id so paginated dumps can be resumed.
+	std::map<std::string, RTC::Router*> mapRouters;
 };
 
 #endif
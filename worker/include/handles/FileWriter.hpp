@@ -0,0 +1,102 @@
+#ifndef MS_FILE_WRITER_HPP
+#define MS_FILE_WRITER_HPP
+
+#include "common.hpp"
+#include "handles/Timer.hpp"
+#include <uv.h>
+#include <string>
+#include <vector>
+
+// Append-only file whose writes are gathered into blocks of BlockSize bytes and
+// performed in the libuv threadpool, so the event loop never blocks on disk.
+// The file is also opened and closed in the threadpool; blocks flushed before
+// it is open are queued.
+// At most maxBlocks blocks are allocated. Records that do not fit into them
+// (because the disk is slower than the input) are dropped as a whole.
+// If the file cannot be opened or a block cannot be written nothing else is
+// written, since the file would have a hole, and the listener is notified.
+class FileWriter : public Timer::Listener
+{
+public:
+	class Listener
+	{
+	public:
+		virtual ~Listener() = default;
+
+	public:
+		virtual void OnFileWriterError(FileWriter* fileWriter, const std::string& error) = 0;
+	};
+
+public:
+	static constexpr size_t BlockSize{ 65536 };
+	// Maximum time (in ms) a non full block is kept in memory.
+	static constexpr uint64_t FlushInterval{ 1000 };
+
+public:
+	struct Shared;
+
+	struct UvWriteData
+	{
+		uv_fs_t req;
+		Shared* shared;
+		uint8_t* block;
+		size_t size;
+		int64_t offset;
+	};
+
+public:
+	FileWriter(Listener* listener, const std::string& path, size_t maxBlocks);
+	FileWriter& operator=(const FileWriter&) = delete;
+	FileWriter(const FileWriter&)            = delete;
+	~FileWriter() override;
+
+public:
+	// Appends a record made of the given buffers. Returns false if it was dropped.
+	bool Write(const uv_buf_t* buffers, size_t count);
+	bool Write(const uint8_t* data, size_t len);
+	// Submits the current block (if any) to the threadpool, or queues it if the
+	// file is not open yet.
+	void Flush();
+	// Offset in the file at which the next record will be written.
+	uint64_t GetOffset() const;
+	uint64_t GetBytesWritten() const;
+	size_t GetPendingWrites() const;
+	size_t GetDroppedWrites() const;
+	size_t GetWriteErrors() const;
+	bool HasFailed() const;
+
+private:
+	bool AcquireBlock();
+	void ReleaseBlock(uint8_t* freeBlock);
+	void SetFailed(const std::string& error);
+
+	/* Callbacks fired by UV events. */
+public:
+	void OnUvOpen(ssize_t result);
+	void OnUvWrite(UvWriteData* writeData, ssize_t result);
+
+	/* Pure virtual methods inherited from Timer::Listener. */
+public:
+	void OnTimer(Timer* timer) override;
+
+private:
+	// Passed by argument.
+	Listener* listener{ nullptr };
+	std::string path;
+	size_t maxBlocks{ 0 };
+	// Allocated by this.
+	Shared* shared{ nullptr };
+	Timer* flushTimer{ nullptr };
+	std::vector<uint8_t*> freeBlocks;
+	// Others.
+	size_t allocatedBlocks{ 0 };
+	uint8_t* block{ nullptr };
+	size_t blockSize{ 0 };
+	uint64_t offset{ 0 };
+	uint64_t bytesWritten{ 0 };
+	size_t droppedWrites{ 0 };
+	size_t writeErrors{ 0 };
+	bool failed{ false };
+};
+
+#endif
@@ -28,6 +28,16 @@ public:
 	void Close();
 	virtual void Dump() const;
 	void Send(const uint8_t* data, size_t len, const struct sockaddr* addr);
+	// Sends a single datagram made of the given buffers (scatter-gather).
+	void Send(const uv_buf_t* buffers, size_t count, const struct sockaddr* addr);
+	// Sends the same datagram to each of the given addresses, with a single
+	// sendmmsg() call when available. sent[i] tells whether it was sent to addrs[i].
+	void Send(
+	  const uv_buf_t* buffers,
+	  size_t count,
+	  const struct sockaddr* const* addrs,
+	  size_t addrCount,
+	  bool* sent);
 	void Send(const std::string& data, const struct sockaddr* addr);
 	void Send(const uint8_t* data, size_t len, const std::string& ip, uint16_t port);
 	void Send(const std::string& data, const std::string& ip, uint16_t port);
@@ -37,6 +47,16 @@ public:
 	uint16_t GetLocalPort() const;
 	size_t GetRecvBytes() const;
 	size_t GetSentBytes() const;
+	// Sizes of the kernel socket buffers (Linux reports twice the requested
+	// size, the extra room is for bookkeeping).
+	void SetRecvBufferSize(uint32_t size);
+	void SetSendBufferSize(uint32_t size);
+	uint32_t GetRecvBufferSize() const;
+	uint32_t GetSendBufferSize() const;
+	// Datagrams dropped by the kernel (mostly due to a full receive buffer).
+	uint32_t GetRecvDrops() const;
+	// Datagrams that could not be sent right away (EAGAIN) and were queued.
+	size_t GetSendEagains() const;
 
 private:
 	bool SetLocalAddress();
@@ -47,9 +67,17 @@ public:
 	void OnUvRecv(ssize_t nread, const uv_buf_t* buf, const struct sockaddr* addr, unsigned int flags);
 	void OnUvSendError(int error);
 
+	/* Callbacks fired by DepIoUring. */
+public:
+	void OnIoUringRecv(
+	  const uint8_t* data, size_t len, const struct sockaddr* addr, const struct timespec* recvTime);
+
 	/* Pure virtual methods that must be implemented by the subclass. */
 protected:
-	virtual void UserOnUdpDatagramRecv(const uint8_t* data, size_t len, const struct sockaddr* addr) = 0;
+	// arrivalTime is the time (in ms, same clock as DepLibUV::GetTime()) at which
+	// the kernel received the datagram, when available.
+	virtual void UserOnUdpDatagramRecv(
+	  const uint8_t* data, size_t len, const struct sockaddr* addr, uint64_t arrivalTime) = 0;
 
 protected:
 	struct sockaddr_storage localAddr;
@@ -61,8 +89,12 @@ private:
 	uv_udp_t* uvHandle{ nullptr };
 	// Others.
 	bool closed{ false };
+	int fd{ -1 };
+	bool recvTimestamps{ false };
+	uint64_t ioUringRecvId{ 0 };
 	size_t recvBytes{ 0 };
 	size_t sentBytes{ 0 };
+	size_t sendEagains{ 0 };
 };
 
 /* Inline methods. */
@@ -107,4 +139,9 @@ inline size_t UdpSocket::GetSentBytes() const
 	return this->sentBytes;
 }
 
+inline size_t UdpSocket::GetSendEagains() const
+{
+	return this->sendEagains;
+}
+
 #endif
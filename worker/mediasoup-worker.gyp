@@ -11,6 +11,7 @@
     'sources':
     [
       # C++ source files.
+      'src/DepIoUring.cpp',
       'src/DepLibSRTP.cpp',
       'src/DepLibUV.cpp',
       'src/DepOpenSSL.cpp',
@@ -20,31 +21,45 @@
       'src/Utils/Crypto.cpp',
       'src/Utils/File.cpp',
       'src/Utils/IP.cpp',
+      'src/Utils/Json.cpp',
+      'src/handles/FileWriter.cpp',
       'src/handles/SignalsHandler.cpp',
       'src/handles/TcpConnection.cpp',
       'src/handles/TcpServer.cpp',
       'src/handles/Timer.cpp',
       'src/handles/UdpSocket.cpp',
       'src/handles/UnixStreamSocket.cpp',
+      'src/Channel/DumpPager.cpp',
       'src/Channel/Notifier.cpp',
       'src/Channel/Request.cpp',
       'src/Channel/UnixStreamSocket.cpp',
       'src/RTC/AudioLevelObserver.cpp',
+      'src/RTC/BroadcastConsumer.cpp',
+      'src/RTC/BroadcastStore.cpp',
       'src/RTC/Consumer.cpp',
       'src/RTC/DtlsTransport.cpp',
+      'src/RTC/FileTransport.cpp',
+      'src/RTC/FlexFecEncoder.cpp',
       'src/RTC/IceCandidate.cpp',
       'src/RTC/IceServer.cpp',
       'src/RTC/KeyFrameRequestManager.cpp',
       'src/RTC/NackGenerator.cpp',
+      'src/RTC/OverloadController.cpp',
+      'src/RTC/PacketCapture.cpp',
       'src/RTC/PipeConsumer.cpp',
       'src/RTC/PipeTransport.cpp',
       'src/RTC/PlainRtpTransport.cpp',
       'src/RTC/PortManager.cpp',
+      'src/RTC/ProbationPacer.cpp',
       'src/RTC/Producer.cpp',
+      'src/RTC/RedEncoder.cpp',
+      'src/RTC/RetransmissionBudget.cpp',
       'src/RTC/Router.cpp',
+      'src/RTC/RtpFanOut.cpp',
       'src/RTC/RtpListener.cpp',
       'src/RTC/RtpObserver.cpp',
       'src/RTC/RtpPacket.cpp',
+      'src/RTC/RtpPacketOverlay.cpp',
       'src/RTC/RtpStream.cpp',
       'src/RTC/RtpStreamRecv.cpp',
       'src/RTC/RtpStreamSend.cpp',
@@ -52,6 +67,7 @@
       'src/RTC/SeqManager.cpp',
       'src/RTC/SimpleConsumer.cpp',
       'src/RTC/SimulcastConsumer.cpp',
+      'src/RTC/StatsWriter.cpp',
       'src/RTC/SrtpSession.cpp',
       'src/RTC/StunMessage.cpp',
       'src/RTC/TcpConnection.cpp',
@@ -70,6 +86,7 @@
       'src/RTC/RtpDictionaries/RtpCodecMimeType.cpp',
       'src/RTC/RtpDictionaries/RtpCodecParameters.cpp',
       'src/RTC/RtpDictionaries/RtpEncodingParameters.cpp',
+      'src/RTC/RtpDictionaries/RtpFecParameters.cpp',
       'src/RTC/RtpDictionaries/RtpHeaderExtensionParameters.cpp',
       'src/RTC/RtpDictionaries/RtpHeaderExtensionUri.cpp',
       'src/RTC/RtpDictionaries/RtpParameters.cpp',
@@ -104,6 +121,7 @@
       'src/RTC/REMB/RemoteBitrateEstimatorAbsSendTime.cpp',
       'src/RTC/REMB/RemoteBitrateEstimatorSingleStream.cpp',
       # C++ include files.
+      'include/DepIoUring.hpp',
       'include/DepLibSRTP.hpp',
       'include/DepLibUV.hpp',
       'include/DepOpenSSL.hpp',
@@ -114,34 +132,47 @@
       'include/Utils.hpp',
       'include/Worker.hpp',
       'include/common.hpp',
+      'include/handles/FileWriter.hpp',
       'include/handles/SignalsHandler.hpp',
       'include/handles/TcpConnection.hpp',
       'include/handles/TcpServer.hpp',
       'include/handles/Timer.hpp',
       'include/handles/UdpSocket.hpp',
       'include/handles/UnixStreamSocket.hpp',
+      'include/Channel/DumpPager.hpp',
       'include/Channel/Notifier.hpp',
       'include/Channel/Request.hpp',
       'include/Channel/UnixStreamSocket.hpp',
       'include/RTC/AudioLevelObserver.hpp',
+      'include/RTC/BroadcastConsumer.hpp',
+      'include/RTC/BroadcastStore.hpp',
       'include/RTC/Consumer.hpp',
       'include/RTC/DtlsTransport.hpp',
+      'include/RTC/FileTransport.hpp',
+      'include/RTC/FlexFecEncoder.hpp',
       'include/RTC/IceCandidate.hpp',
       'include/RTC/IceServer.hpp',
       'include/RTC/KeyFrameRequestManager.hpp',
       'include/RTC/NackGenerator.hpp',
+      'include/RTC/OverloadController.hpp',
+      'include/RTC/PacketCapture.hpp',
       'include/RTC/Parameters.hpp',
       'include/RTC/PipeConsumer.hpp',
       'include/RTC/PipeTransport.hpp',
       'include/RTC/PlainRtpTransport.hpp',
       'include/RTC/PortManager.hpp',
+      'include/RTC/ProbationPacer.hpp',
       'include/RTC/Producer.hpp',
+      'include/RTC/RedEncoder.hpp',
+      'include/RTC/RetransmissionBudget.hpp',
       'include/RTC/Router.hpp',
       'include/RTC/RtpDictionaries.hpp',
       'include/RTC/RtpHeaderExtensionIds.hpp',
+      'include/RTC/RtpFanOut.hpp',
       'include/RTC/RtpListener.hpp',
       'include/RTC/RtpObserver.hpp',
       'include/RTC/RtpPacket.hpp',
+      'include/RTC/RtpPacketOverlay.hpp',
       'include/RTC/RtpStream.hpp',
       'include/RTC/RtpStreamRecv.hpp',
       'include/RTC/RtpStreamSend.hpp',
@@ -149,6 +180,7 @@
       'include/RTC/SeqManager.hpp',
       'include/RTC/SimpleConsumer.hpp',
       'include/RTC/SimulcastConsumer.hpp',
+      'include/RTC/StatsWriter.hpp',
       'include/RTC/SrtpSession.hpp',
       'include/RTC/StunMessage.hpp',
       'include/RTC/TcpConnection.hpp',
@@ -227,10 +259,17 @@
         'defines':
         [
           '_POSIX_C_SOURCE=200112',
-          '_GNU_SOURCE'
+          '_GNU_SOURCE',
+          'MS_SENDMMSG',
+          'MS_RECV_TIMESTAMPS',
+          'MS_RECV_DROPS'
         ]
       }],
 
+      [ 'OS == "linux" and mediasoup_io_uring == "true"', {
+        'defines': [ 'MS_IO_URING' ]
+      }],
+
       [ 'OS == "linux" and mediasoup_asan == "true"', {
         'cflags': [ '-fsanitize=address' ],
         'ldflags': [ '-fsanitize=address' ]
@@ -277,13 +316,27 @@
       [
         # C++ source files.
         'test/src/tests.cpp',
+        'test/src/Channel/TestDumpPager.cpp',
+        'test/src/handles/TestFileWriter.cpp',
+        'test/src/handles/TestUdpSocket.cpp',
+        'test/src/RTC/TestBroadcastConsumer.cpp',
+        'test/src/RTC/TestBroadcastStore.cpp',
+        'test/src/RTC/TestFlexFecEncoder.cpp',
         'test/src/RTC/TestKeyFrameRequestManager.cpp',
         'test/src/RTC/TestNackGenerator.cpp',
+        'test/src/RTC/TestOverloadController.cpp',
+        'test/src/RTC/TestPacketCapture.cpp',
+        'test/src/RTC/TestProbationPacer.cpp',
+        'test/src/RTC/TestRedEncoder.cpp',
         'test/src/RTC/TestRtpPacket.cpp',
+        'test/src/RTC/TestRtpPacketOverlay.cpp',
         'test/src/RTC/TestRtpDataCounter.cpp',
+        'test/src/RTC/TestRtpFanOut.cpp',
         'test/src/RTC/TestRtpStreamSend.cpp',
         'test/src/RTC/TestRtpStreamRecv.cpp',
         'test/src/RTC/TestSeqManager.cpp',
+        'test/src/RTC/TestStatsWriter.cpp',
+        'test/src/RTC/TestTransport.cpp',
         'test/src/RTC/Codecs/TestVP8.cpp',
         'test/src/RTC/RTCP/TestFeedbackPsAfb.cpp',
         'test/src/RTC/RTCP/TestFeedbackPsFir.cpp',
@@ -306,6 +359,7 @@
         'test/src/RTC/RTCP/TestPacket.cpp',
         'test/src/Utils/TestBits.cpp',
         'test/src/Utils/TestIP.cpp',
+        'test/src/Utils/TestJson.cpp',
         'test/src/Utils/TestString.cpp',
         # C++ include files.
         'test/include/catch.hpp',
@@ -0,0 +1,101 @@
+#define MS_CLASS "Channel::DumpPager"
+// #define MS_LOG_DEV
+
+#include "Channel/DumpPager.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Utils.hpp"
+#include <algorithm> // std::min()
+
+namespace Channel
+{
+	/* Static. */
+
+	static constexpr size_t MaxLimit{ 10000 };
+
+	/* Instance methods. */
+
+	DumpPager::DumpPager(json& data)
+	{
+		MS_TRACE();
+
+		if (!data.is_object())
+			return;
+
+		auto jsonLimitIt  = data.find("limit");
+		auto jsonCursorIt = data.find("cursor");
+
+		if (jsonLimitIt == data.end() || jsonLimitIt->is_null())
+			return;
+
+		if (!jsonLimitIt->is_number_integer() || jsonLimitIt->get<int64_t>() <= 0)
+			MS_THROW_TYPE_ERROR("wrong limit (not a positive number)");
+
+		this->limit = std::min(static_cast<size_t>(jsonLimitIt->get<int64_t>()), MaxLimit);
+
+		if (jsonCursorIt == data.end() || jsonCursorIt->is_null())
+			return;
+
+		if (!jsonCursorIt->is_string())
+			MS_THROW_TYPE_ERROR("wrong cursor (not a string)");
+
+		auto cursor = jsonCursorIt->get<std::string>();
+		auto pos    = cursor.find(':');
+
+		if (pos != 1 || cursor[0] < '0' || cursor[0] > '9')
+			MS_THROW_TYPE_ERROR("wrong cursor");
+
+		this->cursorSection = static_cast<uint8_t>(cursor[0] - '0');
+		this->cursorId      = cursor.substr(pos + 1);
+		this->hasCursor     = true;
+	}
+
+	// Must be called before writing each item, being pageSize the bytes already
+	// written (or to be written) in this page. Returns false if the item does
+	// not fit, in which case no more items can be added to this page.
+	bool DumpPager::Add(uint8_t section, const std::string& id, size_t pageSize)
+	{
+		MS_TRACE();
+
+		if (!IsPaginated())
+			return true;
+
+		if (this->hasMore)
+			return false;
+
+		// At least an item is written in each page so pagination progresses.
+		if (this->count != 0 && (this->count == this->limit || pageSize >= MaxPageSize))
+		{
+			this->hasMore = true;
+
+			return false;
+		}
+
+		++this->count;
+		this->lastSection = section;
+		this->lastId.assign(id);
+
+		return true;
+	}
+
+	void DumpPager::AppendNextCursor(std::string& buffer) const
+	{
+		MS_TRACE();
+
+		buffer.append("\"nextCursor\":");
+
+		if (!this->hasMore)
+		{
+			buffer.append("null");
+
+			return;
+		}
+
+		std::string cursor(1, static_cast<char>('0' + this->lastSection));
+
+		cursor.push_back(':');
+		cursor.append(this->lastId);
+
+		Utils::Json::AppendString(buffer, cursor);
+	}
+} // namespace Channel
@@ -47,4 +47,24 @@ namespace Channel
 
 		Notifier::channel->Send(jsonNotification);
 	}
+
+	void Notifier::Emit(const std::string& targetId, const char* event, const std::string& data)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(Notifier::channel != nullptr, "channel unset");
+
+		std::string notification;
+
+		notification.reserve(data.length() + targetId.length() + 64);
+		notification.append("{\"targetId\":");
+		notification.append(json(targetId).dump());
+		notification.append(",\"event\":");
+		notification.append(json(event).dump());
+		notification.append(",\"data\":");
+		notification.append(data);
+		notification.push_back('}');
+
+		Notifier::channel->Send(notification);
+	}
 } // namespace Channel
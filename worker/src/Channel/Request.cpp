@@ -4,6 +4,7 @@
 #include "Channel/Request.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "Channel/UnixStreamSocket.hpp"
 
 namespace Channel
 {
@@ -13,13 +14,17 @@ namespace Channel
 	std::unordered_map<std::string, Request::MethodId> Request::string2MethodId =
 	{
 		{ "worker.dump",                     Request::MethodId::WORKER_DUMP                        },
+		{ "worker.getLoopStats",             Request::MethodId::WORKER_GET_LOOP_STATS              },
 		{ "worker.updateSettings",           Request::MethodId::WORKER_UPDATE_SETTINGS             },
 		{ "worker.createRouter",             Request::MethodId::WORKER_CREATE_ROUTER               },
 		{ "router.close",                    Request::MethodId::ROUTER_CLOSE                       },
 		{ "router.dump",                     Request::MethodId::ROUTER_DUMP                        },
+		{ "router.getStats",                 Request::MethodId::ROUTER_GET_STATS                   },
+		{ "router.setStatsInterval",         Request::MethodId::ROUTER_SET_STATS_INTERVAL          },
 		{ "router.createWebRtcTransport",    Request::MethodId::ROUTER_CREATE_WEBRTC_TRANSPORT     },
 		{ "router.createPlainRtpTransport",  Request::MethodId::ROUTER_CREATE_PLAIN_RTP_TRANSPORT  },
 		{ "router.createPipeTransport",      Request::MethodId::ROUTER_CREATE_PIPE_TRANSPORT       },
+		{ "router.createFileTransport",      Request::MethodId::ROUTER_CREATE_FILE_TRANSPORT       },
 		{ "router.createAudioLevelObserver", Request::MethodId::ROUTER_CREATE_AUDIO_LEVEL_OBSERVER },
 		{ "transport.close",                 Request::MethodId::TRANSPORT_CLOSE                    },
 		{ "transport.dump",                  Request::MethodId::TRANSPORT_DUMP                     },
@@ -29,6 +34,13 @@ namespace Channel
 		{ "transport.restartIce",            Request::MethodId::TRANSPORT_RESTART_ICE              },
 		{ "transport.produce",               Request::MethodId::TRANSPORT_PRODUCE                  },
 		{ "transport.consume",               Request::MethodId::TRANSPORT_CONSUME                  },
+		{ "transport.consumeMany",           Request::MethodId::TRANSPORT_CONSUME_MANY             },
+		{ "transport.closeConsumers",        Request::MethodId::TRANSPORT_CLOSE_CONSUMERS          },
+		{ "transport.startCapture",          Request::MethodId::TRANSPORT_START_CAPTURE            },
+		{ "transport.stopCapture",           Request::MethodId::TRANSPORT_STOP_CAPTURE             },
+		{ "transport.getCapture",            Request::MethodId::TRANSPORT_GET_CAPTURE              },
+		{ "transport.addDestination",        Request::MethodId::TRANSPORT_ADD_DESTINATION          },
+		{ "transport.removeDestination",     Request::MethodId::TRANSPORT_REMOVE_DESTINATION       },
 		{ "producer.close",                  Request::MethodId::PRODUCER_CLOSE                     },
 		{ "producer.dump",                   Request::MethodId::PRODUCER_DUMP                      },
 		{ "producer.getStats",               Request::MethodId::PRODUCER_GET_STATS                 },
@@ -40,6 +52,7 @@ namespace Channel
 		{ "consumer.pause",                  Request::MethodId::CONSUMER_PAUSE                     },
 		{ "consumer.resume",                 Request::MethodId::CONSUMER_RESUME                    },
 		{ "consumer.setPreferredLayers",     Request::MethodId::CONSUMER_SET_PREFERRED_LAYERS      },
+		{ "consumer.setPriority",            Request::MethodId::CONSUMER_SET_PRIORITY              },
 		{ "consumer.requestKeyFrame",        Request::MethodId::CONSUMER_REQUEST_KEY_FRAME         },
 		{ "rtpObserver.close",               Request::MethodId::RTP_OBSERVER_CLOSE                 },
 		{ "rtpObserver.pause",               Request::MethodId::RTP_OBSERVER_PAUSE                 },
@@ -135,6 +148,34 @@ namespace Channel
 		this->channel->Send(jsonResponse);
 	}
 
+	void Request::Accept(const std::string& data)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(!this->replied, "request already replied");
+
+		std::string response;
+
+		response.reserve(data.length() + 64);
+		response.append("{\"id\":");
+		response.append(std::to_string(this->id));
+		response.append(",\"accepted\":true,\"data\":");
+		response.append(data);
+		response.push_back('}');
+
+		// Reject it rather than silently dropping it in the Channel.
+		if (response.length() > Channel::UnixStreamSocket::NsPayloadMaxLen)
+		{
+			Error("response too big");
+
+			return;
+		}
+
+		this->replied = true;
+
+		this->channel->Send(response);
+	}
+
 	void Request::Error(const char* reason)
 	{
 		MS_TRACE();
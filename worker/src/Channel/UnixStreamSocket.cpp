@@ -17,7 +17,6 @@ namespace Channel
 
 	// netstring length for a 65536 bytes payload.
 	static constexpr size_t NsMessageMaxLen{ 65543 };
-	static constexpr size_t NsPayloadMaxLen{ 65536 };
 	static uint8_t WriteBuffer[NsMessageMaxLen];
 
 	/* Instance methods. */
@@ -41,7 +40,16 @@ namespace Channel
 			return;
 
 		std::string nsPayload = jsonMessage.dump();
-		size_t nsPayloadLen   = nsPayload.length();
+
+		Send(nsPayload);
+	}
+
+	void UnixStreamSocket::Send(const std::string& nsPayload)
+	{
+		if (IsClosed())
+			return;
+
+		size_t nsPayloadLen = nsPayload.length();
 		size_t nsNumLen;
 		size_t nsLen;
 
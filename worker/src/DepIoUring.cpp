@@ -0,0 +1,757 @@
+#define MS_CLASS "DepIoUring"
+// #define MS_LOG_DEV
+
+#include "DepIoUring.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Settings.hpp"
+#include "handles/UdpSocket.hpp"
+#ifdef MS_IO_URING
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm> // std::min()
+#include <cerrno>
+#include <cstring> // std::memset(), std::memcpy(), std::strerror()
+#endif
+
+#ifdef MS_IO_URING
+
+/* Static. */
+
+static constexpr uint32_t SqEntries{ 256 };
+static constexpr uint32_t CqEntries{ 4096 };
+static constexpr uint16_t BufferGroupId{ 0 };
+static constexpr uint32_t BufferCount{ 512 }; // Must be a power of 2.
+static constexpr size_t BufferSize{ 4096 };
+static constexpr uint16_t SendSlotCount{ 512 };
+// The upper 8 bits of the user_data of each submission tell its operation.
+static constexpr uint64_t OpRecv{ 1ull << 56 };
+static constexpr uint64_t OpSend{ 2ull << 56 };
+static constexpr uint64_t OpCancel{ 3ull << 56 };
+static constexpr uint64_t OpMask{ 0xFFull << 56 };
+
+inline static int ioUringSetup(uint32_t entries, struct io_uring_params* params)
+{
+	return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+inline static int ioUringEnter(int fd, uint32_t toSubmit, uint32_t minComplete, uint32_t flags)
+{
+	return static_cast<int>(
+	  syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+inline static int ioUringRegister(int fd, uint32_t opcode, void* arg, uint32_t nrArgs)
+{
+	return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs));
+}
+
+/* Static methods for UV callbacks. */
+
+inline static void onEventFd(uv_poll_t* /*handle*/, int status, int /*events*/)
+{
+	if (status == 0)
+		DepIoUring::OnEventFd();
+}
+
+inline static void onPrepare(uv_prepare_t* /*handle*/)
+{
+	DepIoUring::Flush();
+}
+
+inline static void onCheck(uv_check_t* /*handle*/)
+{
+	DepIoUring::Flush();
+}
+
+/* Static variables. */
+
+bool DepIoUring::active{ false };
+int DepIoUring::ringFd{ -1 };
+int DepIoUring::eventFd{ -1 };
+uv_poll_t DepIoUring::eventFdHandle;
+uv_prepare_t DepIoUring::prepareHandle;
+uv_check_t DepIoUring::checkHandle;
+void* DepIoUring::rings{ nullptr };
+size_t DepIoUring::ringsSize{ 0 };
+struct io_uring_sqe* DepIoUring::sqes{ nullptr };
+size_t DepIoUring::sqesSize{ 0 };
+uint32_t* DepIoUring::sqHead{ nullptr };
+uint32_t* DepIoUring::sqTail{ nullptr };
+uint32_t* DepIoUring::sqFlags{ nullptr };
+uint32_t DepIoUring::sqMask{ 0 };
+uint32_t DepIoUring::sqEntries{ 0 };
+uint32_t DepIoUring::sqLocalTail{ 0 };
+uint32_t* DepIoUring::cqHead{ nullptr };
+uint32_t* DepIoUring::cqTail{ nullptr };
+uint32_t DepIoUring::cqMask{ 0 };
+struct io_uring_cqe* DepIoUring::cqes{ nullptr };
+struct io_uring_buf_ring* DepIoUring::bufRing{ nullptr };
+size_t DepIoUring::bufRingSize{ 0 };
+uint8_t* DepIoUring::buffers{ nullptr };
+uint16_t DepIoUring::bufRingTail{ 0 };
+std::unordered_map<uint64_t, DepIoUring::RecvEntry> DepIoUring::mapRecvEntries;
+uint64_t DepIoUring::nextRecvId{ 1 };
+DepIoUring::SendSlot* DepIoUring::sendSlots{ nullptr };
+std::vector<uint16_t> DepIoUring::freeSendSlots;
+
+#endif
+
+DepIoUring::Stats DepIoUring::stats;
+
+/* Static methods. */
+
+void DepIoUring::ClassInit()
+{
+	MS_TRACE();
+
+	if (Settings::configuration.udpBackend != "io_uring")
+		return;
+
+#ifdef MS_IO_URING
+	if (!DepIoUring::Setup())
+	{
+		DepIoUring::Teardown();
+
+		MS_WARN_TAG(info, "io_uring not available, using libuv for UDP sockets");
+
+		return;
+	}
+
+	DepIoUring::active = true;
+
+	MS_DEBUG_TAG(info, "using io_uring for UDP sockets");
+#else
+	MS_WARN_TAG(info, "io_uring support not built, using libuv for UDP sockets");
+#endif
+}
+
+void DepIoUring::ClassDestroy()
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING
+	if (!DepIoUring::active)
+		return;
+
+	DepIoUring::Flush();
+
+	DepIoUring::active = false;
+
+	uv_close(reinterpret_cast<uv_handle_t*>(&DepIoUring::eventFdHandle), nullptr);
+	uv_close(reinterpret_cast<uv_handle_t*>(&DepIoUring::prepareHandle), nullptr);
+	uv_close(reinterpret_cast<uv_handle_t*>(&DepIoUring::checkHandle), nullptr);
+
+	DepIoUring::Teardown();
+#endif
+}
+
+uint64_t DepIoUring::StartRecv(UdpSocket* socket, int fd)
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING
+	if (!DepIoUring::active)
+		return 0u;
+
+	// Sockets receiving via io_uring are not active libuv handles, so the eventfd
+	// poll keeps the loop alive while there are receivers.
+	if (DepIoUring::mapRecvEntries.empty())
+		uv_ref(reinterpret_cast<uv_handle_t*>(&DepIoUring::eventFdHandle));
+
+	uint64_t recvId = DepIoUring::nextRecvId++;
+	auto& entry     = DepIoUring::mapRecvEntries[recvId];
+
+	entry.socket = socket;
+	entry.fd     = fd;
+	std::memset(&entry.msg, 0, sizeof(entry.msg));
+	// Room for the source address and the receive timestamp of each datagram in
+	// the provided buffer.
+	entry.msg.msg_namelen    = sizeof(struct sockaddr_in6);
+	entry.msg.msg_controllen = CMSG_SPACE(sizeof(struct timespec));
+
+	DepIoUring::ArmRecv(recvId, entry);
+	DepIoUring::Flush();
+
+	return recvId;
+#else
+	return 0u;
+#endif
+}
+
+void DepIoUring::StopRecv(uint64_t recvId)
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING
+	if (!DepIoUring::active)
+		return;
+
+	auto it = DepIoUring::mapRecvEntries.find(recvId);
+
+	if (it == DepIoUring::mapRecvEntries.end())
+		return;
+
+	// The entry is removed once the final completion of its recvmsg arrives
+	// since the kernel may still use it.
+	it->second.socket = nullptr;
+
+	auto* sqe = DepIoUring::GetSqe();
+
+	if (sqe)
+	{
+		sqe->opcode    = IORING_OP_ASYNC_CANCEL;
+		sqe->fd        = -1;
+		sqe->addr      = OpRecv | recvId;
+		sqe->user_data = OpCancel;
+	}
+
+	DepIoUring::Flush();
+#endif
+}
+
+bool DepIoUring::Send(int fd, const uint8_t* data, size_t len, const struct sockaddr* addr)
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING
+	if (!DepIoUring::active)
+		return false;
+
+	// Let the caller send it directly, but keep the order of queued datagrams.
+	if (len > sizeof(SendSlot::data) || DepIoUring::freeSendSlots.empty())
+	{
+		DepIoUring::Flush();
+
+		++DepIoUring::stats.sendFallbacks;
+
+		return false;
+	}
+
+	auto* sqe = DepIoUring::GetSqe();
+
+	if (!sqe)
+	{
+		++DepIoUring::stats.sendFallbacks;
+
+		return false;
+	}
+
+	uint16_t slotIdx = DepIoUring::freeSendSlots.back();
+	auto& slot       = DepIoUring::sendSlots[slotIdx];
+	socklen_t addrLen =
+	  addr->sa_family == AF_INET6 ? sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in);
+
+	DepIoUring::freeSendSlots.pop_back();
+
+	std::memcpy(slot.data, data, len);
+	std::memcpy(&slot.addr, addr, addrLen);
+	std::memset(&slot.msg, 0, sizeof(slot.msg));
+
+	slot.iov.iov_base     = slot.data;
+	slot.iov.iov_len      = len;
+	slot.msg.msg_name     = &slot.addr;
+	slot.msg.msg_namelen  = addrLen;
+	slot.msg.msg_iov      = &slot.iov;
+	slot.msg.msg_iovlen   = 1;
+	sqe->opcode           = IORING_OP_SENDMSG;
+	sqe->fd               = fd;
+	sqe->addr             = reinterpret_cast<uintptr_t>(&slot.msg);
+	sqe->len              = 1;
+	sqe->user_data        = OpSend | slotIdx;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+void DepIoUring::Flush()
+{
+	MS_TRACE();
+
+#ifdef MS_IO_URING
+	if (!DepIoUring::active)
+		return;
+
+	uint32_t pending = DepIoUring::sqLocalTail - __atomic_load_n(DepIoUring::sqHead, __ATOMIC_ACQUIRE);
+
+	if (pending == 0u)
+		return;
+
+	__atomic_store_n(DepIoUring::sqTail, DepIoUring::sqLocalTail, __ATOMIC_RELEASE);
+
+	int ret;
+
+	do
+	{
+		ret = ioUringEnter(DepIoUring::ringFd, pending, 0, 0);
+	} while (ret < 0 && errno == EINTR);
+
+	// Unsubmitted entries are retried in the next flush.
+	if (ret < 0)
+		MS_ERROR("io_uring_enter() failed: %s", std::strerror(errno));
+	else
+		++DepIoUring::stats.submits;
+#endif
+}
+
+inline void DepIoUring::OnEventFd()
+{
+#ifdef MS_IO_URING
+	uint64_t count;
+
+	// Just drain the eventfd, completions are read from the ring.
+	while (read(DepIoUring::eventFd, &count, sizeof(count)) == sizeof(count))
+	{
+	}
+
+	DepIoUring::ProcessCompletions();
+	DepIoUring::Flush();
+#endif
+}
+
+#ifdef MS_IO_URING
+
+bool DepIoUring::Setup()
+{
+	MS_TRACE();
+
+	struct io_uring_params params;
+
+	std::memset(&params, 0, sizeof(params));
+
+	// IORING_SETUP_SINGLE_ISSUER requires Linux 6.0, same as multishot recvmsg.
+	params.flags      = IORING_SETUP_CQSIZE | IORING_SETUP_SINGLE_ISSUER;
+	params.cq_entries = CqEntries;
+
+	DepIoUring::ringFd = ioUringSetup(SqEntries, &params);
+
+	if (DepIoUring::ringFd < 0)
+	{
+		MS_WARN_TAG(info, "io_uring_setup() failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	if (
+	  (params.features & IORING_FEAT_SINGLE_MMAP) == 0u || (params.features & IORING_FEAT_NODROP) == 0u)
+	{
+		MS_WARN_TAG(info, "io_uring features not supported");
+
+		return false;
+	}
+
+	size_t sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	size_t cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+
+	DepIoUring::ringsSize = sqRingSize > cqRingSize ? sqRingSize : cqRingSize;
+	DepIoUring::rings     = mmap(
+    nullptr,
+    DepIoUring::ringsSize,
+    PROT_READ | PROT_WRITE,
+    MAP_SHARED | MAP_POPULATE,
+    DepIoUring::ringFd,
+    IORING_OFF_SQ_RING);
+
+	if (DepIoUring::rings == MAP_FAILED)
+	{
+		DepIoUring::rings = nullptr;
+
+		MS_WARN_TAG(info, "mmap() of io_uring rings failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	DepIoUring::sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+	void* sqesMem = mmap(
+	  nullptr,
+	  DepIoUring::sqesSize,
+	  PROT_READ | PROT_WRITE,
+	  MAP_SHARED | MAP_POPULATE,
+	  DepIoUring::ringFd,
+	  IORING_OFF_SQES);
+
+	if (sqesMem == MAP_FAILED)
+	{
+		MS_WARN_TAG(info, "mmap() of io_uring SQEs failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	DepIoUring::sqes = static_cast<struct io_uring_sqe*>(sqesMem);
+
+	auto* ringsPtr = static_cast<uint8_t*>(DepIoUring::rings);
+
+	DepIoUring::sqHead    = reinterpret_cast<uint32_t*>(ringsPtr + params.sq_off.head);
+	DepIoUring::sqTail    = reinterpret_cast<uint32_t*>(ringsPtr + params.sq_off.tail);
+	DepIoUring::sqFlags   = reinterpret_cast<uint32_t*>(ringsPtr + params.sq_off.flags);
+	DepIoUring::sqMask    = *reinterpret_cast<uint32_t*>(ringsPtr + params.sq_off.ring_mask);
+	DepIoUring::sqEntries = params.sq_entries;
+	DepIoUring::cqHead    = reinterpret_cast<uint32_t*>(ringsPtr + params.cq_off.head);
+	DepIoUring::cqTail    = reinterpret_cast<uint32_t*>(ringsPtr + params.cq_off.tail);
+	DepIoUring::cqMask    = *reinterpret_cast<uint32_t*>(ringsPtr + params.cq_off.ring_mask);
+	DepIoUring::cqes      = reinterpret_cast<struct io_uring_cqe*>(ringsPtr + params.cq_off.cqes);
+
+	// SQ slots map 1:1 to SQEs.
+	auto* sqArray = reinterpret_cast<uint32_t*>(ringsPtr + params.sq_off.array);
+
+	for (uint32_t idx{ 0 }; idx < params.sq_entries; ++idx)
+	{
+		sqArray[idx] = idx;
+	}
+
+	DepIoUring::sqLocalTail = *DepIoUring::sqTail;
+
+	// Register the ring of provided buffers for received datagrams.
+	DepIoUring::bufRingSize = BufferCount * sizeof(struct io_uring_buf);
+
+	void* bufRingMem = mmap(
+	  nullptr,
+	  DepIoUring::bufRingSize,
+	  PROT_READ | PROT_WRITE,
+	  MAP_PRIVATE | MAP_ANONYMOUS,
+	  -1,
+	  0);
+
+	if (bufRingMem == MAP_FAILED)
+	{
+		MS_WARN_TAG(info, "mmap() of io_uring buffer ring failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	DepIoUring::bufRing = static_cast<struct io_uring_buf_ring*>(bufRingMem);
+	DepIoUring::buffers = new uint8_t[BufferCount * BufferSize];
+
+	struct io_uring_buf_reg reg;
+
+	std::memset(&reg, 0, sizeof(reg));
+
+	reg.ring_addr    = reinterpret_cast<uintptr_t>(DepIoUring::bufRing);
+	reg.ring_entries = BufferCount;
+	reg.bgid         = BufferGroupId;
+
+	if (ioUringRegister(DepIoUring::ringFd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+	{
+		MS_WARN_TAG(info, "io_uring buffer ring registration failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	DepIoUring::bufRingTail = 0;
+
+	for (uint32_t idx{ 0 }; idx < BufferCount; ++idx)
+	{
+		DepIoUring::RecycleBuffer(static_cast<uint16_t>(idx));
+	}
+
+	// Send slots.
+	DepIoUring::sendSlots = new SendSlot[SendSlotCount];
+	DepIoUring::freeSendSlots.reserve(SendSlotCount);
+
+	for (uint16_t idx{ 0 }; idx < SendSlotCount; ++idx)
+	{
+		DepIoUring::freeSendSlots.push_back(idx);
+	}
+
+	// Signal completions to the libuv loop.
+	DepIoUring::eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	if (DepIoUring::eventFd < 0)
+	{
+		MS_WARN_TAG(info, "eventfd() failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	if (ioUringRegister(DepIoUring::ringFd, IORING_REGISTER_EVENTFD, &DepIoUring::eventFd, 1) < 0)
+	{
+		MS_WARN_TAG(info, "io_uring eventfd registration failed: %s", std::strerror(errno));
+
+		return false;
+	}
+
+	int err = uv_poll_init(DepLibUV::GetLoop(), &DepIoUring::eventFdHandle, DepIoUring::eventFd);
+
+	if (err != 0)
+	{
+		MS_WARN_TAG(info, "uv_poll_init() failed: %s", uv_strerror(err));
+
+		return false;
+	}
+
+	uv_poll_start(&DepIoUring::eventFdHandle, UV_READABLE, static_cast<uv_poll_cb>(onEventFd));
+
+	// Queued sends are submitted once per loop iteration.
+	uv_prepare_init(DepLibUV::GetLoop(), &DepIoUring::prepareHandle);
+	uv_check_init(DepLibUV::GetLoop(), &DepIoUring::checkHandle);
+	uv_prepare_start(&DepIoUring::prepareHandle, static_cast<uv_prepare_cb>(onPrepare));
+	uv_check_start(&DepIoUring::checkHandle, static_cast<uv_check_cb>(onCheck));
+
+	// The eventfd poll is referenced only while there are receivers.
+	uv_unref(reinterpret_cast<uv_handle_t*>(&DepIoUring::eventFdHandle));
+	uv_unref(reinterpret_cast<uv_handle_t*>(&DepIoUring::prepareHandle));
+	uv_unref(reinterpret_cast<uv_handle_t*>(&DepIoUring::checkHandle));
+
+	return true;
+}
+
+void DepIoUring::Teardown()
+{
+	MS_TRACE();
+
+	if (DepIoUring::ringFd >= 0)
+		close(DepIoUring::ringFd);
+
+	if (DepIoUring::eventFd >= 0)
+		close(DepIoUring::eventFd);
+
+	if (DepIoUring::rings)
+		munmap(DepIoUring::rings, DepIoUring::ringsSize);
+
+	if (DepIoUring::sqes)
+		munmap(DepIoUring::sqes, DepIoUring::sqesSize);
+
+	if (DepIoUring::bufRing)
+		munmap(DepIoUring::bufRing, DepIoUring::bufRingSize);
+
+	delete[] DepIoUring::buffers;
+	delete[] DepIoUring::sendSlots;
+
+	DepIoUring::ringFd    = -1;
+	DepIoUring::eventFd   = -1;
+	DepIoUring::rings     = nullptr;
+	DepIoUring::sqes      = nullptr;
+	DepIoUring::bufRing   = nullptr;
+	DepIoUring::buffers   = nullptr;
+	DepIoUring::sendSlots = nullptr;
+	DepIoUring::mapRecvEntries.clear();
+	DepIoUring::freeSendSlots.clear();
+}
+
+struct io_uring_sqe* DepIoUring::GetSqe()
+{
+	MS_TRACE();
+
+	uint32_t head = __atomic_load_n(DepIoUring::sqHead, __ATOMIC_ACQUIRE);
+
+	// The submission ring is full, submit it first.
+	if (DepIoUring::sqLocalTail - head >= DepIoUring::sqEntries)
+	{
+		DepIoUring::Flush();
+
+		head = __atomic_load_n(DepIoUring::sqHead, __ATOMIC_ACQUIRE);
+
+		if (DepIoUring::sqLocalTail - head >= DepIoUring::sqEntries)
+		{
+			MS_WARN_DEV("io_uring submission ring full");
+
+			return nullptr;
+		}
+	}
+
+	auto* sqe = &DepIoUring::sqes[DepIoUring::sqLocalTail & DepIoUring::sqMask];
+
+	++DepIoUring::sqLocalTail;
+
+	std::memset(sqe, 0, sizeof(*sqe));
+
+	return sqe;
+}
+
+void DepIoUring::ArmRecv(uint64_t recvId, RecvEntry& entry)
+{
+	MS_TRACE();
+
+	auto* sqe = DepIoUring::GetSqe();
+
+	if (!sqe)
+	{
+		MS_ERROR("cannot arm recvmsg, io_uring submission ring full");
+
+		return;
+	}
+
+	sqe->opcode    = IORING_OP_RECVMSG;
+	sqe->fd        = entry.fd;
+	sqe->addr      = reinterpret_cast<uintptr_t>(&entry.msg);
+	sqe->len       = 1;
+	sqe->ioprio    = IORING_RECV_MULTISHOT;
+	sqe->flags     = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = BufferGroupId;
+	sqe->user_data = OpRecv | recvId;
+}
+
+void DepIoUring::ProcessCompletions()
+{
+	MS_TRACE();
+
+	while (true)
+	{
+		uint32_t head = *DepIoUring::cqHead;
+		uint32_t tail = __atomic_load_n(DepIoUring::cqTail, __ATOMIC_ACQUIRE);
+
+		if (head == tail)
+		{
+			// Completions that did not fit in the ring are flushed on demand.
+			if ((__atomic_load_n(DepIoUring::sqFlags, __ATOMIC_ACQUIRE) & IORING_SQ_CQ_OVERFLOW) == 0u)
+				break;
+
+			ioUringEnter(DepIoUring::ringFd, 0, 0, IORING_ENTER_GETEVENTS);
+
+			if (__atomic_load_n(DepIoUring::cqTail, __ATOMIC_ACQUIRE) == head)
+				break;
+
+			continue;
+		}
+
+		for (; head != tail; ++head)
+		{
+			auto& cqe         = DepIoUring::cqes[head & DepIoUring::cqMask];
+			uint64_t userData = cqe.user_data;
+			int32_t res       = cqe.res;
+			uint32_t flags    = cqe.flags;
+
+			switch (userData & OpMask)
+			{
+				case OpRecv:
+				{
+					DepIoUring::ProcessRecvCompletion(userData & ~OpMask, res, flags);
+
+					break;
+				}
+
+				case OpSend:
+				{
+					++DepIoUring::stats.sendCompletions;
+
+					DepIoUring::freeSendSlots.push_back(static_cast<uint16_t>(userData & ~OpMask));
+
+					if (res < 0)
+						MS_DEBUG_DEV("sendmsg failed: %s", std::strerror(-res));
+
+					break;
+				}
+
+				default:;
+			}
+		}
+
+		__atomic_store_n(DepIoUring::cqHead, head, __ATOMIC_RELEASE);
+	}
+}
+
+void DepIoUring::ProcessRecvCompletion(uint64_t recvId, int32_t res, uint32_t flags)
+{
+	MS_TRACE();
+
+	auto it = DepIoUring::mapRecvEntries.find(recvId);
+
+	if ((flags & IORING_CQE_F_BUFFER) != 0u)
+	{
+		auto bufferId = static_cast<uint16_t>(flags >> IORING_CQE_BUFFER_SHIFT);
+
+		if (res >= 0 && it != DepIoUring::mapRecvEntries.end() && it->second.socket)
+		{
+			auto& entry = it->second;
+			auto* out =
+			  reinterpret_cast<struct io_uring_recvmsg_out*>(DepIoUring::buffers + bufferId * BufferSize);
+
+			if ((out->flags & MSG_TRUNC) != 0)
+			{
+				MS_ERROR("received datagram was truncated due to insufficient buffer, ignoring it");
+			}
+			else
+			{
+				auto* name    = reinterpret_cast<uint8_t*>(out + 1);
+				auto* control = name + entry.msg.msg_namelen;
+				auto* payload = control + entry.msg.msg_controllen;
+				const struct timespec* recvTime{ nullptr };
+				struct timespec timestamp; // NOLINT(cppcoreguidelines-pro-type-member-init)
+				struct msghdr msg;         // NOLINT(cppcoreguidelines-pro-type-member-init)
+				alignas(struct cmsghdr) uint8_t controlBuffer[CMSG_SPACE(sizeof(struct timespec))];
+
+				// The control data follows the source address so it is not aligned.
+				std::memcpy(
+				  controlBuffer, control, std::min<size_t>(out->controllen, sizeof(controlBuffer)));
+
+				// Look for the SO_TIMESTAMPNS control message.
+				msg.msg_control    = controlBuffer;
+				msg.msg_controllen = std::min<size_t>(out->controllen, sizeof(controlBuffer));
+
+				for (auto* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+				{
+					if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+					{
+						std::memcpy(&timestamp, CMSG_DATA(cmsg), sizeof(timestamp));
+
+						recvTime = &timestamp;
+
+						break;
+					}
+				}
+
+				++DepIoUring::stats.recvCompletions;
+
+				DepLibUV::CountCallback();
+
+				entry.socket->OnIoUringRecv(
+				  payload, out->payloadlen, reinterpret_cast<const struct sockaddr*>(name), recvTime);
+			}
+		}
+
+		DepIoUring::RecycleBuffer(bufferId);
+	}
+
+	// The multishot recvmsg is still armed.
+	if ((flags & IORING_CQE_F_MORE) != 0u)
+		return;
+
+	// The socket may have been closed while delivering the datagram.
+	it = DepIoUring::mapRecvEntries.find(recvId);
+
+	if (it == DepIoUring::mapRecvEntries.end())
+		return;
+
+	if (!it->second.socket)
+	{
+		DepIoUring::mapRecvEntries.erase(it);
+
+		if (DepIoUring::mapRecvEntries.empty())
+			uv_unref(reinterpret_cast<uv_handle_t*>(&DepIoUring::eventFdHandle));
+	}
+	// Out of provided buffers (or just ended), arm it again.
+	else if (res >= 0 || res == -ENOBUFS)
+	{
+		++DepIoUring::stats.recvRearms;
+
+		DepIoUring::ArmRecv(recvId, it->second);
+	}
+	else
+	{
+		MS_ERROR("recvmsg failed: %s", std::strerror(-res));
+	}
+}
+
+inline void DepIoUring::RecycleBuffer(uint16_t bufferId)
+{
+	// Don't use io_uring_buf_ring::bufs, the flexible array in the kernel header
+	// is laid out with an extra offset when compiled as C++.
+	auto* buf = reinterpret_cast<struct io_uring_buf*>(DepIoUring::bufRing) +
+	            (DepIoUring::bufRingTail & (BufferCount - 1));
+
+	buf->addr = reinterpret_cast<uintptr_t>(DepIoUring::buffers + bufferId * BufferSize);
+	buf->len  = BufferSize;
+	buf->bid  = bufferId;
+
+	++DepIoUring::bufRingTail;
+
+	__atomic_store_n(&DepIoUring::bufRing->tail, DepIoUring::bufRingTail, __ATOMIC_RELEASE);
+}
+
+#endif
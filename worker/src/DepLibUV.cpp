@@ -3,11 +3,56 @@
 
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
-#include <cstdlib> // std::abort()
+#include <algorithm> // std::nth_element(), std::max_element()
+#include <cstdlib>   // std::abort()
+
+/* Static. */
+
+// Interval of the loop lag probe timer (in ms).
+static constexpr uint64_t LagProbeInterval{ 50 };
+// Number of lag samples used to compute percentiles (10 seconds).
+static constexpr size_t LagSamples{ 200 };
+// Number of receive delay samples used to compute percentiles.
+static constexpr size_t RecvDelaySamples{ 1000 };
+
+/* Static methods for UV callbacks. */
+
+inline static void onPrepare(uv_prepare_t* /*handle*/)
+{
+	DepLibUV::OnLoopPrepare();
+}
+
+inline static void onCheck(uv_check_t* /*handle*/)
+{
+	DepLibUV::OnLoopCheck();
+}
+
+inline static void onLagProbe(uv_timer_t* /*handle*/)
+{
+	DepLibUV::OnLagProbe();
+}
+
+inline static void onClose(uv_handle_t* handle)
+{
+	delete handle;
+}
 
 /* Static variables. */
 
 uv_loop_t* DepLibUV::loop{ nullptr };
+uv_prepare_t* DepLibUV::prepareHandle{ nullptr };
+uv_check_t* DepLibUV::checkHandle{ nullptr };
+uv_timer_t* DepLibUV::lagProbeHandle{ nullptr };
+DepLibUV::LoopMonitorListener* DepLibUV::loopMonitorListener{ nullptr };
+DepLibUV::LoopStats DepLibUV::loopStats;
+uint64_t DepLibUV::lastPrepareAt{ 0 };
+uint64_t DepLibUV::lastCheckAt{ 0 };
+uint64_t DepLibUV::lastLagProbeAt{ 0 };
+uint64_t DepLibUV::iterationCallbacks{ 0 };
+std::vector<uint64_t> DepLibUV::lagSamples;
+size_t DepLibUV::lagSamplesIdx{ 0 };
+std::vector<uint64_t> DepLibUV::recvDelaySamples;
+size_t DepLibUV::recvDelaySamplesIdx{ 0 };
 
 /* Static methods. */
 
@@ -51,3 +96,172 @@ void DepLibUV::RunLoop()
 
 	uv_run(DepLibUV::loop, UV_RUN_DEFAULT);
 }
+
+void DepLibUV::StartLoopMonitor(LoopMonitorListener* listener)
+{
+	MS_TRACE();
+
+	MS_ASSERT(DepLibUV::prepareHandle == nullptr, "loop monitor already started");
+
+	DepLibUV::loopMonitorListener = listener;
+	DepLibUV::loopStats           = LoopStats();
+	DepLibUV::lastPrepareAt       = 0;
+	DepLibUV::lastCheckAt         = 0;
+	DepLibUV::lastLagProbeAt      = uv_hrtime() / 1000;
+	DepLibUV::lagSamples.clear();
+	DepLibUV::lagSamples.reserve(LagSamples);
+	DepLibUV::lagSamplesIdx = 0;
+	DepLibUV::recvDelaySamples.clear();
+	DepLibUV::recvDelaySamples.reserve(RecvDelaySamples);
+	DepLibUV::recvDelaySamplesIdx = 0;
+
+	DepLibUV::prepareHandle  = new uv_prepare_t;
+	DepLibUV::checkHandle    = new uv_check_t;
+	DepLibUV::lagProbeHandle = new uv_timer_t;
+
+	uv_prepare_init(DepLibUV::loop, DepLibUV::prepareHandle);
+	uv_check_init(DepLibUV::loop, DepLibUV::checkHandle);
+	uv_timer_init(DepLibUV::loop, DepLibUV::lagProbeHandle);
+
+	uv_prepare_start(DepLibUV::prepareHandle, static_cast<uv_prepare_cb>(onPrepare));
+	uv_check_start(DepLibUV::checkHandle, static_cast<uv_check_cb>(onCheck));
+	uv_timer_start(
+	  DepLibUV::lagProbeHandle,
+	  static_cast<uv_timer_cb>(onLagProbe),
+	  LagProbeInterval,
+	  LagProbeInterval);
+
+	// The monitor must not keep the loop alive.
+	uv_unref(reinterpret_cast<uv_handle_t*>(DepLibUV::prepareHandle));
+	uv_unref(reinterpret_cast<uv_handle_t*>(DepLibUV::checkHandle));
+	uv_unref(reinterpret_cast<uv_handle_t*>(DepLibUV::lagProbeHandle));
+}
+
+void DepLibUV::StopLoopMonitor()
+{
+	MS_TRACE();
+
+	if (DepLibUV::prepareHandle == nullptr)
+		return;
+
+	uv_close(reinterpret_cast<uv_handle_t*>(DepLibUV::prepareHandle), static_cast<uv_close_cb>(onClose));
+	uv_close(reinterpret_cast<uv_handle_t*>(DepLibUV::checkHandle), static_cast<uv_close_cb>(onClose));
+	uv_close(reinterpret_cast<uv_handle_t*>(DepLibUV::lagProbeHandle), static_cast<uv_close_cb>(onClose));
+
+	DepLibUV::prepareHandle       = nullptr;
+	DepLibUV::checkHandle         = nullptr;
+	DepLibUV::lagProbeHandle      = nullptr;
+	DepLibUV::loopMonitorListener = nullptr;
+}
+
+void DepLibUV::GetLoopStats(LoopStats& stats)
+{
+	MS_TRACE();
+
+	stats = DepLibUV::loopStats;
+
+	// Include the current iteration.
+	auto callbacks = DepLibUV::loopStats.callbacks - DepLibUV::iterationCallbacks;
+
+	if (callbacks > stats.maxCallbacksPerIteration)
+		stats.maxCallbacksPerIteration = callbacks;
+
+	// The max number of callbacks per iteration is reset on each read.
+	DepLibUV::loopStats.maxCallbacksPerIteration = 0;
+
+	std::vector<uint64_t> samples;
+	auto getPercentile = [&samples](size_t percentile) {
+		auto it = samples.begin() + (samples.size() - 1) * percentile / 100;
+
+		std::nth_element(samples.begin(), it, samples.end());
+
+		return *it;
+	};
+
+	if (!DepLibUV::lagSamples.empty())
+	{
+		samples = DepLibUV::lagSamples;
+
+		stats.lagP50 = getPercentile(50);
+		stats.lagP90 = getPercentile(90);
+		stats.lagP99 = getPercentile(99);
+		stats.lagMax = *std::max_element(samples.begin(), samples.end());
+	}
+
+	if (!DepLibUV::recvDelaySamples.empty())
+	{
+		samples = DepLibUV::recvDelaySamples;
+
+		stats.recvDelayP50 = getPercentile(50);
+		stats.recvDelayP99 = getPercentile(99);
+		stats.recvDelayMax = *std::max_element(samples.begin(), samples.end());
+	}
+}
+
+void DepLibUV::AddRecvDelay(uint64_t delayUs)
+{
+	// Just measured while the loop monitor runs.
+	if (DepLibUV::prepareHandle == nullptr)
+		return;
+
+	if (DepLibUV::recvDelaySamples.size() < RecvDelaySamples)
+	{
+		DepLibUV::recvDelaySamples.push_back(delayUs);
+	}
+	else
+	{
+		DepLibUV::recvDelaySamples[DepLibUV::recvDelaySamplesIdx] = delayUs;
+		DepLibUV::recvDelaySamplesIdx = (DepLibUV::recvDelaySamplesIdx + 1) % RecvDelaySamples;
+	}
+}
+
+inline void DepLibUV::OnLoopPrepare()
+{
+	uint64_t now = uv_hrtime() / 1000;
+
+	// Time since the previous I/O poll phase ended.
+	if (DepLibUV::lastCheckAt != 0)
+		DepLibUV::loopStats.busyTime += now - DepLibUV::lastCheckAt;
+
+	auto callbacks = DepLibUV::loopStats.callbacks - DepLibUV::iterationCallbacks;
+
+	if (callbacks > DepLibUV::loopStats.maxCallbacksPerIteration)
+		DepLibUV::loopStats.maxCallbacksPerIteration = callbacks;
+
+	DepLibUV::iterationCallbacks = DepLibUV::loopStats.callbacks;
+	DepLibUV::lastPrepareAt      = now;
+
+	++DepLibUV::loopStats.iterations;
+}
+
+inline void DepLibUV::OnLoopCheck()
+{
+	uint64_t now = uv_hrtime() / 1000;
+
+	if (DepLibUV::lastPrepareAt != 0)
+		DepLibUV::loopStats.pollTime += now - DepLibUV::lastPrepareAt;
+
+	DepLibUV::lastCheckAt = now;
+}
+
+inline void DepLibUV::OnLagProbe()
+{
+	uint64_t now     = uv_hrtime() / 1000;
+	uint64_t elapsed = now - DepLibUV::lastLagProbeAt;
+	uint64_t lag     = elapsed > LagProbeInterval * 1000 ? elapsed - LagProbeInterval * 1000 : 0;
+
+	DepLibUV::lastLagProbeAt = now;
+
+	if (DepLibUV::lagSamples.size() < LagSamples)
+	{
+		DepLibUV::lagSamples.push_back(lag);
+	}
+	else
+	{
+		DepLibUV::lagSamples[DepLibUV::lagSamplesIdx] = lag;
+		DepLibUV::lagSamplesIdx = (DepLibUV::lagSamplesIdx + 1) % LagSamples;
+	}
+
+	if (DepLibUV::loopMonitorListener)
+		DepLibUV::loopMonitorListener->OnLoopLag(lag);
+}
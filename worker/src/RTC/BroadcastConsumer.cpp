@@ -0,0 +1,594 @@
+#define MS_CLASS "RTC::BroadcastConsumer"
+// #define MS_LOG_DEV
+
+#include "RTC/BroadcastConsumer.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Utils.hpp"
+#include "RTC/Codecs/Codecs.hpp"
+#include "RTC/OverloadController.hpp"
+#include "RTC/SeqManager.hpp"
+#include <utility> // std::pair
+#include <vector>
+
+namespace RTC
+{
+	/* Static. */
+
+	static uint8_t RtxPacketBuffer[RTC::RtpBufferSize];
+	// 16 bit mask + the initial sequence number.
+	static constexpr uint16_t MaxRequestedPackets{ 17 };
+	// Sequence numbers requested by all the items of a NACK.
+	static std::vector<uint16_t> RequestedSeqs;
+	// Requested packets fitting into the retransmission budget.
+	static std::vector<std::pair<uint16_t, const RTC::RtpPacket*>> RetransmittedPackets;
+
+	/* Instance methods. */
+
+	BroadcastConsumer::BroadcastConsumer(
+	  const std::string& id, RTC::Consumer::Listener* listener, json& data)
+	  : RTC::Consumer::Consumer(id, listener, data, RTC::RtpParameters::Type::BROADCAST)
+	{
+		MS_TRACE();
+
+		// Ensure there is a single encoding.
+		if (this->consumableRtpEncodings.size() != 1)
+			MS_THROW_TYPE_ERROR("invalid consumableRtpEncodings with size != 1");
+
+		// Set the RTCP report generation interval.
+		if (this->kind == RTC::Media::Kind::AUDIO)
+			this->maxRtcpInterval = RTC::RTCP::MaxAudioIntervalMs;
+		else
+			this->maxRtcpInterval = RTC::RTCP::MaxVideoIntervalMs;
+
+		auto& encoding   = this->rtpParameters.encodings[0];
+		auto* mediaCodec = this->rtpParameters.GetCodecForEncoding(encoding);
+
+		this->clockRate         = mediaCodec->clockRate;
+		this->keyFrameSupported = Codecs::CanBeKeyFrame(mediaCodec->mimeType);
+
+		for (auto& fb : mediaCodec->rtcpFeedback)
+		{
+			if (fb.type == "nack" && fb.parameter == "")
+			{
+				MS_DEBUG_2TAGS(rtcp, rtx, "NACK supported");
+
+				this->useNack = true;
+			}
+		}
+
+		if (encoding.hasRtx)
+			this->rtxSeq = Utils::Crypto::GetRandomUInt(0u, 0xFFFF);
+	}
+
+	BroadcastConsumer::~BroadcastConsumer()
+	{
+		MS_TRACE();
+
+		if (this->store)
+			RTC::BroadcastStore::Release(this->store);
+	}
+
+	void BroadcastConsumer::FillJsonStats(json& jsonArray) const
+	{
+		MS_TRACE();
+
+		auto& encoding   = this->rtpParameters.encodings[0];
+		auto* mediaCodec = this->rtpParameters.GetCodecForEncoding(encoding);
+
+		// Add stats of our send stream.
+		jsonArray.emplace_back(json::value_t::object);
+
+		auto& jsonObject = jsonArray[0];
+
+		jsonObject["timestamp"]                    = DepLibUV::GetTime();
+		jsonObject["type"]                         = "outbound-rtp";
+		jsonObject["ssrc"]                         = encoding.ssrc;
+		jsonObject["kind"]                         = RTC::Media::GetString(this->kind);
+		jsonObject["mimeType"]                     = mediaCodec->mimeType.ToString();
+		jsonObject["packetCount"]                  = this->packetCount;
+		jsonObject["byteCount"]                    = this->byteCount;
+		jsonObject["packetsLost"]                  = this->packetsLost;
+		jsonObject["fractionLost"]                 = this->fractionLost;
+		jsonObject["packetsDiscarded"]             = 0;
+		jsonObject["packetsRepaired"]              = this->packetsRepaired;
+		jsonObject["nackCount"]                    = this->nackCount;
+		jsonObject["nackRtpPacketCount"]           = this->nackRtpPacketCount;
+		jsonObject["pliCount"]                     = this->pliCount;
+		jsonObject["firCount"]                     = this->firCount;
+		jsonObject["score"]                        = GetScore();
+		jsonObject["retransmissionPacketsDropped"] = this->retransmissionBudget.GetDroppedPackets();
+
+		if (encoding.hasRtx)
+			jsonObject["rtxSsrc"] = encoding.rtx.ssrc;
+
+		// Add stats of our recv stream and the stats shared by all the
+		// BroadcastConsumers of the Producer.
+		if (this->producerRtpStream)
+		{
+			jsonArray.emplace_back(json::value_t::object);
+			this->producerRtpStream->FillJsonStats(jsonArray[1]);
+
+			jsonArray.emplace_back(json::value_t::object);
+			this->store->FillJsonStats(jsonArray[2]);
+		}
+	}
+
+	void BroadcastConsumer::FillJsonScore(json& jsonObject) const
+	{
+		MS_TRACE();
+
+		if (this->producerRtpStream)
+			jsonObject["producer"] = this->producerRtpStream->GetScore();
+		else
+			jsonObject["producer"] = 0;
+
+		jsonObject["consumer"] = GetScore();
+	}
+
+	void BroadcastConsumer::WriteStats(RTC::StatsWriter& writer) const
+	{
+		MS_TRACE();
+
+		uint64_t now = writer.GetTimestamp();
+
+		writer.BeginRow(this->id);
+
+		// NOTE: Values must be added in the same order as declared in StatsWriter::Field.
+		writer.AddValue(RTC::StatsWriter::Field::SSRC, this->rtpParameters.encodings[0].ssrc);
+		writer.AddValue(RTC::StatsWriter::Field::PACKET_COUNT, this->packetCount);
+		writer.AddValue(RTC::StatsWriter::Field::BYTE_COUNT, this->byteCount);
+		writer.AddValue(
+		  RTC::StatsWriter::Field::BITRATE,
+		  this->producerRtpStream && !this->syncRequired ? this->producerRtpStream->GetRate(now) : 0u);
+		writer.AddValue(RTC::StatsWriter::Field::PACKETS_LOST, this->packetsLost);
+		writer.AddValue(RTC::StatsWriter::Field::FRACTION_LOST, this->fractionLost);
+		writer.AddValue(RTC::StatsWriter::Field::PACKETS_DISCARDED, 0u);
+		writer.AddValue(RTC::StatsWriter::Field::PACKETS_REPAIRED, this->packetsRepaired);
+		writer.AddValue(RTC::StatsWriter::Field::NACK_COUNT, this->nackCount);
+		writer.AddValue(RTC::StatsWriter::Field::NACK_RTP_PACKET_COUNT, this->nackRtpPacketCount);
+		writer.AddValue(RTC::StatsWriter::Field::PLI_COUNT, this->pliCount);
+		writer.AddValue(RTC::StatsWriter::Field::FIR_COUNT, this->firCount);
+		writer.AddValue(RTC::StatsWriter::Field::SCORE, GetScore());
+
+		writer.EndRow();
+	}
+
+	void BroadcastConsumer::HandleRequest(Channel::Request* request)
+	{
+		MS_TRACE();
+
+		switch (request->methodId)
+		{
+			case Channel::Request::MethodId::CONSUMER_REQUEST_KEY_FRAME:
+			{
+				RequestKeyFrame();
+
+				request->Accept();
+
+				break;
+			}
+
+			default:
+			{
+				// Pass it to the parent class.
+				RTC::Consumer::HandleRequest(request);
+			}
+		}
+	}
+
+	void BroadcastConsumer::ProducerNewRtpStream(RTC::RtpStream* rtpStream, uint32_t /*mappedSsrc*/)
+	{
+		MS_TRACE();
+
+		if (this->store && rtpStream != this->producerRtpStream)
+		{
+			RTC::BroadcastStore::Release(this->store);
+
+			this->store = nullptr;
+		}
+
+		this->producerRtpStream = rtpStream;
+
+		if (!this->store)
+			this->store = RTC::BroadcastStore::Acquire(rtpStream);
+	}
+
+	void BroadcastConsumer::ProducerRtpStreamScore(RTC::RtpStream* /*rtpStream*/, uint8_t /*score*/)
+	{
+		MS_TRACE();
+
+		// Score events are not emitted for each viewer.
+	}
+
+	void BroadcastConsumer::SendRtpPacket(const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		if (!IsActive() || !this->store)
+			return;
+
+		// Map the payload type.
+		auto payloadType = packet->GetPayloadType();
+
+		// NOTE: This may happen if this Consumer supports just some codecs of those
+		// in the corresponding Producer.
+		if (this->supportedCodecPayloadTypes.find(payloadType) == this->supportedCodecPayloadTypes.end())
+		{
+			MS_DEBUG_DEV("payload type not supported [payloadType:%" PRIu8 "]", payloadType);
+
+			return;
+		}
+
+		// If we need to sync, support key frames and this is not a key frame, ignore
+		// the packet.
+		if (this->syncRequired && this->keyFrameSupported && !packet->IsKeyFrame())
+			return;
+
+		auto now = DepLibUV::GetTime();
+
+		// Sync sequence number and timestamp if required so they follow those of the
+		// last sent packet.
+		if (this->syncRequired)
+		{
+			if (packet->IsKeyFrame())
+				MS_DEBUG_TAG(rtp, "sync key frame received");
+
+			uint32_t diffTs{ 0 };
+
+			if (this->maxPacketMs != 0u)
+				diffTs = static_cast<uint32_t>((now - this->maxPacketMs) * this->clockRate / 1000);
+
+			this->seqOffset       = this->maxSeq + 1 - packet->GetSequenceNumber();
+			this->timestampOffset = this->maxTimestamp + diffTs - packet->GetTimestamp();
+			this->syncBaseSeq     = this->maxSeq + 1;
+			this->maxSeq          = this->maxSeq + 1;
+			this->syncRequired    = false;
+		}
+
+		// Store the original packet so any BroadcastConsumer can retransmit it.
+		if (this->useNack)
+			this->store->StorePacket(packet, now);
+
+		uint16_t seq       = packet->GetSequenceNumber() + this->seqOffset;
+		uint32_t timestamp = packet->GetTimestamp() + this->timestampOffset;
+
+		// Rewrite packet fields (the original packet is not modified).
+		RTC::RtpPacketOverlay overlay(packet);
+
+		overlay.SetSsrc(this->rtpParameters.encodings[0].ssrc);
+		overlay.SetSequenceNumber(seq);
+		overlay.SetTimestamp(timestamp);
+
+		// Send the packet.
+		this->listener->OnConsumerSendRtpPacket(this, overlay);
+
+		// Update counters.
+		this->packetCount++;
+		this->byteCount += packet->GetSize();
+		this->store->stats.packetCount++;
+		this->store->stats.byteCount += packet->GetSize();
+
+		if (RTC::SeqManager<uint16_t>::IsSeqHigherThan(seq, this->maxSeq))
+			this->maxSeq = seq;
+
+		if (
+		  this->maxPacketMs == 0u ||
+		  RTC::SeqManager<uint32_t>::IsSeqHigherThan(timestamp, this->maxTimestamp))
+		{
+			this->maxTimestamp = timestamp;
+			this->maxPacketMs  = now;
+		}
+	}
+
+	void BroadcastConsumer::GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t now)
+	{
+		MS_TRACE();
+
+		if (static_cast<float>((now - this->lastRtcpSentTime) * 1.15) < this->maxRtcpInterval)
+			return;
+
+		if (this->packetCount == 0u)
+			return;
+
+		auto ssrc   = this->rtpParameters.encodings[0].ssrc;
+		auto ntp    = Utils::Time::TimeMs2Ntp(now);
+		auto report = new RTC::RTCP::SenderReport();
+
+		report->SetSsrc(ssrc);
+		report->SetPacketCount(this->packetCount);
+		report->SetOctetCount(static_cast<uint32_t>(this->byteCount));
+		report->SetRtpTs(this->maxTimestamp);
+		report->SetNtpSec(ntp.seconds);
+		report->SetNtpFrac(ntp.fractions);
+
+		packet->AddSenderReport(report);
+
+		// Build SDES chunk for this sender.
+		auto& cname     = this->rtpParameters.rtcp.cname;
+		auto* sdesChunk = new RTC::RTCP::SdesChunk(ssrc);
+		auto* sdesItem =
+		  new RTC::RTCP::SdesItem(RTC::RTCP::SdesItem::Type::CNAME, cname.size(), cname.c_str());
+
+		sdesChunk->AddItem(sdesItem);
+		packet->AddSdesChunk(sdesChunk);
+
+		this->lastRtcpSentTime = now;
+	}
+
+	void BroadcastConsumer::NeedWorstRemoteFractionLost(
+	  uint32_t /*mappedSsrc*/, uint8_t& worstRemoteFractionLost)
+	{
+		MS_TRACE();
+
+		if (!IsActive())
+			return;
+
+		// If our fraction lost is worse than the given one, update it.
+		if (this->fractionLost > worstRemoteFractionLost)
+			worstRemoteFractionLost = this->fractionLost;
+	}
+
+	void BroadcastConsumer::ReceiveNack(RTC::RTCP::FeedbackRtpNackPacket* nackPacket)
+	{
+		MS_TRACE();
+
+		if (!IsActive() || !this->store)
+			return;
+
+		this->nackCount++;
+		this->store->stats.nackCount++;
+
+		if (!this->useNack)
+		{
+			MS_WARN_TAG(rtx, "NACK not supported");
+
+			return;
+		}
+
+		// Retransmissions are suspended while overloaded.
+		if (RTC::OverloadController::IsLevelReached(
+		      RTC::OverloadController::Level::NO_RETRANSMISSIONS))
+		{
+			return;
+		}
+
+		auto now = DepLibUV::GetTime();
+
+		RequestedSeqs.clear();
+		RetransmittedPackets.clear();
+
+		for (auto it = nackPacket->Begin(); it != nackPacket->End(); ++it)
+		{
+			RTC::RTCP::FeedbackRtpNackItem* item = *it;
+			uint16_t seq                         = item->GetPacketId();
+			uint16_t bitmask                     = item->GetLostPacketBitmask();
+
+			this->nackRtpPacketCount += item->CountRequestedPackets();
+			this->store->stats.nackRtpPacketCount += item->CountRequestedPackets();
+
+			RequestedSeqs.push_back(seq);
+
+			for (uint16_t i{ 1 }; i < MaxRequestedPackets; ++i)
+			{
+				if ((bitmask & (1 << (i - 1))) != 0)
+					RequestedSeqs.push_back(seq + i);
+			}
+		}
+
+		this->retransmissionBudget.Update(GetTransmissionRate(now), now);
+
+		// Take the most recent requested packets fitting into the retransmission
+		// budget since the older ones are more likely to arrive too late.
+		size_t droppedPackets{ 0 };
+
+		for (auto it = RequestedSeqs.rbegin(); it != RequestedSeqs.rend(); ++it)
+		{
+			uint16_t seq = *it;
+			auto* packet = GetStoredPacket(seq, now);
+
+			if (!packet)
+				continue;
+
+			if (droppedPackets != 0u || !this->retransmissionBudget.Consume(packet->GetSize()))
+			{
+				droppedPackets++;
+
+				continue;
+			}
+
+			RetransmittedPackets.emplace_back(seq, packet);
+		}
+
+		if (droppedPackets != 0u)
+		{
+			MS_DEBUG_TAG(
+			  rtx,
+			  "retransmission budget exceeded, ignoring %zu requested packets [ssrc:%" PRIu32 "]",
+			  droppedPackets,
+			  this->rtpParameters.encodings[0].ssrc);
+
+			// The first one was already accounted by Consume().
+			this->retransmissionBudget.Drop(droppedPackets - 1);
+		}
+
+		// Retransmit them in order.
+		for (auto it = RetransmittedPackets.rbegin(); it != RetransmittedPackets.rend(); ++it)
+		{
+			RetransmitPacket(it->first, it->second);
+		}
+	}
+
+	void BroadcastConsumer::ReceiveKeyFrameRequest(RTC::RTCP::FeedbackPs::MessageType messageType)
+	{
+		MS_TRACE();
+
+		if (!IsActive())
+			return;
+
+		switch (messageType)
+		{
+			case RTC::RTCP::FeedbackPs::MessageType::PLI:
+				this->pliCount++;
+				if (this->store)
+					this->store->stats.pliCount++;
+				break;
+
+			case RTC::RTCP::FeedbackPs::MessageType::FIR:
+				this->firCount++;
+				if (this->store)
+					this->store->stats.firCount++;
+				break;
+
+			default:;
+		}
+
+		RequestKeyFrame();
+	}
+
+	void BroadcastConsumer::ReceiveRtcpReceiverReport(RTC::RTCP::ReceiverReport* report)
+	{
+		MS_TRACE();
+
+		this->packetsLost  = report->GetTotalLost();
+		this->fractionLost = report->GetFractionLost();
+	}
+
+	uint32_t BroadcastConsumer::GetTransmissionRate(uint64_t now)
+	{
+		MS_TRACE();
+
+		// There is no per viewer rate calculator, but a synced viewer gets what the
+		// Producer sends.
+		if (!IsActive() || this->syncRequired || !this->producerRtpStream)
+			return 0u;
+
+		return this->producerRtpStream->GetRate(now);
+	}
+
+	float BroadcastConsumer::GetLossPercentage() const
+	{
+		MS_TRACE();
+
+		if (!IsActive())
+			return 0;
+
+		return static_cast<float>(this->fractionLost) * 100 / 256;
+	}
+
+	void BroadcastConsumer::Paused(bool /*wasProducer*/)
+	{
+		MS_TRACE();
+	}
+
+	void BroadcastConsumer::Resumed(bool wasProducer)
+	{
+		MS_TRACE();
+
+		// We need to sync and wait for a key frame (if supported). Otherwise the
+		// receiver will request lot of NACKs due to unknown RTP packets.
+		this->syncRequired = true;
+
+		// If we have been resumed due to the Producer becoming resumed, we don't
+		// need to request a key frame since the Producer already requested it.
+		if (!wasProducer)
+			RequestKeyFrame();
+	}
+
+	void BroadcastConsumer::UserOnTransportConnected()
+	{
+		MS_TRACE();
+
+		// RTP packets were not processed while disconnected, so resync the stream
+		// with a key frame.
+		this->syncRequired = true;
+
+		RequestKeyFrame();
+	}
+
+	const RTC::RtpPacket* BroadcastConsumer::GetStoredPacket(uint16_t seq, uint64_t now) const
+	{
+		MS_TRACE();
+
+		// Packets sent before the last sync have different offsets.
+		if (
+		  this->syncRequired || RTC::SeqManager<uint16_t>::IsSeqLowerThan(seq, this->syncBaseSeq) ||
+		  RTC::SeqManager<uint16_t>::IsSeqHigherThan(seq, this->maxSeq))
+		{
+			return nullptr;
+		}
+
+		return this->store->GetPacket(seq - this->seqOffset, now);
+	}
+
+	void BroadcastConsumer::RetransmitPacket(uint16_t seq, const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		auto& encoding = this->rtpParameters.encodings[0];
+
+		// Rewrite the stored packet fields as they were sent to this viewer.
+		RTC::RtpPacketOverlay overlay(packet);
+
+		overlay.SetSsrc(encoding.ssrc);
+		overlay.SetSequenceNumber(seq);
+		overlay.SetTimestamp(packet->GetTimestamp() + this->timestampOffset);
+
+		if (encoding.hasRtx)
+		{
+			auto* rtxCodec  = this->rtpParameters.GetRtxCodecForEncoding(encoding);
+			auto* rtxPacket = overlay.Clone(RtxPacketBuffer);
+
+			rtxPacket->RtxEncode(rtxCodec->payloadType, encoding.rtx.ssrc, ++this->rtxSeq);
+
+			MS_DEBUG_TAG(
+			  rtx,
+			  "sending RTX packet [ssrc:%" PRIu32 ", seq:%" PRIu16 "] recovering original [ssrc:%" PRIu32
+			  ", seq:%" PRIu16 "]",
+			  rtxPacket->GetSsrc(),
+			  rtxPacket->GetSequenceNumber(),
+			  overlay.GetSsrc(),
+			  overlay.GetSequenceNumber());
+
+			// Send the packet.
+			this->listener->OnConsumerSendRtpPacket(this, RTC::RtpPacketOverlay(rtxPacket));
+
+			delete rtxPacket;
+		}
+		else
+		{
+			MS_DEBUG_TAG(
+			  rtx,
+			  "retransmitting packet [ssrc:%" PRIu32 ", seq:%" PRIu16 "]",
+			  overlay.GetSsrc(),
+			  overlay.GetSequenceNumber());
+
+			// Send the packet.
+			this->listener->OnConsumerSendRtpPacket(this, overlay);
+		}
+
+		this->packetsRepaired++;
+		this->store->stats.packetsRepaired++;
+	}
+
+	void BroadcastConsumer::RequestKeyFrame()
+	{
+		MS_TRACE();
+
+		if (!IsActive() || !this->producerRtpStream || this->kind != RTC::Media::Kind::VIDEO)
+			return;
+
+		auto mappedSsrc = this->consumableRtpEncodings[0].ssrc;
+
+		this->listener->OnConsumerKeyFrameRequested(this, mappedSsrc);
+	}
+
+	inline uint8_t BroadcastConsumer::GetScore() const
+	{
+		MS_TRACE();
+
+		// Just based on the fraction lost reported by the remote.
+		return static_cast<uint8_t>(10 - (this->fractionLost * 10 / 256));
+	}
+} // namespace RTC
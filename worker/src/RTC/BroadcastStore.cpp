@@ -0,0 +1,157 @@
+#define MS_CLASS "RTC::BroadcastStore"
+// #define MS_LOG_DEV
+
+#include "RTC/BroadcastStore.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+
+namespace RTC
+{
+	/* Static. */
+
+	// Don't retransmit packets older than this (ms).
+	static constexpr uint64_t MaxRetransmissionDelay{ 2000 };
+
+	/* Class variables. */
+
+	std::unordered_map<const RTC::RtpStream*, RTC::BroadcastStore*>
+	  BroadcastStore::mapProducerRtpStreamStore;
+
+	/* Class methods. */
+
+	RTC::BroadcastStore* BroadcastStore::Acquire(const RTC::RtpStream* producerRtpStream)
+	{
+		MS_TRACE();
+
+		auto it = BroadcastStore::mapProducerRtpStreamStore.find(producerRtpStream);
+		RTC::BroadcastStore* store{ nullptr };
+
+		if (it == BroadcastStore::mapProducerRtpStreamStore.end())
+		{
+			store = new RTC::BroadcastStore(producerRtpStream);
+
+			BroadcastStore::mapProducerRtpStreamStore[producerRtpStream] = store;
+		}
+		else
+		{
+			store = it->second;
+		}
+
+		store->numConsumers++;
+
+		return store;
+	}
+
+	void BroadcastStore::Release(RTC::BroadcastStore* store)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(store->numConsumers > 0, "store without consumers");
+
+		if (--store->numConsumers > 0)
+			return;
+
+		BroadcastStore::mapProducerRtpStreamStore.erase(store->producerRtpStream);
+
+		delete store;
+	}
+
+	/* Instance methods. */
+
+	BroadcastStore::BroadcastStore(const RTC::RtpStream* producerRtpStream)
+	  : producerRtpStream(producerRtpStream)
+	{
+		MS_TRACE();
+	}
+
+	BroadcastStore::~BroadcastStore()
+	{
+		MS_TRACE();
+
+		// Delete cloned packets.
+		for (auto& bufferItem : this->buffer)
+		{
+			delete bufferItem.packet;
+		}
+	}
+
+	void BroadcastStore::FillJsonStats(json& jsonObject) const
+	{
+		MS_TRACE();
+
+		jsonObject["timestamp"]          = DepLibUV::GetTime();
+		jsonObject["type"]               = "broadcast";
+		jsonObject["consumerCount"]      = this->numConsumers;
+		jsonObject["packetCount"]        = this->stats.packetCount;
+		jsonObject["byteCount"]          = this->stats.byteCount;
+		jsonObject["packetsRepaired"]    = this->stats.packetsRepaired;
+		jsonObject["nackCount"]          = this->stats.nackCount;
+		jsonObject["nackRtpPacketCount"] = this->stats.nackRtpPacketCount;
+		jsonObject["pliCount"]           = this->stats.pliCount;
+		jsonObject["firCount"]           = this->stats.firCount;
+	}
+
+	void BroadcastStore::StorePacket(const RTC::RtpPacket* packet, uint64_t now)
+	{
+		MS_TRACE();
+
+		auto seq = packet->GetSequenceNumber();
+
+		if (this->buffer.empty())
+		{
+			this->storage.resize(BufferSize);
+			this->buffer.resize(BufferSize);
+		}
+
+		auto& bufferItem = this->buffer[seq & (BufferSize - 1)];
+
+		// Already stored while being sent to another consumer.
+		if (
+		  bufferItem.packet && bufferItem.packet->GetSequenceNumber() == seq &&
+		  bufferItem.packet->GetTimestamp() == packet->GetTimestamp())
+		{
+			return;
+		}
+
+		if (packet->GetSize() > RTC::MtuSize)
+		{
+			MS_WARN_TAG(
+			  rtp,
+			  "packet too big [ssrc:%" PRIu32 ", seq:%" PRIu16 ", size:%zu]",
+			  packet->GetSsrc(),
+			  seq,
+			  packet->GetSize());
+
+			return;
+		}
+
+		// Free the packet stored in this position (if any) and reuse its storage.
+		delete bufferItem.packet;
+
+		bufferItem.packet   = packet->Clone(this->storage[seq & (BufferSize - 1)].store);
+		bufferItem.storedAt = now;
+	}
+
+	const RTC::RtpPacket* BroadcastStore::GetPacket(uint16_t seq, uint64_t now) const
+	{
+		MS_TRACE();
+
+		if (this->buffer.empty())
+			return nullptr;
+
+		auto& bufferItem = this->buffer[seq & (BufferSize - 1)];
+
+		if (!bufferItem.packet || bufferItem.packet->GetSequenceNumber() != seq)
+			return nullptr;
+
+		// Just provide the packet if no older than MaxRetransmissionDelay ms.
+		if (now - bufferItem.storedAt > MaxRetransmissionDelay)
+		{
+			MS_DEBUG_TAG(rtx, "ignoring retransmission for too old packet [seq:%" PRIu16 "]", seq);
+
+			return nullptr;
+		}
+
+		return bufferItem.packet;
+	}
+} // namespace RTC
@@ -133,11 +133,6 @@ namespace RTC
 				*data = tl0PictureIndex;
 		}
 
-		void VP8::PayloadDescriptor::Restore(uint8_t* data) const
-		{
-			this->Encode(data, this->pictureId, this->tl0PictureIndex);
-		}
-
 		void VP8::PayloadDescriptor::Dump() const
 		{
 			MS_TRACE();
@@ -223,11 +218,6 @@ namespace RTC
 			return true;
 		};
 
-		void VP8::PayloadDescriptorHandler::Restore(uint8_t* data)
-		{
-			this->payloadDescriptor->Restore(data);
-		}
-
 		void VP8::ProcessRtpPacket(RTC::RtpPacket* packet)
 		{
 			MS_TRACE();
@@ -2,6 +2,7 @@
 // #define MS_LOG_DEV
 
 #include "RTC/Consumer.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Channel/Notifier.hpp"
@@ -75,6 +76,20 @@ namespace RTC
 		if (jsonPausedIt != data.end() && jsonPausedIt->is_boolean())
 			this->paused = jsonPausedIt->get<bool>();
 
+		auto jsonPriorityIt = data.find("priority");
+
+		if (jsonPriorityIt != data.end())
+		{
+			if (
+			  !jsonPriorityIt->is_number_unsigned() || jsonPriorityIt->get<uint32_t>() < 1u ||
+			  jsonPriorityIt->get<uint32_t>() > 255u)
+			{
+				MS_THROW_TYPE_ERROR("wrong priority");
+			}
+
+			this->priority = jsonPriorityIt->get<uint8_t>();
+		}
+
 		// Fill supported codec payload types.
 		for (auto& codec : this->rtpParameters.codecs)
 		{
@@ -133,6 +148,9 @@ namespace RTC
 		// Add producerPaused.
 		jsonObject["producerPaused"] = this->producerPaused;
 
+		// Add priority.
+		jsonObject["priority"] = this->priority;
+
 		// Add lossPercentage.
 		jsonObject["lossPercentage"] = GetLossPercentage();
 	}
@@ -209,6 +227,31 @@ namespace RTC
 				break;
 			}
 
+			case Channel::Request::MethodId::CONSUMER_SET_PRIORITY:
+			{
+				auto jsonPriorityIt = request->data.find("priority");
+
+				if (
+				  jsonPriorityIt == request->data.end() || !jsonPriorityIt->is_number_unsigned() ||
+				  jsonPriorityIt->get<uint32_t>() < 1u || jsonPriorityIt->get<uint32_t>() > 255u)
+				{
+					MS_THROW_TYPE_ERROR("wrong priority");
+				}
+
+				this->priority = jsonPriorityIt->get<uint8_t>();
+
+				MS_DEBUG_DEV(
+				  "priority changed to %" PRIu8 " [consumerId:%s]", this->priority, this->id.c_str());
+
+				json data(json::object());
+
+				data["priority"] = this->priority;
+
+				request->Accept(data);
+
+				break;
+			}
+
 			default:
 			{
 				MS_THROW_ERROR("unknown method '%s'", request->method.c_str());
@@ -216,6 +259,38 @@ namespace RTC
 		}
 	}
 
+	void Consumer::TransportConnected()
+	{
+		MS_TRACE();
+
+		if (this->transportConnected)
+			return;
+
+		this->transportConnected = true;
+
+		MS_DEBUG_DEV("Transport connected [consumerId:%s]", this->id.c_str());
+
+		// Get RTP packets again.
+		this->listener->OnConsumerSubscriptionChanged(this);
+
+		UserOnTransportConnected();
+	}
+
+	void Consumer::TransportDisconnected()
+	{
+		MS_TRACE();
+
+		if (!this->transportConnected)
+			return;
+
+		this->transportConnected = false;
+
+		MS_DEBUG_DEV("Transport disconnected [consumerId:%s]", this->id.c_str());
+
+		// Don't get RTP packets while disconnected.
+		this->listener->OnConsumerSubscriptionChanged(this);
+	}
+
 	void Consumer::ProducerPaused()
 	{
 		MS_TRACE();
@@ -266,4 +341,19 @@ namespace RTC
 
 		this->listener->onConsumerProducerClosed(this);
 	}
+
+	bool Consumer::GetSubscribedMappedSsrcs(std::vector<uint32_t>& /*mappedSsrcs*/) const
+	{
+		MS_TRACE();
+
+		return false;
+	}
+
+	uint32_t Consumer::UseAvailableBitrate(uint32_t /*bitrate*/, bool /*canPause*/)
+	{
+		MS_TRACE();
+
+		// By default the Consumer cannot adapt its bitrate.
+		return GetTransmissionRate(DepLibUV::GetTime());
+	}
 } // namespace RTC
@@ -0,0 +1,283 @@
+#define MS_CLASS "RTC::FileTransport"
+// #define MS_LOG_DEV
+
+#include "RTC/FileTransport.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Utils.hpp"
+#include "Channel/Notifier.hpp"
+#include <sys/time.h> // gettimeofday()
+#include <cstring>    // std::memcpy()
+
+namespace RTC
+{
+	/* Static. */
+
+	static const char RtpdumpPreamble[]{ "#!rtpplay1.0 0.0.0.0/0\n" };
+
+	/* Instance methods. */
+
+	FileTransport::FileTransport(const std::string& id, RTC::Transport::Listener* listener, json& data)
+	  : RTC::Transport::Transport(id, listener)
+	{
+		MS_TRACE();
+
+		auto jsonPathIt = data.find("path");
+
+		if (jsonPathIt == data.end())
+			MS_THROW_TYPE_ERROR("missing path");
+		else if (!jsonPathIt->is_string())
+			MS_THROW_TYPE_ERROR("wrong path (not a string)");
+
+		this->path = jsonPathIt->get<std::string>();
+
+		if (this->path.empty())
+			MS_THROW_TYPE_ERROR("wrong path (empty)");
+
+		try
+		{
+			// This may throw.
+			this->fileWriter = new FileWriter(this, this->path, MaxBlocks);
+
+			// This may throw.
+			this->indexWriter = new FileWriter(this, this->path + ".idx", 1);
+		}
+		catch (const MediaSoupError& error)
+		{
+			MS_ERROR("constructor failed: %s", error.what());
+
+			// Must delete everything since the destructor won't be called.
+
+			delete this->fileWriter;
+			this->fileWriter = nullptr;
+
+			throw;
+		}
+
+		WriteFileHeader();
+
+		// There is no remote endpoint, so the transport is connected from the
+		// beginning. This also makes new Consumers request a key frame.
+		RTC::Transport::Connected();
+	}
+
+	FileTransport::~FileTransport()
+	{
+		MS_TRACE();
+
+		// Pending blocks are flushed and the files closed once written.
+		delete this->fileWriter;
+
+		delete this->indexWriter;
+	}
+
+	void FileTransport::FillJson(json& jsonObject) const
+	{
+		MS_TRACE();
+
+		// Call the parent method.
+		RTC::Transport::FillJson(jsonObject);
+
+		// Add path.
+		jsonObject["path"] = this->path;
+	}
+
+	void FileTransport::FillJsonStats(json& jsonArray) const
+	{
+		MS_TRACE();
+
+		jsonArray.emplace_back(json::value_t::object);
+		auto& jsonObject = jsonArray[0];
+
+		// Add type.
+		jsonObject["type"] = "transport";
+
+		// Add transportId.
+		jsonObject["transportId"] = this->id;
+
+		// Add timestamp.
+		jsonObject["timestamp"] = DepLibUV::GetTime();
+
+		// Add bytesReceived.
+		jsonObject["bytesReceived"] = 0;
+
+		// Add bytesSent.
+		jsonObject["bytesSent"] = this->recordedBytes;
+
+		// Add recordedPackets.
+		jsonObject["recordedPackets"] = this->recordedPackets;
+
+		// Add droppedPackets.
+		jsonObject["droppedPackets"] = this->droppedPackets;
+
+		// Add pendingWrites.
+		jsonObject["pendingWrites"] = this->fileWriter->GetPendingWrites();
+
+		// Add bytesWritten.
+		jsonObject["bytesWritten"] = this->fileWriter->GetBytesWritten();
+
+		// Add writeErrors.
+		jsonObject["writeErrors"] =
+		  this->fileWriter->GetWriteErrors() + this->indexWriter->GetWriteErrors();
+	}
+
+	void FileTransport::HandleRequest(Channel::Request* request)
+	{
+		MS_TRACE();
+
+		switch (request->methodId)
+		{
+			case Channel::Request::MethodId::TRANSPORT_PRODUCE:
+			{
+				MS_THROW_ERROR("cannot produce on a FileTransport");
+			}
+
+			default:
+			{
+				// Pass it to the parent class.
+				RTC::Transport::HandleRequest(request);
+			}
+		}
+	}
+
+	inline bool FileTransport::IsConnected() const
+	{
+		return true;
+	}
+
+	inline size_t FileTransport::GetRecvBytes() const
+	{
+		return 0;
+	}
+
+	inline size_t FileTransport::GetSentBytes() const
+	{
+		return this->recordedBytes;
+	}
+
+	void FileTransport::SendRtpPacket(const RTC::RtpPacketOverlay& overlay)
+	{
+		MS_TRACE();
+
+		// Leave room for the record header.
+		uv_buf_t buffers[RTC::RtpPacketOverlay::MaxBuffers + 1];
+		size_t count = overlay.FillBuffers(buffers + 1);
+
+		WriteRecord(buffers, count + 1, overlay.GetSize(), true);
+	}
+
+	void FileTransport::SendRtcpPacket(RTC::RTCP::Packet* packet)
+	{
+		MS_TRACE();
+
+		uv_buf_t buffers[2];
+
+		buffers[1] = uv_buf_init(
+		  reinterpret_cast<char*>(const_cast<uint8_t*>(packet->GetData())), packet->GetSize());
+
+		WriteRecord(buffers, 2, packet->GetSize(), false);
+	}
+
+	void FileTransport::SendRtcpCompoundPacket(RTC::RTCP::CompoundPacket* packet)
+	{
+		MS_TRACE();
+
+		uv_buf_t buffers[2];
+
+		buffers[1] = uv_buf_init(
+		  reinterpret_cast<char*>(const_cast<uint8_t*>(packet->GetData())), packet->GetSize());
+
+		WriteRecord(buffers, 2, packet->GetSize(), false);
+	}
+
+	void FileTransport::WriteFileHeader()
+	{
+		MS_TRACE();
+
+		struct timeval now; // NOLINT(cppcoreguidelines-pro-type-member-init)
+		uint8_t header[16];
+
+		gettimeofday(&now, nullptr);
+
+		this->startTime = DepLibUV::GetTime();
+
+		// Start time, source address and port (unknown) and padding.
+		Utils::Byte::Set4Bytes(header, 0, static_cast<uint32_t>(now.tv_sec));
+		Utils::Byte::Set4Bytes(header, 4, static_cast<uint32_t>(now.tv_usec));
+		Utils::Byte::Set4Bytes(header, 8, 0);
+		Utils::Byte::Set2Bytes(header, 12, 0);
+		Utils::Byte::Set2Bytes(header, 14, 0);
+
+		uv_buf_t buffers[2];
+
+		buffers[0] = uv_buf_init(const_cast<char*>(RtpdumpPreamble), sizeof(RtpdumpPreamble) - 1);
+		buffers[1] = uv_buf_init(reinterpret_cast<char*>(header), sizeof(header));
+
+		this->fileWriter->Write(buffers, 2);
+	}
+
+	// The first buffer is filled here with the record header.
+	void FileTransport::WriteRecord(uv_buf_t* buffers, size_t count, size_t len, bool isRtp)
+	{
+		MS_TRACE();
+
+		// Recording stopped due to a write error.
+		if (RecordHeaderSize + len > UINT16_MAX || this->fileWriter->HasFailed())
+		{
+			this->droppedPackets++;
+
+			return;
+		}
+
+		uint64_t now = DepLibUV::GetTime();
+		auto elapsed = static_cast<uint32_t>(now - this->startTime);
+		uint8_t header[RecordHeaderSize];
+
+		Utils::Byte::Set2Bytes(header, 0, static_cast<uint16_t>(RecordHeaderSize + len));
+		Utils::Byte::Set2Bytes(header, 2, isRtp ? static_cast<uint16_t>(len) : 0);
+		Utils::Byte::Set4Bytes(header, 4, elapsed);
+
+		buffers[0] = uv_buf_init(reinterpret_cast<char*>(header), RecordHeaderSize);
+
+		uint64_t offset = this->fileWriter->GetOffset();
+
+		if (!this->fileWriter->Write(buffers, count))
+		{
+			this->droppedPackets++;
+
+			return;
+		}
+
+		this->recordedPackets++;
+		this->recordedBytes += len;
+
+		// Index the first RTP packet after every IndexInterval so players can seek
+		// without scanning the file. Only records accepted by the writer are indexed.
+		if (isRtp && (!this->hasIndexEntry || now - this->lastIndexTime >= IndexInterval))
+		{
+			uint8_t entry[IndexEntrySize];
+
+			Utils::Byte::Set4Bytes(entry, 0, elapsed);
+			Utils::Byte::Set8Bytes(entry, 4, offset);
+
+			if (this->indexWriter->Write(entry, sizeof(entry)))
+			{
+				this->hasIndexEntry = true;
+				this->lastIndexTime = now;
+			}
+		}
+	}
+
+	inline void FileTransport::OnFileWriterError(FileWriter* fileWriter, const std::string& error)
+	{
+		MS_TRACE();
+
+		json data(json::object());
+
+		data["path"]  = fileWriter == this->fileWriter ? this->path : this->path + ".idx";
+		data["error"] = error;
+
+		Channel::Notifier::Emit(this->id, "recordingerror", data);
+	}
+} // namespace RTC
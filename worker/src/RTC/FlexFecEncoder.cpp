@@ -0,0 +1,199 @@
+#define MS_CLASS "RTC::FlexFecEncoder"
+// #define MS_LOG_DEV
+
+#include "RTC/FlexFecEncoder.hpp"
+#include "Logger.hpp"
+#include "Utils.hpp"
+#include <cstring> // std::memset()
+
+namespace RTC
+{
+	/* Static. */
+
+	static constexpr size_t RtpHeaderSize{ 12 };
+
+	/* Instance methods. */
+
+	FlexFecEncoder::FlexFecEncoder(uint8_t payloadType, uint32_t ssrc, uint32_t protectedSsrc)
+	  : payloadType(payloadType), ssrc(ssrc), protectedSsrc(protectedSsrc)
+	{
+		MS_TRACE();
+
+		this->seq = static_cast<uint16_t>(Utils::Crypto::GetRandomUInt(0u, 0xFFFF));
+	}
+
+	FlexFecEncoder::~FlexFecEncoder()
+	{
+		MS_TRACE();
+
+		delete this->fecPacket;
+	}
+
+	void FlexFecEncoder::FillJson(json& jsonObject) const
+	{
+		MS_TRACE();
+
+		jsonObject["ssrc"]        = this->ssrc;
+		jsonObject["groupSize"]   = this->groupSize;
+		jsonObject["packetsSent"] = this->packetsSent;
+	}
+
+	void FlexFecEncoder::SetFractionLost(uint8_t fractionLost)
+	{
+		MS_TRACE();
+
+		size_t groupSize;
+
+		// fractionLost is given in 1/256 units.
+		if (fractionLost < 5) // < 2%.
+			groupSize = 0;
+		else if (fractionLost < 13) // < 5%.
+			groupSize = 10;
+		else if (fractionLost < 26) // < 10%.
+			groupSize = 6;
+		else if (fractionLost < 51) // < 20%.
+			groupSize = 4;
+		else
+			groupSize = 2;
+
+		if (groupSize == this->groupSize)
+			return;
+
+		MS_DEBUG_TAG(
+		  rtp,
+		  "FEC group size changed [ssrc:%" PRIu32 ", fractionLost:%" PRIu8 ", groupSize:%zu]",
+		  this->ssrc,
+		  fractionLost,
+		  groupSize);
+
+		this->groupSize = groupSize;
+
+		if (this->groupSize == 0)
+			Reset();
+	}
+
+	const RTC::RtpPacket* FlexFecEncoder::AddPacket(const RTC::RtpPacketOverlay& overlay)
+	{
+		MS_TRACE();
+
+		if (this->groupSize == 0)
+			return nullptr;
+
+		size_t length = overlay.GetSize();
+
+		if (length < RtpHeaderSize || length - RtpHeaderSize > RTC::MtuSize)
+			return nullptr;
+
+		uint16_t seq = overlay.GetSequenceNumber();
+
+		// The packet does not fit into the mask of the current group (or it is older
+		// than its first packet), so start a new group.
+		if (this->numPackets != 0 && static_cast<uint16_t>(seq - this->seqBase) >= MaxGroupSize)
+			Reset();
+
+		if (this->numPackets == 0)
+		{
+			std::memset(this->buffer, 0, sizeof(this->buffer));
+
+			this->seqBase          = seq;
+			this->mask             = 0;
+			this->maxPayloadLength = 0;
+		}
+
+		uint16_t maskBit = 1 << (MaxGroupSize - 1 - static_cast<uint16_t>(seq - this->seqBase));
+
+		// Already protected.
+		if ((this->mask & maskBit) != 0u)
+			return nullptr;
+
+		uv_buf_t buffers[RTC::RtpPacketOverlay::MaxBuffers];
+		size_t count  = overlay.FillBuffers(buffers);
+		auto* header  = reinterpret_cast<const uint8_t*>(buffers[0].base);
+		auto* fecData = this->buffer + RtpHeaderSize;
+
+		// XOR the P, X, CC, M and PT fields.
+		fecData[0] ^= header[0];
+		fecData[1] ^= header[1];
+
+		// XOR the length of the packet (without the fixed header).
+		Utils::Byte::Set2Bytes(
+		  fecData, 2, Utils::Byte::Get2Bytes(fecData, 2) ^ static_cast<uint16_t>(length - RtpHeaderSize));
+
+		// XOR the timestamp.
+		for (size_t i{ 4 }; i < 8; ++i)
+		{
+			fecData[i] ^= header[i];
+		}
+
+		// XOR everything after the fixed header (CSRCs, extensions and payload).
+		auto* fecPayload = this->buffer + HeaderSize;
+
+		for (size_t i{ 1 }; i < count; ++i)
+		{
+			auto* data = reinterpret_cast<const uint8_t*>(buffers[i].base);
+
+			for (size_t j{ 0 }; j < buffers[i].len; ++j)
+			{
+				*fecPayload++ ^= data[j];
+			}
+		}
+
+		if (length - RtpHeaderSize > this->maxPayloadLength)
+			this->maxPayloadLength = length - RtpHeaderSize;
+
+		this->mask |= maskBit;
+		this->numPackets++;
+		this->timestamp = overlay.GetTimestamp();
+
+		// Send the repair packet once the group is full or at the end of a frame if
+		// the group is big enough.
+		if (
+		  this->numPackets >= this->groupSize ||
+		  (overlay.GetPacket()->HasMarker() && this->numPackets * 2 >= this->groupSize))
+		{
+			return CreateFecPacket();
+		}
+
+		return nullptr;
+	}
+
+	void FlexFecEncoder::Reset()
+	{
+		MS_TRACE();
+
+		this->numPackets = 0;
+	}
+
+	RTC::RtpPacket* FlexFecEncoder::CreateFecPacket()
+	{
+		MS_TRACE();
+
+		// RTP header.
+		this->buffer[0] = 0x80;
+		this->buffer[1] = this->payloadType & 0x7F;
+		Utils::Byte::Set2Bytes(this->buffer, 2, this->seq++);
+		Utils::Byte::Set4Bytes(this->buffer, 4, this->timestamp);
+		Utils::Byte::Set4Bytes(this->buffer, 8, this->ssrc);
+
+		auto* fecHeader = this->buffer + RtpHeaderSize;
+
+		// R and F bits (flexible mask).
+		fecHeader[0] &= 0x3F;
+		// SSRCCount and reserved.
+		fecHeader[8] = 1;
+		Utils::Byte::Set4Bytes(fecHeader, 12, this->protectedSsrc);
+		Utils::Byte::Set2Bytes(fecHeader, 16, this->seqBase);
+		// K bit (no more mask chunks) and mask.
+		Utils::Byte::Set2Bytes(fecHeader, 18, 0x8000 | this->mask);
+
+		delete this->fecPacket;
+
+		this->fecPacket = RTC::RtpPacket::Parse(this->buffer, HeaderSize + this->maxPayloadLength);
+
+		Reset();
+
+		this->packetsSent++;
+
+		return this->fecPacket;
+	}
+} // namespace RTC
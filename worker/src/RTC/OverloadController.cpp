@@ -0,0 +1,130 @@
+#define MS_CLASS "RTC::OverloadController"
+// #define MS_LOG_DEV
+
+#include "RTC/OverloadController.hpp"
+#include "Logger.hpp"
+#include "Settings.hpp"
+#include <algorithm> // std::nth_element()
+
+namespace RTC
+{
+	/* Static. */
+
+	// Duration of each evaluation period (ms).
+	static constexpr uint64_t PeriodDuration{ 1000 };
+	// Consecutive calm periods required to lower the level one step.
+	static constexpr size_t CalmPeriodsToRestore{ 5 };
+	// A period is calm if its median lag is below threshold / CalmThresholdDivisor.
+	static constexpr uint64_t CalmThresholdDivisor{ 4 };
+
+	/* Class variables. */
+
+	OverloadController::Level OverloadController::level{ OverloadController::Level::NONE };
+	uint64_t OverloadController::levelChanges{ 0 };
+	uint64_t OverloadController::periodStartedAt{ 0 };
+	size_t OverloadController::calmPeriods{ 0 };
+	std::vector<uint64_t> OverloadController::periodSamples;
+	// clang-format off
+	std::vector<std::string> OverloadController::level2String =
+	{
+		"none",
+		"no-retransmissions",
+		"lower-spatial-layers",
+		"lower-temporal-layers",
+		"stretch-rtcp"
+	};
+	// clang-format on
+
+	/* Class methods. */
+
+	bool OverloadController::ProcessLagSample(uint64_t lagUs, uint64_t now)
+	{
+		MS_TRACE();
+
+		uint64_t thresholdUs = Settings::configuration.overloadLagThreshold * 1000;
+
+		// Disabled, restore everything at once.
+		if (thresholdUs == 0u)
+		{
+			bool changed = SetLevel(Level::NONE);
+
+			Reset();
+
+			return changed;
+		}
+
+		if (OverloadController::periodSamples.empty())
+			OverloadController::periodStartedAt = now;
+
+		OverloadController::periodSamples.push_back(lagUs);
+
+		if (now - OverloadController::periodStartedAt < PeriodDuration)
+			return false;
+
+		auto& samples = OverloadController::periodSamples;
+		auto median   = samples.begin() + samples.size() / 2;
+
+		std::nth_element(samples.begin(), median, samples.end());
+
+		uint64_t medianLag = *median;
+
+		samples.clear();
+
+		if (medianLag >= thresholdUs)
+		{
+			OverloadController::calmPeriods = 0;
+
+			if (OverloadController::level == Level::STRETCH_RTCP)
+				return false;
+
+			return SetLevel(static_cast<Level>(static_cast<uint8_t>(OverloadController::level) + 1));
+		}
+		else if (medianLag < thresholdUs / CalmThresholdDivisor)
+		{
+			if (OverloadController::level == Level::NONE)
+				return false;
+
+			if (++OverloadController::calmPeriods < CalmPeriodsToRestore)
+				return false;
+
+			OverloadController::calmPeriods = 0;
+
+			return SetLevel(static_cast<Level>(static_cast<uint8_t>(OverloadController::level) - 1));
+		}
+		else
+		{
+			OverloadController::calmPeriods = 0;
+
+			return false;
+		}
+	}
+
+	void OverloadController::Reset()
+	{
+		MS_TRACE();
+
+		OverloadController::level           = Level::NONE;
+		OverloadController::periodStartedAt = 0;
+		OverloadController::calmPeriods     = 0;
+		OverloadController::periodSamples.clear();
+	}
+
+	bool OverloadController::SetLevel(Level level)
+	{
+		MS_TRACE();
+
+		if (level == OverloadController::level)
+			return false;
+
+		MS_DEBUG_TAG(
+		  info,
+		  "overload level changed [from:%s, to:%s]",
+		  GetLevelString().c_str(),
+		  OverloadController::level2String[static_cast<uint8_t>(level)].c_str());
+
+		OverloadController::level = level;
+		++OverloadController::levelChanges;
+
+		return true;
+	}
+} // namespace RTC
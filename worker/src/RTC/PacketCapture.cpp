@@ -0,0 +1,236 @@
+#define MS_CLASS "RTC::PacketCapture"
+// #define MS_LOG_DEV
+
+#include "RTC/PacketCapture.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Utils.hpp"
+#include <sys/time.h> // gettimeofday()
+#include <cstring>    // std::memcpy()
+
+namespace RTC
+{
+	/* Static. */
+
+	// pcapng block types.
+	static constexpr uint32_t SectionHeaderBlock{ 0x0A0D0D0A };
+	static constexpr uint32_t InterfaceDescriptionBlock{ 0x00000001 };
+	static constexpr uint32_t EnhancedPacketBlock{ 0x00000006 };
+	static constexpr uint32_t ByteOrderMagic{ 0x1A2B3C4D };
+	// Raw IPv4 packets.
+	static constexpr uint16_t LinkTypeIpv4{ 228 };
+	static constexpr uint16_t EpbFlagsOption{ 2 };
+	// Synthetic addresses (10.0.0.1 is the worker) and port.
+	static constexpr uint32_t LocalAddress{ 0x0A000001 };
+	static constexpr uint32_t RemoteAddress{ 0x0A000002 };
+	static constexpr uint16_t Port{ 5004 };
+
+	// pcapng fields are written in host byte order, as told by ByteOrderMagic.
+	template<typename T>
+	inline static void appendValue(std::vector<uint8_t>& buffer, T value)
+	{
+		auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+
+		buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+	}
+
+	static void appendIpUdpHeader(
+	  std::vector<uint8_t>& buffer, PacketCapture::Direction direction, size_t length)
+	{
+		uint8_t header[PacketCapture::IpUdpHeaderSize];
+		bool isIn = direction == PacketCapture::Direction::IN;
+
+		// IPv4 header (20 bytes) with DF flag, TTL 64 and UDP protocol.
+		Utils::Byte::Set1Byte(header, 0, 0x45);
+		Utils::Byte::Set1Byte(header, 1, 0);
+		Utils::Byte::Set2Bytes(
+		  header, 2, static_cast<uint16_t>(PacketCapture::IpUdpHeaderSize + length));
+		Utils::Byte::Set2Bytes(header, 4, 0);
+		Utils::Byte::Set2Bytes(header, 6, 0x4000);
+		Utils::Byte::Set1Byte(header, 8, 64);
+		Utils::Byte::Set1Byte(header, 9, 17);
+		Utils::Byte::Set2Bytes(header, 10, 0);
+		Utils::Byte::Set4Bytes(header, 12, isIn ? RemoteAddress : LocalAddress);
+		Utils::Byte::Set4Bytes(header, 16, isIn ? LocalAddress : RemoteAddress);
+
+		uint32_t sum{ 0 };
+
+		for (size_t i{ 0 }; i < 20; i += 2)
+		{
+			sum += Utils::Byte::Get2Bytes(header, i);
+		}
+
+		while ((sum >> 16) != 0)
+		{
+			sum = (sum & 0xFFFF) + (sum >> 16);
+		}
+
+		Utils::Byte::Set2Bytes(header, 10, static_cast<uint16_t>(~sum));
+
+		// UDP header (8 bytes) with no checksum.
+		Utils::Byte::Set2Bytes(header, 20, Port);
+		Utils::Byte::Set2Bytes(header, 22, Port);
+		Utils::Byte::Set2Bytes(header, 24, static_cast<uint16_t>(8 + length));
+		Utils::Byte::Set2Bytes(header, 26, 0);
+
+		buffer.insert(buffer.end(), header, header + sizeof(header));
+	}
+
+	/* Instance methods. */
+
+	PacketCapture::PacketCapture(size_t snapLength, size_t maxPackets)
+	  : snapLength(snapLength), maxPackets(maxPackets)
+	{
+		MS_TRACE();
+
+		if (snapLength == 0 || snapLength > MaxSnapLength)
+			MS_THROW_TYPE_ERROR("wrong snapLength");
+
+		if (maxPackets == 0 || maxPackets > MaxBufferSize / snapLength)
+			MS_THROW_TYPE_ERROR("wrong maxPackets");
+
+		this->entries.resize(maxPackets);
+		this->storage.resize(maxPackets * snapLength);
+
+		struct timeval now; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+		gettimeofday(&now, nullptr);
+
+		this->timeOffset = static_cast<uint64_t>(now.tv_sec) * 1000000 +
+		                   static_cast<uint64_t>(now.tv_usec) - uv_hrtime() / 1000;
+	}
+
+	void PacketCapture::FillJson(json& jsonObject) const
+	{
+		MS_TRACE();
+
+		// Add snapLength.
+		jsonObject["snapLength"] = this->snapLength;
+
+		// Add maxPackets.
+		jsonObject["maxPackets"] = this->maxPackets;
+
+		// Add packetCount.
+		jsonObject["packetCount"] = this->packetCount;
+
+		// Add overwrittenPackets.
+		jsonObject["overwrittenPackets"] = this->overwrittenPackets;
+	}
+
+	void PacketCapture::Add(Direction direction, const uint8_t* data, size_t len)
+	{
+		MS_TRACE();
+
+		uint8_t* slot = Append(direction, len);
+
+		std::memcpy(slot, data, std::min(len, this->snapLength));
+	}
+
+	void PacketCapture::Add(Direction direction, const uv_buf_t* buffers, size_t count)
+	{
+		MS_TRACE();
+
+		size_t len{ 0 };
+
+		for (size_t i{ 0 }; i < count; ++i)
+		{
+			len += buffers[i].len;
+		}
+
+		uint8_t* slot    = Append(direction, len);
+		size_t remaining = std::min(len, this->snapLength);
+
+		for (size_t i{ 0 }; i < count && remaining != 0; ++i)
+		{
+			size_t copyLen = std::min(static_cast<size_t>(buffers[i].len), remaining);
+
+			std::memcpy(slot, buffers[i].base, copyLen);
+
+			slot += copyLen;
+			remaining -= copyLen;
+		}
+	}
+
+	void PacketCapture::Serialize(std::vector<uint8_t>& buffer) const
+	{
+		MS_TRACE();
+
+		buffer.clear();
+
+		// Section Header Block (no options).
+		appendValue<uint32_t>(buffer, SectionHeaderBlock);
+		appendValue<uint32_t>(buffer, 28);
+		appendValue<uint32_t>(buffer, ByteOrderMagic);
+		appendValue<uint16_t>(buffer, 1);
+		appendValue<uint16_t>(buffer, 0);
+		appendValue<int64_t>(buffer, -1);
+		appendValue<uint32_t>(buffer, 28);
+
+		// Interface Description Block (no options, microsecond resolution).
+		appendValue<uint32_t>(buffer, InterfaceDescriptionBlock);
+		appendValue<uint32_t>(buffer, 20);
+		appendValue<uint16_t>(buffer, LinkTypeIpv4);
+		appendValue<uint16_t>(buffer, 0);
+		appendValue<uint32_t>(buffer, static_cast<uint32_t>(IpUdpHeaderSize + this->snapLength));
+		appendValue<uint32_t>(buffer, 20);
+
+		size_t first = (this->next + this->maxPackets - this->packetCount) % this->maxPackets;
+
+		for (size_t i{ 0 }; i < this->packetCount; ++i)
+		{
+			size_t idx          = (first + i) % this->maxPackets;
+			const auto& entry   = this->entries[idx];
+			const uint8_t* data = this->storage.data() + idx * this->snapLength;
+			size_t capturedLen  = IpUdpHeaderSize + entry.capturedLength;
+			size_t paddedLen    = Utils::Byte::PadTo4Bytes(static_cast<uint32_t>(capturedLen));
+			// Block header and trailer, fields, data and epb_flags option.
+			auto blockLen = static_cast<uint32_t>(32 + paddedLen + 12);
+
+			// Enhanced Packet Block.
+			appendValue<uint32_t>(buffer, EnhancedPacketBlock);
+			appendValue<uint32_t>(buffer, blockLen);
+			appendValue<uint32_t>(buffer, 0);
+			appendValue<uint32_t>(buffer, static_cast<uint32_t>(entry.time >> 32));
+			appendValue<uint32_t>(buffer, static_cast<uint32_t>(entry.time));
+			appendValue<uint32_t>(buffer, static_cast<uint32_t>(capturedLen));
+			appendValue<uint32_t>(buffer, static_cast<uint32_t>(IpUdpHeaderSize + entry.length));
+
+			appendIpUdpHeader(buffer, entry.direction, entry.length);
+
+			buffer.insert(buffer.end(), data, data + entry.capturedLength);
+			buffer.insert(buffer.end(), paddedLen - capturedLen, 0);
+
+			// epb_flags: inbound (1) or outbound (2).
+			appendValue<uint16_t>(buffer, EpbFlagsOption);
+			appendValue<uint16_t>(buffer, 4);
+			appendValue<uint32_t>(buffer, entry.direction == Direction::IN ? 1 : 2);
+			// opt_endofopt.
+			appendValue<uint32_t>(buffer, 0);
+
+			appendValue<uint32_t>(buffer, blockLen);
+		}
+	}
+
+	inline uint8_t* PacketCapture::Append(Direction direction, size_t len)
+	{
+		MS_TRACE();
+
+		auto& entry = this->entries[this->next];
+
+		entry.time           = this->timeOffset + uv_hrtime() / 1000;
+		entry.length         = static_cast<uint32_t>(len);
+		entry.capturedLength = static_cast<uint16_t>(std::min(len, this->snapLength));
+		entry.direction      = direction;
+
+		uint8_t* slot = this->storage.data() + this->next * this->snapLength;
+
+		this->next = (this->next + 1) % this->maxPackets;
+
+		if (this->packetCount < this->maxPackets)
+			this->packetCount++;
+		else
+			this->overwrittenPackets++;
+
+		return slot;
+	}
+} // namespace RTC
@@ -49,6 +49,20 @@ namespace RTC
 		// Do nothing.
 	}
 
+	void PipeConsumer::WriteStats(RTC::StatsWriter& writer) const
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->mapMappedSsrcRtpStream)
+		{
+			auto* rtpStream = kv.second;
+
+			writer.BeginRow(this->id);
+			rtpStream->WriteStats(writer);
+			writer.EndRow();
+		}
+	}
+
 	void PipeConsumer::HandleRequest(Channel::Request* request)
 	{
 		MS_TRACE();
@@ -72,13 +86,6 @@ namespace RTC
 		}
 	}
 
-	void PipeConsumer::TransportConnected()
-	{
-		MS_TRACE();
-
-		RequestKeyFrame();
-	}
-
 	void PipeConsumer::ProducerNewRtpStream(RTC::RtpStream* /*rtpStream*/, uint32_t /*mappedSsrc*/)
 	{
 		MS_TRACE();
@@ -93,7 +100,7 @@ namespace RTC
 		// Do nothing.
 	}
 
-	void PipeConsumer::SendRtpPacket(RTC::RtpPacket* packet)
+	void PipeConsumer::SendRtpPacket(const RTC::RtpPacket* packet)
 	{
 		MS_TRACE();
 
@@ -101,12 +108,13 @@ namespace RTC
 			return;
 
 		auto* rtpStream = this->mapMappedSsrcRtpStream.at(packet->GetSsrc());
+		RTC::RtpPacketOverlay overlay(packet);
 
 		// Process the packet.
-		if (rtpStream->ReceivePacket(packet))
+		if (rtpStream->ReceivePacket(overlay))
 		{
 			// Send the packet.
-			this->listener->OnConsumerSendRtpPacket(this, packet);
+			this->listener->OnConsumerSendRtpPacket(this, overlay);
 		}
 		else
 		{
@@ -248,6 +256,13 @@ namespace RTC
 			RequestKeyFrame();
 	}
 
+	void PipeConsumer::UserOnTransportConnected()
+	{
+		MS_TRACE();
+
+		RequestKeyFrame();
+	}
+
 	void PipeConsumer::CreateRtpStreams()
 	{
 		MS_TRACE();
@@ -334,6 +349,6 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		this->listener->OnConsumerSendRtpPacket(this, packet);
+		this->listener->OnConsumerSendRtpPacket(this, RTC::RtpPacketOverlay(packet));
 	}
 } // namespace RTC
@@ -46,10 +46,17 @@ namespace RTC
 			this->listenIp.announcedIp.assign(jsonAnnouncedIpIt->get<std::string>());
 		}
 
+		uint32_t udpRecvBufferSize{ 0 };
+		uint32_t udpSendBufferSize{ 0 };
+
+		// This may throw.
+		ReadUdpBufferSizes(data, udpRecvBufferSize, udpSendBufferSize);
+
 		try
 		{
 			// This may throw.
-			this->udpSocket = new RTC::UdpSocket(this, this->listenIp.ip);
+			this->udpSocket =
+			  new RTC::UdpSocket(this, this->listenIp.ip, udpRecvBufferSize, udpSendBufferSize);
 		}
 		catch (const MediaSoupError& error)
 		{
@@ -135,6 +142,18 @@ namespace RTC
 			// Add bytesSent.
 			jsonObject["bytesSent"] = 0;
 		}
+
+		// Add udpRecvBufferSize.
+		jsonObject["udpRecvBufferSize"] = this->udpSocket->GetRecvBufferSize();
+
+		// Add udpSendBufferSize.
+		jsonObject["udpSendBufferSize"] = this->udpSocket->GetSendBufferSize();
+
+		// Add udpRecvDrops.
+		jsonObject["udpRecvDrops"] = this->udpSocket->GetRecvDrops();
+
+		// Add udpSendEagains.
+		jsonObject["udpSendEagains"] = this->udpSocket->GetSendEagains();
 	}
 
 	void PipeTransport::HandleRequest(Channel::Request* request)
@@ -252,17 +271,35 @@ namespace RTC
 		return this->tuple != nullptr;
 	}
 
-	void PipeTransport::SendRtpPacket(RTC::RtpPacket* packet)
+	inline size_t PipeTransport::GetRecvBytes() const
+	{
+		if (this->tuple == nullptr)
+			return 0;
+
+		return this->tuple->GetRecvBytes();
+	}
+
+	inline size_t PipeTransport::GetSentBytes() const
+	{
+		if (this->tuple == nullptr)
+			return 0;
+
+		return this->tuple->GetSentBytes();
+	}
+
+	void PipeTransport::SendRtpPacket(const RTC::RtpPacketOverlay& overlay)
 	{
 		MS_TRACE();
 
 		if (!IsConnected())
 			return;
 
-		const uint8_t* data = packet->GetData();
-		size_t len          = packet->GetSize();
+		CapturePacket(RTC::PacketCapture::Direction::OUT, overlay);
 
-		this->tuple->Send(data, len);
+		uv_buf_t buffers[RTC::RtpPacketOverlay::MaxBuffers];
+		size_t count = overlay.FillBuffers(buffers);
+
+		this->tuple->Send(buffers, count);
 	}
 
 	void PipeTransport::SendRtcpPacket(RTC::RTCP::Packet* packet)
@@ -275,6 +312,8 @@ namespace RTC
 		const uint8_t* data = packet->GetData();
 		size_t len          = packet->GetSize();
 
+		CapturePacket(RTC::PacketCapture::Direction::OUT, data, len);
+
 		this->tuple->Send(data, len);
 	}
 
@@ -288,6 +327,8 @@ namespace RTC
 		const uint8_t* data = packet->GetData();
 		size_t len          = packet->GetSize();
 
+		CapturePacket(RTC::PacketCapture::Direction::OUT, data, len);
+
 		this->tuple->Send(data, len);
 	}
 
@@ -326,6 +367,8 @@ namespace RTC
 			return;
 		}
 
+		CapturePacket(RTC::PacketCapture::Direction::IN, data, len);
+
 		RTC::RtpPacket* packet = RTC::RtpPacket::Parse(data, len);
 
 		if (packet == nullptr)
@@ -378,6 +421,8 @@ namespace RTC
 			return;
 		}
 
+		CapturePacket(RTC::PacketCapture::Direction::IN, data, len);
+
 		RTC::RTCP::Packet* packet = RTC::RTCP::Packet::Parse(data, len);
 
 		if (packet == nullptr)
@@ -400,7 +445,11 @@ namespace RTC
 	}
 
 	inline void PipeTransport::OnPacketRecv(
-	  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr)
+	  RTC::UdpSocket* socket,
+	  const uint8_t* data,
+	  size_t len,
+	  const struct sockaddr* remoteAddr,
+	  uint64_t /*arrivalTime*/)
 	{
 		MS_TRACE();
 
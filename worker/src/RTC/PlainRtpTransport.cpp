@@ -9,6 +9,61 @@
 
 namespace RTC
 {
+	/* Static. */
+
+	static void parseDestination(
+	  const json& data, std::string& ip, uint16_t& port, struct sockaddr_storage& addrStorage)
+	{
+		auto jsonIpIt = data.find("ip");
+
+		if (jsonIpIt == data.end() || !jsonIpIt->is_string())
+			MS_THROW_TYPE_ERROR("missing ip");
+
+		ip = jsonIpIt->get<std::string>();
+
+		// This may throw.
+		Utils::IP::NormalizeIp(ip);
+
+		auto jsonPortIt = data.find("port");
+
+		if (jsonPortIt == data.end() || !jsonPortIt->is_number_unsigned())
+			MS_THROW_TYPE_ERROR("missing port");
+
+		port = jsonPortIt->get<uint16_t>();
+
+		int err;
+
+		switch (Utils::IP::GetFamily(ip))
+		{
+			case AF_INET:
+			{
+				err = uv_ip4_addr(
+				  ip.c_str(), static_cast<int>(port), reinterpret_cast<struct sockaddr_in*>(&addrStorage));
+
+				if (err != 0)
+					MS_ABORT("uv_ip4_addr() failed: %s", uv_strerror(err));
+
+				break;
+			}
+
+			case AF_INET6:
+			{
+				err = uv_ip6_addr(
+				  ip.c_str(), static_cast<int>(port), reinterpret_cast<struct sockaddr_in6*>(&addrStorage));
+
+				if (err != 0)
+					MS_ABORT("uv_ip6_addr() failed: %s", uv_strerror(err));
+
+				break;
+			}
+
+			default:
+			{
+				MS_THROW_ERROR("invalid IP '%s'", ip.c_str());
+			}
+		}
+	}
+
 	/* Instance methods. */
 
 	// NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
@@ -84,15 +139,23 @@ namespace RTC
 			}
 		}
 
+		uint32_t udpRecvBufferSize{ 0 };
+		uint32_t udpSendBufferSize{ 0 };
+
+		// This may throw.
+		ReadUdpBufferSizes(data, udpRecvBufferSize, udpSendBufferSize);
+
 		try
 		{
 			// This may throw.
-			this->udpSocket = new RTC::UdpSocket(this, this->listenIp.ip);
+			this->udpSocket =
+			  new RTC::UdpSocket(this, this->listenIp.ip, udpRecvBufferSize, udpSendBufferSize);
 
 			if (!this->rtcpMux)
 			{
 				// This may throw.
-				this->rtcpUdpSocket = new RTC::UdpSocket(this, this->listenIp.ip);
+				this->rtcpUdpSocket =
+				  new RTC::UdpSocket(this, this->listenIp.ip, udpRecvBufferSize, udpSendBufferSize);
 			}
 		}
 		catch (const MediaSoupError& error)
@@ -181,6 +244,10 @@ namespace RTC
 			}
 		}
 
+		// Add destinations.
+		if (!this->destinations.empty())
+			FillJsonDestinations(jsonObject["destinations"]);
+
 		// Add headerExtensionIds.
 		jsonObject["rtpHeaderExtensions"] = json::object();
 		auto jsonRtpHeaderExtensionsIt    = jsonObject.find("rtpHeaderExtensions");
@@ -237,6 +304,25 @@ namespace RTC
 		// Add rtcpTuple.
 		if (!this->rtcpMux && this->rtcpTuple != nullptr)
 			this->rtcpTuple->FillJson(jsonObject["rtcpTuple"]);
+
+		// Add udpRecvBufferSize.
+		jsonObject["udpRecvBufferSize"] = this->udpSocket->GetRecvBufferSize();
+
+		// Add udpSendBufferSize.
+		jsonObject["udpSendBufferSize"] = this->udpSocket->GetSendBufferSize();
+
+		// Add udpRecvDrops.
+		jsonObject["udpRecvDrops"] = this->udpSocket->GetRecvDrops() +
+		                             (this->rtcpUdpSocket ? this->rtcpUdpSocket->GetRecvDrops() : 0);
+
+		// Add udpSendEagains.
+		jsonObject["udpSendEagains"] =
+		  this->udpSocket->GetSendEagains() +
+		  (this->rtcpUdpSocket ? this->rtcpUdpSocket->GetSendEagains() : 0);
+
+		// Add destinations.
+		if (!this->destinations.empty())
+			FillJsonDestinations(jsonObject["destinations"]);
 	}
 
 	void PlainRtpTransport::HandleRequest(Channel::Request* request)
@@ -416,6 +502,62 @@ namespace RTC
 				break;
 			}
 
+			case Channel::Request::MethodId::TRANSPORT_ADD_DESTINATION:
+			{
+				if (this->tuple == nullptr)
+					MS_THROW_ERROR("not connected");
+				else if (!this->rtcpMux)
+					MS_THROW_ERROR("cannot add destinations with rtcpMux disabled");
+				else if (this->destinations.size() >= MaxDestinations)
+					MS_THROW_ERROR("too many destinations");
+
+				Destination destination;
+
+				// This may throw.
+				parseDestination(request->data, destination.ip, destination.port, destination.addrStorage);
+
+				auto* addr = reinterpret_cast<const struct sockaddr*>(&destination.addrStorage);
+
+				if (addr->sa_family != this->udpSocket->GetLocalAddress()->sa_family)
+					MS_THROW_ERROR("destination IP family does not match the local IP");
+
+				if (
+				  Utils::IP::CompareAddresses(addr, this->tuple->GetRemoteAddress()) ||
+				  GetDestination(addr) != nullptr)
+				{
+					MS_THROW_ERROR("destination already exists");
+				}
+
+				this->destinations.push_back(destination);
+
+				request->Accept();
+
+				break;
+			}
+
+			case Channel::Request::MethodId::TRANSPORT_REMOVE_DESTINATION:
+			{
+				std::string ip;
+				uint16_t port{ 0u };
+				struct sockaddr_storage addrStorage; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+				// This may throw.
+				parseDestination(request->data, ip, port, addrStorage);
+
+				auto* destination =
+				  GetDestination(reinterpret_cast<const struct sockaddr*>(&addrStorage));
+
+				if (destination == nullptr)
+					MS_THROW_ERROR("destination not found");
+
+				this->destinations.erase(
+				  this->destinations.begin() + (destination - this->destinations.data()));
+
+				request->Accept();
+
+				break;
+			}
+
 			default:
 			{
 				// Pass it to the parent class.
@@ -429,17 +571,35 @@ namespace RTC
 		return this->tuple != nullptr;
 	}
 
-	void PlainRtpTransport::SendRtpPacket(RTC::RtpPacket* packet)
+	inline size_t PlainRtpTransport::GetRecvBytes() const
+	{
+		if (this->tuple == nullptr)
+			return 0;
+
+		return this->tuple->GetRecvBytes();
+	}
+
+	inline size_t PlainRtpTransport::GetSentBytes() const
+	{
+		if (this->tuple == nullptr)
+			return 0;
+
+		return this->tuple->GetSentBytes();
+	}
+
+	void PlainRtpTransport::SendRtpPacket(const RTC::RtpPacketOverlay& overlay)
 	{
 		MS_TRACE();
 
 		if (!IsConnected())
 			return;
 
-		const uint8_t* data = packet->GetData();
-		size_t len          = packet->GetSize();
+		CapturePacket(RTC::PacketCapture::Direction::OUT, overlay);
 
-		this->tuple->Send(data, len);
+		uv_buf_t buffers[RTC::RtpPacketOverlay::MaxBuffers];
+		size_t count = overlay.FillBuffers(buffers);
+
+		Send(buffers, count);
 	}
 
 	void PlainRtpTransport::SendRtcpPacket(RTC::RTCP::Packet* packet)
@@ -452,8 +612,12 @@ namespace RTC
 		const uint8_t* data = packet->GetData();
 		size_t len          = packet->GetSize();
 
+		CapturePacket(RTC::PacketCapture::Direction::OUT, data, len);
+
+		uv_buf_t buffer = uv_buf_init(reinterpret_cast<char*>(const_cast<uint8_t*>(data)), len);
+
 		if (this->rtcpMux)
-			this->tuple->Send(data, len);
+			Send(&buffer, 1);
 		else if (this->rtcpTuple)
 			this->rtcpTuple->Send(data, len);
 	}
@@ -468,12 +632,94 @@ namespace RTC
 		const uint8_t* data = packet->GetData();
 		size_t len          = packet->GetSize();
 
+		CapturePacket(RTC::PacketCapture::Direction::OUT, data, len);
+
+		uv_buf_t buffer = uv_buf_init(reinterpret_cast<char*>(const_cast<uint8_t*>(data)), len);
+
 		if (this->rtcpMux)
-			this->tuple->Send(data, len);
+			Send(&buffer, 1);
 		else if (this->rtcpTuple)
 			this->rtcpTuple->Send(data, len);
 	}
 
+	inline void PlainRtpTransport::Send(const uv_buf_t* buffers, size_t count)
+	{
+		MS_TRACE();
+
+		if (this->destinations.empty())
+		{
+			this->tuple->Send(buffers, count);
+
+			return;
+		}
+
+		// The datagram is sent to the tuple and to every destination at once.
+		const struct sockaddr* addrs[MaxDestinations + 1];
+		bool sent[MaxDestinations + 1];
+		size_t addrCount{ 0 };
+		size_t len{ 0 };
+
+		addrs[addrCount++] = this->tuple->GetRemoteAddress();
+
+		for (auto& destination : this->destinations)
+		{
+			addrs[addrCount++] = reinterpret_cast<const struct sockaddr*>(&destination.addrStorage);
+		}
+
+		for (size_t i{ 0 }; i < count; ++i)
+		{
+			len += buffers[i].len;
+		}
+
+		this->udpSocket->Send(buffers, count, addrs, addrCount, sent);
+
+		for (size_t i{ 1 }; i < addrCount; ++i)
+		{
+			if (!sent[i])
+				continue;
+
+			auto& destination = this->destinations[i - 1];
+
+			destination.packetsSent++;
+			destination.bytesSent += len;
+		}
+	}
+
+	inline PlainRtpTransport::Destination* PlainRtpTransport::GetDestination(
+	  const struct sockaddr* addr)
+	{
+		MS_TRACE();
+
+		for (auto& destination : this->destinations)
+		{
+			auto* destinationAddr = reinterpret_cast<const struct sockaddr*>(&destination.addrStorage);
+
+			if (Utils::IP::CompareAddresses(destinationAddr, addr))
+				return std::addressof(destination);
+		}
+
+		return nullptr;
+	}
+
+	void PlainRtpTransport::FillJsonDestinations(json& jsonArray) const
+	{
+		MS_TRACE();
+
+		jsonArray = json::array();
+
+		for (auto& destination : this->destinations)
+		{
+			jsonArray.emplace_back(json::value_t::object);
+			auto& jsonObject = jsonArray[jsonArray.size() - 1];
+
+			jsonObject["ip"]                  = destination.ip;
+			jsonObject["port"]                = destination.port;
+			jsonObject["packetsSent"]         = destination.packetsSent;
+			jsonObject["bytesSent"]           = destination.bytesSent;
+			jsonObject["rtcpPacketsReceived"] = destination.rtcpPacketsReceived;
+		}
+	}
+
 	inline void PlainRtpTransport::OnPacketRecv(RTC::TransportTuple* tuple, const uint8_t* data, size_t len)
 	{
 		MS_TRACE();
@@ -524,9 +770,9 @@ namespace RTC
 				if (!this->listenIp.announcedIp.empty())
 					this->tuple->SetLocalAnnouncedIp(this->listenIp.announcedIp);
 
-				// If not yet connected do it now.
-				if (!IsConnected())
-					RTC::Transport::Connected();
+				// Now we are connected. Note that IsConnected() already returns true
+				// since the tuple is set.
+				RTC::Transport::Connected();
 			}
 
 			// Verify that the packet's tuple matches our RTP tuple.
@@ -538,6 +784,8 @@ namespace RTC
 			}
 		}
 
+		CapturePacket(RTC::PacketCapture::Direction::IN, data, len);
+
 		RTC::RtpPacket* packet = RTC::RtpPacket::Parse(data, len);
 
 		if (packet == nullptr)
@@ -586,6 +834,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		Destination* destination{ nullptr };
+
 		// If multiSource is set allow it without any checking.
 		if (this->multiSource)
 		{
@@ -612,9 +862,9 @@ namespace RTC
 				if (!this->listenIp.announcedIp.empty())
 					this->tuple->SetLocalAnnouncedIp(this->listenIp.announcedIp);
 
-				// If not yet connected do it now.
-				if (!IsConnected())
-					RTC::Transport::Connected();
+				// Now we are connected. Note that IsConnected() already returns true
+				// since the tuple is set.
+				RTC::Transport::Connected();
 			}
 			// If no RTCP-mux and RTCP tuple is unset, set it if we are in comedia mode.
 			else if (!this->rtcpMux && !this->rtcpTuple)
@@ -634,12 +884,20 @@ namespace RTC
 					this->rtcpTuple->SetLocalAnnouncedIp(this->listenIp.announcedIp);
 			}
 
-			// If RTCP-mux verify that the packet's tuple matches our RTP tuple.
+			// If RTCP-mux verify that the packet's tuple matches our RTP tuple or
+			// one of the destinations.
 			if (this->rtcpMux && !this->tuple->Compare(tuple))
 			{
-				MS_DEBUG_TAG(rtcp, "ignoring RTCP packet from unknown IP:port");
+				destination = GetDestination(tuple->GetRemoteAddress());
 
-				return;
+				if (destination == nullptr)
+				{
+					MS_DEBUG_TAG(rtcp, "ignoring RTCP packet from unknown IP:port");
+
+					return;
+				}
+
+				destination->rtcpPacketsReceived++;
 			}
 			// If no RTCP-mux verify that the packet's tuple matches our RTCP tuple.
 			else if (!this->rtcpMux && !this->rtcpTuple->Compare(tuple))
@@ -650,6 +908,8 @@ namespace RTC
 			}
 		}
 
+		CapturePacket(RTC::PacketCapture::Direction::IN, data, len);
+
 		RTC::RTCP::Packet* packet = RTC::RTCP::Packet::Parse(data, len);
 
 		if (packet == nullptr)
@@ -659,10 +919,13 @@ namespace RTC
 			return;
 		}
 
-		// Handle each RTCP packet.
+		// Handle each RTCP packet. Feedback from destinations is aggregated with
+		// the one from the tuple, but their Receiver Reports are ignored so they
+		// do not mix up the stats and score of the Consumers.
 		while (packet != nullptr)
 		{
-			ReceiveRtcpPacket(packet);
+			if (destination == nullptr || packet->GetType() != RTC::RTCP::Type::RR)
+				ReceiveRtcpPacket(packet);
 
 			RTC::RTCP::Packet* previousPacket = packet;
 
@@ -672,7 +935,11 @@ namespace RTC
 	}
 
 	inline void PlainRtpTransport::OnPacketRecv(
-	  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr)
+	  RTC::UdpSocket* socket,
+	  const uint8_t* data,
+	  size_t len,
+	  const struct sockaddr* remoteAddr,
+	  uint64_t /*arrivalTime*/)
 	{
 		MS_TRACE();
 
@@ -0,0 +1,55 @@
+#define MS_CLASS "RTC::ProbationPacer"
+// #define MS_LOG_DEV
+
+#include "RTC/ProbationPacer.hpp"
+#include "Logger.hpp"
+#include "RTC/RtpPacket.hpp" // RTC::MtuSize
+
+namespace RTC
+{
+	/* Static. */
+
+	// Do not accumulate more credit than this.
+	static constexpr uint64_t MaxCredit{ 2 * RTC::MtuSize };
+
+	/* Instance methods. */
+
+	void ProbationPacer::SetBitrate(uint32_t bitrate)
+	{
+		MS_TRACE();
+
+		this->bitrate = bitrate;
+
+		if (this->bitrate == 0u)
+			this->credit = 0u;
+	}
+
+	void ProbationPacer::AddMediaPacket(size_t size, uint32_t mediaBitrate, uint64_t now)
+	{
+		MS_TRACE();
+
+		// Start a new probation.
+		if (now - this->startedAt >= Interval)
+		{
+			this->startedAt = now;
+			this->credit    = 0u;
+		}
+		// Probation already finished.
+		else if (now - this->startedAt >= Duration)
+		{
+			this->credit = 0u;
+
+			return;
+		}
+
+		if (mediaBitrate == 0u || this->bitrate == 0u)
+			return;
+
+		// Send probation bytes in proportion to the sent media bytes so the
+		// outgoing bitrate matches the probed one.
+		this->credit += uint64_t{ size } * this->bitrate / mediaBitrate;
+
+		if (this->credit > MaxCredit)
+			this->credit = MaxCredit;
+	}
+} // namespace RTC
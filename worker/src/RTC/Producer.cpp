@@ -363,6 +363,20 @@ namespace RTC
 		}
 	}
 
+	void Producer::WriteStats(RTC::StatsWriter& writer) const
+	{
+		MS_TRACE();
+
+		for (auto& kv : this->mapSsrcRtpStream)
+		{
+			auto* rtpStream = kv.second;
+
+			writer.BeginRow(this->id);
+			rtpStream->WriteStats(writer);
+			writer.EndRow();
+		}
+	}
+
 	void Producer::HandleRequest(Channel::Request* request)
 	{
 		MS_TRACE();
@@ -0,0 +1,179 @@
+#define MS_CLASS "RTC::RedEncoder"
+// #define MS_LOG_DEV
+
+#include "RTC/RedEncoder.hpp"
+#include "Logger.hpp"
+#include "Utils.hpp"
+#include <cstring> // std::memcpy(), std::memmove()
+
+namespace RTC
+{
+	/* Instance methods. */
+
+	RedEncoder::RedEncoder(uint8_t payloadType) : payloadType(payloadType)
+	{
+		MS_TRACE();
+	}
+
+	RedEncoder::~RedEncoder()
+	{
+		MS_TRACE();
+
+		delete this->redPacket;
+	}
+
+	void RedEncoder::FillJson(json& jsonObject) const
+	{
+		MS_TRACE();
+
+		jsonObject["payloadType"] = this->payloadType;
+		jsonObject["distance"]    = this->distance;
+		jsonObject["packetsSent"] = this->packetsSent;
+	}
+
+	void RedEncoder::SetFractionLost(uint8_t fractionLost)
+	{
+		MS_TRACE();
+
+		size_t distance;
+
+		// fractionLost is given in 1/256 units.
+		if (fractionLost < 5) // < 2%.
+			distance = 0;
+		else if (fractionLost < 26) // < 10%.
+			distance = 1;
+		else
+			distance = 2;
+
+		if (distance == this->distance)
+			return;
+
+		MS_DEBUG_TAG(
+		  rtp,
+		  "RED distance changed [fractionLost:%" PRIu8 ", distance:%zu]",
+		  fractionLost,
+		  distance);
+
+		this->distance = distance;
+	}
+
+	const RTC::RtpPacket* RedEncoder::Encode(const RTC::RtpPacketOverlay& overlay)
+	{
+		MS_TRACE();
+
+		auto* packet = overlay.GetPacket();
+		size_t size  = overlay.GetSize();
+
+		// Padding would end up in the middle of the RED payload.
+		if (packet->GetPayloadPadding() != 0u || size > sizeof(this->buffer))
+			return nullptr;
+
+		size_t headerLength  = packet->GetPayload() - packet->GetData();
+		size_t payloadLength = packet->GetPayloadLength();
+		uint32_t timestamp   = overlay.GetTimestamp();
+		uint8_t payloadType  = overlay.GetPayloadType();
+		uint8_t* payload     = this->buffer + headerLength;
+
+		overlay.Serialize(this->buffer);
+
+		if (this->distance == 0)
+		{
+			StoreBlock(timestamp, payloadType, payload, payloadLength);
+
+			return nullptr;
+		}
+
+		// Redundant blocks to be sent, oldest first.
+		const Block* blocks[MaxDistance];
+		size_t numBlocks{ 0 };
+		// The primary block header is 1 byte, the others 4 bytes.
+		size_t redHeaderLength{ 1 };
+		size_t redundantLength{ 0 };
+
+		for (size_t i{ this->distance }; i > 0; --i)
+		{
+			size_t idx      = (this->lastBlockIdx + MaxDistance + 1 - i) % MaxDistance;
+			auto& block     = this->blocks[idx];
+			uint32_t offset = timestamp - block.timestamp;
+
+			if (block.length == 0 || offset == 0 || offset > MaxTimestampOffset)
+				continue;
+
+			size_t redSize = size + redHeaderLength + redundantLength + 4 + block.length;
+
+			if (redSize > sizeof(this->buffer))
+				continue;
+
+			blocks[numBlocks++] = std::addressof(block);
+			redHeaderLength += 4;
+			redundantLength += block.length;
+		}
+
+		// Move the primary payload to the end.
+		std::memmove(payload + redHeaderLength + redundantLength, payload, payloadLength);
+
+		auto* redHeader = payload;
+		auto* blockData = payload + redHeaderLength;
+
+		for (size_t i{ 0 }; i < numBlocks; ++i)
+		{
+			auto* block     = blocks[i];
+			uint32_t offset = timestamp - block->timestamp;
+			uint32_t length = static_cast<uint32_t>(block->length);
+
+			// F bit, block payload type, timestamp offset and block length.
+			redHeader[0] = 0x80 | block->payloadType;
+			Utils::Byte::Set3Bytes(redHeader, 1, (offset << 10) | length);
+			redHeader += 4;
+
+			std::memcpy(blockData, block->data, block->length);
+			blockData += block->length;
+		}
+
+		// Primary block header.
+		redHeader[0] = payloadType & 0x7F;
+
+		// Set the RED payload type keeping the marker bit.
+		this->buffer[1] = (this->buffer[1] & 0x80) | (this->payloadType & 0x7F);
+
+		delete this->redPacket;
+
+		this->redPacket =
+		  RTC::RtpPacket::Parse(this->buffer, size + redHeaderLength + redundantLength);
+
+		StoreBlock(timestamp, payloadType, blockData, payloadLength);
+
+		if (!this->redPacket)
+			return nullptr;
+
+		this->packetsSent++;
+
+		return this->redPacket;
+	}
+
+	void RedEncoder::StoreBlock(
+	  uint32_t timestamp, uint8_t payloadType, const uint8_t* data, size_t length)
+	{
+		MS_TRACE();
+
+		// Replace the oldest block.
+		this->lastBlockIdx = (this->lastBlockIdx + 1) % MaxDistance;
+
+		auto& block = this->blocks[this->lastBlockIdx];
+
+		block.timestamp   = timestamp;
+		block.payloadType = payloadType;
+
+		// Too big to be carried as a redundant block.
+		if (length > MaxBlockLength)
+		{
+			block.length = 0;
+
+			return;
+		}
+
+		block.length = length;
+
+		std::memcpy(block.data, data, length);
+	}
+} // namespace RTC
@@ -0,0 +1,49 @@
+#define MS_CLASS "RTC::RetransmissionBudget"
+// #define MS_LOG_DEV
+
+#include "RTC/RetransmissionBudget.hpp"
+#include "Logger.hpp"
+
+namespace RTC
+{
+	/* Instance methods. */
+
+	void RetransmissionBudget::Update(uint32_t mediaBitrate, uint64_t now)
+	{
+		MS_TRACE();
+
+		auto bitrate = static_cast<uint64_t>(mediaBitrate * MediaBitrateFactor);
+
+		if (bitrate < MinBitrate)
+			bitrate = MinBitrate;
+
+		uint64_t maxBytes = bitrate * Window / 8000;
+
+		// First update, start with the bucket full.
+		if (this->updatedAt == 0u)
+			this->availableBytes = maxBytes;
+		else
+			this->availableBytes += (now - this->updatedAt) * bitrate / 8000;
+
+		if (this->availableBytes > maxBytes)
+			this->availableBytes = maxBytes;
+
+		this->updatedAt = now;
+	}
+
+	bool RetransmissionBudget::Consume(size_t size)
+	{
+		MS_TRACE();
+
+		if (size > this->availableBytes)
+		{
+			this->droppedPackets++;
+
+			return false;
+		}
+
+		this->availableBytes -= size;
+
+		return true;
+	}
+} // namespace RTC
@@ -2,16 +2,25 @@
 // #define MS_LOG_DEV
 
 #include "RTC/Router.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
+#include "Channel/Notifier.hpp"
 #include "RTC/AudioLevelObserver.hpp"
+#include "RTC/FileTransport.hpp"
 #include "RTC/PipeTransport.hpp"
 #include "RTC/PlainRtpTransport.hpp"
+#include "RTC/StatsWriter.hpp"
 #include "RTC/WebRtcTransport.hpp"
 
 namespace RTC
 {
+	/* Static. */
+
+	static constexpr uint32_t MinStatsInterval{ 100 };    // In ms.
+	static constexpr uint32_t MaxStatsInterval{ 60000 };  // In ms.
+
 	/* Instance methods. */
 
 	Router::Router(const std::string& id) : id(id)
@@ -32,6 +41,8 @@ namespace RTC
 		}
 		this->mapTransports.clear();
 
+		delete this->statsTimer;
+
 		// Close all RtpObservers.
 		for (auto& kv : this->mapRtpObservers)
 		{
@@ -44,86 +55,233 @@ namespace RTC
 		// Clear other maps.
 		this->mapProducerConsumers.clear();
 		this->mapConsumerProducer.clear();
+		this->mapConsumers.clear();
+		this->mapProducerRtpFanOut.clear();
 		this->mapProducerRtpObservers.clear();
 		this->mapProducers.clear();
 	}
 
-	void Router::FillJson(json& jsonObject) const
+	void Router::FillJson(std::string& buffer, Channel::DumpPager& pager) const
 	{
 		MS_TRACE();
 
 		// Add id.
-		jsonObject["id"] = this->id;
+		buffer.append("{\"id\":");
+		Utils::Json::AppendString(buffer, this->id);
 
 		// Add transportIds.
-		jsonObject["transportIds"] = json::array();
-		auto jsonTransportIdsIt    = jsonObject.find("transportIds");
+		buffer.append(",\"transportIds\":[");
 
-		for (auto& kv : this->mapTransports)
+		for (auto it = pager.Begin(DumpSection::TRANSPORTS, this->mapTransports);
+		     it != this->mapTransports.end();
+		     ++it)
 		{
-			auto& transportId = kv.first;
+			if (!pager.Add(DumpSection::TRANSPORTS, it->first, buffer.length()))
+				break;
+
+			if (buffer.back() != '[')
+				buffer.push_back(',');
 
-			jsonTransportIdsIt->emplace_back(transportId);
+			Utils::Json::AppendString(buffer, it->first);
 		}
 
 		// Add rtpObserverIds.
-		jsonObject["rtpObserverIds"] = json::array();
-		auto jsonRtpObserverIdsIt    = jsonObject.find("rtpObserverIds");
+		buffer.append("],\"rtpObserverIds\":[");
 
-		for (auto& kv : this->mapRtpObservers)
+		for (auto it = pager.Begin(DumpSection::RTP_OBSERVERS, this->mapRtpObservers);
+		     it != this->mapRtpObservers.end();
+		     ++it)
+		{
+			if (!pager.Add(DumpSection::RTP_OBSERVERS, it->first, buffer.length()))
+				break;
+
+			if (buffer.back() != '[')
+				buffer.push_back(',');
+
+			Utils::Json::AppendString(buffer, it->first);
+		}
+
+		buffer.push_back(']');
+
+		// Select the Producers and Consumers of this page. Consumer ids are listed
+		// under their Producer id (and the other way around) in the page in which
+		// the Consumer is selected, so the Consumers of a Producer may be spread
+		// across many pages.
+		std::vector<RTC::Producer*> producers;
+		std::unordered_map<RTC::Producer*, std::vector<RTC::Consumer*>> producerConsumers;
+		std::vector<RTC::Consumer*> consumers;
+		// Bytes to be written for the selected items.
+		size_t pageSize = buffer.length();
+
+		for (auto it = pager.Begin(DumpSection::PRODUCERS, this->mapProducers);
+		     it != this->mapProducers.end();
+		     ++it)
+		{
+			auto* producer = it->second;
+
+			if (!pager.Add(DumpSection::PRODUCERS, it->first, pageSize))
+				break;
+
+			producers.push_back(producer);
+			producerConsumers[producer];
+
+			pageSize += 2 * (it->first.length() + 6);
+
+			for (auto* rtpObserver : this->mapProducerRtpObservers.at(producer))
+			{
+				pageSize += rtpObserver->id.length() + 3;
+			}
+		}
+
+		size_t selectedProducers = producers.size();
+
+		for (auto it = pager.Begin(DumpSection::CONSUMERS, this->mapConsumers);
+		     it != this->mapConsumers.end();
+		     ++it)
 		{
-			auto& rtpObserverId = kv.first;
+			auto* consumer = it->second;
+			auto* producer = this->mapConsumerProducer.at(consumer);
+
+			if (!pager.Add(DumpSection::CONSUMERS, it->first, pageSize))
+				break;
+
+			consumers.push_back(consumer);
+
+			if (producerConsumers.find(producer) == producerConsumers.end())
+			{
+				producers.push_back(producer);
+
+				pageSize += producer->id.length() + 6;
+			}
+
+			producerConsumers[producer].push_back(consumer);
 
-			jsonRtpObserverIdsIt->emplace_back(rtpObserverId);
+			pageSize += 2 * it->first.length() + producer->id.length() + 9;
 		}
 
 		// Add mapProducerIdConsumerIds.
-		jsonObject["mapProducerIdConsumerIds"] = json::object();
-		auto jsonMapProducerConsumersIt        = jsonObject.find("mapProducerIdConsumerIds");
+		buffer.append(",\"mapProducerIdConsumerIds\":{");
 
-		for (auto& kv : this->mapProducerConsumers)
+		for (auto* producer : producers)
 		{
-			auto* producer  = kv.first;
-			auto& consumers = kv.second;
+			if (buffer.back() != '{')
+				buffer.push_back(',');
 
-			(*jsonMapProducerConsumersIt)[producer->id] = json::array();
-			auto jsonProducerIdIt                       = jsonMapProducerConsumersIt->find(producer->id);
+			Utils::Json::AppendString(buffer, producer->id);
+			buffer.append(":[");
 
-			for (auto* consumer : consumers)
+			for (auto* consumer : producerConsumers.at(producer))
 			{
-				jsonProducerIdIt->emplace_back(consumer->id);
+				if (buffer.back() != '[')
+					buffer.push_back(',');
+
+				Utils::Json::AppendString(buffer, consumer->id);
 			}
+
+			buffer.push_back(']');
 		}
 
 		// Add mapConsumerIdProducerId.
-		jsonObject["mapConsumerIdProducerId"] = json::object();
-		auto jsonMapConsumerProducerIt        = jsonObject.find("mapConsumerIdProducerId");
+		buffer.append("},\"mapConsumerIdProducerId\":{");
 
-		for (auto& kv : this->mapConsumerProducer)
+		for (auto* consumer : consumers)
 		{
-			auto* consumer = kv.first;
-			auto* producer = kv.second;
+			if (buffer.back() != '{')
+				buffer.push_back(',');
 
-			(*jsonMapConsumerProducerIt)[consumer->id] = producer->id;
+			Utils::Json::AppendString(buffer, consumer->id);
+			buffer.push_back(':');
+			Utils::Json::AppendString(buffer, this->mapConsumerProducer.at(consumer)->id);
 		}
 
-		// Add mapProducerIdObserverIds.
-		jsonObject["mapProducerIdObserverIds"] = json::object();
-		auto jsonMapProducerRtpObserversIt     = jsonObject.find("mapProducerIdObserverIds");
+		// Add mapProducerIdObserverIds (just for the Producers selected above).
+		buffer.append("},\"mapProducerIdObserverIds\":{");
 
-		for (auto& kv : this->mapProducerRtpObservers)
+		for (size_t idx{ 0 }; idx < selectedProducers; ++idx)
 		{
-			auto* producer     = kv.first;
-			auto& rtpObservers = kv.second;
+			auto* producer = producers[idx];
 
-			(*jsonMapProducerRtpObserversIt)[producer->id] = json::array();
-			auto jsonProducerIdIt = jsonMapProducerRtpObserversIt->find(producer->id);
+			if (buffer.back() != '{')
+				buffer.push_back(',');
 
-			for (auto* rtpObserver : rtpObservers)
+			Utils::Json::AppendString(buffer, producer->id);
+			buffer.append(":[");
+
+			for (auto* rtpObserver : this->mapProducerRtpObservers.at(producer))
 			{
-				jsonProducerIdIt->emplace_back(rtpObserver->id);
+				if (buffer.back() != '[')
+					buffer.push_back(',');
+
+				Utils::Json::AppendString(buffer, rtpObserver->id);
 			}
+
+			buffer.push_back(']');
+		}
+
+		buffer.push_back('}');
+
+		// Add nextCursor.
+		if (pager.IsPaginated())
+		{
+			buffer.push_back(',');
+			pager.AppendNextCursor(buffer);
+		}
+
+		buffer.push_back('}');
+	}
+
+	void Router::FillStats(RTC::StatsWriter& writer, Channel::DumpPager& pager) const
+	{
+		MS_TRACE();
+
+		// Tables are the sections of a paginated request.
+		auto section = static_cast<uint8_t>(RTC::StatsWriter::Table::TRANSPORTS);
+
+		writer.BeginTable(RTC::StatsWriter::Table::TRANSPORTS);
+
+		for (auto it = pager.Begin(section, this->mapTransports); it != this->mapTransports.end(); ++it)
+		{
+			auto* transport = it->second;
+
+			if (!pager.Add(section, it->first, writer.GetSize()))
+				break;
+
+			transport->WriteStats(writer);
+		}
+
+		writer.EndTable();
+
+		section = static_cast<uint8_t>(RTC::StatsWriter::Table::PRODUCERS);
+
+		writer.BeginTable(RTC::StatsWriter::Table::PRODUCERS);
+
+		for (auto it = pager.Begin(section, this->mapProducers); it != this->mapProducers.end(); ++it)
+		{
+			auto* producer = it->second;
+
+			if (!pager.Add(section, it->first, writer.GetSize()))
+				break;
+
+			producer->WriteStats(writer);
+		}
+
+		writer.EndTable();
+
+		section = static_cast<uint8_t>(RTC::StatsWriter::Table::CONSUMERS);
+
+		writer.BeginTable(RTC::StatsWriter::Table::CONSUMERS);
+
+		for (auto it = pager.Begin(section, this->mapConsumers); it != this->mapConsumers.end(); ++it)
+		{
+			auto* consumer = it->second;
+
+			if (!pager.Add(section, it->first, writer.GetSize()))
+				break;
+
+			consumer->WriteStats(writer);
 		}
+
+		writer.EndTable();
 	}
 
 	void Router::HandleRequest(Channel::Request* request)
@@ -134,15 +292,59 @@ namespace RTC
 		{
 			case Channel::Request::MethodId::ROUTER_DUMP:
 			{
-				json data(json::object());
+				// This may throw.
+				Channel::DumpPager pager(request->data);
+				std::string data;
+
+				FillJson(data, pager);
+
+				request->Accept(data);
+
+				break;
+			}
+
+			case Channel::Request::MethodId::ROUTER_GET_STATS:
+			{
+				// This may throw.
+				uint32_t fieldMask = RTC::StatsWriter::GetFieldMask(request->data);
+				Channel::DumpPager pager(request->data);
+				RTC::StatsWriter writer(fieldMask, DepLibUV::GetTime());
+
+				FillStats(writer, pager);
 
-				FillJson(data);
+				auto& stats = writer.Close();
+
+				if (!pager.IsPaginated())
+				{
+					request->Accept(stats);
+
+					break;
+				}
+
+				// Add nextCursor into the stats object.
+				std::string data;
+
+				data.reserve(stats.length() + 64);
+				data.append(stats, 0, stats.length() - 1);
+				data.push_back(',');
+				pager.AppendNextCursor(data);
+				data.push_back('}');
 
 				request->Accept(data);
 
 				break;
 			}
 
+			case Channel::Request::MethodId::ROUTER_SET_STATS_INTERVAL:
+			{
+				// This may throw.
+				SetStatsInterval(request);
+
+				request->Accept();
+
+				break;
+			}
+
 			case Channel::Request::MethodId::ROUTER_CREATE_WEBRTC_TRANSPORT:
 			{
 				std::string transportId;
@@ -213,6 +415,29 @@ namespace RTC
 				break;
 			}
 
+			case Channel::Request::MethodId::ROUTER_CREATE_FILE_TRANSPORT:
+			{
+				std::string transportId;
+
+				// This may throw
+				SetNewTransportIdFromRequest(request, transportId);
+
+				auto* fileTransport = new RTC::FileTransport(transportId, this, request->data);
+
+				// Insert into the map.
+				this->mapTransports[transportId] = fileTransport;
+
+				MS_DEBUG_DEV("FileTransport created [transportId:%s]", transportId.c_str());
+
+				json data(json::object());
+
+				fileTransport->FillJson(data);
+
+				request->Accept(data);
+
+				break;
+			}
+
 			case Channel::Request::MethodId::ROUTER_CREATE_AUDIO_LEVEL_OBSERVER:
 			{
 				std::string rtpObserverId;
@@ -436,6 +661,47 @@ namespace RTC
 		return producer;
 	}
 
+	void Router::SetStatsInterval(Channel::Request* request)
+	{
+		MS_TRACE();
+
+		auto jsonIntervalIt = request->data.find("interval");
+
+		if (jsonIntervalIt == request->data.end() || !jsonIntervalIt->is_number_unsigned())
+			MS_THROW_TYPE_ERROR("missing interval");
+
+		auto interval = jsonIntervalIt->get<uint32_t>();
+
+		// This may throw.
+		auto fieldMask = RTC::StatsWriter::GetFieldMask(request->data);
+
+		// Zero interval disables stats events.
+		if (interval == 0)
+		{
+			if (this->statsTimer)
+				this->statsTimer->Stop();
+
+			this->statsSnapshot.Clear();
+
+			return;
+		}
+
+		if (interval < MinStatsInterval)
+			interval = MinStatsInterval;
+		else if (interval > MaxStatsInterval)
+			interval = MaxStatsInterval;
+
+		if (!this->statsTimer)
+			this->statsTimer = new Timer(this);
+
+		this->statsFieldMask = fieldMask;
+
+		// Next event will contain all the values.
+		this->statsSnapshot.Clear();
+
+		this->statsTimer->Start(interval, interval);
+	}
+
 	inline void Router::OnTransportNewProducer(RTC::Transport* /*transport*/, RTC::Producer* producer)
 	{
 		MS_TRACE();
@@ -452,6 +718,7 @@ namespace RTC
 		// Insert the Producer in the maps.
 		this->mapProducers[producer->id] = producer;
 		this->mapProducerConsumers[producer];
+		this->mapProducerRtpFanOut[producer];
 		this->mapProducerRtpObservers[producer];
 	}
 
@@ -497,6 +764,7 @@ namespace RTC
 		// Remove the Producer from the maps.
 		this->mapProducers.erase(mapProducersIt);
 		this->mapProducerConsumers.erase(mapProducerConsumersIt);
+		this->mapProducerRtpFanOut.erase(producer);
 		this->mapProducerRtpObservers.erase(mapProducerRtpObserversIt);
 	}
 
@@ -579,12 +847,8 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		auto& consumers = this->mapProducerConsumers.at(producer);
-
-		for (auto* consumer : consumers)
-		{
-			consumer->SendRtpPacket(packet);
-		}
+		// Just Consumers that need the stream of the packet get it.
+		this->mapProducerRtpFanOut.at(producer).SendRtpPacket(packet);
 
 		auto it = this->mapProducerRtpObservers.find(producer);
 
@@ -635,6 +899,11 @@ namespace RTC
 		  this->mapConsumerProducer.find(consumer) == this->mapConsumerProducer.end(),
 		  "Consumer already present in mapConsumerProducer");
 
+		if (this->mapConsumers.find(consumer->id) != this->mapConsumers.end())
+		{
+			MS_THROW_ERROR("Consumer already present in mapConsumers [consumerId:%s]", consumer->id.c_str());
+		}
+
 		// Update the Consumer status based on the Producer status.
 		if (producer->IsPaused())
 			consumer->ProducerPaused();
@@ -644,6 +913,8 @@ namespace RTC
 
 		consumers.insert(consumer);
 		this->mapConsumerProducer[consumer] = producer;
+		this->mapConsumers[consumer->id]    = consumer;
+		this->mapProducerRtpFanOut.at(producer).AddConsumer(consumer);
 
 		// Get all streams in the Producer and provide the Consumer with them.
 		// NOTE: This must be done at the end. Otherwise, if consumer->ProducerNewRtpStream()
@@ -684,9 +955,11 @@ namespace RTC
 		auto& consumers = this->mapProducerConsumers.at(producer);
 
 		consumers.erase(consumer);
+		this->mapProducerRtpFanOut.at(producer).RemoveConsumer(consumer);
 
-		// Remove the Consumer from the map.
+		// Remove the Consumer from the maps.
 		this->mapConsumerProducer.erase(mapConsumerProducerIt);
+		this->mapConsumers.erase(consumer->id);
 	}
 
 	inline void Router::OnTransportConsumerProducerClosed(
@@ -705,8 +978,9 @@ namespace RTC
 		  mapConsumerProducerIt != this->mapConsumerProducer.end(),
 		  "Consumer not present in mapConsumerProducer");
 
-		// Remove the Consumer from the map.
+		// Remove the Consumer from the maps.
 		this->mapConsumerProducer.erase(mapConsumerProducerIt);
+		this->mapConsumers.erase(consumer->id);
 	}
 
 	inline void Router::OnTransportConsumerKeyFrameRequested(
@@ -718,4 +992,44 @@ namespace RTC
 
 		producer->RequestKeyFrame(mappedSsrc);
 	}
+
+	inline void Router::OnTransportConsumerSubscriptionChanged(
+	  RTC::Transport* /*transport*/, RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		auto mapConsumerProducerIt = this->mapConsumerProducer.find(consumer);
+
+		// The Consumer may not be in the maps yet (or anymore).
+		if (mapConsumerProducerIt == this->mapConsumerProducer.end())
+			return;
+
+		auto* producer = mapConsumerProducerIt->second;
+		auto it        = this->mapProducerRtpFanOut.find(producer);
+
+		if (it != this->mapProducerRtpFanOut.end())
+			it->second.UpdateConsumer(consumer);
+	}
+
+	inline void Router::OnStatsWriterChunk(RTC::StatsWriter* /*writer*/, const std::string& chunk)
+	{
+		MS_TRACE();
+
+		Channel::Notifier::Emit(this->id, "stats", chunk);
+	}
+
+	inline void Router::OnTimer(Timer* /*timer*/)
+	{
+		MS_TRACE();
+
+		Channel::DumpPager pager;
+		// Chunks are emitted as they are completed, so the snapshot never gets
+		// ahead of what was sent. Nothing is emitted if nothing changed.
+		RTC::StatsWriter writer(
+		  this->statsFieldMask, DepLibUV::GetTime(), &this->statsSnapshot, this);
+
+		FillStats(writer, pager);
+
+		writer.Close();
+	}
 } // namespace RTC
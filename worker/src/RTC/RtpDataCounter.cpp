@@ -12,17 +12,17 @@ namespace RTC
 		MS_TRACE();
 
 		// Ignore too old data. Should never happen.
-		if (now < this->oldestTime)
+		if (now / this->itemSize < this->oldestTime)
 			return;
 
 		RemoveOldData(now);
 
 		// Set data in the index before the oldest index.
-		uint32_t offset = this->windowSize - 1;
+		uint32_t offset = this->windowItems - 1;
 		uint32_t index  = this->oldestIndex + offset;
 
-		if (index >= this->windowSize)
-			index -= this->windowSize;
+		if (index >= this->windowItems)
+			index -= this->windowItems;
 
 		this->buffer[index].count += size;
 		this->totalCount += size;
@@ -34,7 +34,9 @@ namespace RTC
 
 		RemoveOldData(now);
 
-		float scale = this->scale / this->windowSize;
+		// The newest item is only partially elapsed.
+		size_t coveredTime = this->windowSize - this->itemSize + (now % this->itemSize) + 1;
+		float scale        = this->scale / coveredTime;
 
 		return static_cast<uint32_t>(std::trunc(this->totalCount * scale + 0.5f));
 	}
@@ -43,7 +45,7 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		uint64_t newOldestTime = now - this->windowSize;
+		uint64_t newOldestTime = now / this->itemSize - this->windowItems;
 
 		// Should never happen.
 		if (newOldestTime < this->oldestTime)
@@ -55,12 +57,12 @@ namespace RTC
 			return;
 		}
 
-		// We are in the same time unit (ms) as the last entry.
+		// We are in the same time unit (item) as the last entry.
 		if (newOldestTime == this->oldestTime)
 			return;
 
 		// A whole window size time has elapsed since last entry. Reset the buffer.
-		if (newOldestTime > this->oldestTime + this->windowSize)
+		if (newOldestTime > this->oldestTime + this->windowItems)
 		{
 			Reset(now);
 
@@ -74,7 +76,7 @@ namespace RTC
 			this->totalCount -= oldestItem.count;
 			this->buffer[this->oldestIndex] = BufferItem();
 
-			if (++this->oldestIndex >= this->windowSize)
+			if (++this->oldestIndex >= this->windowItems)
 				this->oldestIndex = 0;
 
 			++this->oldestTime;
@@ -83,12 +85,12 @@ namespace RTC
 		this->oldestTime = newOldestTime;
 	}
 
-	void RtpDataCounter::Update(RTC::RtpPacket* packet)
+	void RtpDataCounter::Update(size_t size)
 	{
 		uint64_t now = DepLibUV::GetTime();
 
 		this->packets++;
-		this->bytes += packet->GetSize();
-		this->rate.Update(packet->GetSize(), now);
+		this->bytes += size;
+		this->rate.Update(size, now);
 	}
 } // namespace RTC
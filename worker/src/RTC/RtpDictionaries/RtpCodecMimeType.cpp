@@ -45,7 +45,8 @@ namespace RTC
 		{ "ulpfec",          RtpCodecMimeType::Subtype::ULPFEC          },
 		{ "flexfec",         RtpCodecMimeType::Subtype::FLEXFEC         },
 		{ "x-ulpfecuc",      RtpCodecMimeType::Subtype::X_ULPFECUC      },
-		{ "red",             RtpCodecMimeType::Subtype::RED             }
+		{ "red",             RtpCodecMimeType::Subtype::RED             },
+		{ "flexfec-03",      RtpCodecMimeType::Subtype::FLEXFEC_03      }
 	};
 	std::map<RtpCodecMimeType::Subtype, std::string> RtpCodecMimeType::subtype2String =
 	{
@@ -71,7 +72,8 @@ namespace RTC
 		{ RtpCodecMimeType::Subtype::ULPFEC,          "ulpfec"          },
 		{ RtpCodecMimeType::Subtype::FLEXFEC,         "flexfec"         },
 		{ RtpCodecMimeType::Subtype::X_ULPFECUC,      "x-ulpfecuc"      },
-		{ RtpCodecMimeType::Subtype::RED,             "red"             }
+		{ RtpCodecMimeType::Subtype::RED,             "red"             },
+		{ RtpCodecMimeType::Subtype::FLEXFEC_03,      "flexfec-03"      }
 	};
 	// clang-format on
 
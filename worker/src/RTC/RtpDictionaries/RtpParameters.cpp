@@ -17,7 +17,8 @@ namespace RTC
 		{ "simple",    RtpParameters::Type::SIMPLE    },
 		{ "simulcast", RtpParameters::Type::SIMULCAST },
 		{ "svc",       RtpParameters::Type::SVC       },
-		{ "pipe",      RtpParameters::Type::PIPE      }
+		{ "pipe",      RtpParameters::Type::PIPE      },
+		{ "broadcast", RtpParameters::Type::BROADCAST }
 	};
 	std::map<RtpParameters::Type, std::string> RtpParameters::type2String =
 	{
@@ -25,7 +26,8 @@ namespace RTC
 		{ RtpParameters::Type::SIMPLE,    "simple"    },
 		{ RtpParameters::Type::SIMULCAST, "simulcast" },
 		{ RtpParameters::Type::SVC,       "svc"       },
-		{ RtpParameters::Type::PIPE,      "pipe"      }
+		{ RtpParameters::Type::PIPE,      "pipe"      },
+		{ RtpParameters::Type::BROADCAST, "broadcast" }
 	};
 	// clang-format on
 
@@ -220,7 +222,8 @@ namespace RTC
 			jsonObject["rtcp"] = json::object();
 	}
 
-	const RTC::RtpCodecParameters* RtpParameters::GetCodecForEncoding(RtpEncodingParameters& encoding) const
+	const RTC::RtpCodecParameters* RtpParameters::GetCodecForEncoding(
+	  const RtpEncodingParameters& encoding) const
 	{
 		MS_TRACE();
 
@@ -242,7 +245,8 @@ namespace RTC
 		return nullptr;
 	}
 
-	const RTC::RtpCodecParameters* RtpParameters::GetRtxCodecForEncoding(RtpEncodingParameters& encoding) const
+	const RTC::RtpCodecParameters* RtpParameters::GetRtxCodecForEncoding(
+	  const RtpEncodingParameters& encoding) const
 	{
 		MS_TRACE();
 
@@ -252,7 +256,9 @@ namespace RTC
 
 		for (const auto& codec : this->codecs)
 		{
-			if (codec.mimeType.IsFeatureCodec() && codec.parameters.GetInteger(AptString) == payloadType)
+			if (
+			  codec.mimeType.subtype == RTC::RtpCodecMimeType::Subtype::RTX &&
+			  codec.parameters.GetInteger(AptString) == payloadType)
 			{
 				return std::addressof(codec);
 			}
@@ -261,6 +267,32 @@ namespace RTC
 		return nullptr;
 	}
 
+	const RTC::RtpCodecParameters* RtpParameters::GetFecCodec() const
+	{
+		MS_TRACE();
+
+		for (const auto& codec : this->codecs)
+		{
+			if (codec.mimeType.subtype == RTC::RtpCodecMimeType::Subtype::FLEXFEC_03)
+				return std::addressof(codec);
+		}
+
+		return nullptr;
+	}
+
+	const RTC::RtpCodecParameters* RtpParameters::GetRedCodec() const
+	{
+		MS_TRACE();
+
+		for (const auto& codec : this->codecs)
+		{
+			if (codec.mimeType.subtype == RTC::RtpCodecMimeType::Subtype::RED)
+				return std::addressof(codec);
+		}
+
+		return nullptr;
+	}
+
 	void RtpParameters::ValidateCodecs()
 	{
 		MS_TRACE();
@@ -297,6 +329,8 @@ namespace RTC
 								MS_THROW_TYPE_ERROR("apt in RTX codec points to a ULPFEC codec");
 							else if (codec.mimeType.subtype == RTC::RtpCodecMimeType::Subtype::FLEXFEC)
 								MS_THROW_TYPE_ERROR("apt in RTX codec points to a FLEXFEC codec");
+							else if (codec.mimeType.subtype == RTC::RtpCodecMimeType::Subtype::FLEXFEC_03)
+								MS_THROW_TYPE_ERROR("apt in RTX codec points to a FLEXFEC codec");
 							else
 								break;
 						}
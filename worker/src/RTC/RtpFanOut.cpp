@@ -0,0 +1,162 @@
+#define MS_CLASS "RTC::RtpFanOut"
+// #define MS_LOG_DEV
+
+#include "RTC/RtpFanOut.hpp"
+#include "Logger.hpp"
+#include <algorithm> // std::find()
+
+namespace RTC
+{
+	/* Static. */
+
+	inline static void removeFromVector(std::vector<RTC::Consumer*>& consumers, RTC::Consumer* consumer)
+	{
+		auto it = std::find(consumers.begin(), consumers.end(), consumer);
+
+		if (it == consumers.end())
+			return;
+
+		// Order does not matter.
+		*it = consumers.back();
+		consumers.pop_back();
+	}
+
+	/* Instance methods. */
+
+	void RtpFanOut::AddConsumer(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		Subscribe(consumer);
+	}
+
+	void RtpFanOut::RemoveConsumer(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		Unsubscribe(consumer);
+
+		this->pendingUpdates.erase(
+		  std::remove(this->pendingUpdates.begin(), this->pendingUpdates.end(), consumer),
+		  this->pendingUpdates.end());
+	}
+
+	void RtpFanOut::UpdateConsumer(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		// Don't touch the vectors being iterated.
+		if (this->dispatching)
+		{
+			this->pendingUpdates.push_back(consumer);
+
+			return;
+		}
+
+		Unsubscribe(consumer);
+		Subscribe(consumer);
+	}
+
+	void RtpFanOut::SendRtpPacket(const RTC::RtpPacket* packet)
+	{
+		MS_TRACE();
+
+		this->dispatching = true;
+
+		for (auto* consumer : this->allStreamsConsumers)
+		{
+			consumer->SendRtpPacket(packet);
+		}
+
+		auto it = this->mapMappedSsrcConsumers.find(packet->GetSsrc());
+
+		if (it != this->mapMappedSsrcConsumers.end())
+		{
+			for (auto* consumer : it->second)
+			{
+				consumer->SendRtpPacket(packet);
+			}
+		}
+
+		this->dispatching = false;
+
+		if (this->pendingUpdates.empty())
+			return;
+
+		auto pendingUpdates = std::move(this->pendingUpdates);
+
+		this->pendingUpdates.clear();
+
+		for (auto* consumer : pendingUpdates)
+		{
+			UpdateConsumer(consumer);
+		}
+	}
+
+	size_t RtpFanOut::GetNumConsumers(uint32_t mappedSsrc) const
+	{
+		MS_TRACE();
+
+		size_t numConsumers = this->allStreamsConsumers.size();
+		auto it             = this->mapMappedSsrcConsumers.find(mappedSsrc);
+
+		if (it != this->mapMappedSsrcConsumers.end())
+			numConsumers += it->second.size();
+
+		return numConsumers;
+	}
+
+	void RtpFanOut::Subscribe(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		// Consumers whose Transport is not connected don't get packets at all.
+		if (!consumer->IsTransportConnected())
+			return;
+
+		std::vector<uint32_t> mappedSsrcs;
+
+		if (!consumer->GetSubscribedMappedSsrcs(mappedSsrcs))
+		{
+			this->allStreamsConsumers.push_back(consumer);
+
+			return;
+		}
+
+		for (auto mappedSsrc : mappedSsrcs)
+		{
+			this->mapMappedSsrcConsumers[mappedSsrc].push_back(consumer);
+		}
+
+		this->mapConsumerMappedSsrcs[consumer] = std::move(mappedSsrcs);
+	}
+
+	void RtpFanOut::Unsubscribe(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		auto it = this->mapConsumerMappedSsrcs.find(consumer);
+
+		if (it == this->mapConsumerMappedSsrcs.end())
+		{
+			removeFromVector(this->allStreamsConsumers, consumer);
+
+			return;
+		}
+
+		for (auto mappedSsrc : it->second)
+		{
+			auto mapMappedSsrcConsumersIt = this->mapMappedSsrcConsumers.find(mappedSsrc);
+
+			if (mapMappedSsrcConsumersIt == this->mapMappedSsrcConsumers.end())
+				continue;
+
+			removeFromVector(mapMappedSsrcConsumersIt->second, consumer);
+
+			if (mapMappedSsrcConsumersIt->second.empty())
+				this->mapMappedSsrcConsumers.erase(mapMappedSsrcConsumersIt);
+		}
+
+		this->mapConsumerMappedSsrcs.erase(it);
+	}
+} // namespace RTC
@@ -484,24 +484,14 @@ namespace RTC
 		return true;
 	}
 
-	bool RtpPacket::EncodePayload(RTC::Codecs::EncodingContext* context)
+	bool RtpPacket::EncodePayload(RTC::Codecs::EncodingContext* context, uint8_t* data) const
 	{
 		MS_TRACE();
 
 		if (!this->payloadDescriptorHandler)
 			return true;
 
-		return this->payloadDescriptorHandler->Encode(context, this->payload);
-	}
-
-	void RtpPacket::RestorePayload()
-	{
-		MS_TRACE();
-
-		if (!this->payloadDescriptorHandler)
-			return;
-
-		this->payloadDescriptorHandler->Restore(this->payload);
+		return this->payloadDescriptorHandler->Encode(context, data);
 	}
 
 	void RtpPacket::ShiftPayload(size_t payloadOffset, size_t shift, bool expand)
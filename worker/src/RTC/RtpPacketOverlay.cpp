@@ -0,0 +1,102 @@
+#define MS_CLASS "RTC::RtpPacketOverlay"
+// #define MS_LOG_DEV
+
+#include "RTC/RtpPacketOverlay.hpp"
+#include "Logger.hpp"
+#include <algorithm> // std::min()
+#include <cstring>   // std::memcpy()
+
+namespace RTC
+{
+	/* Instance methods. */
+
+	RtpPacketOverlay::RtpPacketOverlay(const RTC::RtpPacket* packet) : packet(packet)
+	{
+		MS_TRACE();
+
+		std::memcpy(std::addressof(this->header), packet->GetData(), sizeof(this->header));
+	}
+
+	bool RtpPacketOverlay::EncodePayload(RTC::Codecs::EncodingContext* context)
+	{
+		MS_TRACE();
+
+		this->payloadPrefixSize =
+		  std::min(this->packet->GetPayloadLength(), size_t{ MaxPayloadPrefixSize });
+
+		std::memcpy(this->payloadPrefix, this->packet->GetPayload(), this->payloadPrefixSize);
+
+		if (!this->packet->EncodePayload(context, this->payloadPrefix))
+		{
+			this->payloadPrefixSize = 0;
+
+			return false;
+		}
+
+		return true;
+	}
+
+	void RtpPacketOverlay::Serialize(uint8_t* buffer) const
+	{
+		MS_TRACE();
+
+		uv_buf_t buffers[MaxBuffers];
+		size_t count = FillBuffers(buffers);
+
+		for (size_t i{ 0 }; i < count; ++i)
+		{
+			std::memcpy(buffer, buffers[i].base, buffers[i].len);
+
+			buffer += buffers[i].len;
+		}
+	}
+
+	size_t RtpPacketOverlay::FillBuffers(uv_buf_t* buffers) const
+	{
+		MS_TRACE();
+
+		auto* data           = const_cast<uint8_t*>(this->packet->GetData());
+		size_t size          = this->packet->GetSize();
+		size_t payloadOffset = this->packet->GetPayload() - data;
+		size_t offset        = sizeof(this->header);
+		size_t count{ 0 };
+
+		buffers[count++] = uv_buf_init(
+		  reinterpret_cast<char*>(const_cast<RTC::RtpPacket::Header*>(std::addressof(this->header))),
+		  sizeof(this->header));
+
+		if (this->payloadPrefixSize != 0u)
+		{
+			// CSRCs and header extensions.
+			if (payloadOffset > offset)
+			{
+				buffers[count++] =
+				  uv_buf_init(reinterpret_cast<char*>(data + offset), payloadOffset - offset);
+			}
+
+			buffers[count++] = uv_buf_init(
+			  reinterpret_cast<char*>(const_cast<uint8_t*>(this->payloadPrefix)), this->payloadPrefixSize);
+
+			offset = payloadOffset + this->payloadPrefixSize;
+		}
+
+		if (size > offset)
+			buffers[count++] = uv_buf_init(reinterpret_cast<char*>(data + offset), size - offset);
+
+		return count;
+	}
+
+	RTC::RtpPacket* RtpPacketOverlay::Clone(const uint8_t* buffer) const
+	{
+		MS_TRACE();
+
+		auto* clonedPacket = this->packet->Clone(buffer);
+
+		std::memcpy(const_cast<uint8_t*>(buffer), std::addressof(this->header), sizeof(this->header));
+
+		if (this->payloadPrefixSize != 0u)
+			std::memcpy(clonedPacket->GetPayload(), this->payloadPrefix, this->payloadPrefixSize);
+
+		return clonedPacket;
+	}
+} // namespace RTC
@@ -76,11 +76,38 @@ namespace RTC
 			jsonObject["rtxSsrc"] = this->params.rtxSsrc;
 	}
 
+	void RtpStream::WriteStats(RTC::StatsWriter& writer)
+	{
+		MS_TRACE();
+
+		uint64_t now = writer.GetTimestamp();
+
+		// NOTE: Values must be added in the same order as declared in StatsWriter::Field.
+		writer.AddValue(RTC::StatsWriter::Field::SSRC, this->params.ssrc);
+		writer.AddValue(RTC::StatsWriter::Field::PACKET_COUNT, this->transmissionCounter.GetPacketCount());
+		writer.AddValue(RTC::StatsWriter::Field::BYTE_COUNT, this->transmissionCounter.GetBytes());
+		writer.AddValue(RTC::StatsWriter::Field::BITRATE, this->transmissionCounter.GetRate(now));
+		writer.AddValue(RTC::StatsWriter::Field::PACKETS_LOST, this->packetsLost);
+		writer.AddValue(RTC::StatsWriter::Field::FRACTION_LOST, this->fractionLost);
+		writer.AddValue(RTC::StatsWriter::Field::PACKETS_DISCARDED, this->packetsDiscarded);
+		writer.AddValue(RTC::StatsWriter::Field::PACKETS_REPAIRED, this->packetsRepaired);
+		writer.AddValue(RTC::StatsWriter::Field::NACK_COUNT, this->nackCount);
+		writer.AddValue(RTC::StatsWriter::Field::NACK_RTP_PACKET_COUNT, this->nackRtpPacketCount);
+		writer.AddValue(RTC::StatsWriter::Field::PLI_COUNT, this->pliCount);
+		writer.AddValue(RTC::StatsWriter::Field::FIR_COUNT, this->firCount);
+		writer.AddValue(RTC::StatsWriter::Field::SCORE, this->score);
+	}
+
 	bool RtpStream::ReceivePacket(RTC::RtpPacket* packet)
 	{
 		MS_TRACE();
 
-		uint16_t seq = packet->GetSequenceNumber();
+		return ReceivePacketFields(packet->GetSequenceNumber(), packet->GetTimestamp(), packet->GetSize());
+	}
+
+	bool RtpStream::ReceivePacketFields(uint16_t seq, uint32_t timestamp, size_t size)
+	{
+		MS_TRACE();
 
 		// If this is the first packet seen, initialize stuff.
 		if (!this->started)
@@ -89,40 +116,35 @@ namespace RTC
 
 			this->started     = true;
 			this->maxSeq      = seq - 1;
-			this->maxPacketTs = packet->GetTimestamp();
+			this->maxPacketTs = timestamp;
 			this->maxPacketMs = DepLibUV::GetTime();
 		}
 
 		// If not a valid packet ignore it.
-		if (!UpdateSeq(packet))
+		if (!UpdateSeq(seq, timestamp))
 		{
-			MS_WARN_TAG(
-			  rtp,
-			  "invalid packet [ssrc:%" PRIu32 ", seq:%" PRIu16 "]",
-			  packet->GetSsrc(),
-			  packet->GetSequenceNumber());
+			MS_WARN_TAG(rtp, "invalid packet [ssrc:%" PRIu32 ", seq:%" PRIu16 "]", this->params.ssrc, seq);
 
 			return false;
 		}
 
 		// Increase counters.
-		this->transmissionCounter.Update(packet);
+		this->transmissionCounter.Update(size);
 
 		// Update highest seen RTP timestamp.
-		if (RTC::SeqManager<uint32_t>::IsSeqHigherThan(packet->GetTimestamp(), this->maxPacketTs))
+		if (RTC::SeqManager<uint32_t>::IsSeqHigherThan(timestamp, this->maxPacketTs))
 		{
-			this->maxPacketTs = packet->GetTimestamp();
+			this->maxPacketTs = timestamp;
 			this->maxPacketMs = DepLibUV::GetTime();
 		}
 
 		return true;
 	}
 
-	bool RtpStream::UpdateSeq(RTC::RtpPacket* packet)
+	bool RtpStream::UpdateSeq(uint16_t seq, uint32_t timestamp)
 	{
 		MS_TRACE();
 
-		uint16_t seq    = packet->GetSequenceNumber();
 		uint16_t udelta = seq - this->maxSeq;
 
 		// If the new packet sequence number is greater than the max seen but not
@@ -153,12 +175,12 @@ namespace RTC
 				MS_WARN_TAG(
 				  rtp,
 				  "too bad sequence number, re-syncing RTP [ssrc:%" PRIu32 ", seq:%" PRIu16 "]",
-				  packet->GetSsrc(),
-				  packet->GetSequenceNumber());
+				  this->params.ssrc,
+				  seq);
 
 				InitSeq(seq);
 
-				this->maxPacketTs = packet->GetTimestamp();
+				this->maxPacketTs = timestamp;
 				this->maxPacketMs = DepLibUV::GetTime();
 			}
 			else
@@ -166,8 +188,8 @@ namespace RTC
 				MS_WARN_TAG(
 				  rtp,
 				  "bad sequence number, ignoring packet [ssrc:%" PRIu32 ", seq:%" PRIu16 "]",
-				  packet->GetSsrc(),
-				  packet->GetSequenceNumber());
+				  this->params.ssrc,
+				  seq);
 
 				this->badSeq = (seq + 1) & (RtpSeqMod - 1);
 
@@ -277,7 +299,7 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		this->retransmissionCounter.Update(packet);
+		this->retransmissionCounter.Update(packet->GetSize());
 	}
 
 	void RtpStream::PacketRepaired(RTC::RtpPacket* /*packet*/)
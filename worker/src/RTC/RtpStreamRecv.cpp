@@ -129,7 +129,7 @@ namespace RTC
 		  packet->GetSequenceNumber());
 
 		// If not a valid packet ignore it.
-		if (!UpdateSeq(packet))
+		if (!UpdateSeq(packet->GetSequenceNumber(), packet->GetTimestamp()))
 		{
 			MS_WARN_TAG(
 			  rtx,
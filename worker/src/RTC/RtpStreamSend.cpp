@@ -15,6 +15,8 @@ namespace RTC
 	// 17: 16 bit mask + the initial sequence number.
 	static constexpr size_t MaxRequestedPackets{ 17 };
 	static std::vector<RTC::RtpPacket*> RetransmissionContainer(MaxRequestedPackets + 1);
+	// Packets requested by all the items of a NACK.
+	static std::vector<RTC::RtpPacket*> RequestedPackets;
 	// Don't retransmit packets older than this (ms).
 	static constexpr uint32_t MaxRetransmissionDelay{ 2000 };
 	static constexpr uint32_t DefaultRtt{ 100 };
@@ -42,27 +44,39 @@ namespace RTC
 
 		RTC::RtpStream::FillJsonStats(jsonObject);
 
-		jsonObject["type"]          = "outbound-rtp";
-		jsonObject["roundTripTime"] = this->rtt;
+		jsonObject["type"]                         = "outbound-rtp";
+		jsonObject["roundTripTime"]                = this->rtt;
+		jsonObject["probationPacketsSent"]         = this->probationPacketsSent;
+		jsonObject["retransmissionPacketsDropped"] = this->retransmissionBudget.GetDroppedPackets();
 	}
 
 	bool RtpStreamSend::ReceivePacket(RTC::RtpPacket* packet)
 	{
 		MS_TRACE();
 
+		return ReceivePacket(RTC::RtpPacketOverlay(packet));
+	}
+
+	bool RtpStreamSend::ReceivePacket(const RTC::RtpPacketOverlay& overlay)
+	{
+		MS_TRACE();
+
 		// Call the parent method.
-		if (!RtpStream::ReceivePacket(packet))
+		if (!RtpStream::ReceivePacketFields(
+		      overlay.GetSequenceNumber(), overlay.GetTimestamp(), overlay.GetSize()))
+		{
 			return false;
+		}
 
 		// If it's a key frame clear the RTP retransmission buffer to avoid
 		// congesting the receiver by sending useless retransmissions (now that we
 		// are sending a newer key frame).
-		if (packet->IsKeyFrame())
+		if (overlay.IsKeyFrame())
 			ClearRetransmissionBuffer();
 
 		// If bufferSize was given, store the packet into the buffer.
 		if (!this->storage.empty())
-			StorePacket(packet);
+			StorePacket(overlay);
 
 		return true;
 	}
@@ -73,6 +87,8 @@ namespace RTC
 
 		this->nackCount++;
 
+		RequestedPackets.clear();
+
 		for (auto it = nackPacket->Begin(); it != nackPacket->End(); ++it)
 		{
 			RTC::RTCP::FeedbackRtpNackItem* item = *it;
@@ -90,13 +106,56 @@ namespace RTC
 				if (packet == nullptr)
 					break;
 
-				// Retransmit the packet.
-				RetransmitPacket(packet);
-
-				// Mark the packet as repaired.
-				PacketRepaired(packet);
+				RequestedPackets.push_back(packet);
 			}
 		}
+
+		if (RequestedPackets.empty())
+			return;
+
+		uint64_t now = DepLibUV::GetTime();
+
+		this->retransmissionBudget.Update(this->transmissionCounter.GetRate(now), now);
+
+		// If not all the requested packets fit into the retransmission budget,
+		// take the most recent ones since the older ones are more likely to
+		// arrive too late.
+		size_t availableBytes = this->retransmissionBudget.GetAvailableBytes();
+		size_t firstIdx       = RequestedPackets.size();
+
+		for (; firstIdx > 0; --firstIdx)
+		{
+			size_t size = RequestedPackets[firstIdx - 1]->GetSize();
+
+			if (size > availableBytes)
+				break;
+
+			availableBytes -= size;
+		}
+
+		if (firstIdx > 0)
+		{
+			MS_DEBUG_TAG(
+			  rtx,
+			  "retransmission budget exceeded, ignoring %zu requested packets [ssrc:%" PRIu32 "]",
+			  firstIdx,
+			  GetSsrc());
+
+			this->retransmissionBudget.Drop(firstIdx);
+		}
+
+		for (size_t idx{ firstIdx }; idx < RequestedPackets.size(); ++idx)
+		{
+			auto* packet = RequestedPackets[idx];
+
+			this->retransmissionBudget.Consume(packet->GetSize());
+
+			// Retransmit the packet.
+			RetransmitPacket(packet);
+
+			// Mark the packet as repaired.
+			PacketRepaired(packet);
+		}
 	}
 
 	void RtpStreamSend::ReceiveKeyFrameRequest(RTC::RTCP::FeedbackPs::MessageType messageType)
@@ -258,24 +317,52 @@ namespace RTC
 		PacketRetransmitted(packet);
 	}
 
-	void RtpStreamSend::StorePacket(RTC::RtpPacket* packet)
+	size_t RtpStreamSend::SendProbationPacket(uint64_t now)
+	{
+		MS_TRACE();
+
+		// Probation packets must not be taken as media by the receiver.
+		if (!HasRtx() || this->buffer.empty())
+			return 0u;
+
+		auto* packet    = this->buffer.back().packet;
+		auto* rtxPacket = packet->Clone(RtxPacketBuffer);
+
+		rtxPacket->RtxEncode(this->params.rtxPayloadType, this->params.rtxSsrc, ++this->rtxSeq);
+
+		// So the receiver bitrate estimator takes the real sending time.
+		rtxPacket->UpdateAbsSendTime(now);
+
+		size_t size = rtxPacket->GetSize();
+
+		static_cast<RTC::RtpStreamSend::Listener*>(this->listener)
+		  ->OnRtpStreamRetransmitRtpPacket(this, rtxPacket);
+
+		delete rtxPacket;
+
+		this->probationPacketsSent++;
+
+		return size;
+	}
+
+	void RtpStreamSend::StorePacket(const RTC::RtpPacketOverlay& overlay)
 	{
 		MS_TRACE();
 
-		if (packet->GetSize() > RTC::MtuSize)
+		if (overlay.GetSize() > RTC::MtuSize)
 		{
 			MS_WARN_TAG(
 			  rtp,
 			  "packet too big [ssrc:%" PRIu32 ", seq:%" PRIu16 ", size:%zu]",
-			  packet->GetSsrc(),
-			  packet->GetSequenceNumber(),
-			  packet->GetSize());
+			  overlay.GetSsrc(),
+			  overlay.GetSequenceNumber(),
+			  overlay.GetSize());
 
 			return;
 		}
 
 		// Sum the packet seq number and the number of 16 bits cycles.
-		auto packetSeq = packet->GetSequenceNumber();
+		auto packetSeq = overlay.GetSequenceNumber();
 		BufferItem bufferItem;
 
 		bufferItem.seq = packetSeq;
@@ -285,7 +372,7 @@ namespace RTC
 		{
 			auto store = this->storage[0].store;
 
-			bufferItem.packet = packet->Clone(store);
+			bufferItem.packet = overlay.Clone(store);
 			this->buffer.push_back(bufferItem);
 
 			return;
@@ -343,7 +430,7 @@ namespace RTC
 		}
 
 		// Update the new buffer item so it points to the cloned packed.
-		(*newBufferIt).packet = packet->Clone(store);
+		(*newBufferIt).packet = overlay.Clone(store);
 	}
 
 	// This method looks for the requested RTP packets and inserts them into the
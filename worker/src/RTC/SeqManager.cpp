@@ -47,16 +47,29 @@ namespace RTC
 		// Update maxInput.
 		this->maxInput = input;
 
-		// Clear dropped set.
-		this->dropped.clear();
+		// Clear dropped inputs.
+		this->dropped.reset();
+		this->dropWindowStart = input + 1;
 	}
 
 	template<typename T>
 	void SeqManager<T>::Drop(T input)
 	{
 		// Mark as dropped if 'input' is higher than anyone already processed.
-		if (SeqManager<T>::IsSeqHigherThan(input, this->maxInput))
-			this->dropped.insert(input);
+		if (!SeqManager<T>::IsSeqHigherThan(input, this->maxInput))
+			return;
+
+		T offset = input - this->dropWindowStart;
+
+		// Slide the window so 'input' becomes its last entry.
+		if (offset >= DropWindowSize)
+		{
+			SlideDropWindow(input - DropWindowSize + 1);
+
+			offset = DropWindowSize - 1;
+		}
+
+		this->dropped.set(offset);
 	}
 
 	template<typename T>
@@ -71,27 +84,35 @@ namespace RTC
 		auto base = this->base;
 
 		// There are dropped inputs. Synchronize.
-		if (!this->dropped.empty())
+		if (this->dropped.any())
 		{
-			// Delete dropped inputs older than input - MaxValue/2.
-			auto it = this->dropped.lower_bound(input - MaxValue / 2);
-			this->dropped.erase(this->dropped.begin(), it);
-
-			// Check whether this input was dropped.
-			it = this->dropped.find(input);
+			T offset = input - this->dropWindowStart;
 
-			if (it != this->dropped.end())
+			// Input is higher than the window. All dropped inputs are lower than it,
+			// so slide the window to make 'input' its last entry.
+			if (offset >= DropWindowSize && SeqManager<T>::IsSeqHigherThan(input, this->dropWindowStart))
 			{
-				MS_WARN_TAG(rtp, "trying to send a dropped input");
+				SlideDropWindow(input - DropWindowSize + 1);
 
-				return false;
+				offset = DropWindowSize - 1;
+				base   = this->base;
 			}
 
-			// Count dropped entries before 'input' in order to adapt the base.
-			size_t dropped = std::count_if(
-			  this->dropped.begin(), this->dropped.end(), [&input](T i) { return i < input; });
+			// Otherwise input is lower than the window so no dropped input in it is
+			// lower than input.
+			if (offset < DropWindowSize)
+			{
+				// Check whether this input was dropped.
+				if (this->dropped.test(offset))
+				{
+					MS_WARN_TAG(rtp, "trying to send a dropped input");
 
-			base -= dropped;
+					return false;
+				}
+
+				// Count dropped entries before 'input' in order to adapt the base.
+				base -= (this->dropped << (DropWindowSize - offset)).count();
+			}
 		}
 
 		output = input + base;
@@ -112,6 +133,27 @@ namespace RTC
 		return true;
 	}
 
+	template<typename T>
+	void SeqManager<T>::SlideDropWindow(T start)
+	{
+		T shift = start - this->dropWindowStart;
+
+		// Dropped inputs leaving the window are lower than any future input, so
+		// they are permanently accounted in base.
+		if (shift >= DropWindowSize)
+		{
+			this->base -= this->dropped.count();
+			this->dropped.reset();
+		}
+		else
+		{
+			this->base -= (this->dropped << (DropWindowSize - shift)).count();
+			this->dropped >>= shift;
+		}
+
+		this->dropWindowStart = start;
+	}
+
 	template<typename T>
 	T SeqManager<T>::GetMaxInput() const
 	{
@@ -9,6 +9,12 @@
 
 namespace RTC
 {
+	/* Static. */
+
+	// While suppressing silence, forward a silent packet if no packet was sent
+	// in this interval so the receiver does not consider the stream inactive.
+	static constexpr uint64_t SilenceKeepAliveInterval{ 1000u }; // In ms.
+
 	/* Instance methods. */
 
 	SimpleConsumer::SimpleConsumer(const std::string& id, RTC::Consumer::Listener* listener, json& data)
@@ -20,6 +26,24 @@ namespace RTC
 		if (this->consumableRtpEncodings.size() != 1)
 			MS_THROW_TYPE_ERROR("invalid consumableRtpEncodings with size != 1");
 
+		auto jsonSilenceThresholdIt = data.find("silenceThreshold");
+
+		if (jsonSilenceThresholdIt != data.end())
+		{
+			if (!jsonSilenceThresholdIt->is_number_integer())
+				MS_THROW_TYPE_ERROR("wrong silenceThreshold (not an integer)");
+			else if (this->kind != RTC::Media::Kind::AUDIO)
+				MS_THROW_TYPE_ERROR("silenceThreshold just valid for audio");
+
+			auto silenceThreshold = jsonSilenceThresholdIt->get<int>();
+
+			if (silenceThreshold < -127 || silenceThreshold > 0)
+				MS_THROW_TYPE_ERROR("wrong silenceThreshold (not in range [-127, 0])");
+
+			this->silenceSuppression = true;
+			this->silenceThreshold   = static_cast<int8_t>(silenceThreshold);
+		}
+
 		// Set the RTCP report generation interval.
 		if (this->kind == RTC::Media::Kind::AUDIO)
 			this->maxRtcpInterval = RTC::RTCP::MaxAudioIntervalMs;
@@ -28,6 +52,29 @@ namespace RTC
 
 		// Create RtpStreamSend instance for sending a single stream to the remote.
 		CreateRtpStream();
+
+		auto& encoding = this->rtpParameters.encodings[0];
+		auto* fecCodec = this->rtpParameters.GetFecCodec();
+
+		// Generate FEC if negotiated.
+		if (this->kind == RTC::Media::Kind::VIDEO && encoding.hasFec && fecCodec)
+		{
+			this->fecEncoder =
+			  new RTC::FlexFecEncoder(fecCodec->payloadType, encoding.fec.ssrc, encoding.ssrc);
+		}
+
+		auto* mediaCodec = this->rtpParameters.GetCodecForEncoding(encoding);
+		auto* redCodec   = this->rtpParameters.GetRedCodec();
+
+		// Generate RED if negotiated. Just for Opus with the same clock rate.
+		if (
+		  this->kind == RTC::Media::Kind::AUDIO && redCodec &&
+		  mediaCodec->mimeType.subtype == RTC::RtpCodecMimeType::Subtype::OPUS &&
+		  mediaCodec->clockRate == redCodec->clockRate &&
+		  mediaCodec->channels == redCodec->channels)
+		{
+			this->redEncoder = new RTC::RedEncoder(redCodec->payloadType);
+		}
 	}
 
 	SimpleConsumer::~SimpleConsumer()
@@ -35,6 +82,8 @@ namespace RTC
 		MS_TRACE();
 
 		delete this->rtpStream;
+		delete this->fecEncoder;
+		delete this->redEncoder;
 	}
 
 	void SimpleConsumer::FillJson(json& jsonObject) const
@@ -46,6 +95,21 @@ namespace RTC
 
 		// Add rtpStream.
 		this->rtpStream->FillJson(jsonObject["rtpStream"]);
+
+		// Add fec.
+		if (this->fecEncoder)
+			this->fecEncoder->FillJson(jsonObject["fec"]);
+
+		// Add red.
+		if (this->redEncoder)
+			this->redEncoder->FillJson(jsonObject["red"]);
+
+		// Add silenceThreshold and silencePacketsSuppressed.
+		if (this->silenceSuppression)
+		{
+			jsonObject["silenceThreshold"]         = this->silenceThreshold;
+			jsonObject["silencePacketsSuppressed"] = this->silencePacketsSuppressed;
+		}
 	}
 
 	void SimpleConsumer::FillJsonStats(json& jsonArray) const
@@ -76,6 +140,15 @@ namespace RTC
 		jsonObject["consumer"] = this->rtpStream->GetScore();
 	}
 
+	void SimpleConsumer::WriteStats(RTC::StatsWriter& writer) const
+	{
+		MS_TRACE();
+
+		writer.BeginRow(this->id);
+		this->rtpStream->WriteStats(writer);
+		writer.EndRow();
+	}
+
 	void SimpleConsumer::HandleRequest(Channel::Request* request)
 	{
 		MS_TRACE();
@@ -99,13 +172,6 @@ namespace RTC
 		}
 	}
 
-	void SimpleConsumer::TransportConnected()
-	{
-		MS_TRACE();
-
-		RequestKeyFrame();
-	}
-
 	void SimpleConsumer::ProducerNewRtpStream(RTC::RtpStream* rtpStream, uint32_t /*mappedSsrc*/)
 	{
 		MS_TRACE();
@@ -124,13 +190,17 @@ namespace RTC
 		EmitScore();
 	}
 
-	void SimpleConsumer::SendRtpPacket(RTC::RtpPacket* packet)
+	void SimpleConsumer::SendRtpPacket(const RTC::RtpPacket* packet)
 	{
 		MS_TRACE();
 
 		if (!IsActive())
 			return;
 
+		// Apply the overload level if it changed since the previous packet.
+		if (this->overloadLevel != RTC::OverloadController::GetLevel())
+			ApplyOverloadLevel();
+
 		// Map the payload type.
 		auto payloadType = packet->GetPayloadType();
 
@@ -148,6 +218,20 @@ namespace RTC
 		if (this->syncRequired && this->keyFrameSupported && !packet->IsKeyFrame())
 			return;
 
+		// Drop silent audio packets unless nothing was sent for a while.
+		if (
+		  this->silenceSuppression && IsSilentPacket(packet) &&
+		  DepLibUV::GetTime() - this->rtpStream->GetMaxPacketMs() < SilenceKeepAliveInterval)
+		{
+			// Remove the gap in the sequence numbers. Not needed if a sync is pending.
+			if (!this->syncRequired)
+				this->rtpSeqManager.Drop(packet->GetSequenceNumber());
+
+			this->silencePacketsSuppressed++;
+
+			return;
+		}
+
 		// Whether this is the first packet after re-sync.
 		bool isSyncPacket = this->syncRequired;
 
@@ -176,11 +260,13 @@ namespace RTC
 			this->syncRequired = false;
 		}
 
+		RTC::RtpPacketOverlay overlay(packet);
+
 		// TODO: Not sure how to deal with it, but if this happens (and we drop the packet)
 		// we shouldn't have unset the syncRequired flag, etc.
 		//
 		// Rewrite payload if needed. Drop packet if necessary.
-		if (this->encodingContext && !packet->EncodePayload(this->encodingContext.get()))
+		if (this->encodingContext && !overlay.EncodePayload(this->encodingContext.get()))
 		{
 			this->rtpSeqManager.Drop(packet->GetSequenceNumber());
 			this->rtpTimestampManager.Drop(packet->GetTimestamp());
@@ -195,15 +281,10 @@ namespace RTC
 		this->rtpSeqManager.Input(packet->GetSequenceNumber(), seq);
 		this->rtpTimestampManager.Input(packet->GetTimestamp(), timestamp);
 
-		// Save original packet fields.
-		auto origSsrc      = packet->GetSsrc();
-		auto origSeq       = packet->GetSequenceNumber();
-		auto origTimestamp = packet->GetTimestamp();
-
-		// Rewrite packet.
-		packet->SetSsrc(this->rtpParameters.encodings[0].ssrc);
-		packet->SetSequenceNumber(seq);
-		packet->SetTimestamp(timestamp);
+		// Rewrite packet fields (the original packet is not modified).
+		overlay.SetSsrc(this->rtpParameters.encodings[0].ssrc);
+		overlay.SetSequenceNumber(seq);
+		overlay.SetTimestamp(timestamp);
 
 		if (isSyncPacket)
 		{
@@ -211,18 +292,32 @@ namespace RTC
 			  rtp,
 			  "sending sync packet [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32
 			  "] from original [seq:%" PRIu16 ", ts:%" PRIu32 "]",
-			  packet->GetSsrc(),
+			  overlay.GetSsrc(),
+			  overlay.GetSequenceNumber(),
+			  overlay.GetTimestamp(),
 			  packet->GetSequenceNumber(),
-			  packet->GetTimestamp(),
-			  origSeq,
-			  origTimestamp);
+			  packet->GetTimestamp());
 		}
 
 		// Process the packet.
-		if (this->rtpStream->ReceivePacket(packet))
+		if (this->rtpStream->ReceivePacket(overlay))
 		{
-			// Send the packet.
-			this->listener->OnConsumerSendRtpPacket(this, packet);
+			auto* redPacket = this->redEncoder ? this->redEncoder->Encode(overlay) : nullptr;
+
+			// Send the packet (or its RED encapsulation).
+			if (redPacket)
+				this->listener->OnConsumerSendRtpPacket(this, RTC::RtpPacketOverlay(redPacket));
+			else
+				this->listener->OnConsumerSendRtpPacket(this, overlay);
+
+			// Send a FEC packet if the group of protected packets is complete.
+			if (this->fecEncoder)
+			{
+				auto* fecPacket = this->fecEncoder->AddPacket(overlay);
+
+				if (fecPacket)
+					this->listener->OnConsumerSendRtpPacket(this, RTC::RtpPacketOverlay(fecPacket));
+			}
 		}
 		else
 		{
@@ -230,21 +325,12 @@ namespace RTC
 			  rtp,
 			  "failed to send packet [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32
 			  "] from original [seq:%" PRIu16 ", ts:%" PRIu32 "]",
-			  packet->GetSsrc(),
+			  overlay.GetSsrc(),
+			  overlay.GetSequenceNumber(),
+			  overlay.GetTimestamp(),
 			  packet->GetSequenceNumber(),
-			  packet->GetTimestamp(),
-			  origSeq,
-			  origTimestamp);
+			  packet->GetTimestamp());
 		}
-
-		// Restore packet fields.
-		packet->SetSsrc(origSsrc);
-		packet->SetSequenceNumber(origSeq);
-		packet->SetTimestamp(origTimestamp);
-
-		// Restore the original payload if needed.
-		if (this->encodingContext)
-			packet->RestorePayload();
 	}
 
 	void SimpleConsumer::GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t now)
@@ -291,6 +377,13 @@ namespace RTC
 		if (!IsActive())
 			return;
 
+		// Retransmissions are suspended while overloaded.
+		if (RTC::OverloadController::IsLevelReached(
+		      RTC::OverloadController::Level::NO_RETRANSMISSIONS))
+		{
+			return;
+		}
+
 		this->rtpStream->ReceiveNack(nackPacket);
 	}
 
@@ -311,6 +404,14 @@ namespace RTC
 		MS_TRACE();
 
 		this->rtpStream->ReceiveRtcpReceiverReport(report);
+
+		// Adapt the FEC protection to the losses reported by the receiver.
+		if (this->fecEncoder)
+			this->fecEncoder->SetFractionLost(report->GetFractionLost());
+
+		// Same for the audio redundancy.
+		if (this->redEncoder)
+			this->redEncoder->SetFractionLost(report->GetFractionLost());
 	}
 
 	uint32_t SimpleConsumer::GetTransmissionRate(uint64_t now)
@@ -363,6 +464,17 @@ namespace RTC
 			RequestKeyFrame();
 	}
 
+	void SimpleConsumer::UserOnTransportConnected()
+	{
+		MS_TRACE();
+
+		// RTP packets were not processed while disconnected, so resync the stream
+		// with a key frame.
+		this->syncRequired = true;
+
+		RequestKeyFrame();
+	}
+
 	void SimpleConsumer::CreateRtpStream()
 	{
 		MS_TRACE();
@@ -450,6 +562,42 @@ namespace RTC
 		Channel::Notifier::Emit(this->id, "score", data);
 	}
 
+	void SimpleConsumer::ApplyOverloadLevel()
+	{
+		MS_TRACE();
+
+		this->overloadLevel = RTC::OverloadController::GetLevel();
+
+		if (!this->encodingContext)
+			return;
+
+		RTC::Codecs::EncodingContext::Preferences preferences;
+
+		// Keep just the base temporal layer.
+		if (RTC::OverloadController::IsLevelReached(
+		      RTC::OverloadController::Level::LOWER_TEMPORAL_LAYERS))
+		{
+			preferences.temporalLayer = 0;
+		}
+
+		this->encodingContext->SetPreferences(preferences);
+	}
+
+	inline bool SimpleConsumer::IsSilentPacket(const RTC::RtpPacket* packet) const
+	{
+		MS_TRACE();
+
+		uint8_t volume;
+		bool voice;
+
+		// Packets without audio level are not considered silent.
+		if (!packet->ReadAudioLevel(volume, voice))
+			return false;
+
+		// The audio level is given as -dBov.
+		return !voice && -static_cast<int>(volume) < this->silenceThreshold;
+	}
+
 	inline void SimpleConsumer::OnRtpStreamScore(RTC::RtpStream* /*rtpStream*/, uint8_t /*score*/)
 	{
 		MS_TRACE();
@@ -463,6 +611,6 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		this->listener->OnConsumerSendRtpPacket(this, packet);
+		this->listener->OnConsumerSendRtpPacket(this, RTC::RtpPacketOverlay(packet));
 	}
 } // namespace RTC
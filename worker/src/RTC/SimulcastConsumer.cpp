@@ -2,6 +2,7 @@
 // #define MS_LOG_DEV
 
 #include "RTC/SimulcastConsumer.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Channel/Notifier.hpp"
@@ -44,6 +45,16 @@ namespace RTC
 
 		// Create RtpStreamSend instance for sending a single stream to the remote.
 		CreateRtpStream();
+
+		auto& encoding = this->rtpParameters.encodings[0];
+		auto* fecCodec = this->rtpParameters.GetFecCodec();
+
+		// Generate FEC if negotiated.
+		if (this->kind == RTC::Media::Kind::VIDEO && encoding.hasFec && fecCodec)
+		{
+			this->fecEncoder =
+			  new RTC::FlexFecEncoder(fecCodec->payloadType, encoding.fec.ssrc, encoding.ssrc);
+		}
 	}
 
 	SimulcastConsumer::~SimulcastConsumer()
@@ -51,6 +62,7 @@ namespace RTC
 		MS_TRACE();
 
 		delete this->rtpStream;
+		delete this->fecEncoder;
 	}
 
 	void SimulcastConsumer::FillJson(json& jsonObject) const
@@ -63,6 +75,17 @@ namespace RTC
 		// Add rtpStream.
 		this->rtpStream->FillJson(jsonObject["rtpStream"]);
 
+		// Add fec.
+		if (this->fecEncoder)
+			this->fecEncoder->FillJson(jsonObject["fec"]);
+
+		// Add availableBitrate.
+		if (this->availableBitrate != std::numeric_limits<uint32_t>::max())
+			jsonObject["availableBitrate"] = this->availableBitrate;
+
+		// Add probationSpatialLayer.
+		jsonObject["probationSpatialLayer"] = this->probationSpatialLayer;
+
 		// TODO: Add layers, etc.
 	}
 
@@ -98,6 +121,15 @@ namespace RTC
 		jsonObject["consumer"] = this->rtpStream->GetScore();
 	}
 
+	void SimulcastConsumer::WriteStats(RTC::StatsWriter& writer) const
+	{
+		MS_TRACE();
+
+		writer.BeginRow(this->id);
+		this->rtpStream->WriteStats(writer);
+		writer.EndRow();
+	}
+
 	void SimulcastConsumer::HandleRequest(Channel::Request* request)
 	{
 		MS_TRACE();
@@ -158,13 +190,6 @@ namespace RTC
 		}
 	}
 
-	void SimulcastConsumer::TransportConnected()
-	{
-		MS_TRACE();
-
-		RequestKeyFrame();
-	}
-
 	void SimulcastConsumer::ProducerNewRtpStream(RTC::RtpStream* rtpStream, uint32_t mappedSsrc)
 	{
 		MS_TRACE();
@@ -199,13 +224,32 @@ namespace RTC
 		EmitScore();
 	}
 
-	void SimulcastConsumer::SendRtpPacket(RTC::RtpPacket* packet)
+	bool SimulcastConsumer::GetSubscribedMappedSsrcs(std::vector<uint32_t>& mappedSsrcs) const
+	{
+		MS_TRACE();
+
+		// Packets of the current spatial layer and, while switching, those of the
+		// target one (waiting for a key frame).
+		if (this->currentSpatialLayer != -1)
+			mappedSsrcs.push_back(this->consumableRtpEncodings[this->currentSpatialLayer].ssrc);
+
+		if (this->targetSpatialLayer != -1 && this->targetSpatialLayer != this->currentSpatialLayer)
+			mappedSsrcs.push_back(this->consumableRtpEncodings[this->targetSpatialLayer].ssrc);
+
+		return true;
+	}
+
+	void SimulcastConsumer::SendRtpPacket(const RTC::RtpPacket* packet)
 	{
 		MS_TRACE();
 
 		if (!IsActive())
 			return;
 
+		// Apply the overload level if it changed since the previous packet.
+		if (this->overloadLevel != RTC::OverloadController::GetLevel())
+			ApplyOverloadLevel();
+
 		// Map the payload type.
 		auto payloadType = packet->GetPayloadType();
 
@@ -273,11 +317,13 @@ namespace RTC
 			this->syncRequired = false;
 		}
 
+		RTC::RtpPacketOverlay overlay(packet);
+
 		// TODO: Not sure how to deal with it, but if this happens (and we drop the packet)
 		// we shouldn't have unset the syncRequired flag, etc.
 		//
 		// Rewrite payload if needed. Drop packet if necessary.
-		if (this->encodingContext && !packet->EncodePayload(this->encodingContext.get()))
+		if (this->encodingContext && !overlay.EncodePayload(this->encodingContext.get()))
 		{
 			this->rtpSeqManager.Drop(packet->GetSequenceNumber());
 			this->rtpTimestampManager.Drop(packet->GetTimestamp());
@@ -292,15 +338,10 @@ namespace RTC
 		this->rtpSeqManager.Input(packet->GetSequenceNumber(), seq);
 		this->rtpTimestampManager.Input(packet->GetTimestamp(), timestamp);
 
-		// Save original packet fields.
-		auto origSsrc      = packet->GetSsrc();
-		auto origSeq       = packet->GetSequenceNumber();
-		auto origTimestamp = packet->GetTimestamp();
-
-		// Rewrite packet.
-		packet->SetSsrc(this->rtpParameters.encodings[0].ssrc);
-		packet->SetSequenceNumber(seq);
-		packet->SetTimestamp(timestamp);
+		// Rewrite packet fields (the original packet is not modified).
+		overlay.SetSsrc(this->rtpParameters.encodings[0].ssrc);
+		overlay.SetSequenceNumber(seq);
+		overlay.SetTimestamp(timestamp);
 
 		if (isSyncPacket)
 		{
@@ -308,18 +349,31 @@ namespace RTC
 			  rtp,
 			  "sending sync packet [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32
 			  "] from original [seq:%" PRIu16 ", ts:%" PRIu32 "]",
-			  packet->GetSsrc(),
+			  overlay.GetSsrc(),
+			  overlay.GetSequenceNumber(),
+			  overlay.GetTimestamp(),
 			  packet->GetSequenceNumber(),
-			  packet->GetTimestamp(),
-			  origSeq,
-			  origTimestamp);
+			  packet->GetTimestamp());
 		}
 
 		// Process the packet.
-		if (this->rtpStream->ReceivePacket(packet))
+		if (this->rtpStream->ReceivePacket(overlay))
 		{
 			// Send the packet.
-			this->listener->OnConsumerSendRtpPacket(this, packet);
+			this->listener->OnConsumerSendRtpPacket(this, overlay);
+
+			// Send a FEC packet if the group of protected packets is complete.
+			if (this->fecEncoder)
+			{
+				auto* fecPacket = this->fecEncoder->AddPacket(overlay);
+
+				if (fecPacket)
+					this->listener->OnConsumerSendRtpPacket(this, RTC::RtpPacketOverlay(fecPacket));
+			}
+
+			// Probe the bitrate of the next spatial layer if limited by bitrate.
+			if (this->probationSpatialLayer != -1)
+				SendProbationPackets(overlay.GetSize());
 		}
 		else
 		{
@@ -327,21 +381,12 @@ namespace RTC
 			  rtp,
 			  "failed to send packet [ssrc:%" PRIu32 ", seq:%" PRIu16 ", ts:%" PRIu32
 			  "] from original [seq:%" PRIu16 ", ts:%" PRIu32 "]",
-			  packet->GetSsrc(),
+			  overlay.GetSsrc(),
+			  overlay.GetSequenceNumber(),
+			  overlay.GetTimestamp(),
 			  packet->GetSequenceNumber(),
-			  packet->GetTimestamp(),
-			  origSeq,
-			  origTimestamp);
+			  packet->GetTimestamp());
 		}
-
-		// Restore packet fields.
-		packet->SetSsrc(origSsrc);
-		packet->SetSequenceNumber(origSeq);
-		packet->SetTimestamp(origTimestamp);
-
-		// Restore the original payload if needed.
-		if (this->encodingContext)
-			packet->RestorePayload();
 	}
 
 	void SimulcastConsumer::GetRtcp(RTC::RTCP::CompoundPacket* packet, uint64_t now)
@@ -388,6 +433,13 @@ namespace RTC
 		if (!IsActive())
 			return;
 
+		// Retransmissions are suspended while overloaded.
+		if (RTC::OverloadController::IsLevelReached(
+		      RTC::OverloadController::Level::NO_RETRANSMISSIONS))
+		{
+			return;
+		}
+
 		this->rtpStream->ReceiveNack(nackPacket);
 	}
 
@@ -408,6 +460,10 @@ namespace RTC
 		MS_TRACE();
 
 		this->rtpStream->ReceiveRtcpReceiverReport(report);
+
+		// Adapt the FEC protection to the losses reported by the receiver.
+		if (this->fecEncoder)
+			this->fecEncoder->SetFractionLost(report->GetFractionLost());
 	}
 
 	uint32_t SimulcastConsumer::GetTransmissionRate(uint64_t now)
@@ -439,6 +495,23 @@ namespace RTC
 		}
 	}
 
+	uint32_t SimulcastConsumer::UseAvailableBitrate(uint32_t bitrate, bool canPause)
+	{
+		MS_TRACE();
+
+		this->availableBitrate   = bitrate;
+		this->canPauseForBitrate = canPause;
+
+		RecalculateTargetSpatialLayer();
+
+		auto* producerTargetRtpStream = GetProducerTargetRtpStream();
+
+		if (!IsActive() || !producerTargetRtpStream)
+			return 0u;
+
+		return producerTargetRtpStream->GetRate(DepLibUV::GetTime());
+	}
+
 	void SimulcastConsumer::Paused(bool /*wasProducer*/)
 	{
 		MS_TRACE();
@@ -462,6 +535,17 @@ namespace RTC
 			RequestKeyFrame();
 	}
 
+	void SimulcastConsumer::UserOnTransportConnected()
+	{
+		MS_TRACE();
+
+		// RTP packets were not processed while disconnected, so resync the stream
+		// with a key frame.
+		this->syncRequired = true;
+
+		RequestKeyFrame();
+	}
+
 	void SimulcastConsumer::CreateRtpStream()
 	{
 		MS_TRACE();
@@ -562,6 +646,37 @@ namespace RTC
 		Channel::Notifier::Emit(this->id, "score", data);
 	}
 
+	void SimulcastConsumer::ApplyOverloadLevel()
+	{
+		MS_TRACE();
+
+		this->overloadLevel = RTC::OverloadController::GetLevel();
+
+		UpdateEncodingPreferences();
+		RecalculateTargetSpatialLayer();
+	}
+
+	void SimulcastConsumer::UpdateEncodingPreferences()
+	{
+		MS_TRACE();
+
+		if (!this->encodingContext)
+			return;
+
+		RTC::Codecs::EncodingContext::Preferences preferences;
+
+		// Keep just the base temporal layer if overloaded or if not even the lowest
+		// spatial layer fits into the available bitrate.
+		if (
+		  this->bitrateExceeded || RTC::OverloadController::IsLevelReached(
+		                             RTC::OverloadController::Level::LOWER_TEMPORAL_LAYERS))
+		{
+			preferences.temporalLayer = 0;
+		}
+
+		this->encodingContext->SetPreferences(preferences);
+	}
+
 	void SimulcastConsumer::SetCurrentSpatialLayer(int16_t spatialLayer)
 	{
 		MS_TRACE();
@@ -571,6 +686,8 @@ namespace RTC
 
 		this->currentSpatialLayer = spatialLayer;
 
+		this->listener->OnConsumerSubscriptionChanged(this);
+
 		MS_DEBUG_DEV(
 		  "current spatial layer changed to %" PRIi16 " [consumerId:%s]",
 		  this->currentSpatialLayer,
@@ -591,6 +708,22 @@ namespace RTC
 		MS_TRACE();
 
 		int16_t newTargetSpatialLayer{ -1 };
+		int16_t maxSpatialLayer{ this->preferredSpatialLayer };
+		// Not even the lowest healthy spatial layer fits into the available bitrate.
+		bool noLayerFits{ false };
+		// Lowest healthy spatial layer not fitting into the available bitrate.
+		int16_t lowestLimitedSpatialLayer{ -1 };
+		// Next healthy spatial layer above the target one, if limited by bitrate.
+		int16_t nextSpatialLayer{ -1 };
+		uint64_t now = DepLibUV::GetTime();
+
+		// Step down one spatial layer while overloaded.
+		if (
+		  maxSpatialLayer > 0 &&
+		  RTC::OverloadController::IsLevelReached(RTC::OverloadController::Level::LOWER_SPATIAL_LAYERS))
+		{
+			--maxSpatialLayer;
+		}
 
 		// No Producer streams.
 		if (this->producerRtpStreams.empty())
@@ -605,31 +738,92 @@ namespace RTC
 				auto spatialLayer       = static_cast<int16_t>(idx);
 				auto* producerRtpStream = this->producerRtpStreams[idx];
 
-				// Ignore spatial layers higher than the preferred one.
-				if (spatialLayer > this->preferredSpatialLayer)
+				// Ignore spatial layers higher than the preferred (or overload capped) one.
+				if (spatialLayer > maxSpatialLayer)
 					continue;
 
 				// Ignore spatial layers for non existing or unhealthy Producer streams.
 				if (!producerRtpStream || producerRtpStream->GetScore() < 5)
 					continue;
 
+				// Ignore spatial layers not fitting into the available bitrate.
+				if (producerRtpStream->GetRate(now) > this->availableBitrate)
+				{
+					if (lowestLimitedSpatialLayer != -1)
+						nextSpatialLayer = lowestLimitedSpatialLayer;
+
+					lowestLimitedSpatialLayer = spatialLayer;
+
+					continue;
+				}
+
 				newTargetSpatialLayer = spatialLayer;
+				nextSpatialLayer      = lowestLimitedSpatialLayer;
 
 				break;
 			}
 
+			// If none fits into the available bitrate stop sending if allowed (so
+			// Consumers with higher priority get the bitrate) or take the lowest
+			// healthy one.
+			if (newTargetSpatialLayer == -1 && lowestLimitedSpatialLayer != -1)
+			{
+				noLayerFits = true;
+
+				if (!this->canPauseForBitrate)
+					newTargetSpatialLayer = lowestLimitedSpatialLayer;
+			}
+
 			// TODO: It may happen that spatial layer 1 exists and it's healthy while 0
 			// does not exist or is unhealthy. If preferred spatial layer was 0 then we
 			// end here without newTargetSpatialLayer. In that scenario we should take
 			// whichever available.
 		}
 
+		// Probe for the bitrate the next spatial layer needs. Never if not even
+		// the target one fits into the available bitrate, since probation packets
+		// would just add more traffic to an already congested link.
+		if (nextSpatialLayer != -1 && newTargetSpatialLayer != -1 && !noLayerFits)
+		{
+			uint32_t nextBitrate   = this->producerRtpStreams[nextSpatialLayer]->GetRate(now);
+			uint32_t targetBitrate = this->producerRtpStreams[newTargetSpatialLayer]->GetRate(now);
+
+			this->probationSpatialLayer = nextSpatialLayer;
+			this->probationPacer.SetBitrate(
+			  nextBitrate > targetBitrate ? nextBitrate - targetBitrate : 0u);
+		}
+		else
+		{
+			this->probationSpatialLayer = -1;
+			this->probationPacer.SetBitrate(0u);
+		}
+
+		if (noLayerFits != this->bitrateExceeded)
+		{
+			this->bitrateExceeded = noLayerFits;
+
+			UpdateEncodingPreferences();
+		}
+
 		// Nothing changed.
 		if (newTargetSpatialLayer == this->targetSpatialLayer)
 			return;
 
 		this->targetSpatialLayer = newTargetSpatialLayer;
 
+		this->listener->OnConsumerSubscriptionChanged(this);
+
+		// Stop sending right away if there is not bitrate for any spatial layer.
+		if (this->targetSpatialLayer == -1 && noLayerFits)
+		{
+			MS_DEBUG_TAG(
+			  rbe, "not enough bitrate for any spatial layer [consumerId:%s]", this->id.c_str());
+
+			SetCurrentSpatialLayer(-1);
+
+			return;
+		}
+
 		// Already using the target layer. Do nothing.
 		if (this->targetSpatialLayer == this->currentSpatialLayer)
 			return;
@@ -643,6 +837,33 @@ namespace RTC
 		  this->id.c_str());
 	}
 
+	void SimulcastConsumer::SendProbationPackets(size_t size)
+	{
+		MS_TRACE();
+
+		uint64_t now = DepLibUV::GetTime();
+
+		this->probationPacer.AddMediaPacket(size, this->rtpStream->GetRate(now), now);
+
+		for (size_t i{ 0 };
+		     i < RTC::ProbationPacer::MaxPacketsPerMediaPacket &&
+		     this->probationPacer.GetAvailableBytes() > 0u;
+		     ++i)
+		{
+			size_t sent = this->rtpStream->SendProbationPacket(now);
+
+			// No RTX or nothing to send.
+			if (sent == 0u)
+			{
+				this->probationPacer.Clear();
+
+				break;
+			}
+
+			this->probationPacer.Consume(sent);
+		}
+	}
+
 	inline RTC::RtpStream* SimulcastConsumer::GetProducerCurrentRtpStream() const
 	{
 		MS_TRACE();
@@ -681,6 +902,6 @@ namespace RTC
 	{
 		MS_TRACE();
 
-		this->listener->OnConsumerSendRtpPacket(this, packet);
+		this->listener->OnConsumerSendRtpPacket(this, RTC::RtpPacketOverlay(packet));
 	}
 } // namespace RTC
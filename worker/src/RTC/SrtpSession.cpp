@@ -135,20 +135,27 @@ namespace RTC
 
 		std::memcpy(EncryptBuffer, *data, *len);
 
-		srtp_err_status_t err =
-		  srtp_protect(this->session, (void*)EncryptBuffer, reinterpret_cast<int*>(len));
+		return ProtectRtp(data, len);
+	}
 
-		if (DepLibSRTP::IsError(err))
+	bool SrtpSession::EncryptRtp(
+	  const RTC::RtpPacketOverlay& overlay, const uint8_t** data, size_t* len)
+	{
+		MS_TRACE();
+
+		*len = overlay.GetSize();
+
+		// Ensure that the resulting SRTP packet fits into the encrypt buffer.
+		if (*len + SRTP_MAX_TRAILER_LEN > EncryptBufferSize)
 		{
-			MS_WARN_TAG(srtp, "srtp_protect() failed: %s", DepLibSRTP::GetErrorString(err));
+			MS_WARN_TAG(srtp, "cannot encrypt RTP packet, size too big (%zu bytes)", *len);
 
 			return false;
 		}
 
-		// Update the given data pointer.
-		*data = (const uint8_t*)EncryptBuffer;
+		overlay.Serialize(EncryptBuffer);
 
-		return true;
+		return ProtectRtp(data, len);
 	}
 
 	bool SrtpSession::DecryptSrtp(const uint8_t* data, size_t* len)
@@ -213,4 +220,24 @@ namespace RTC
 
 		return true;
 	}
+
+	bool SrtpSession::ProtectRtp(const uint8_t** data, size_t* len)
+	{
+		MS_TRACE();
+
+		srtp_err_status_t err =
+		  srtp_protect(this->session, (void*)EncryptBuffer, reinterpret_cast<int*>(len));
+
+		if (DepLibSRTP::IsError(err))
+		{
+			MS_WARN_TAG(srtp, "srtp_protect() failed: %s", DepLibSRTP::GetErrorString(err));
+
+			return false;
+		}
+
+		// Update the given data pointer.
+		*data = (const uint8_t*)EncryptBuffer;
+
+		return true;
+	}
 } // namespace RTC
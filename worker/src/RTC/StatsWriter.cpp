@@ -0,0 +1,364 @@
+#define MS_CLASS "RTC::StatsWriter"
+// #define MS_LOG_DEV
+
+#include "RTC/StatsWriter.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Utils.hpp"
+
+namespace RTC
+{
+	/* Static. */
+
+	static constexpr size_t InitialBufferSize{ 4096 };
+
+	/* Class variables. */
+
+	// clang-format off
+	std::unordered_map<std::string, StatsWriter::Field> StatsWriter::string2Field =
+	{
+		{ "bytesReceived",            StatsWriter::Field::BYTES_RECEIVED             },
+		{ "bytesSent",                StatsWriter::Field::BYTES_SENT                 },
+		{ "availableIncomingBitrate", StatsWriter::Field::AVAILABLE_INCOMING_BITRATE },
+		{ "availableOutgoingBitrate", StatsWriter::Field::AVAILABLE_OUTGOING_BITRATE },
+		{ "ssrc",                     StatsWriter::Field::SSRC                       },
+		{ "packetCount",              StatsWriter::Field::PACKET_COUNT               },
+		{ "byteCount",                StatsWriter::Field::BYTE_COUNT                 },
+		{ "bitrate",                  StatsWriter::Field::BITRATE                    },
+		{ "packetsLost",              StatsWriter::Field::PACKETS_LOST               },
+		{ "fractionLost",             StatsWriter::Field::FRACTION_LOST              },
+		{ "packetsDiscarded",         StatsWriter::Field::PACKETS_DISCARDED          },
+		{ "packetsRepaired",          StatsWriter::Field::PACKETS_REPAIRED           },
+		{ "nackCount",                StatsWriter::Field::NACK_COUNT                 },
+		{ "nackRtpPacketCount",       StatsWriter::Field::NACK_RTP_PACKET_COUNT      },
+		{ "pliCount",                 StatsWriter::Field::PLI_COUNT                  },
+		{ "firCount",                 StatsWriter::Field::FIR_COUNT                  },
+		{ "score",                    StatsWriter::Field::SCORE                      }
+	};
+
+	std::unordered_map<uint8_t, std::string> StatsWriter::field2String =
+	{
+		{ static_cast<uint8_t>(StatsWriter::Field::BYTES_RECEIVED),             "bytesReceived"            },
+		{ static_cast<uint8_t>(StatsWriter::Field::BYTES_SENT),                 "bytesSent"                },
+		{ static_cast<uint8_t>(StatsWriter::Field::AVAILABLE_INCOMING_BITRATE), "availableIncomingBitrate" },
+		{ static_cast<uint8_t>(StatsWriter::Field::AVAILABLE_OUTGOING_BITRATE), "availableOutgoingBitrate" },
+		{ static_cast<uint8_t>(StatsWriter::Field::SSRC),                       "ssrc"                     },
+		{ static_cast<uint8_t>(StatsWriter::Field::PACKET_COUNT),               "packetCount"              },
+		{ static_cast<uint8_t>(StatsWriter::Field::BYTE_COUNT),                 "byteCount"                },
+		{ static_cast<uint8_t>(StatsWriter::Field::BITRATE),                    "bitrate"                  },
+		{ static_cast<uint8_t>(StatsWriter::Field::PACKETS_LOST),               "packetsLost"              },
+		{ static_cast<uint8_t>(StatsWriter::Field::FRACTION_LOST),              "fractionLost"             },
+		{ static_cast<uint8_t>(StatsWriter::Field::PACKETS_DISCARDED),          "packetsDiscarded"         },
+		{ static_cast<uint8_t>(StatsWriter::Field::PACKETS_REPAIRED),           "packetsRepaired"          },
+		{ static_cast<uint8_t>(StatsWriter::Field::NACK_COUNT),                 "nackCount"                },
+		{ static_cast<uint8_t>(StatsWriter::Field::NACK_RTP_PACKET_COUNT),      "nackRtpPacketCount"       },
+		{ static_cast<uint8_t>(StatsWriter::Field::PLI_COUNT),                  "pliCount"                 },
+		{ static_cast<uint8_t>(StatsWriter::Field::FIR_COUNT),                  "firCount"                 },
+		{ static_cast<uint8_t>(StatsWriter::Field::SCORE),                      "score"                    }
+	};
+	// clang-format on
+
+	/* Class methods. */
+
+	uint32_t StatsWriter::GetFieldMask(json& data)
+	{
+		MS_TRACE();
+
+		auto jsonFieldsIt = data.find("fields");
+
+		// No mask means all fields.
+		if (jsonFieldsIt == data.end() || jsonFieldsIt->is_null())
+			return (1u << static_cast<uint8_t>(Field::MAX)) - 1;
+
+		if (!jsonFieldsIt->is_array())
+			MS_THROW_TYPE_ERROR("wrong fields (not an array)");
+
+		uint32_t fieldMask{ 0 };
+
+		for (auto& jsonField : *jsonFieldsIt)
+		{
+			if (!jsonField.is_string())
+				MS_THROW_TYPE_ERROR("wrong field (not a string)");
+
+			auto it = StatsWriter::string2Field.find(jsonField.get<std::string>());
+
+			if (it == StatsWriter::string2Field.end())
+				MS_THROW_TYPE_ERROR("unknown field '%s'", jsonField.get<std::string>().c_str());
+
+			fieldMask |= 1u << static_cast<uint8_t>(it->second);
+		}
+
+		return fieldMask;
+	}
+
+	const std::string& StatsWriter::GetFieldName(Field field)
+	{
+		MS_TRACE();
+
+		return StatsWriter::field2String.at(static_cast<uint8_t>(field));
+	}
+
+	/* Instance methods. */
+
+	StatsWriter::StatsWriter(uint32_t fieldMask, uint64_t now, Snapshot* snapshot, Listener* listener)
+	  : fieldMask(fieldMask), now(now), snapshot(snapshot), listener(listener)
+	{
+		MS_TRACE();
+
+		// The ssrc is always needed to identify RtpStream rows.
+		this->fieldMask |= 1u << static_cast<uint8_t>(Field::SSRC);
+
+		// Entries not touched in this generation will be removed on Close().
+		if (this->snapshot)
+			++this->snapshot->generation;
+
+		this->buffer.reserve(InitialBufferSize);
+		this->buffer.append("{\"timestamp\":");
+		this->buffer.append(std::to_string(this->now));
+	}
+
+	void StatsWriter::BeginTable(Table table)
+	{
+		MS_TRACE();
+
+		MS_ASSERT(!this->closed, "StatsWriter closed");
+
+		Field firstField{ Field::SSRC };
+		Field lastField{ Field::SCORE };
+
+		switch (table)
+		{
+			case Table::TRANSPORTS:
+			{
+				this->tableHeader.assign(",\"transports\":");
+				this->table = 't';
+				firstField = Field::BYTES_RECEIVED;
+				lastField  = Field::AVAILABLE_OUTGOING_BITRATE;
+
+				break;
+			}
+
+			case Table::PRODUCERS:
+			{
+				this->tableHeader.assign(",\"producers\":");
+				this->table = 'p';
+				firstField = Field::SSRC;
+				lastField  = Field::SCORE;
+
+				break;
+			}
+
+			case Table::CONSUMERS:
+			{
+				this->tableHeader.assign(",\"consumers\":");
+				this->table = 'c';
+				firstField = Field::SSRC;
+				lastField  = Field::SCORE;
+
+				break;
+			}
+		}
+
+		this->tableHeader.append("{\"fields\":[\"id\"");
+
+		for (auto idx = static_cast<uint8_t>(firstField); idx <= static_cast<uint8_t>(lastField); ++idx)
+		{
+			auto field = static_cast<Field>(idx);
+
+			if (!HasField(field))
+				continue;
+
+			this->tableHeader.push_back(',');
+			Utils::Json::AppendString(this->tableHeader, StatsWriter::GetFieldName(field));
+		}
+
+		this->tableHeader.append("],\"rows\":[");
+
+		this->buffer.append(this->tableHeader);
+		this->firstRow = true;
+	}
+
+	void StatsWriter::EndTable()
+	{
+		MS_TRACE();
+
+		this->buffer.append("]}");
+		this->table = 0;
+	}
+
+	void StatsWriter::BeginRow(const std::string& id)
+	{
+		MS_TRACE();
+
+		// In delta mode the row is written once all its values are known.
+		if (this->snapshot)
+		{
+			this->rowId.assign(id);
+			this->rowValues.clear();
+
+			return;
+		}
+
+		++this->rowCount;
+
+		if (!this->firstRow)
+			this->buffer.push_back(',');
+
+		this->firstRow = false;
+
+		this->buffer.push_back('[');
+		Utils::Json::AppendString(this->buffer, id);
+	}
+
+	void StatsWriter::AddValue(Field field, uint64_t value)
+	{
+		MS_TRACE();
+
+		if (!HasField(field))
+			return;
+
+		if (this->snapshot)
+		{
+			this->rowValues.push_back(value);
+
+			return;
+		}
+
+		this->buffer.push_back(',');
+		this->buffer.append(std::to_string(value));
+	}
+
+	void StatsWriter::EndRow()
+	{
+		MS_TRACE();
+
+		if (this->snapshot)
+			WriteDeltaRow();
+		else
+			this->buffer.push_back(']');
+
+		MayFlushChunk();
+	}
+
+	const std::string& StatsWriter::Close()
+	{
+		MS_TRACE();
+
+		if (!this->closed)
+		{
+			this->closed = true;
+
+			this->buffer.push_back('}');
+
+			// Last chunk (unless nothing was written).
+			if (this->listener && this->rowCount != 0)
+				this->listener->OnStatsWriterChunk(this, this->buffer);
+
+			// Forget entities that no longer exist.
+			if (this->snapshot)
+			{
+				auto& entries = this->snapshot->entries;
+
+				for (auto it = entries.begin(); it != entries.end();)
+				{
+					if (it->second.generation != this->snapshot->generation)
+						it = entries.erase(it);
+					else
+						++it;
+				}
+			}
+		}
+
+		return this->buffer;
+	}
+
+	void StatsWriter::WriteDeltaRow()
+	{
+		MS_TRACE();
+
+		// RtpStream rows are identified by id and ssrc (always the first value).
+		bool isRtpStreamRow = this->table != 't';
+		std::string key(1, this->table);
+
+		key.append(this->rowId);
+
+		if (isRtpStreamRow && !this->rowValues.empty())
+		{
+			key.push_back('/');
+			key.append(std::to_string(this->rowValues[0]));
+		}
+
+		auto& entry     = this->snapshot->entries[key];
+		bool isNewEntry = entry.values.size() != this->rowValues.size();
+		size_t rowStart = this->buffer.length();
+		bool changed{ false };
+
+		entry.generation = this->snapshot->generation;
+
+		if (!this->firstRow)
+			this->buffer.push_back(',');
+
+		this->buffer.push_back('[');
+		Utils::Json::AppendString(this->buffer, this->rowId);
+
+		for (size_t idx{ 0 }; idx < this->rowValues.size(); ++idx)
+		{
+			uint64_t value = this->rowValues[idx];
+			bool isSsrc    = isRtpStreamRow && idx == 0;
+
+			if (!isNewEntry && !isSsrc && entry.values[idx] == value)
+				continue;
+
+			if (!isSsrc)
+				changed = true;
+
+			// Column 0 is the id.
+			this->buffer.push_back(',');
+			this->buffer.append(std::to_string(idx + 1));
+			this->buffer.push_back(',');
+			this->buffer.append(std::to_string(value));
+		}
+
+		this->buffer.push_back(']');
+
+		entry.values = this->rowValues;
+
+		// Nothing changed so discard the row.
+		if (!changed && !isNewEntry)
+		{
+			this->buffer.resize(rowStart);
+
+			return;
+		}
+
+		this->firstRow = false;
+		++this->rowCount;
+	}
+
+	void StatsWriter::MayFlushChunk()
+	{
+		MS_TRACE();
+
+		if (!this->listener || this->buffer.length() < MaxChunkSize)
+			return;
+
+		// Close the current table and the chunk.
+		if (this->table != 0)
+			this->buffer.append("]}");
+
+		this->buffer.append(",\"more\":true}");
+
+		this->listener->OnStatsWriterChunk(this, this->buffer);
+
+		// Start a new chunk and continue the current table on it.
+		this->buffer.clear();
+		this->buffer.append("{\"timestamp\":");
+		this->buffer.append(std::to_string(this->now));
+
+		if (this->table != 0)
+		{
+			this->buffer.append(this->tableHeader);
+			this->firstRow = true;
+		}
+	}
+} // namespace RTC
@@ -4,10 +4,15 @@
 #include "RTC/TcpConnection.hpp"
 #include "Logger.hpp"
 #include "Utils.hpp"
-#include <cstring> // std::memmove()
+#include <cstring> // std::memmove(), std::memcpy()
 
 namespace RTC
 {
+	/* Static. */
+
+	static constexpr size_t GatherBufferSize{ 65536 };
+	static uint8_t GatherBuffer[GatherBufferSize];
+
 	/* Instance methods. */
 
 	TcpConnection::TcpConnection(Listener* listener, size_t bufferSize)
@@ -153,4 +158,27 @@ namespace RTC
 		Utils::Byte::Set2Bytes(frameLen, 0, len);
 		Write(frameLen, 2, data, len);
 	}
+
+	void TcpConnection::Send(const uv_buf_t* buffers, size_t count)
+	{
+		MS_TRACE();
+
+		size_t len{ 0 };
+
+		for (size_t i{ 0 }; i < count; ++i)
+		{
+			if (len + buffers[i].len > GatherBufferSize)
+			{
+				MS_WARN_DEV("frame too big");
+
+				return;
+			}
+
+			std::memcpy(GatherBuffer + len, buffers[i].base, buffers[i].len);
+
+			len += buffers[i].len;
+		}
+
+		Send(GatherBuffer, len);
+	}
 } // namespace RTC
@@ -6,7 +6,9 @@
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
+#include "RTC/BroadcastConsumer.hpp"
 #include "RTC/Consumer.hpp"
+#include "RTC/OverloadController.hpp"
 #include "RTC/PipeConsumer.hpp"
 #include "RTC/RTCP/FeedbackPs.hpp"
 #include "RTC/RTCP/FeedbackPsAfb.hpp"
@@ -17,9 +19,100 @@
 #include "RTC/RtpDictionaries.hpp"
 #include "RTC/SimpleConsumer.hpp"
 #include "RTC/SimulcastConsumer.hpp"
+#include <algorithm> // std::stable_sort()
+#include <unordered_set>
+#include <vector>
 
 namespace RTC
 {
+	/* Static. */
+
+	// RTCP interval multiplier while overloaded.
+	static constexpr uint64_t OverloadRtcpIntervalFactor{ 4 };
+	// Default packet capture settings.
+	static constexpr size_t DefaultCaptureSnapLength{ 96 };
+	static constexpr size_t DefaultCaptureMaxPackets{ 10000 };
+	// Bytes of pcapng capture per response, so the base64 encoded chunk fits
+	// into a Channel message.
+	static constexpr size_t CaptureChunkSize{ 45000 };
+
+	/* Class methods. */
+
+	void Transport::ReadUdpBufferSizes(json& data, uint32_t& recvBufferSize, uint32_t& sendBufferSize)
+	{
+		MS_TRACE();
+
+		auto jsonUdpRecvBufferSizeIt = data.find("udpRecvBufferSize");
+
+		if (jsonUdpRecvBufferSizeIt != data.end())
+		{
+			if (!jsonUdpRecvBufferSizeIt->is_number_unsigned())
+				MS_THROW_TYPE_ERROR("wrong udpRecvBufferSize (not an unsigned number)");
+
+			recvBufferSize = jsonUdpRecvBufferSizeIt->get<uint32_t>();
+		}
+
+		auto jsonUdpSendBufferSizeIt = data.find("udpSendBufferSize");
+
+		if (jsonUdpSendBufferSizeIt != data.end())
+		{
+			if (!jsonUdpSendBufferSizeIt->is_number_unsigned())
+				MS_THROW_TYPE_ERROR("wrong udpSendBufferSize (not an unsigned number)");
+
+			sendBufferSize = jsonUdpSendBufferSizeIt->get<uint32_t>();
+		}
+	}
+
+	uint32_t Transport::DistributeBitrate(
+	  uint32_t bitrate, const std::vector<RTC::Consumer*>& consumers)
+	{
+		MS_TRACE();
+
+		uint32_t remainingBitrate = bitrate;
+		std::vector<RTC::Consumer*> adaptiveConsumers;
+
+		// Consumers that cannot adapt their bitrate (audio ones among them) take
+		// their part first.
+		for (auto* consumer : consumers)
+		{
+			if (consumer->GetType() == RTC::RtpParameters::Type::SIMULCAST)
+			{
+				adaptiveConsumers.push_back(consumer);
+
+				continue;
+			}
+
+			uint32_t usedBitrate = consumer->UseAvailableBitrate(remainingBitrate, false);
+
+			remainingBitrate = usedBitrate < remainingBitrate ? remainingBitrate - usedBitrate : 0u;
+		}
+
+		// Then simulcast Consumers in priority order. All but the first active one
+		// may stop sending if the remaining bitrate is not enough for them.
+		std::stable_sort(
+		  adaptiveConsumers.begin(),
+		  adaptiveConsumers.end(),
+		  [](const RTC::Consumer* a, const RTC::Consumer* b) {
+			  return a->GetPriority() > b->GetPriority();
+		  });
+
+		bool canPause{ false };
+
+		for (auto* consumer : adaptiveConsumers)
+		{
+			uint32_t usedBitrate = consumer->UseAvailableBitrate(remainingBitrate, canPause);
+
+			remainingBitrate = usedBitrate < remainingBitrate ? remainingBitrate - usedBitrate : 0u;
+
+			// Paused Consumers do not send, so they do not take the place of the
+			// first one.
+			if (consumer->IsActive())
+				canPause = true;
+		}
+
+		return remainingBitrate;
+	}
+
 	/* Instance methods. */
 
 	Transport::Transport(const std::string& id, Listener* listener) : id(id), listener(listener)
@@ -57,6 +150,9 @@ namespace RTC
 
 		// Delete the RTCP timer.
 		delete this->rtcpTimer;
+
+		// Delete the packet capture.
+		delete this->packetCapture;
 	}
 
 	void Transport::CloseProducersAndConsumers()
@@ -135,6 +231,27 @@ namespace RTC
 
 			(*jsonMapSsrcConsumerId)[std::to_string(ssrc)] = consumer->id;
 		}
+
+		// Add capture.
+		if (this->packetCapture != nullptr)
+		{
+			this->packetCapture->FillJson(jsonObject["capture"]);
+
+			jsonObject["capture"]["capturing"] = this->capturing;
+		}
+	}
+
+	void Transport::WriteStats(RTC::StatsWriter& writer) const
+	{
+		MS_TRACE();
+
+		// NOTE: Values must be added in the same order as declared in StatsWriter::Field.
+		writer.BeginRow(this->id);
+		writer.AddValue(RTC::StatsWriter::Field::BYTES_RECEIVED, GetRecvBytes());
+		writer.AddValue(RTC::StatsWriter::Field::BYTES_SENT, GetSentBytes());
+		writer.AddValue(RTC::StatsWriter::Field::AVAILABLE_INCOMING_BITRATE, this->availableIncomingBitrate);
+		writer.AddValue(RTC::StatsWriter::Field::AVAILABLE_OUTGOING_BITRATE, this->availableOutgoingBitrate);
+		writer.EndRow();
 	}
 
 	void Transport::HandleRequest(Channel::Request* request)
@@ -247,95 +364,206 @@ namespace RTC
 				// This may throw.
 				SetNewConsumerIdFromRequest(request, consumerId);
 
-				// Get type.
-				auto jsonTypeIt = request->data.find("type");
+				// This may throw.
+				auto* consumer = CreateConsumer(consumerId, producerId, request->data);
 
-				if (jsonTypeIt == request->data.end() || !jsonTypeIt->is_string())
-					MS_THROW_TYPE_ERROR("missing type");
+				// Create status response.
+				json data(json::object());
 
-				// This may throw.
-				auto type = RTC::RtpParameters::GetType(jsonTypeIt->get<std::string>());
+				FillJsonConsumerStatus(consumer, data);
+
+				request->Accept(data);
+
+				// If the Transport is already connected tell it to the new Consumer.
+				if (IsConnected())
+					consumer->TransportConnected();
+
+				break;
+			}
+
+			case Channel::Request::MethodId::TRANSPORT_CONSUME_MANY:
+			{
+				auto jsonConsumersIt = request->data.find("consumers");
+
+				if (jsonConsumersIt == request->data.end() || !jsonConsumersIt->is_array())
+					MS_THROW_TYPE_ERROR("missing consumers");
 
-				RTC::Consumer* consumer{ nullptr };
+				std::unordered_set<std::string> consumerIds;
 
-				switch (type)
+				// Validate ids before creating anything.
+				for (auto& jsonConsumer : *jsonConsumersIt)
 				{
-					case RTC::RtpParameters::Type::NONE:
-					{
-						MS_THROW_TYPE_ERROR("invalid type 'none'");
+					if (!jsonConsumer.is_object())
+						MS_THROW_TYPE_ERROR("wrong consumer (not an object)");
 
-						break;
-					}
+					auto jsonConsumerIdIt = jsonConsumer.find("consumerId");
+					auto jsonProducerIdIt = jsonConsumer.find("producerId");
 
-					case RTC::RtpParameters::Type::SIMPLE:
-					{
-						// This may throw.
-						consumer = new RTC::SimpleConsumer(consumerId, this, request->data);
+					if (jsonConsumerIdIt == jsonConsumer.end() || !jsonConsumerIdIt->is_string())
+						MS_THROW_TYPE_ERROR("missing consumer.consumerId");
 
-						break;
-					}
+					if (jsonProducerIdIt == jsonConsumer.end() || !jsonProducerIdIt->is_string())
+						MS_THROW_TYPE_ERROR("missing consumer.producerId");
 
-					case RTC::RtpParameters::Type::SIMULCAST:
-					{
-						// This may throw.
-						consumer = new RTC::SimulcastConsumer(consumerId, this, request->data);
+					auto consumerId = jsonConsumerIdIt->get<std::string>();
 
-						break;
+					if (
+					  this->mapConsumers.find(consumerId) != this->mapConsumers.end() ||
+					  !consumerIds.insert(consumerId).second)
+					{
+						MS_THROW_ERROR("a Consumer with same consumerId already exists");
 					}
+				}
 
-					case RTC::RtpParameters::Type::SVC:
-					{
-						MS_THROW_TYPE_ERROR("not yet implemented type 'svc'");
+				std::vector<RTC::Consumer*> consumers;
 
-						break;
-					}
+				consumers.reserve(jsonConsumersIt->size());
 
-					case RTC::RtpParameters::Type::PIPE:
+				// Either all the Consumers are created or none.
+				try
+				{
+					for (auto& jsonConsumer : *jsonConsumersIt)
 					{
+						auto consumerId = jsonConsumer["consumerId"].get<std::string>();
+						auto producerId = jsonConsumer["producerId"].get<std::string>();
+
 						// This may throw.
-						consumer = new RTC::PipeConsumer(consumerId, this, request->data);
+						consumers.push_back(CreateConsumer(consumerId, producerId, jsonConsumer));
+					}
+				}
+				catch (const MediaSoupError& error)
+				{
+					for (auto* consumer : consumers)
+					{
+						CloseConsumer(consumer);
+					}
 
-						break;
+					throw;
+				}
+
+				// Create status response.
+				json data(json::array());
+
+				for (auto* consumer : consumers)
+				{
+					data.emplace_back(json::value_t::object);
+
+					FillJsonConsumerStatus(consumer, data.back());
+				}
+
+				request->Accept(data);
+
+				// If the Transport is already connected tell it to the new Consumers.
+				if (IsConnected())
+				{
+					for (auto* consumer : consumers)
+					{
+						consumer->TransportConnected();
 					}
 				}
 
-				// Notify the listener.
-				// This may throw if no Producer is found.
-				try
+				break;
+			}
+
+			case Channel::Request::MethodId::TRANSPORT_CLOSE_CONSUMERS:
+			{
+				auto jsonConsumerIdsIt = request->data.find("consumerIds");
+
+				if (jsonConsumerIdsIt == request->data.end() || !jsonConsumerIdsIt->is_array())
+					MS_THROW_TYPE_ERROR("missing consumerIds");
+
+				// Unknown (i.e. already closed) Consumers are ignored.
+				for (auto& jsonConsumerId : *jsonConsumerIdsIt)
 				{
-					this->listener->OnTransportNewConsumer(this, consumer, producerId);
+					if (!jsonConsumerId.is_string())
+						MS_THROW_TYPE_ERROR("wrong consumerId (not a string)");
+
+					auto it = this->mapConsumers.find(jsonConsumerId.get<std::string>());
+
+					if (it == this->mapConsumers.end())
+						continue;
+
+					CloseConsumer(it->second);
 				}
-				catch (const MediaSoupError& error)
+
+				request->Accept();
+
+				break;
+			}
+
+			case Channel::Request::MethodId::TRANSPORT_START_CAPTURE:
+			{
+				size_t snapLength{ DefaultCaptureSnapLength };
+				size_t maxPackets{ DefaultCaptureMaxPackets };
+
+				auto jsonSnapLengthIt = request->data.find("snapLength");
+
+				if (jsonSnapLengthIt != request->data.end())
 				{
-					delete consumer;
+					if (!jsonSnapLengthIt->is_number_unsigned())
+						MS_THROW_TYPE_ERROR("wrong snapLength (not a number)");
 
-					throw;
+					snapLength = jsonSnapLengthIt->get<size_t>();
 				}
 
-				// Insert into the maps.
-				this->mapConsumers[consumerId] = consumer;
+				auto jsonMaxPacketsIt = request->data.find("maxPackets");
 
-				for (auto ssrc : consumer->GetMediaSsrcs())
+				if (jsonMaxPacketsIt != request->data.end())
 				{
-					this->mapSsrcConsumer[ssrc] = consumer;
+					if (!jsonMaxPacketsIt->is_number_unsigned())
+						MS_THROW_TYPE_ERROR("wrong maxPackets (not a number)");
+
+					maxPackets = jsonMaxPacketsIt->get<size_t>();
 				}
 
-				MS_DEBUG_DEV(
-				  "Consumer created [consumerId:%s, producerId:%s]", consumerId.c_str(), producerId.c_str());
+				// This may throw.
+				auto* capture = new RTC::PacketCapture(snapLength, maxPackets);
 
-				// Create status response.
-				json data(json::object());
+				// Any previous capture is discarded.
+				delete this->packetCapture;
 
-				data["paused"]         = consumer->IsPaused();
-				data["producerPaused"] = consumer->IsProducerPaused();
+				this->packetCapture = capture;
+				this->capturing     = true;
+				this->captureSnapshot.clear();
 
-				consumer->FillJsonScore(data["score"]);
+				request->Accept();
 
-				request->Accept(data);
+				break;
+			}
 
-				// If the Transport is already connected tell it to the new Consumer.
-				if (IsConnected())
-					consumer->TransportConnected();
+			case Channel::Request::MethodId::TRANSPORT_STOP_CAPTURE:
+			{
+				// Captured packets are kept until a new capture is started.
+				this->capturing = false;
+
+				request->Accept();
+
+				break;
+			}
+
+			case Channel::Request::MethodId::TRANSPORT_GET_CAPTURE:
+			{
+				if (this->packetCapture == nullptr)
+					MS_THROW_ERROR("no capture");
+
+				size_t offset{ 0 };
+
+				auto jsonOffsetIt = request->data.find("offset");
+
+				if (jsonOffsetIt != request->data.end())
+				{
+					if (!jsonOffsetIt->is_number_unsigned())
+						MS_THROW_TYPE_ERROR("wrong offset (not a number)");
+
+					offset = jsonOffsetIt->get<size_t>();
+				}
+
+				json data(json::object());
+
+				// This may throw.
+				FillCaptureChunk(offset, data);
+
+				request->Accept(data);
 
 				break;
 			}
@@ -369,21 +597,7 @@ namespace RTC
 				// This may throw.
 				RTC::Consumer* consumer = GetConsumerFromRequest(request);
 
-				// Remove it from the maps.
-				this->mapConsumers.erase(consumer->id);
-
-				for (auto ssrc : consumer->GetMediaSsrcs())
-				{
-					this->mapSsrcConsumer.erase(ssrc);
-				}
-
-				// Notify the listener.
-				this->listener->OnTransportConsumerClosed(this, consumer);
-
-				MS_DEBUG_DEV("Consumer closed [consumerId:%s]", consumer->id.c_str());
-
-				// Delete it.
-				delete consumer;
+				CloseConsumer(consumer);
 
 				request->Accept();
 
@@ -418,6 +632,20 @@ namespace RTC
 				break;
 			}
 
+			case Channel::Request::MethodId::CONSUMER_SET_PRIORITY:
+			{
+				// This may throw.
+				RTC::Consumer* consumer = GetConsumerFromRequest(request);
+
+				consumer->HandleRequest(request);
+
+				// Distribute the available bitrate again according to the new priority.
+				if (this->availableOutgoingBitrate != 0u)
+					DistributeAvailableOutgoingBitrate();
+
+				break;
+			}
+
 			default:
 			{
 				MS_THROW_ERROR("unknown method '%s'", request->method.c_str());
@@ -425,10 +653,140 @@ namespace RTC
 		}
 	}
 
+	RTC::Consumer* Transport::CreateConsumer(
+	  const std::string& consumerId, std::string& producerId, json& data)
+	{
+		MS_TRACE();
+
+		// Get type.
+		auto jsonTypeIt = data.find("type");
+
+		if (jsonTypeIt == data.end() || !jsonTypeIt->is_string())
+			MS_THROW_TYPE_ERROR("missing type");
+
+		// This may throw.
+		auto type = RTC::RtpParameters::GetType(jsonTypeIt->get<std::string>());
+
+		RTC::Consumer* consumer{ nullptr };
+
+		switch (type)
+		{
+			case RTC::RtpParameters::Type::NONE:
+			{
+				MS_THROW_TYPE_ERROR("invalid type 'none'");
+
+				break;
+			}
+
+			case RTC::RtpParameters::Type::SIMPLE:
+			{
+				// This may throw.
+				consumer = new RTC::SimpleConsumer(consumerId, this, data);
+
+				break;
+			}
+
+			case RTC::RtpParameters::Type::SIMULCAST:
+			{
+				// This may throw.
+				consumer = new RTC::SimulcastConsumer(consumerId, this, data);
+
+				break;
+			}
+
+			case RTC::RtpParameters::Type::SVC:
+			{
+				MS_THROW_TYPE_ERROR("not yet implemented type 'svc'");
+
+				break;
+			}
+
+			case RTC::RtpParameters::Type::PIPE:
+			{
+				// This may throw.
+				consumer = new RTC::PipeConsumer(consumerId, this, data);
+
+				break;
+			}
+
+			case RTC::RtpParameters::Type::BROADCAST:
+			{
+				// This may throw.
+				consumer = new RTC::BroadcastConsumer(consumerId, this, data);
+
+				break;
+			}
+		}
+
+		// Notify the listener.
+		// This may throw if no Producer is found.
+		try
+		{
+			this->listener->OnTransportNewConsumer(this, consumer, producerId);
+		}
+		catch (const MediaSoupError& error)
+		{
+			delete consumer;
+
+			throw;
+		}
+
+		// Insert into the maps.
+		this->mapConsumers[consumerId] = consumer;
+
+		for (auto ssrc : consumer->GetMediaSsrcs())
+		{
+			this->mapSsrcConsumer[ssrc] = consumer;
+		}
+
+		MS_DEBUG_DEV(
+		  "Consumer created [consumerId:%s, producerId:%s]", consumerId.c_str(), producerId.c_str());
+
+		return consumer;
+	}
+
+	void Transport::CloseConsumer(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		// Remove it from the maps.
+		this->mapConsumers.erase(consumer->id);
+
+		for (auto ssrc : consumer->GetMediaSsrcs())
+		{
+			this->mapSsrcConsumer.erase(ssrc);
+		}
+
+		// Notify the listener.
+		this->listener->OnTransportConsumerClosed(this, consumer);
+
+		MS_DEBUG_DEV("Consumer closed [consumerId:%s]", consumer->id.c_str());
+
+		// Delete it.
+		delete consumer;
+	}
+
+	void Transport::FillJsonConsumerStatus(RTC::Consumer* consumer, json& jsonObject) const
+	{
+		MS_TRACE();
+
+		jsonObject["paused"]         = consumer->IsPaused();
+		jsonObject["producerPaused"] = consumer->IsProducerPaused();
+		jsonObject["priority"]       = consumer->GetPriority();
+
+		consumer->FillJsonScore(jsonObject["score"]);
+	}
+
 	void Transport::Connected()
 	{
 		MS_TRACE();
 
+		// May be called again with no disconnection in between.
+		if (this->connected)
+			return;
+
+		this->connected = true;
+
 		// Start the RTCP timer.
 		this->rtcpTimer->Start(static_cast<uint64_t>(RTC::RTCP::MaxVideoIntervalMs / 2));
 
@@ -446,8 +804,22 @@ namespace RTC
 	{
 		MS_TRACE();
 
+		if (!this->connected)
+			return;
+
+		this->connected = false;
+
 		// Stop the RTCP timer.
 		this->rtcpTimer->Stop();
+
+		// Iterate all Consumers and tell them that the Transport is disconnected,
+		// so they will stop processing RTP packets.
+		for (auto& kv : this->mapConsumers)
+		{
+			auto* consumer = kv.second;
+
+			consumer->TransportDisconnected();
+		}
 	}
 
 	void Transport::ReceiveRtcpPacket(RTC::RTCP::Packet* packet)
@@ -531,6 +903,8 @@ namespace RTC
 
 							this->availableOutgoingBitrate = remb->GetBitrate();
 
+							DistributeAvailableOutgoingBitrate();
+
 							break;
 						}
 						else
@@ -755,6 +1129,56 @@ namespace RTC
 		return consumer;
 	}
 
+	void Transport::DistributeAvailableOutgoingBitrate()
+	{
+		MS_TRACE();
+
+		std::vector<RTC::Consumer*> consumers;
+
+		consumers.reserve(this->mapConsumers.size());
+
+		for (auto& kv : this->mapConsumers)
+		{
+			consumers.push_back(kv.second);
+		}
+
+		uint32_t remainingBitrate = DistributeBitrate(this->availableOutgoingBitrate, consumers);
+
+		MS_DEBUG_TAG(
+		  rbe,
+		  "available outgoing bitrate distributed [available:%" PRIu32 "bps, remaining:%" PRIu32
+		  "bps]",
+		  this->availableOutgoingBitrate,
+		  remainingBitrate);
+	}
+
+	void Transport::FillCaptureChunk(size_t offset, json& data)
+	{
+		MS_TRACE();
+
+		// The capture is serialized when its first chunk is requested, so all the
+		// chunks belong to the same snapshot.
+		if (offset == 0)
+			this->packetCapture->Serialize(this->captureSnapshot);
+
+		if (this->captureSnapshot.empty() || offset >= this->captureSnapshot.size())
+			MS_THROW_TYPE_ERROR("wrong offset");
+
+		size_t size = this->captureSnapshot.size();
+		size_t len  = std::min(size - offset, CaptureChunkSize);
+
+		data["size"]   = size;
+		data["offset"] = offset;
+		data["data"]   = Utils::String::Base64Encode(this->captureSnapshot.data() + offset, len);
+
+		// Release the snapshot once the last chunk is fetched.
+		if (offset + len == size)
+		{
+			this->captureSnapshot.clear();
+			this->captureSnapshot.shrink_to_fit();
+		}
+	}
+
 	void Transport::SendRtcp(uint64_t now)
 	{
 		MS_TRACE();
@@ -866,11 +1290,12 @@ namespace RTC
 		  this, producer, mappedSsrc, worstRemoteFractionLost);
 	}
 
-	inline void Transport::OnConsumerSendRtpPacket(RTC::Consumer* /*consumer*/, RTC::RtpPacket* packet)
+	inline void Transport::OnConsumerSendRtpPacket(
+	  RTC::Consumer* /*consumer*/, const RTC::RtpPacketOverlay& overlay)
 	{
 		MS_TRACE();
 
-		SendRtpPacket(packet);
+		SendRtpPacket(overlay);
 	}
 
 	inline void Transport::OnConsumerKeyFrameRequested(RTC::Consumer* consumer, uint32_t mappedSsrc)
@@ -880,6 +1305,13 @@ namespace RTC
 		this->listener->OnTransportConsumerKeyFrameRequested(this, consumer, mappedSsrc);
 	}
 
+	inline void Transport::OnConsumerSubscriptionChanged(RTC::Consumer* consumer)
+	{
+		MS_TRACE();
+
+		this->listener->OnTransportConsumerSubscriptionChanged(this, consumer);
+	}
+
 	inline void Transport::onConsumerProducerClosed(RTC::Consumer* consumer)
 	{
 		MS_TRACE();
@@ -938,6 +1370,11 @@ namespace RTC
 			 * of all participants.
 			 */
 			interval *= static_cast<float>(Utils::Crypto::GetRandomUInt(5, 15)) / 10;
+
+			// Send RTCP less often while overloaded.
+			if (RTC::OverloadController::IsLevelReached(RTC::OverloadController::Level::STRETCH_RTCP))
+				interval *= OverloadRtcpIntervalFactor;
+
 			this->rtcpTimer->Start(interval);
 		}
 	}
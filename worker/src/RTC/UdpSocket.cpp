@@ -3,6 +3,7 @@
 
 #include "RTC/UdpSocket.hpp"
 #include "Logger.hpp"
+#include "Settings.hpp"
 #include "RTC/PortManager.hpp"
 #include <string>
 
@@ -10,11 +11,24 @@ namespace RTC
 {
 	/* Instance methods. */
 
-	UdpSocket::UdpSocket(Listener* listener, std::string& ip)
+	UdpSocket::UdpSocket(
+	  Listener* listener, std::string& ip, uint32_t recvBufferSize, uint32_t sendBufferSize)
 	  : // This may throw.
 	    ::UdpSocket::UdpSocket(PortManager::BindUdp(ip)), listener(listener)
 	{
 		MS_TRACE();
+
+		if (recvBufferSize == 0u)
+			recvBufferSize = Settings::configuration.udpRecvBufferSize;
+
+		if (sendBufferSize == 0u)
+			sendBufferSize = Settings::configuration.udpSendBufferSize;
+
+		if (recvBufferSize != 0u)
+			SetRecvBufferSize(recvBufferSize);
+
+		if (sendBufferSize != 0u)
+			SetSendBufferSize(sendBufferSize);
 	}
 
 	UdpSocket::~UdpSocket()
@@ -24,7 +38,8 @@ namespace RTC
 		PortManager::UnbindUdp(this->localIp, this->localPort);
 	}
 
-	void UdpSocket::UserOnUdpDatagramRecv(const uint8_t* data, size_t len, const struct sockaddr* addr)
+	void UdpSocket::UserOnUdpDatagramRecv(
+	  const uint8_t* data, size_t len, const struct sockaddr* addr, uint64_t arrivalTime)
 	{
 		MS_TRACE();
 
@@ -36,6 +51,6 @@ namespace RTC
 		}
 
 		// Notify the reader.
-		this->listener->OnPacketRecv(this, data, len, addr);
+		this->listener->OnPacketRecv(this, data, len, addr, arrivalTime);
 	}
 } // namespace RTC
@@ -82,6 +82,12 @@ namespace RTC
 			preferTcp = jsonPreferTcpIt->get<bool>();
 		}
 
+		uint32_t udpRecvBufferSize{ 0 };
+		uint32_t udpSendBufferSize{ 0 };
+
+		// This may throw.
+		ReadUdpBufferSizes(data, udpRecvBufferSize, udpSendBufferSize);
+
 		auto jsonListenIpsIt = data.find("listenIps");
 
 		if (jsonListenIpsIt == data.end())
@@ -148,7 +154,8 @@ namespace RTC
 					uint32_t icePriority = generateIceCandidatePriority(iceLocalPreference);
 
 					// This may throw.
-					auto* udpSocket = new RTC::UdpSocket(this, listenIp.ip);
+					auto* udpSocket =
+					  new RTC::UdpSocket(this, listenIp.ip, udpRecvBufferSize, udpSendBufferSize);
 
 					this->udpSockets[udpSocket] = listenIp.announcedIp;
 
@@ -469,6 +476,25 @@ namespace RTC
 		// Add maxIncomingBitrate.
 		if (this->maxIncomingBitrate != 0u)
 			jsonObject["maxIncomingBitrate"] = this->maxIncomingBitrate;
+
+		// Add UDP socket stats (all of them have the same buffer sizes).
+		if (!this->udpSockets.empty())
+		{
+			auto* udpSocket = this->udpSockets.begin()->first;
+			uint32_t udpRecvDrops{ 0 };
+			size_t udpSendEagains{ 0 };
+
+			for (auto& kv : this->udpSockets)
+			{
+				udpRecvDrops += kv.first->GetRecvDrops();
+				udpSendEagains += kv.first->GetSendEagains();
+			}
+
+			jsonObject["udpRecvBufferSize"] = udpSocket->GetRecvBufferSize();
+			jsonObject["udpSendBufferSize"] = udpSocket->GetSendBufferSize();
+			jsonObject["udpRecvDrops"]      = udpRecvDrops;
+			jsonObject["udpSendEagains"]    = udpSendEagains;
+		}
 	}
 
 	void WebRtcTransport::HandleRequest(Channel::Request* request)
@@ -670,6 +696,22 @@ namespace RTC
 		  this->dtlsTransport->GetState() == RTC::DtlsTransport::DtlsState::CONNECTED);
 	}
 
+	inline size_t WebRtcTransport::GetRecvBytes() const
+	{
+		if (this->iceSelectedTuple == nullptr)
+			return 0;
+
+		return this->iceSelectedTuple->GetRecvBytes();
+	}
+
+	inline size_t WebRtcTransport::GetSentBytes() const
+	{
+		if (this->iceSelectedTuple == nullptr)
+			return 0;
+
+		return this->iceSelectedTuple->GetSentBytes();
+	}
+
 	void WebRtcTransport::MayRunDtlsTransport()
 	{
 		MS_TRACE();
@@ -744,7 +786,7 @@ namespace RTC
 		}
 	}
 
-	void WebRtcTransport::SendRtpPacket(RTC::RtpPacket* packet)
+	void WebRtcTransport::SendRtpPacket(const RTC::RtpPacketOverlay& overlay)
 	{
 		MS_TRACE();
 
@@ -759,10 +801,12 @@ namespace RTC
 			return;
 		}
 
-		const uint8_t* data = packet->GetData();
-		size_t len          = packet->GetSize();
+		const uint8_t* data{ nullptr };
+		size_t len{ 0 };
+
+		CapturePacket(RTC::PacketCapture::Direction::OUT, overlay);
 
-		if (!this->srtpSendSession->EncryptRtp(&data, &len))
+		if (!this->srtpSendSession->EncryptRtp(overlay, &data, &len))
 			return;
 
 		this->iceSelectedTuple->Send(data, len);
@@ -786,6 +830,8 @@ namespace RTC
 			return;
 		}
 
+		CapturePacket(RTC::PacketCapture::Direction::OUT, data, len);
+
 		if (!this->srtpSendSession->EncryptRtcp(&data, &len))
 			return;
 
@@ -810,13 +856,16 @@ namespace RTC
 			return;
 		}
 
+		CapturePacket(RTC::PacketCapture::Direction::OUT, data, len);
+
 		if (!this->srtpSendSession->EncryptRtcp(&data, &len))
 			return;
 
 		this->iceSelectedTuple->Send(data, len);
 	}
 
-	inline void WebRtcTransport::OnPacketRecv(RTC::TransportTuple* tuple, const uint8_t* data, size_t len)
+	inline void WebRtcTransport::OnPacketRecv(
+	  RTC::TransportTuple* tuple, const uint8_t* data, size_t len, uint64_t arrivalTime)
 	{
 		MS_TRACE();
 
@@ -833,7 +882,7 @@ namespace RTC
 		// Check if it's RTP.
 		else if (RTC::RtpPacket::IsRtp(data, len))
 		{
-			OnRtpDataRecv(tuple, data, len);
+			OnRtpDataRecv(tuple, data, len, arrivalTime);
 		}
 		// Check if it's DTLS.
 		else if (RTC::DtlsTransport::IsDtls(data, len))
@@ -898,7 +947,8 @@ namespace RTC
 		}
 	}
 
-	inline void WebRtcTransport::OnRtpDataRecv(RTC::TransportTuple* tuple, const uint8_t* data, size_t len)
+	inline void WebRtcTransport::OnRtpDataRecv(
+	  RTC::TransportTuple* tuple, const uint8_t* data, size_t len, uint64_t arrivalTime)
 	{
 		MS_TRACE();
 
@@ -950,6 +1000,8 @@ namespace RTC
 			return;
 		}
 
+		CapturePacket(RTC::PacketCapture::Direction::IN, data, len);
+
 		RTC::RtpPacket* packet = RTC::RtpPacket::Parse(data, len);
 
 		if (packet == nullptr)
@@ -965,13 +1017,14 @@ namespace RTC
 		packet->SetRidExtensionId(this->rtpHeaderExtensionIds.rid);
 		packet->SetRepairedRidExtensionId(this->rtpHeaderExtensionIds.rrid);
 
-		// Feed the remote bitrate estimator (REMB).
+		// Feed the remote bitrate estimator (REMB) with the time the packet was
+		// received rather than the time it is processed.
 		uint32_t absSendTime;
 
 		if (packet->ReadAbsSendTime(absSendTime))
 		{
 			this->rembRemoteBitrateEstimator->IncomingPacket(
-			  DepLibUV::GetTime(), packet->GetPayloadLength(), *packet, absSendTime);
+			  arrivalTime, packet->GetPayloadLength(), *packet, absSendTime);
 		}
 
 		// Get the associated Producer.
@@ -1037,6 +1090,8 @@ namespace RTC
 		if (!this->srtpRecvSession->DecryptSrtcp(data, &len))
 			return;
 
+		CapturePacket(RTC::PacketCapture::Direction::IN, data, len);
+
 		RTC::RTCP::Packet* packet = RTC::RTCP::Packet::Parse(data, len);
 
 		if (packet == nullptr)
@@ -1059,13 +1114,17 @@ namespace RTC
 	}
 
 	inline void WebRtcTransport::OnPacketRecv(
-	  RTC::UdpSocket* socket, const uint8_t* data, size_t len, const struct sockaddr* remoteAddr)
+	  RTC::UdpSocket* socket,
+	  const uint8_t* data,
+	  size_t len,
+	  const struct sockaddr* remoteAddr,
+	  uint64_t arrivalTime)
 	{
 		MS_TRACE();
 
 		RTC::TransportTuple tuple(socket, remoteAddr);
 
-		OnPacketRecv(&tuple, data, len);
+		OnPacketRecv(&tuple, data, len, arrivalTime);
 	}
 
 	inline void WebRtcTransport::OnRtcTcpConnectionClosed(
@@ -1086,7 +1145,7 @@ namespace RTC
 
 		RTC::TransportTuple tuple(connection);
 
-		OnPacketRecv(&tuple, data, len);
+		OnPacketRecv(&tuple, data, len, DepLibUV::GetTime());
 	}
 
 	inline void WebRtcTransport::OnOutgoingStunMessage(
@@ -1138,6 +1197,10 @@ namespace RTC
 
 		// If ready, run the DTLS handler.
 		MayRunDtlsTransport();
+
+		// If DTLS was already connected (ICE reconnected) tell the parent class.
+		if (IsConnected())
+			RTC::Transport::Connected();
 	}
 
 	inline void WebRtcTransport::OnIceCompleted(const RTC::IceServer* /*iceServer*/)
@@ -1155,6 +1218,10 @@ namespace RTC
 
 		// If ready, run the DTLS handler.
 		MayRunDtlsTransport();
+
+		// If DTLS was already connected (ICE reconnected) tell the parent class.
+		if (IsConnected())
+			RTC::Transport::Connected();
 	}
 
 	inline void WebRtcTransport::OnIceDisconnected(const RTC::IceServer* /*iceServer*/)
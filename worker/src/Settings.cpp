@@ -47,12 +47,18 @@ void Settings::SetConfiguration(int argc, char* argv[])
 	// clang-format off
 	struct option options[] =
 	{
-		{ "logLevel",            optional_argument, nullptr, 'l' },
-		{ "logTags",             optional_argument, nullptr, 't' },
-		{ "rtcMinPort",          optional_argument, nullptr, 'm' },
-		{ "rtcMaxPort",          optional_argument, nullptr, 'M' },
-		{ "dtlsCertificateFile", optional_argument, nullptr, 'c' },
-		{ "dtlsPrivateKeyFile",  optional_argument, nullptr, 'p' },
+		{ "logLevel",             optional_argument, nullptr, 'l' },
+		{ "logTags",              optional_argument, nullptr, 't' },
+		{ "rtcMinPort",           optional_argument, nullptr, 'm' },
+		{ "rtcMaxPort",           optional_argument, nullptr, 'M' },
+		{ "dtlsCertificateFile",  optional_argument, nullptr, 'c' },
+		{ "dtlsPrivateKeyFile",   optional_argument, nullptr, 'p' },
+		{ "loopLagThreshold",     optional_argument, nullptr, 'L' },
+		{ "overloadLagThreshold", optional_argument, nullptr, 'O' },
+		{ "udpBackend",           optional_argument, nullptr, 'u' },
+		{ "udpRecvBufferSize",    optional_argument, nullptr, 'R' },
+		{ "udpSendBufferSize",    optional_argument, nullptr, 'S' },
+		{ "udpRecvTimestamps",    optional_argument, nullptr, 'T' },
 		{ nullptr, 0, nullptr, 0 }
 	};
 	// clang-format on
@@ -129,6 +135,87 @@ void Settings::SetConfiguration(int argc, char* argv[])
 				break;
 			}
 
+			case 'L':
+			{
+				try
+				{
+					Settings::configuration.loopLagThreshold = static_cast<uint32_t>(std::stoul(optarg));
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				break;
+			}
+
+			case 'O':
+			{
+				try
+				{
+					Settings::configuration.overloadLagThreshold =
+					  static_cast<uint32_t>(std::stoul(optarg));
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				break;
+			}
+
+			case 'u':
+			{
+				stringValue = std::string(optarg);
+
+				if (stringValue != "libuv" && stringValue != "io_uring")
+					MS_THROW_TYPE_ERROR("invalid udpBackend '%s'", stringValue.c_str());
+
+				Settings::configuration.udpBackend = stringValue;
+
+				break;
+			}
+
+			case 'R':
+			{
+				try
+				{
+					Settings::configuration.udpRecvBufferSize = static_cast<uint32_t>(std::stoul(optarg));
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				break;
+			}
+
+			case 'S':
+			{
+				try
+				{
+					Settings::configuration.udpSendBufferSize = static_cast<uint32_t>(std::stoul(optarg));
+				}
+				catch (const std::exception& error)
+				{
+					MS_THROW_TYPE_ERROR("%s", error.what());
+				}
+
+				break;
+			}
+
+			case 'T':
+			{
+				stringValue = std::string(optarg);
+
+				if (stringValue != "true" && stringValue != "false")
+					MS_THROW_TYPE_ERROR("invalid udpRecvTimestamps '%s'", stringValue.c_str());
+
+				Settings::configuration.udpRecvTimestamps = stringValue == "true";
+
+				break;
+			}
+
 			// Invalid option.
 			case '?':
 			{
@@ -208,6 +295,19 @@ void Settings::PrintConfiguration()
 	MS_DEBUG_TAG(info, "  logTags             : %s", logTagsStream.str().c_str());
 	MS_DEBUG_TAG(info, "  rtcMinPort          : %" PRIu16, Settings::configuration.rtcMinPort);
 	MS_DEBUG_TAG(info, "  rtcMaxPort          : %" PRIu16, Settings::configuration.rtcMaxPort);
+	MS_DEBUG_TAG(
+	  info, "  loopLagThreshold    : %" PRIu32, Settings::configuration.loopLagThreshold);
+	MS_DEBUG_TAG(
+	  info, "  overloadLagThreshold: %" PRIu32, Settings::configuration.overloadLagThreshold);
+	MS_DEBUG_TAG(info, "  udpBackend          : %s", Settings::configuration.udpBackend.c_str());
+	MS_DEBUG_TAG(
+	  info, "  udpRecvBufferSize   : %" PRIu32, Settings::configuration.udpRecvBufferSize);
+	MS_DEBUG_TAG(
+	  info, "  udpSendBufferSize   : %" PRIu32, Settings::configuration.udpSendBufferSize);
+	MS_DEBUG_TAG(
+	  info,
+	  "  udpRecvTimestamps   : %s",
+	  Settings::configuration.udpRecvTimestamps ? "true" : "false");
 	if (!Settings::configuration.dtlsCertificateFile.empty())
 	{
 		MS_DEBUG_TAG(
@@ -229,6 +329,8 @@ void Settings::HandleRequest(Channel::Request* request)
 		{
 			auto jsonLogLevelIt = request->data.find("logLevel");
 			auto jsonLogTagsIt  = request->data.find("logTags");
+			auto jsonLoopLagThresholdIt = request->data.find("loopLagThreshold");
+			auto jsonOverloadLagThresholdIt = request->data.find("overloadLagThreshold");
 
 			// Update logLevel if requested.
 			if (jsonLogLevelIt != request->data.end() && jsonLogLevelIt->is_string())
@@ -253,6 +355,23 @@ void Settings::HandleRequest(Channel::Request* request)
 				Settings::SetLogTags(logTags);
 			}
 
+			// Update loopLagThreshold if requested.
+			if (
+			  jsonLoopLagThresholdIt != request->data.end() &&
+			  jsonLoopLagThresholdIt->is_number_unsigned())
+			{
+				Settings::configuration.loopLagThreshold = jsonLoopLagThresholdIt->get<uint32_t>();
+			}
+
+			// Update overloadLagThreshold if requested.
+			if (
+			  jsonOverloadLagThresholdIt != request->data.end() &&
+			  jsonOverloadLagThresholdIt->is_number_unsigned())
+			{
+				Settings::configuration.overloadLagThreshold =
+				  jsonOverloadLagThresholdIt->get<uint32_t>();
+			}
+
 			// Print the new effective configuration.
 			Settings::PrintConfiguration();
 
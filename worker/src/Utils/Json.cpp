@@ -0,0 +1,47 @@
+#define MS_CLASS "Utils::Json"
+// #define MS_LOG_DEV
+
+#include "Logger.hpp"
+#include "Utils.hpp"
+#include <cstdio> // std::snprintf()
+
+namespace Utils
+{
+	void Json::AppendString(std::string& buffer, const std::string& value)
+	{
+		MS_TRACE();
+
+		buffer.push_back('"');
+
+		for (auto c : value)
+		{
+			switch (c)
+			{
+				case '"':
+					buffer.append("\\\"");
+					break;
+
+				case '\\':
+					buffer.append("\\\\");
+					break;
+
+				default:
+				{
+					if (static_cast<uint8_t>(c) < 0x20)
+					{
+						char escaped[8];
+
+						std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<uint8_t>(c));
+						buffer.append(escaped);
+					}
+					else
+					{
+						buffer.push_back(c);
+					}
+				}
+			}
+		}
+
+		buffer.push_back('"');
+	}
+} // namespace Utils
@@ -2,11 +2,14 @@
 // #define MS_LOG_DEV
 
 #include "Worker.hpp"
+#include "DepIoUring.hpp"
 #include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Settings.hpp"
+#include "Utils.hpp"
 #include "Channel/Notifier.hpp"
+#include "RTC/OverloadController.hpp"
 
 /* Instance methods. */
 
@@ -24,6 +27,9 @@ Worker::Worker(Channel::UnixStreamSocket* channel) : channel(channel)
 	this->signalsHandler->AddSignal(SIGINT, "INT");
 	this->signalsHandler->AddSignal(SIGTERM, "TERM");
 
+	// Measure the loop activity.
+	DepLibUV::StartLoopMonitor(this);
+
 	// Tell the Node process that we are running.
 	Channel::Notifier::Emit(std::to_string(Logger::pid), "running");
 
@@ -52,6 +58,9 @@ void Worker::Close()
 	// Delete the SignalsHandler.
 	delete this->signalsHandler;
 
+	// Stop the loop monitor.
+	DepLibUV::StopLoopMonitor();
+
 	// Delete all Routers.
 	for (auto& kv : this->mapRouters)
 	{
@@ -65,22 +74,76 @@ void Worker::Close()
 	delete this->channel;
 }
 
-void Worker::FillJson(json& jsonObject) const
+void Worker::FillJson(std::string& buffer, Channel::DumpPager& pager) const
 {
 	MS_TRACE();
 
 	// Add pid.
-	jsonObject["pid"] = Logger::pid;
+	buffer.append("{\"pid\":");
+	buffer.append(std::to_string(Logger::pid));
 
 	// Add routerIds.
-	jsonObject["routerIds"] = json::array();
-	auto jsonRouterIdsIt    = jsonObject.find("routerIds");
+	buffer.append(",\"routerIds\":[");
 
-	for (auto& kv : this->mapRouters)
+	for (auto it = pager.Begin(0, this->mapRouters); it != this->mapRouters.end(); ++it)
+	{
+		if (!pager.Add(0, it->first, buffer.length()))
+			break;
+
+		if (buffer.back() != '[')
+			buffer.push_back(',');
+
+		Utils::Json::AppendString(buffer, it->first);
+	}
+
+	buffer.push_back(']');
+
+	// Add nextCursor.
+	if (pager.IsPaginated())
+	{
+		buffer.push_back(',');
+		pager.AppendNextCursor(buffer);
+	}
+
+	buffer.push_back('}');
+}
+
+void Worker::FillJsonLoopStats(json& jsonObject) const
+{
+	MS_TRACE();
+
+	DepLibUV::LoopStats stats;
+
+	DepLibUV::GetLoopStats(stats);
+
+	// Times are given in milliseconds.
+	jsonObject["iterations"]               = stats.iterations;
+	jsonObject["callbacks"]                = stats.callbacks;
+	jsonObject["maxCallbacksPerIteration"] = stats.maxCallbacksPerIteration;
+	jsonObject["pollTime"]                 = stats.pollTime / 1000.0;
+	jsonObject["busyTime"]                 = stats.busyTime / 1000.0;
+	jsonObject["lagP50"]                   = stats.lagP50 / 1000.0;
+	jsonObject["lagP90"]                   = stats.lagP90 / 1000.0;
+	jsonObject["lagP99"]                   = stats.lagP99 / 1000.0;
+	jsonObject["lagMax"]                   = stats.lagMax / 1000.0;
+	jsonObject["recvDelayP50"]             = stats.recvDelayP50 / 1000.0;
+	jsonObject["recvDelayP99"]             = stats.recvDelayP99 / 1000.0;
+	jsonObject["recvDelayMax"]             = stats.recvDelayMax / 1000.0;
+	jsonObject["overloadLevel"]            = RTC::OverloadController::GetLevelString();
+	jsonObject["overloadLevelChanges"]     = RTC::OverloadController::GetLevelChanges();
+
+	if (DepIoUring::IsActive())
 	{
-		auto& routerId = kv.first;
+		auto& ioUringStats = DepIoUring::GetStats();
 
-		jsonRouterIdsIt->emplace_back(routerId);
+		jsonObject["ioUring"] = json::object();
+		auto jsonIoUringIt    = jsonObject.find("ioUring");
+
+		(*jsonIoUringIt)["submits"]         = ioUringStats.submits;
+		(*jsonIoUringIt)["recvCompletions"] = ioUringStats.recvCompletions;
+		(*jsonIoUringIt)["sendCompletions"] = ioUringStats.sendCompletions;
+		(*jsonIoUringIt)["sendFallbacks"]   = ioUringStats.sendFallbacks;
+		(*jsonIoUringIt)["recvRearms"]      = ioUringStats.recvRearms;
 	}
 }
 
@@ -128,10 +191,23 @@ inline void Worker::OnChannelRequest(Channel::UnixStreamSocket* /*channel*/, Cha
 	switch (request->methodId)
 	{
 		case Channel::Request::MethodId::WORKER_DUMP:
+		{
+			// This may throw.
+			Channel::DumpPager pager(request->data);
+			std::string data;
+
+			FillJson(data, pager);
+
+			request->Accept(data);
+
+			break;
+		}
+
+		case Channel::Request::MethodId::WORKER_GET_LOOP_STATS:
 		{
 			json data(json::object());
 
-			FillJson(data);
+			FillJsonLoopStats(data);
 
 			request->Accept(data);
 
@@ -242,3 +318,36 @@ inline void Worker::OnSignal(SignalsHandler* /*signalsHandler*/, int signum)
 		}
 	}
 }
+
+inline void Worker::OnLoopLag(uint64_t lagUs)
+{
+	MS_TRACE();
+
+	uint64_t now = DepLibUV::GetTime();
+
+	if (RTC::OverloadController::ProcessLagSample(lagUs, now))
+	{
+		json data(json::object());
+
+		data["level"] = RTC::OverloadController::GetLevelString();
+
+		Channel::Notifier::Emit(std::to_string(Logger::pid), "overload", data);
+	}
+
+	uint64_t threshold = Settings::configuration.loopLagThreshold;
+
+	if (threshold == 0u || lagUs < threshold * 1000)
+		return;
+
+	// Notify at most once per second.
+	if (this->lastLoopLagNotificationAt != 0u && now - this->lastLoopLagNotificationAt < 1000)
+		return;
+
+	this->lastLoopLagNotificationAt = now;
+
+	json data(json::object());
+
+	data["lag"] = lagUs / 1000.0;
+
+	Channel::Notifier::Emit(std::to_string(Logger::pid), "looplag", data);
+}
@@ -0,0 +1,475 @@
+#define MS_CLASS "FileWriter"
+// #define MS_LOG_DEV
+
+#include "handles/FileWriter.hpp"
+#include "DepLibUV.hpp"
+#include "Logger.hpp"
+#include "MediaSoupErrors.hpp"
+#include <fcntl.h> // O_WRONLY, O_CREAT, O_TRUNC
+#include <cstring> // std::memcpy()
+
+// State shared with the open and write requests in flight, so the file can be
+// closed once the last of them completes even if the FileWriter has already been
+// deleted.
+struct FileWriter::Shared
+{
+	uv_file fd;
+	bool opening;
+	size_t pendingWrites;
+	// Blocks flushed while the file is being opened.
+	std::vector<FileWriter::UvWriteData*> queuedWrites;
+	FileWriter* writer;
+};
+
+/* Static methods for UV callbacks. */
+
+inline static void onClose(uv_fs_t* req)
+{
+	uv_fs_req_cleanup(req);
+
+	delete req;
+}
+
+static void closeFile(uv_file fd)
+{
+	auto* req = new uv_fs_t;
+
+	int err = uv_fs_close(DepLibUV::GetLoop(), req, fd, static_cast<uv_fs_cb>(onClose));
+
+	if (err != 0)
+	{
+		MS_ERROR("uv_fs_close() failed: %s", uv_strerror(err));
+
+		delete req;
+	}
+}
+
+static void onWrite(uv_fs_t* req);
+
+static int submitWrite(FileWriter::Shared* shared, FileWriter::UvWriteData* writeData)
+{
+	uv_buf_t buffer = uv_buf_init(reinterpret_cast<char*>(writeData->block), writeData->size);
+
+	// Blocks are written at explicit offsets, so they may complete in any order.
+	int err = uv_fs_write(
+	  DepLibUV::GetLoop(),
+	  &writeData->req,
+	  shared->fd,
+	  &buffer,
+	  1,
+	  writeData->offset,
+	  static_cast<uv_fs_cb>(onWrite));
+
+	if (err == 0)
+		shared->pendingWrites++;
+
+	return err;
+}
+
+inline static void onOpen(uv_fs_t* req)
+{
+	auto* shared = static_cast<FileWriter::Shared*>(req->data);
+	auto result  = static_cast<ssize_t>(req->result);
+
+	uv_fs_req_cleanup(req);
+
+	delete req;
+
+	shared->opening = false;
+
+	if (shared->writer != nullptr)
+	{
+		shared->writer->OnUvOpen(result);
+
+		return;
+	}
+
+	// The FileWriter is gone, so write the queued blocks and close the file after
+	// the last write.
+	if (result >= 0)
+		shared->fd = static_cast<uv_file>(result);
+
+	for (auto* writeData : shared->queuedWrites)
+	{
+		if (result < 0 || submitWrite(shared, writeData) != 0)
+		{
+			delete[] writeData->block;
+			delete writeData;
+		}
+	}
+
+	shared->queuedWrites.clear();
+
+	if (shared->pendingWrites == 0)
+	{
+		if (result >= 0)
+			closeFile(shared->fd);
+
+		delete shared;
+	}
+}
+
+static void onWrite(uv_fs_t* req)
+{
+	auto* writeData = static_cast<FileWriter::UvWriteData*>(req->data);
+	auto* shared    = writeData->shared;
+	auto result     = static_cast<ssize_t>(req->result);
+
+	uv_fs_req_cleanup(req);
+
+	shared->pendingWrites--;
+
+	if (shared->writer != nullptr)
+	{
+		shared->writer->OnUvWrite(writeData, result);
+	}
+	// The FileWriter is gone, so close the file after the last write.
+	else
+	{
+		delete[] writeData->block;
+
+		if (shared->pendingWrites == 0)
+		{
+			closeFile(shared->fd);
+
+			delete shared;
+		}
+	}
+
+	delete writeData;
+}
+
+/* Instance methods. */
+
+FileWriter::FileWriter(Listener* listener, const std::string& path, size_t maxBlocks)
+  : listener(listener), path(path), maxBlocks(maxBlocks)
+{
+	MS_TRACE();
+
+	if (maxBlocks == 0)
+		MS_THROW_TYPE_ERROR("maxBlocks must be greater than 0");
+
+	// This may throw.
+	this->flushTimer = new Timer(this);
+
+	this->shared = new Shared{ -1, true, 0, {}, this };
+
+	// Records are queued into blocks until the file is open.
+	auto* req = new uv_fs_t;
+
+	req->data = static_cast<void*>(this->shared);
+
+	int err = uv_fs_open(
+	  DepLibUV::GetLoop(),
+	  req,
+	  path.c_str(),
+	  O_WRONLY | O_CREAT | O_TRUNC,
+	  0644,
+	  static_cast<uv_fs_cb>(onOpen));
+
+	if (err != 0)
+	{
+		delete req;
+
+		delete this->shared;
+		this->shared = nullptr;
+
+		delete this->flushTimer;
+		this->flushTimer = nullptr;
+
+		MS_THROW_ERROR("uv_fs_open() failed for '%s': %s", path.c_str(), uv_strerror(err));
+	}
+}
+
+FileWriter::~FileWriter()
+{
+	MS_TRACE();
+
+	// Do not notify errors while closing.
+	this->listener = nullptr;
+
+	Flush();
+
+	delete this->flushTimer;
+
+	for (auto* freeBlock : this->freeBlocks)
+	{
+		delete[] freeBlock;
+	}
+
+	if (!this->shared->opening && this->shared->pendingWrites == 0)
+	{
+		if (this->shared->fd >= 0)
+			closeFile(this->shared->fd);
+
+		delete this->shared;
+	}
+	else
+	{
+		this->shared->writer = nullptr;
+	}
+}
+
+bool FileWriter::Write(const uv_buf_t* buffers, size_t count)
+{
+	MS_TRACE();
+
+	if (this->failed)
+	{
+		this->droppedWrites++;
+
+		return false;
+	}
+
+	size_t len{ 0 };
+
+	for (size_t i{ 0 }; i < count; ++i)
+	{
+		len += buffers[i].len;
+	}
+
+	if (len > BlockSize)
+	{
+		MS_WARN_DEV("record too big for a block [len:%zu]", len);
+
+		this->droppedWrites++;
+
+		return false;
+	}
+
+	if (this->block != nullptr && this->blockSize + len > BlockSize)
+		Flush();
+
+	if (this->block == nullptr && !AcquireBlock())
+	{
+		MS_WARN_DEV("no free block, record dropped [path:%s]", this->path.c_str());
+
+		this->droppedWrites++;
+
+		return false;
+	}
+
+	for (size_t i{ 0 }; i < count; ++i)
+	{
+		std::memcpy(this->block + this->blockSize, buffers[i].base, buffers[i].len);
+
+		this->blockSize += buffers[i].len;
+	}
+
+	this->offset += len;
+
+	return true;
+}
+
+bool FileWriter::Write(const uint8_t* data, size_t len)
+{
+	MS_TRACE();
+
+	uv_buf_t buffer = uv_buf_init(reinterpret_cast<char*>(const_cast<uint8_t*>(data)), len);
+
+	return Write(&buffer, 1);
+}
+
+void FileWriter::Flush()
+{
+	MS_TRACE();
+
+	if (this->block == nullptr)
+		return;
+
+	this->flushTimer->Stop();
+
+	if (this->blockSize == 0)
+		return;
+
+	auto* writeData     = new UvWriteData;
+	writeData->req.data = static_cast<void*>(writeData);
+	writeData->shared   = this->shared;
+	writeData->block    = this->block;
+	writeData->size     = this->blockSize;
+	writeData->offset   = static_cast<int64_t>(this->offset - this->blockSize);
+
+	this->block     = nullptr;
+	this->blockSize = 0;
+
+	if (this->shared->opening)
+	{
+		this->shared->queuedWrites.push_back(writeData);
+
+		return;
+	}
+
+	int err = submitWrite(this->shared, writeData);
+
+	if (err != 0)
+	{
+		ReleaseBlock(writeData->block);
+
+		delete writeData;
+
+		SetFailed(std::string("uv_fs_write() failed: ") + uv_strerror(err));
+	}
+}
+
+uint64_t FileWriter::GetOffset() const
+{
+	return this->offset;
+}
+
+uint64_t FileWriter::GetBytesWritten() const
+{
+	return this->bytesWritten;
+}
+
+size_t FileWriter::GetPendingWrites() const
+{
+	return this->shared->queuedWrites.size() + this->shared->pendingWrites;
+}
+
+size_t FileWriter::GetDroppedWrites() const
+{
+	return this->droppedWrites;
+}
+
+size_t FileWriter::GetWriteErrors() const
+{
+	return this->writeErrors;
+}
+
+bool FileWriter::HasFailed() const
+{
+	return this->failed;
+}
+
+bool FileWriter::AcquireBlock()
+{
+	MS_TRACE();
+
+	if (!this->freeBlocks.empty())
+	{
+		this->block = this->freeBlocks.back();
+		this->freeBlocks.pop_back();
+	}
+	else if (this->allocatedBlocks < this->maxBlocks)
+	{
+		this->block = new uint8_t[BlockSize];
+		this->allocatedBlocks++;
+	}
+	else
+	{
+		return false;
+	}
+
+	this->blockSize = 0;
+
+	this->flushTimer->Start(FlushInterval);
+
+	return true;
+}
+
+inline void FileWriter::ReleaseBlock(uint8_t* freeBlock)
+{
+	MS_TRACE();
+
+	this->freeBlocks.push_back(freeBlock);
+}
+
+void FileWriter::SetFailed(const std::string& error)
+{
+	MS_TRACE();
+
+	MS_ERROR("%s [path:%s]", error.c_str(), this->path.c_str());
+
+	this->writeErrors++;
+
+	if (this->failed)
+		return;
+
+	this->failed = true;
+
+	// Discard the current block, later blocks would leave a hole in the file.
+	if (this->block != nullptr)
+	{
+		this->flushTimer->Stop();
+
+		ReleaseBlock(this->block);
+
+		this->block     = nullptr;
+		this->blockSize = 0;
+	}
+
+	for (auto* writeData : this->shared->queuedWrites)
+	{
+		ReleaseBlock(writeData->block);
+
+		delete writeData;
+	}
+
+	this->shared->queuedWrites.clear();
+
+	if (this->listener != nullptr)
+		this->listener->OnFileWriterError(this, error);
+}
+
+inline void FileWriter::OnUvOpen(ssize_t result)
+{
+	MS_TRACE();
+
+	if (result < 0)
+	{
+		SetFailed(std::string("uv_fs_open() failed: ") + uv_strerror(static_cast<int>(result)));
+
+		return;
+	}
+
+	this->shared->fd = static_cast<uv_file>(result);
+
+	// Write the blocks flushed while opening.
+	std::vector<UvWriteData*> queuedWrites;
+
+	queuedWrites.swap(this->shared->queuedWrites);
+
+	for (auto* writeData : queuedWrites)
+	{
+		if (!this->failed)
+		{
+			int err = submitWrite(this->shared, writeData);
+
+			if (err == 0)
+				continue;
+
+			SetFailed(std::string("uv_fs_write() failed: ") + uv_strerror(err));
+		}
+
+		ReleaseBlock(writeData->block);
+
+		delete writeData;
+	}
+}
+
+inline void FileWriter::OnUvWrite(UvWriteData* writeData, ssize_t result)
+{
+	MS_TRACE();
+
+	ReleaseBlock(writeData->block);
+
+	if (result < 0)
+	{
+		SetFailed(std::string("block write failed: ") + uv_strerror(static_cast<int>(result)));
+	}
+	else if (static_cast<size_t>(result) != writeData->size)
+	{
+		SetFailed("block write failed: short write");
+	}
+	else
+	{
+		this->bytesWritten += writeData->size;
+	}
+}
+
+inline void FileWriter::OnTimer(Timer* /*timer*/)
+{
+	MS_TRACE();
+
+	Flush();
+}
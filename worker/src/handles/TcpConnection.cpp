@@ -28,6 +28,8 @@ inline static void onRead(uv_stream_t* handle, ssize_t nread, const uv_buf_t* bu
 	if (connection == nullptr)
 		return;
 
+	DepLibUV::CountCallback();
+
 	connection->OnUvRead(nread, buf);
 }
 
@@ -2,6 +2,7 @@
 // #define MS_LOG_DEV
 
 #include "handles/TcpServer.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
 #include "Utils.hpp"
@@ -15,6 +16,8 @@ inline static void onConnection(uv_stream_t* handle, int status)
 	if (server == nullptr)
 		return;
 
+	DepLibUV::CountCallback();
+
 	server->OnUvConnection(status);
 }
 
@@ -10,6 +10,8 @@
 
 inline static void onTimer(uv_timer_t* handle)
 {
+	DepLibUV::CountCallback();
+
 	static_cast<Timer*>(handle->data)->OnUvTimer();
 }
 
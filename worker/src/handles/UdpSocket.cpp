@@ -2,14 +2,75 @@
 // #define MS_LOG_DEV
 
 #include "handles/UdpSocket.hpp"
+#include "DepIoUring.hpp"
+#include "DepLibUV.hpp"
 #include "Logger.hpp"
 #include "MediaSoupErrors.hpp"
+#include "Settings.hpp"
 #include "Utils.hpp"
+#include <algorithm> // std::min()
+#if defined(MS_SENDMMSG) || defined(MS_RECV_TIMESTAMPS) || defined(MS_RECV_DROPS)
+#include <sys/socket.h> // sendmmsg(), setsockopt(), getsockopt()
+#include <cerrno>       // errno
+#endif
+#ifdef MS_RECV_DROPS
+#include <linux/sock_diag.h> // SK_MEMINFO_DROPS
+#endif
+#ifdef MS_RECV_TIMESTAMPS
+#include <linux/sockios.h> // SIOCGSTAMPNS
+#include <sys/ioctl.h>     // ioctl()
+#include <ctime>           // clock_gettime()
+#endif
 
 /* Static. */
 
 static constexpr size_t ReadBufferSize{ 65536 };
 static uint8_t ReadBuffer[ReadBufferSize];
+static constexpr size_t GatherBufferSize{ 65536 };
+static uint8_t GatherBuffer[GatherBufferSize];
+#ifdef MS_SENDMMSG
+// Destinations sent per sendmmsg() call.
+static constexpr size_t MaxSendMessages{ 64 };
+// Buffers of the datagram sent with sendmmsg().
+static constexpr size_t MaxSendBuffers{ 8 };
+static struct mmsghdr SendMessages[MaxSendMessages];
+static struct iovec SendIovecs[MaxSendBuffers];
+#endif
+#ifdef MS_RECV_TIMESTAMPS
+// Receive delays (in us) above this are due to wall clock steps.
+static constexpr int64_t MaxRecvDelay{ 10000000 };
+#endif
+
+// Converts the kernel receive time (wall clock) of a datagram into the loop
+// clock, and records how long it waited before being processed.
+static uint64_t getArrivalTime(const struct timespec* recvTime)
+{
+#ifdef MS_RECV_TIMESTAMPS
+	if (recvTime == nullptr)
+		return DepLibUV::GetTime();
+
+	struct timespec now; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+	clock_gettime(CLOCK_REALTIME, &now);
+
+	int64_t delay = (static_cast<int64_t>(now.tv_sec) - recvTime->tv_sec) * 1000000 +
+	                (static_cast<int64_t>(now.tv_nsec) - recvTime->tv_nsec) / 1000;
+
+	if (delay < 0 || delay > MaxRecvDelay)
+		return DepLibUV::GetTime();
+
+	DepLibUV::AddRecvDelay(static_cast<uint64_t>(delay));
+
+	uint64_t arrivalTime = (uv_hrtime() / 1000 - static_cast<uint64_t>(delay)) / 1000;
+
+	// Loop time is not updated while processing, so never go beyond it.
+	return std::min(arrivalTime, DepLibUV::GetTime());
+#else
+	(void)recvTime;
+
+	return DepLibUV::GetTime();
+#endif
+}
 
 /* Static methods for UV callbacks. */
 
@@ -31,6 +92,8 @@ inline static void onRecv(
 	if (socket == nullptr)
 		return;
 
+	DepLibUV::CountCallback();
+
 	socket->OnUvRecv(nread, buf, addr, flags);
 }
 
@@ -67,14 +130,48 @@ UdpSocket::UdpSocket(uv_udp_t* uvHandle) : uvHandle(uvHandle)
 
 	this->uvHandle->data = (void*)this;
 
-	err = uv_udp_recv_start(
-	  this->uvHandle, static_cast<uv_alloc_cb>(onAlloc), static_cast<uv_udp_recv_cb>(onRecv));
+	uv_os_fd_t fd;
 
-	if (err != 0)
+	if (uv_fileno(reinterpret_cast<uv_handle_t*>(this->uvHandle), &fd) == 0)
+		this->fd = fd;
+
+#ifdef MS_RECV_TIMESTAMPS
+	// Ask the kernel to timestamp received datagrams. io_uring gets them as
+	// control messages, while for libuv they must be fetched with SIOCGSTAMPNS
+	// (whose first call enables them, and which does not work if control
+	// messages are enabled). That is an extra syscall per datagram so, for
+	// libuv, just if enabled in the settings.
+	if (this->fd != -1)
 	{
-		uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
+		int on{ 1 };
+		struct timespec timestamp; // NOLINT(cppcoreguidelines-pro-type-member-init)
 
-		MS_THROW_ERROR("uv_udp_recv_start() failed: %s", uv_strerror(err));
+		if (DepIoUring::IsActive())
+		{
+			setsockopt(this->fd, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on));
+		}
+		else if (Settings::configuration.udpRecvTimestamps)
+		{
+			this->recvTimestamps = ioctl(this->fd, SIOCGSTAMPNS, &timestamp) == 0 || errno == ENOENT;
+		}
+	}
+#endif
+
+	// Receive via io_uring if enabled, otherwise via libuv.
+	if (this->fd != -1)
+		this->ioUringRecvId = DepIoUring::StartRecv(this, this->fd);
+
+	if (this->ioUringRecvId == 0u)
+	{
+		err = uv_udp_recv_start(
+		  this->uvHandle, static_cast<uv_alloc_cb>(onAlloc), static_cast<uv_udp_recv_cb>(onRecv));
+
+		if (err != 0)
+		{
+			uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
+
+			MS_THROW_ERROR("uv_udp_recv_start() failed: %s", uv_strerror(err));
+		}
 	}
 
 	// Set local address.
@@ -107,10 +204,17 @@ void UdpSocket::Close()
 	this->uvHandle->data = nullptr;
 
 	// Don't read more.
-	int err = uv_udp_recv_stop(this->uvHandle);
+	if (this->ioUringRecvId != 0u)
+	{
+		DepIoUring::StopRecv(this->ioUringRecvId);
+	}
+	else
+	{
+		int err = uv_udp_recv_stop(this->uvHandle);
 
-	if (err != 0)
-		MS_ABORT("uv_udp_recv_stop() failed: %s", uv_strerror(err));
+		if (err != 0)
+			MS_ABORT("uv_udp_recv_stop() failed: %s", uv_strerror(err));
+	}
 
 	uv_close(reinterpret_cast<uv_handle_t*>(this->uvHandle), static_cast<uv_close_cb>(onClose));
 }
@@ -136,6 +240,16 @@ void UdpSocket::Send(const uint8_t* data, size_t len, const struct sockaddr* add
 	if (len == 0)
 		return;
 
+	// If enabled, queue it into io_uring so it's submitted in batch at the end
+	// of the loop iteration.
+	if (this->fd != -1 && DepIoUring::Send(this->fd, data, len, addr))
+	{
+		// Update sent bytes.
+		this->sentBytes += len;
+
+		return;
+	}
+
 	// First try uv_udp_try_send(). In case it can not directly send the datagram
 	// then build a uv_req_t and use uv_udp_send().
 
@@ -168,6 +282,8 @@ void UdpSocket::Send(const uint8_t* data, size_t len, const struct sockaddr* add
 	}
 	// Otherwise UV_EAGAIN was returned so cannot send data at first time. Use uv_udp_send().
 
+	this->sendEagains++;
+
 	// MS_DEBUG_DEV("could not send the datagram at first time, using uv_udp_send() now");
 
 	// Allocate a special UvSendData struct pointer.
@@ -197,6 +313,179 @@ void UdpSocket::Send(const uint8_t* data, size_t len, const struct sockaddr* add
 	}
 }
 
+void UdpSocket::Send(const uv_buf_t* buffers, size_t count, const struct sockaddr* addr)
+{
+	MS_TRACE();
+
+	if (this->closed)
+		return;
+
+	if (count == 1)
+	{
+		Send(reinterpret_cast<const uint8_t*>(buffers[0].base), buffers[0].len, addr);
+
+		return;
+	}
+
+	size_t len{ 0 };
+
+	for (size_t i{ 0 }; i < count; ++i)
+	{
+		len += buffers[i].len;
+	}
+
+	if (len == 0)
+		return;
+
+	// io_uring and uv_udp_send() need the datagram in a single buffer.
+	if (this->fd == -1 || !DepIoUring::IsActive())
+	{
+		int sent = uv_udp_try_send(
+		  this->uvHandle, const_cast<uv_buf_t*>(buffers), static_cast<unsigned int>(count), addr);
+
+		if (sent >= 0)
+		{
+			if (sent != static_cast<int>(len))
+				MS_WARN_DEV("datagram truncated (just %d of %zu bytes were sent)", sent, len);
+
+			// Update sent bytes.
+			this->sentBytes += sent;
+
+			return;
+		}
+		// Error,
+		if (sent != UV_EAGAIN)
+		{
+			MS_WARN_DEV("uv_udp_try_send() failed: %s", uv_strerror(sent));
+
+			return;
+		}
+	}
+
+	if (len > GatherBufferSize)
+	{
+		MS_WARN_DEV("datagram too big (%zu bytes)", len);
+
+		return;
+	}
+
+	uint8_t* data = GatherBuffer;
+
+	for (size_t i{ 0 }; i < count; ++i)
+	{
+		std::memcpy(data, buffers[i].base, buffers[i].len);
+
+		data += buffers[i].len;
+	}
+
+	Send(GatherBuffer, len, addr);
+}
+
+void UdpSocket::Send(
+  const uv_buf_t* buffers,
+  size_t count,
+  const struct sockaddr* const* addrs,
+  size_t addrCount,
+  bool* sent)
+{
+	MS_TRACE();
+
+	for (size_t i{ 0 }; i < addrCount; ++i)
+	{
+		sent[i] = false;
+	}
+
+	if (this->closed)
+		return;
+
+	size_t len{ 0 };
+
+	for (size_t i{ 0 }; i < count; ++i)
+	{
+		len += buffers[i].len;
+	}
+
+	if (len == 0)
+		return;
+
+#ifdef MS_SENDMMSG
+	// io_uring already batches the sends of the whole loop iteration.
+	if (this->fd != -1 && !DepIoUring::IsActive() && count <= MaxSendBuffers && addrCount > 1)
+	{
+		// All the messages share the same buffers.
+		for (size_t i{ 0 }; i < count; ++i)
+		{
+			SendIovecs[i].iov_base = buffers[i].base;
+			SendIovecs[i].iov_len  = buffers[i].len;
+		}
+
+		size_t idx{ 0 };
+
+		while (idx < addrCount)
+		{
+			size_t messageCount = std::min(addrCount - idx, MaxSendMessages);
+
+			for (size_t i{ 0 }; i < messageCount; ++i)
+			{
+				auto* addr   = addrs[idx + i];
+				auto& header = SendMessages[i].msg_hdr;
+
+				header             = {};
+				header.msg_name    = const_cast<struct sockaddr*>(addr);
+				header.msg_namelen = addr->sa_family == AF_INET6 ? sizeof(struct sockaddr_in6)
+				                                                 : sizeof(struct sockaddr_in);
+				header.msg_iov     = SendIovecs;
+				header.msg_iovlen  = count;
+			}
+
+			int ret = sendmmsg(this->fd, SendMessages, static_cast<unsigned int>(messageCount), 0);
+
+			if (ret > 0)
+			{
+				for (size_t i{ 0 }; i < static_cast<size_t>(ret); ++i)
+				{
+					sent[idx + i] = true;
+				}
+
+				// Update sent bytes.
+				this->sentBytes += len * ret;
+
+				idx += static_cast<size_t>(ret);
+
+				continue;
+			}
+
+			if (ret < 0 && errno == EINTR)
+				continue;
+
+			// The first message could not be sent. Retry it alone so it gets queued
+			// if the socket is not writable, and go on with the rest.
+			if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			{
+				Send(buffers, count, addrs[idx]);
+
+				sent[idx] = true;
+			}
+			else
+			{
+				MS_WARN_DEV("sendmmsg() failed: %s", uv_strerror(-errno));
+			}
+
+			idx++;
+		}
+
+		return;
+	}
+#endif
+
+	for (size_t i{ 0 }; i < addrCount; ++i)
+	{
+		Send(buffers, count, addrs[i]);
+
+		sent[i] = true;
+	}
+}
+
 void UdpSocket::Send(const uint8_t* data, size_t len, const std::string& ip, uint16_t port)
 {
 	MS_TRACE();
@@ -246,6 +535,77 @@ void UdpSocket::Send(const uint8_t* data, size_t len, const std::string& ip, uin
 	Send(data, len, reinterpret_cast<struct sockaddr*>(&addr));
 }
 
+void UdpSocket::SetRecvBufferSize(uint32_t size)
+{
+	MS_TRACE();
+
+	auto value = static_cast<int>(size);
+	int err    = uv_recv_buffer_size(reinterpret_cast<uv_handle_t*>(this->uvHandle), &value);
+
+	if (err != 0)
+		MS_ERROR("uv_recv_buffer_size() failed: %s", uv_strerror(err));
+}
+
+void UdpSocket::SetSendBufferSize(uint32_t size)
+{
+	MS_TRACE();
+
+	auto value = static_cast<int>(size);
+	int err    = uv_send_buffer_size(reinterpret_cast<uv_handle_t*>(this->uvHandle), &value);
+
+	if (err != 0)
+		MS_ERROR("uv_send_buffer_size() failed: %s", uv_strerror(err));
+}
+
+uint32_t UdpSocket::GetRecvBufferSize() const
+{
+	MS_TRACE();
+
+	// A zero value means reading it.
+	int value{ 0 };
+
+	if (uv_recv_buffer_size(reinterpret_cast<uv_handle_t*>(this->uvHandle), &value) != 0)
+		return 0;
+
+	return static_cast<uint32_t>(value);
+}
+
+uint32_t UdpSocket::GetSendBufferSize() const
+{
+	MS_TRACE();
+
+	// A zero value means reading it.
+	int value{ 0 };
+
+	if (uv_send_buffer_size(reinterpret_cast<uv_handle_t*>(this->uvHandle), &value) != 0)
+		return 0;
+
+	return static_cast<uint32_t>(value);
+}
+
+uint32_t UdpSocket::GetRecvDrops() const
+{
+	MS_TRACE();
+
+#ifdef MS_RECV_DROPS
+	// Same counter given by SO_RXQ_OVFL, but read on demand instead of with
+	// every datagram (which libuv would not provide anyway).
+	uint32_t memInfo[SK_MEMINFO_VARS];
+	socklen_t len = sizeof(memInfo);
+
+	if (
+	  this->fd == -1 || getsockopt(this->fd, SOL_SOCKET, SO_MEMINFO, memInfo, &len) != 0 ||
+	  len <= SK_MEMINFO_DROPS * sizeof(uint32_t))
+	{
+		return 0;
+	}
+
+	return memInfo[SK_MEMINFO_DROPS];
+#else
+	return 0;
+#endif
+}
+
 bool UdpSocket::SetLocalAddress()
 {
 	MS_TRACE();
@@ -308,8 +668,20 @@ inline void UdpSocket::OnUvRecv(
 		// Update received bytes.
 		this->recvBytes += nread;
 
+		const struct timespec* recvTime{ nullptr };
+
+#ifdef MS_RECV_TIMESTAMPS
+		struct timespec timestamp; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+		// libuv does not provide the ancillary data, but it reads a single datagram
+		// before calling us, so this is the timestamp of this one.
+		if (this->recvTimestamps && ioctl(this->fd, SIOCGSTAMPNS, &timestamp) == 0)
+			recvTime = &timestamp;
+#endif
+
 		// Notify the subclass.
-		UserOnUdpDatagramRecv(reinterpret_cast<uint8_t*>(buf->base), nread, addr);
+		UserOnUdpDatagramRecv(
+		  reinterpret_cast<uint8_t*>(buf->base), nread, addr, getArrivalTime(recvTime));
 	}
 	// Some error.
 	else
@@ -318,6 +690,21 @@ inline void UdpSocket::OnUvRecv(
 	}
 }
 
+void UdpSocket::OnIoUringRecv(
+  const uint8_t* data, size_t len, const struct sockaddr* addr, const struct timespec* recvTime)
+{
+	MS_TRACE();
+
+	if (this->closed)
+		return;
+
+	// Update received bytes.
+	this->recvBytes += len;
+
+	// Notify the subclass.
+	UserOnUdpDatagramRecv(data, len, addr, getArrivalTime(recvTime));
+}
+
 inline void UdpSocket::OnUvSendError(int /*error*/)
 {
 	MS_TRACE();
@@ -32,6 +32,8 @@ inline static void onRead(uv_stream_t* handle, ssize_t nread, const uv_buf_t* bu
 	if (socket == nullptr)
 		return;
 
+	DepLibUV::CountCallback();
+
 	socket->OnUvRead(nread, buf);
 }
 
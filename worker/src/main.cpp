@@ -2,6 +2,7 @@
 // #define MS_LOG_DEV
 
 #include "common.hpp"
+#include "DepIoUring.hpp"
 #include "DepLibSRTP.hpp"
 #include "DepLibUV.hpp"
 #include "DepOpenSSL.hpp"
@@ -106,6 +107,7 @@ int main(int argc, char* argv[])
 		RTC::DtlsTransport::ClassInit();
 		RTC::SrtpSession::ClassInit();
 		Channel::Notifier::ClassInit(channel);
+		DepIoUring::ClassInit();
 
 		// Ignore some signals.
 		IgnoreSignals();
@@ -114,6 +116,7 @@ int main(int argc, char* argv[])
 		Worker worker(channel);
 
 		// Free static stuff.
+		DepIoUring::ClassDestroy();
 		DepLibUV::ClassDestroy();
 		DepLibSRTP::ClassDestroy();
 		Utils::Crypto::ClassDestroy();
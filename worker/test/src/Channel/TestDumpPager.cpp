@@ -0,0 +1,146 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "json.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Channel/DumpPager.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace Channel;
+using json = nlohmann::json;
+
+static std::vector<std::string> selectIds(
+  DumpPager& pager, uint8_t section, const std::map<std::string, int>& items, size_t pageSize = 0)
+{
+	std::vector<std::string> ids;
+
+	for (auto it = pager.Begin(section, items); it != items.end(); ++it)
+	{
+		if (!pager.Add(section, it->first, pageSize))
+			break;
+
+		ids.push_back(it->first);
+	}
+
+	return ids;
+}
+
+static std::string getNextCursor(DumpPager& pager)
+{
+	std::string buffer("{");
+
+	pager.AppendNextCursor(buffer);
+	buffer.push_back('}');
+
+	auto jsonNextCursor = json::parse(buffer)["nextCursor"];
+
+	return jsonNextCursor.is_null() ? "" : jsonNextCursor.get<std::string>();
+}
+
+SCENARIO("DumpPager", "[channel]")
+{
+	// clang-format off
+	std::map<std::string, int> section0 =
+	{
+		{ "c", 0 },
+		{ "a", 0 },
+		{ "b", 0 }
+	};
+	std::map<std::string, int> section1 =
+	{
+		{ "z", 0 },
+		{ "y", 0 },
+		{ "x", 0 }
+	};
+	// clang-format on
+
+	SECTION("no limit returns all the items")
+	{
+		json data = json::object();
+		DumpPager pager(data);
+
+		auto ids0 = selectIds(pager, 0, section0);
+		auto ids1 = selectIds(pager, 1, section1, DumpPager::MaxPageSize);
+
+		REQUIRE(!pager.IsPaginated());
+		REQUIRE(ids0.size() == 3);
+		REQUIRE(ids1.size() == 3);
+	}
+
+	SECTION("pages follow id order across sections")
+	{
+		std::vector<std::vector<std::string>> pages;
+		std::string cursor;
+
+		do
+		{
+			json data = { { "limit", 4 } };
+
+			if (!cursor.empty())
+				data["cursor"] = cursor;
+
+			DumpPager pager(data);
+
+			auto ids  = selectIds(pager, 0, section0);
+			auto ids1 = selectIds(pager, 1, section1);
+
+			ids.insert(ids.end(), ids1.begin(), ids1.end());
+			pages.push_back(ids);
+
+			cursor = getNextCursor(pager);
+		} while (!cursor.empty());
+
+		// clang-format off
+		std::vector<std::vector<std::string>> expectedPages =
+		{
+			{ "a", "b", "c", "x" },
+			{ "y", "z" }
+		};
+		// clang-format on
+
+		REQUIRE(pages == expectedPages);
+	}
+
+	SECTION("pages do not exceed MaxPageSize")
+	{
+		json data = { { "limit", 10 } };
+		DumpPager pager(data);
+
+		// At least an item is always written.
+		auto ids0 = selectIds(pager, 0, section0, DumpPager::MaxPageSize);
+
+		REQUIRE(ids0 == std::vector<std::string>({ "a" }));
+		REQUIRE(getNextCursor(pager) == "0:a");
+
+		// No more items fit into this page.
+		REQUIRE(selectIds(pager, 1, section1).empty());
+	}
+
+	SECTION("cursor remains valid if items are removed")
+	{
+		json data = { { "limit", 2 }, { "cursor", "0:b" } };
+		DumpPager pager(data);
+
+		section0.erase("c");
+		section0.erase("b");
+		section0["bb"] = 0;
+
+		REQUIRE(selectIds(pager, 0, section0) == std::vector<std::string>({ "bb" }));
+		REQUIRE(selectIds(pager, 1, section1) == std::vector<std::string>({ "x" }));
+		REQUIRE(getNextCursor(pager) == "1:x");
+	}
+
+	SECTION("wrong data throws")
+	{
+		json data1 = { { "limit", 0 } };
+		json data2 = { { "limit", "10" } };
+		json data3 = { { "limit", 10 }, { "cursor", "foo" } };
+		json data4 = { { "limit", 10 }, { "cursor", 1 } };
+
+		REQUIRE_THROWS_AS(DumpPager(data1), MediaSoupTypeError);
+		REQUIRE_THROWS_AS(DumpPager(data2), MediaSoupTypeError);
+		REQUIRE_THROWS_AS(DumpPager(data3), MediaSoupTypeError);
+		REQUIRE_THROWS_AS(DumpPager(data4), MediaSoupTypeError);
+	}
+}
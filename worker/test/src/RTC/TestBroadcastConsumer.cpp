@@ -0,0 +1,185 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "json.hpp"
+#include "Channel/Notifier.hpp"
+#include "Channel/UnixStreamSocket.hpp"
+#include "RTC/BroadcastConsumer.hpp"
+#include "RTC/RTCP/FeedbackRtpNack.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/RtpStreamRecv.hpp"
+#include <sys/socket.h> // socketpair()
+#include <unistd.h>     // close()
+#include <utility>      // std::pair
+#include <vector>
+
+using namespace RTC;
+using json = nlohmann::json;
+
+SCENARIO("BroadcastConsumer retransmissions", "[rtp][broadcast]")
+{
+	class BroadcastConsumerListener : public Consumer::Listener
+	{
+	public:
+		void OnConsumerSendRtpPacket(Consumer* consumer, const RtpPacketOverlay& overlay) override
+		{
+			this->sent.emplace_back(consumer, overlay.GetSequenceNumber());
+			this->sentOriginalSeqs.push_back(overlay.GetPacket()->GetSequenceNumber());
+		}
+
+		void OnConsumerKeyFrameRequested(Consumer* /*consumer*/, uint32_t /*mappedSsrc*/) override
+		{
+		}
+
+		void OnConsumerSubscriptionChanged(Consumer* /*consumer*/) override
+		{
+		}
+
+		void onConsumerProducerClosed(Consumer* /*consumer*/) override
+		{
+		}
+
+	public:
+		std::vector<std::pair<Consumer*, uint16_t>> sent;
+		std::vector<uint16_t> sentOriginalSeqs;
+	};
+
+	class RtpStreamRecvListener : public RtpStreamRecv::Listener
+	{
+	public:
+		void OnRtpStreamScore(RtpStream* /*rtpStream*/, uint8_t /*score*/) override
+		{
+		}
+
+		void OnRtpStreamSendRtcpPacket(RtpStreamRecv* /*rtpStream*/, RTCP::Packet* /*packet*/) override
+		{
+		}
+
+		void OnRtpStreamNeedWorstRemoteFractionLost(
+		  RtpStreamRecv* /*rtpStream*/, uint8_t& /*worstRemoteFractionLost*/) override
+		{
+		}
+	};
+
+	// Pausing and resuming a Consumer emits notifications.
+	int fds[2];
+
+	REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+
+	auto* channel = new Channel::UnixStreamSocket(fds[0]);
+
+	Channel::Notifier::ClassInit(channel);
+
+	json data = json::parse(R"({
+		"kind"          : "audio",
+		"rtpParameters" :
+		{
+			"codecs" :
+			[
+				{
+					"mimeType"     : "audio/opus",
+					"payloadType"  : 100,
+					"clockRate"    : 48000,
+					"channels"     : 2,
+					"rtcpFeedback" : [ { "type": "nack" } ]
+				}
+			],
+			"encodings" : [ { "ssrc": 11111111 } ]
+		},
+		"consumableRtpEncodings" : [ { "ssrc": 22222222 } ]
+	})");
+
+	// clang-format off
+	uint8_t buffer[] =
+	{
+		0x80, 0x64, 0x00, 0x01,
+		0x00, 0x00, 0x00, 0x04,
+		0x00, 0x00, 0x00, 0x05,
+		0x11, 0x22, 0x33, 0x44
+	};
+	// clang-format on
+
+	RtpPacket* packet = RtpPacket::Parse(buffer, sizeof(buffer));
+
+	REQUIRE(packet);
+
+	RtpStream::Params params;
+
+	params.ssrc      = 22222222;
+	params.clockRate = 48000;
+	params.useNack   = true;
+
+	RtpStreamRecvListener rtpStreamListener;
+	RtpStreamRecv rtpStream(&rtpStreamListener, params);
+	BroadcastConsumerListener listener;
+	BroadcastConsumer consumer1("consumer1", &listener, data);
+	BroadcastConsumer consumer2("consumer2", &listener, data);
+
+	consumer1.ProducerNewRtpStream(&rtpStream, 11111111);
+	consumer2.ProducerNewRtpStream(&rtpStream, 11111111);
+
+	auto sendPacket = [&](uint16_t seq) {
+		packet->SetSequenceNumber(seq);
+		packet->SetTimestamp(seq * 960);
+
+		consumer1.SendRtpPacket(packet);
+		consumer2.SendRtpPacket(packet);
+	};
+
+	auto nack = [&](BroadcastConsumer& consumer, uint16_t seq) {
+		RTCP::FeedbackRtpNackPacket nackPacket(0, 11111111);
+
+		nackPacket.AddItem(new RTCP::FeedbackRtpNackItem(seq, 0));
+		listener.sent.clear();
+		listener.sentOriginalSeqs.clear();
+		consumer.ReceiveNack(&nackPacket);
+	};
+
+	SECTION("NACKed packets sent before a resync are not retransmitted")
+	{
+		for (uint16_t seq{ 1 }; seq <= 3; ++seq)
+		{
+			sendPacket(seq);
+		}
+
+		// consumer2 misses the packets stored (for consumer1) while paused.
+		consumer2.ProducerPaused();
+
+		for (uint16_t seq{ 4 }; seq <= 10; ++seq)
+		{
+			sendPacket(seq);
+		}
+
+		consumer2.ProducerResumed();
+		sendPacket(11);
+
+		// consumer2 sent seqs 1, 2 and 3 before pausing and seq 11 as 4 after
+		// resuming.
+		nack(consumer2, 4);
+
+		REQUIRE(listener.sent.size() == 1);
+		REQUIRE(listener.sent[0].first == &consumer2);
+		REQUIRE(listener.sent[0].second == 4);
+		REQUIRE(listener.sentOriginalSeqs[0] == 11);
+
+		// Seq 2 would be mapped to the stored packet 9 with the current offset.
+		nack(consumer2, 2);
+
+		REQUIRE(listener.sent.empty());
+
+		// consumer1 was never paused.
+		nack(consumer1, 2);
+
+		REQUIRE(listener.sent.size() == 1);
+		REQUIRE(listener.sent[0].first == &consumer1);
+		REQUIRE(listener.sent[0].second == 2);
+		REQUIRE(listener.sentOriginalSeqs[0] == 2);
+	}
+
+	delete packet;
+
+	Channel::Notifier::ClassInit(nullptr);
+
+	delete channel;
+
+	close(fds[1]);
+}
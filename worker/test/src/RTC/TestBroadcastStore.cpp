@@ -0,0 +1,84 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "RTC/BroadcastStore.hpp"
+#include "RTC/RtpPacket.hpp"
+
+using namespace RTC;
+
+SCENARIO("BroadcastStore", "[rtp][broadcast]")
+{
+	// clang-format off
+	uint8_t buffer[] =
+	{
+		0x80, 0x65, 0x00, 0x01,
+		0x00, 0x00, 0x00, 0x04,
+		0x00, 0x00, 0x00, 0x05
+	};
+	// clang-format on
+
+	RtpPacket* packet = RtpPacket::Parse(buffer, sizeof(buffer));
+
+	REQUIRE(packet);
+
+	SECTION("stores are shared by consumers of the same stream")
+	{
+		auto* stream1 = reinterpret_cast<const RtpStream*>(0x1);
+		auto* stream2 = reinterpret_cast<const RtpStream*>(0x2);
+
+		auto* store1 = BroadcastStore::Acquire(stream1);
+		auto* store2 = BroadcastStore::Acquire(stream1);
+		auto* store3 = BroadcastStore::Acquire(stream2);
+
+		REQUIRE(store1 == store2);
+		REQUIRE(store1 != store3);
+		REQUIRE(store1->GetNumConsumers() == 2);
+		REQUIRE(store3->GetNumConsumers() == 1);
+
+		BroadcastStore::Release(store2);
+
+		REQUIRE(store1->GetNumConsumers() == 1);
+
+		BroadcastStore::Release(store1);
+		BroadcastStore::Release(store3);
+	}
+
+	SECTION("stored packets are retrieved by sequence number")
+	{
+		BroadcastStore store(nullptr);
+
+		REQUIRE(store.GetPacket(1, 1000) == nullptr);
+
+		store.StorePacket(packet, 1000);
+
+		auto* storedPacket = store.GetPacket(1, 1500);
+
+		REQUIRE(storedPacket);
+		REQUIRE(storedPacket != packet);
+		REQUIRE(storedPacket->GetSequenceNumber() == 1);
+		REQUIRE(storedPacket->GetTimestamp() == 4);
+		REQUIRE(store.GetPacket(2, 1500) == nullptr);
+
+		// Storing the same packet again (for another consumer) keeps the stored one.
+		store.StorePacket(packet, 1200);
+
+		REQUIRE(store.GetPacket(1, 1500) == storedPacket);
+
+		// Too old.
+		REQUIRE(store.GetPacket(1, 3001) == nullptr);
+	}
+
+	SECTION("older packets are replaced")
+	{
+		BroadcastStore store(nullptr);
+
+		store.StorePacket(packet, 1000);
+
+		packet->SetSequenceNumber(1 + BroadcastStore::BufferSize);
+		store.StorePacket(packet, 1000);
+
+		REQUIRE(store.GetPacket(1, 1000) == nullptr);
+		REQUIRE(store.GetPacket(1 + BroadcastStore::BufferSize, 1000));
+	}
+
+	delete packet;
+}
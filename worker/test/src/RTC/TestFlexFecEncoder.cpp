@@ -0,0 +1,177 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "Utils.hpp"
+#include "RTC/FlexFecEncoder.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/RtpPacketOverlay.hpp"
+#include <cstring> // std::memcmp(), std::memcpy()
+#include <vector>
+
+using namespace RTC;
+
+static RtpPacket* createPacket(
+  uint8_t* buffer, uint16_t seq, uint32_t timestamp, size_t payloadLength)
+{
+	buffer[0] = 0x80;
+	buffer[1] = 0x60;
+	Utils::Byte::Set2Bytes(buffer, 2, seq);
+	Utils::Byte::Set4Bytes(buffer, 4, timestamp);
+	Utils::Byte::Set4Bytes(buffer, 8, 1111);
+
+	for (size_t i{ 0 }; i < payloadLength; ++i)
+	{
+		buffer[12 + i] = static_cast<uint8_t>(seq + i);
+	}
+
+	return RtpPacket::Parse(buffer, 12 + payloadLength);
+}
+
+SCENARIO("FlexFecEncoder", "[rtp][fec]")
+{
+	FlexFecEncoder encoder(120, 3333, 2222);
+
+	uint8_t buffers[4][100];
+	size_t payloadLengths[] = { 50, 20, 80, 30 };
+	std::vector<RtpPacket*> packets;
+
+	for (size_t i{ 0 }; i < 4; ++i)
+	{
+		packets.push_back(createPacket(buffers[i], 10 + i, 5000 + i, payloadLengths[i]));
+	}
+
+	SECTION("no repair packets if there are no losses")
+	{
+		REQUIRE(encoder.GetGroupSize() == 0);
+
+		for (auto* packet : packets)
+		{
+			REQUIRE(encoder.AddPacket(RtpPacketOverlay(packet)) == nullptr);
+		}
+	}
+
+	SECTION("group size depends on the fraction lost")
+	{
+		encoder.SetFractionLost(10);
+		REQUIRE(encoder.GetGroupSize() == 10);
+
+		encoder.SetFractionLost(100);
+		REQUIRE(encoder.GetGroupSize() == 2);
+
+		encoder.SetFractionLost(0);
+		REQUIRE(encoder.GetGroupSize() == 0);
+	}
+
+	SECTION("a lost packet is recovered from the repair packet")
+	{
+		// 4 packets per repair packet.
+		encoder.SetFractionLost(30);
+
+		REQUIRE(encoder.GetGroupSize() == 4);
+
+		const RtpPacket* fecPacket{ nullptr };
+
+		for (auto* packet : packets)
+		{
+			RtpPacketOverlay overlay(packet);
+
+			// Sent with the SSRC of the Consumer.
+			overlay.SetSsrc(2222);
+
+			REQUIRE(fecPacket == nullptr);
+
+			fecPacket = encoder.AddPacket(overlay);
+		}
+
+		REQUIRE(fecPacket);
+		REQUIRE(fecPacket->GetPayloadType() == 120);
+		REQUIRE(fecPacket->GetSsrc() == 3333);
+		REQUIRE(fecPacket->GetTimestamp() == 5003);
+		REQUIRE(fecPacket->GetSize() == FlexFecEncoder::HeaderSize + 80);
+
+		const uint8_t* fecHeader = fecPacket->GetData() + 12;
+
+		// SSRCCount, protected SSRC, SN base and mask (K bit and 4 packets).
+		REQUIRE(fecHeader[8] == 1);
+		REQUIRE(Utils::Byte::Get4Bytes(fecHeader, 12) == 2222);
+		REQUIRE(Utils::Byte::Get2Bytes(fecHeader, 16) == 10);
+		REQUIRE(Utils::Byte::Get2Bytes(fecHeader, 18) == 0xF800);
+
+		// Recover the second packet.
+		uint8_t recovered[FlexFecEncoder::HeaderSize + 80];
+
+		std::memcpy(recovered, fecPacket->GetData(), fecPacket->GetSize());
+
+		for (size_t i : { 0, 2, 3 })
+		{
+			auto* data = packets[i]->GetData();
+
+			recovered[12] ^= data[0];
+			recovered[13] ^= data[1];
+			auto length = static_cast<uint16_t>(packets[i]->GetSize() - 12);
+
+			Utils::Byte::Set2Bytes(recovered, 14, Utils::Byte::Get2Bytes(recovered, 14) ^ length);
+
+			for (size_t j{ 4 }; j < 8; ++j)
+			{
+				recovered[12 + j] ^= data[j];
+			}
+
+			for (size_t j{ 12 }; j < packets[i]->GetSize(); ++j)
+			{
+				recovered[FlexFecEncoder::HeaderSize + j - 12] ^= data[j];
+			}
+		}
+
+		auto* lostPacket = packets[1];
+
+		REQUIRE((recovered[12] & 0x3F) == (lostPacket->GetData()[0] & 0x3F));
+		REQUIRE(recovered[13] == lostPacket->GetData()[1]);
+		REQUIRE(Utils::Byte::Get2Bytes(recovered, 14) == lostPacket->GetSize() - 12);
+		REQUIRE(Utils::Byte::Get4Bytes(recovered, 16) == lostPacket->GetTimestamp());
+		REQUIRE(
+		  std::memcmp(
+		    recovered + FlexFecEncoder::HeaderSize,
+		    lostPacket->GetData() + 12,
+		    lostPacket->GetSize() - 12) == 0);
+	}
+
+	SECTION("a new group starts if a packet does not fit into the mask")
+	{
+		encoder.SetFractionLost(10);
+
+		REQUIRE(encoder.AddPacket(RtpPacketOverlay(packets[0])) == nullptr);
+
+		uint16_t seqBase = 10 + FlexFecEncoder::MaxGroupSize;
+
+		packets[1]->SetSequenceNumber(seqBase);
+
+		REQUIRE(encoder.AddPacket(RtpPacketOverlay(packets[1])) == nullptr);
+
+		// End of a frame, but the group (2 packets) is not big enough.
+		packets[2]->SetSequenceNumber(seqBase + 1);
+		packets[2]->SetMarker(true);
+
+		REQUIRE(encoder.AddPacket(RtpPacketOverlay(packets[2])) == nullptr);
+
+		for (uint16_t seq = seqBase + 2; seq < seqBase + 9; ++seq)
+		{
+			packets[3]->SetSequenceNumber(seq);
+
+			REQUIRE(encoder.AddPacket(RtpPacketOverlay(packets[3])) == nullptr);
+		}
+
+		// The tenth packet of the group completes it.
+		packets[3]->SetSequenceNumber(seqBase + 9);
+
+		auto* fecPacket = encoder.AddPacket(RtpPacketOverlay(packets[3]));
+
+		REQUIRE(fecPacket);
+		REQUIRE(Utils::Byte::Get2Bytes(fecPacket->GetData() + 12, 16) == seqBase);
+		REQUIRE(Utils::Byte::Get2Bytes(fecPacket->GetData() + 12, 18) == 0xFFE0);
+	}
+
+	for (auto* packet : packets)
+	{
+		delete packet;
+	}
+}
@@ -43,10 +43,6 @@ public:
 	{
 		return true;
 	};
-	void Restore(uint8_t* /*data*/)
-	{
-		return;
-	};
 	bool IsKeyFrame() const
 	{
 		return this->isKeyFrame;
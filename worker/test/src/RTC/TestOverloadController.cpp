@@ -0,0 +1,111 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "Settings.hpp"
+#include "RTC/OverloadController.hpp"
+
+using namespace RTC;
+
+using Level = OverloadController::Level;
+
+// Feeds one period (1 second) of samples with the given lag (in ms).
+static bool feedPeriod(uint64_t& now, uint64_t lagMs)
+{
+	bool changed{ false };
+
+	for (int i{ 0 }; i <= 20; ++i)
+	{
+		changed |= OverloadController::ProcessLagSample(lagMs * 1000, now);
+		now += 50;
+	}
+
+	return changed;
+}
+
+SCENARIO("Overload controller", "[overload]")
+{
+	OverloadController::Reset();
+	Settings::configuration.overloadLagThreshold = 40;
+
+	uint64_t now{ 1000000 };
+
+	SECTION("disabled by default")
+	{
+		Settings::configuration.overloadLagThreshold = 0;
+
+		feedPeriod(now, 500);
+
+		REQUIRE(OverloadController::GetLevel() == Level::NONE);
+	}
+
+	SECTION("level is raised one step per overloaded period")
+	{
+		REQUIRE(feedPeriod(now, 50));
+		REQUIRE(OverloadController::GetLevel() == Level::NO_RETRANSMISSIONS);
+		REQUIRE(OverloadController::GetLevelString() == "no-retransmissions");
+
+		REQUIRE(feedPeriod(now, 50));
+		REQUIRE(OverloadController::GetLevel() == Level::LOWER_SPATIAL_LAYERS);
+
+		REQUIRE(feedPeriod(now, 50));
+		REQUIRE(OverloadController::GetLevel() == Level::LOWER_TEMPORAL_LAYERS);
+
+		REQUIRE(feedPeriod(now, 50));
+		REQUIRE(OverloadController::GetLevel() == Level::STRETCH_RTCP);
+		REQUIRE(OverloadController::IsLevelReached(Level::NO_RETRANSMISSIONS));
+
+		// Already at the highest level.
+		REQUIRE(!feedPeriod(now, 50));
+		REQUIRE(OverloadController::GetLevel() == Level::STRETCH_RTCP);
+	}
+
+	SECTION("isolated spikes do not raise the level")
+	{
+		for (int i{ 0 }; i < 21; ++i)
+		{
+			OverloadController::ProcessLagSample(i % 4 == 0 ? 200000 : 0, now);
+			now += 50;
+		}
+
+		REQUIRE(OverloadController::GetLevel() == Level::NONE);
+	}
+
+	SECTION("level is lowered one step after several calm periods")
+	{
+		feedPeriod(now, 50);
+		feedPeriod(now, 50);
+
+		REQUIRE(OverloadController::GetLevel() == Level::LOWER_SPATIAL_LAYERS);
+
+		for (int i{ 0 }; i < 4; ++i)
+			REQUIRE(!feedPeriod(now, 0));
+
+		REQUIRE(feedPeriod(now, 0));
+		REQUIRE(OverloadController::GetLevel() == Level::NO_RETRANSMISSIONS);
+
+		// Lag between the calm and overload thresholds resets the calm count.
+		for (int i{ 0 }; i < 4; ++i)
+			feedPeriod(now, 0);
+
+		feedPeriod(now, 20);
+
+		for (int i{ 0 }; i < 4; ++i)
+			REQUIRE(!feedPeriod(now, 0));
+
+		REQUIRE(feedPeriod(now, 0));
+		REQUIRE(OverloadController::GetLevel() == Level::NONE);
+	}
+
+	SECTION("disabling restores everything at once")
+	{
+		feedPeriod(now, 50);
+		feedPeriod(now, 50);
+
+		Settings::configuration.overloadLagThreshold = 0;
+
+		REQUIRE(OverloadController::ProcessLagSample(0, now));
+		REQUIRE(OverloadController::GetLevel() == Level::NONE);
+	}
+
+	OverloadController::Reset();
+	Settings::configuration.overloadLagThreshold = 0;
+}
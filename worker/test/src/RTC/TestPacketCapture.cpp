@@ -0,0 +1,160 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "MediaSoupErrors.hpp"
+#include "Utils.hpp"
+#include "RTC/PacketCapture.hpp"
+#include <cstring> // std::memcmp(), std::memcpy()
+#include <limits>
+#include <vector>
+
+using namespace RTC;
+
+struct CapturedPacket
+{
+	uint32_t flags;
+	uint32_t length;
+	std::vector<uint8_t> data;
+};
+
+static uint32_t read32(const std::vector<uint8_t>& buffer, size_t offset)
+{
+	uint32_t value;
+
+	std::memcpy(&value, buffer.data() + offset, sizeof(value));
+
+	return value;
+}
+
+// Parses the Enhanced Packet Blocks of the given pcapng buffer.
+static std::vector<CapturedPacket> parse(const std::vector<uint8_t>& buffer)
+{
+	std::vector<CapturedPacket> packets;
+
+	REQUIRE(read32(buffer, 0) == 0x0A0D0D0A);
+	REQUIRE(read32(buffer, 8) == 0x1A2B3C4D);
+
+	size_t offset{ 0 };
+
+	while (offset < buffer.size())
+	{
+		uint32_t type     = read32(buffer, offset);
+		uint32_t blockLen = read32(buffer, offset + 4);
+
+		REQUIRE(blockLen % 4 == 0);
+		REQUIRE(read32(buffer, offset + blockLen - 4) == blockLen);
+
+		if (type == 6)
+		{
+			uint32_t capturedLen = read32(buffer, offset + 20);
+			uint32_t length      = read32(buffer, offset + 24);
+			const uint8_t* data  = buffer.data() + offset + 28;
+			uint32_t flags = read32(buffer, offset + 28 + Utils::Byte::PadTo4Bytes(capturedLen) + 4);
+
+			// Synthetic IPv4 and UDP headers.
+			REQUIRE(data[0] == 0x45);
+			REQUIRE(data[9] == 17);
+			REQUIRE(Utils::Byte::Get2Bytes(data, 2) == length);
+			REQUIRE(Utils::Byte::Get2Bytes(data, 24) == length - 20);
+
+			packets.push_back(
+			  { flags,
+			    static_cast<uint32_t>(length - PacketCapture::IpUdpHeaderSize),
+			    std::vector<uint8_t>(data + PacketCapture::IpUdpHeaderSize, data + capturedLen) });
+		}
+
+		offset += blockLen;
+	}
+
+	REQUIRE(offset == buffer.size());
+
+	return packets;
+}
+
+SCENARIO("PacketCapture", "[capture]")
+{
+	uint8_t packet[200];
+
+	for (size_t i{ 0 }; i < sizeof(packet); ++i)
+	{
+		packet[i] = static_cast<uint8_t>(i);
+	}
+
+	SECTION("packets are truncated to the snap length")
+	{
+		PacketCapture capture(50, 10);
+		std::vector<uint8_t> buffer;
+
+		capture.Add(PacketCapture::Direction::IN, packet, 30);
+		capture.Add(PacketCapture::Direction::OUT, packet, 200);
+
+		capture.Serialize(buffer);
+
+		auto packets = parse(buffer);
+
+		REQUIRE(packets.size() == 2);
+		REQUIRE(packets[0].flags == 1);
+		REQUIRE(packets[0].length == 30);
+		REQUIRE(packets[0].data.size() == 30);
+		REQUIRE(std::memcmp(packets[0].data.data(), packet, 30) == 0);
+		REQUIRE(packets[1].flags == 2);
+		REQUIRE(packets[1].length == 200);
+		REQUIRE(packets[1].data.size() == 50);
+		REQUIRE(std::memcmp(packets[1].data.data(), packet, 50) == 0);
+	}
+
+	SECTION("buffers are gathered")
+	{
+		PacketCapture capture(50, 10);
+		std::vector<uint8_t> buffer;
+		uv_buf_t buffers[3];
+
+		buffers[0] = uv_buf_init(reinterpret_cast<char*>(packet), 12);
+		buffers[1] = uv_buf_init(reinterpret_cast<char*>(packet + 12), 20);
+		buffers[2] = uv_buf_init(reinterpret_cast<char*>(packet + 32), 100);
+
+		capture.Add(PacketCapture::Direction::OUT, buffers, 3);
+
+		capture.Serialize(buffer);
+
+		auto packets = parse(buffer);
+
+		REQUIRE(packets.size() == 1);
+		REQUIRE(packets[0].length == 132);
+		REQUIRE(packets[0].data.size() == 50);
+		REQUIRE(std::memcmp(packets[0].data.data(), packet, 50) == 0);
+	}
+
+	SECTION("oldest packets are overwritten")
+	{
+		PacketCapture capture(10, 4);
+		std::vector<uint8_t> buffer;
+
+		for (size_t i{ 0 }; i < 10; ++i)
+		{
+			capture.Add(PacketCapture::Direction::IN, packet + i, 10);
+		}
+
+		REQUIRE(capture.GetPacketCount() == 4);
+
+		capture.Serialize(buffer);
+
+		auto packets = parse(buffer);
+
+		REQUIRE(packets.size() == 4);
+
+		for (size_t i{ 0 }; i < 4; ++i)
+		{
+			REQUIRE(packets[i].data[0] == 6 + i);
+		}
+	}
+
+	SECTION("wrong settings throw")
+	{
+		REQUIRE_THROWS_AS(PacketCapture(0, 10), MediaSoupTypeError);
+		REQUIRE_THROWS_AS(PacketCapture(2000, 10), MediaSoupTypeError);
+		REQUIRE_THROWS_AS(PacketCapture(1500, 1000000), MediaSoupTypeError);
+		// maxPackets * snapLength would overflow.
+		REQUIRE_THROWS_AS(
+		  PacketCapture(1024, std::numeric_limits<size_t>::max() / 1024 + 2), MediaSoupTypeError);
+	}
+}
@@ -0,0 +1,104 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "RTC/ProbationPacer.hpp"
+#include "RTC/RtpPacket.hpp" // RTC::MtuSize
+
+using namespace RTC;
+
+SCENARIO("ProbationPacer", "[rtp][probation]")
+{
+	ProbationPacer pacer;
+	uint64_t now{ 100000 };
+
+	SECTION("no credit without probation bitrate")
+	{
+		pacer.AddMediaPacket(1000, 500000, now);
+
+		REQUIRE(pacer.GetBitrate() == 0u);
+		REQUIRE(pacer.GetAvailableBytes() == 0u);
+	}
+
+	SECTION("no credit without media bitrate")
+	{
+		pacer.SetBitrate(250000);
+		pacer.AddMediaPacket(1000, 0, now);
+
+		REQUIRE(pacer.GetAvailableBytes() == 0u);
+	}
+
+	SECTION("credit is proportional to the sent media")
+	{
+		pacer.SetBitrate(250000);
+
+		pacer.AddMediaPacket(1000, 500000, now);
+		REQUIRE(pacer.GetAvailableBytes() == 500u);
+
+		pacer.AddMediaPacket(200, 500000, now + 10);
+		REQUIRE(pacer.GetAvailableBytes() == 600u);
+
+		pacer.Consume(400);
+		REQUIRE(pacer.GetAvailableBytes() == 200u);
+
+		// Probation packets bigger than the credit.
+		pacer.Consume(1000);
+		REQUIRE(pacer.GetAvailableBytes() == 0u);
+	}
+
+	SECTION("credit is limited")
+	{
+		pacer.SetBitrate(2000000);
+
+		for (int i{ 0 }; i < 10; ++i)
+		{
+			pacer.AddMediaPacket(1000, 500000, now);
+		}
+
+		REQUIRE(pacer.GetAvailableBytes() == 2 * MtuSize);
+	}
+
+	SECTION("probation lasts Duration once per Interval")
+	{
+		pacer.SetBitrate(500000);
+
+		pacer.AddMediaPacket(1000, 500000, now);
+		REQUIRE(pacer.GetAvailableBytes() == 1000u);
+
+		// Probation finished, pending credit is discarded.
+		pacer.AddMediaPacket(1000, 500000, now + ProbationPacer::Duration);
+		REQUIRE(pacer.GetAvailableBytes() == 0u);
+
+		pacer.AddMediaPacket(1000, 500000, now + ProbationPacer::Interval - 1);
+		REQUIRE(pacer.GetAvailableBytes() == 0u);
+
+		// New probation.
+		pacer.AddMediaPacket(1000, 500000, now + ProbationPacer::Interval);
+		REQUIRE(pacer.GetAvailableBytes() == 1000u);
+	}
+
+	SECTION("stopping the probation clears the credit")
+	{
+		pacer.SetBitrate(500000);
+		pacer.AddMediaPacket(1000, 500000, now);
+
+		REQUIRE(pacer.GetAvailableBytes() == 1000u);
+
+		// I.e. not even the target layer fits into the available bitrate.
+		pacer.SetBitrate(0);
+
+		REQUIRE(pacer.GetAvailableBytes() == 0u);
+
+		pacer.AddMediaPacket(1000, 500000, now + 10);
+
+		REQUIRE(pacer.GetAvailableBytes() == 0u);
+	}
+
+	SECTION("Clear() discards the credit")
+	{
+		pacer.SetBitrate(500000);
+		pacer.AddMediaPacket(1000, 500000, now);
+		pacer.Clear();
+
+		REQUIRE(pacer.GetAvailableBytes() == 0u);
+		REQUIRE(pacer.GetBitrate() == 500000u);
+	}
+}
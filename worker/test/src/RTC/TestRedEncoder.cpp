@@ -0,0 +1,128 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "Utils.hpp"
+#include "RTC/RedEncoder.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/RtpPacketOverlay.hpp"
+#include <cstring> // std::memcmp()
+#include <vector>
+
+using namespace RTC;
+
+static RtpPacket* createPacket(
+  uint8_t* buffer, uint16_t seq, uint32_t timestamp, size_t payloadLength)
+{
+	buffer[0] = 0x80;
+	buffer[1] = 0x80 | 100; // Marker bit and payload type.
+	Utils::Byte::Set2Bytes(buffer, 2, seq);
+	Utils::Byte::Set4Bytes(buffer, 4, timestamp);
+	Utils::Byte::Set4Bytes(buffer, 8, 1111);
+
+	for (size_t i{ 0 }; i < payloadLength; ++i)
+	{
+		buffer[12 + i] = static_cast<uint8_t>(seq + i);
+	}
+
+	return RtpPacket::Parse(buffer, 12 + payloadLength);
+}
+
+SCENARIO("RedEncoder", "[rtp][red]")
+{
+	RedEncoder encoder(63);
+
+	uint8_t buffers[3][100];
+	size_t payloadLengths[] = { 50, 20, 80 };
+	std::vector<RtpPacket*> packets;
+
+	for (size_t i{ 0 }; i < 3; ++i)
+	{
+		packets.push_back(createPacket(buffers[i], 10 + i, 960 * (i + 1), payloadLengths[i]));
+	}
+
+	SECTION("packets are sent as they are if there are no losses")
+	{
+		REQUIRE(encoder.GetDistance() == 0);
+
+		for (auto* packet : packets)
+		{
+			REQUIRE(encoder.Encode(RtpPacketOverlay(packet)) == nullptr);
+		}
+	}
+
+	SECTION("distance depends on the fraction lost")
+	{
+		encoder.SetFractionLost(10);
+		REQUIRE(encoder.GetDistance() == 1);
+
+		encoder.SetFractionLost(100);
+		REQUIRE(encoder.GetDistance() == 2);
+
+		encoder.SetFractionLost(0);
+		REQUIRE(encoder.GetDistance() == 0);
+	}
+
+	SECTION("RED packets carry the previous payloads")
+	{
+		// Previous payloads are kept even if no redundancy is sent.
+		REQUIRE(encoder.Encode(RtpPacketOverlay(packets[0])) == nullptr);
+
+		encoder.SetFractionLost(100);
+
+		REQUIRE(encoder.Encode(RtpPacketOverlay(packets[1])));
+
+		RtpPacketOverlay overlay(packets[2]);
+
+		overlay.SetSequenceNumber(2000);
+		overlay.SetSsrc(2222);
+
+		auto* redPacket = encoder.Encode(overlay);
+
+		REQUIRE(redPacket);
+		REQUIRE(redPacket->GetPayloadType() == 63);
+		REQUIRE(redPacket->HasMarker());
+		REQUIRE(redPacket->GetSequenceNumber() == 2000);
+		REQUIRE(redPacket->GetSsrc() == 2222);
+		REQUIRE(redPacket->GetTimestamp() == 2880);
+		REQUIRE(redPacket->GetPayloadLength() == 4 + 4 + 1 + 50 + 20 + 80);
+
+		auto* payload = redPacket->GetPayload();
+
+		// Oldest block first.
+		REQUIRE(payload[0] == (0x80 | 100));
+		REQUIRE(Utils::Byte::Get3Bytes(payload, 1) >> 10 == 1920);
+		REQUIRE((Utils::Byte::Get3Bytes(payload, 1) & 0x3FF) == 50);
+		REQUIRE(payload[4] == (0x80 | 100));
+		REQUIRE(Utils::Byte::Get3Bytes(payload, 5) >> 10 == 960);
+		REQUIRE((Utils::Byte::Get3Bytes(payload, 5) & 0x3FF) == 20);
+		REQUIRE(payload[8] == 100);
+
+		payload += 9;
+
+		for (auto* packet : packets)
+		{
+			REQUIRE(std::memcmp(payload, packet->GetPayload(), packet->GetPayloadLength()) == 0);
+
+			payload += packet->GetPayloadLength();
+		}
+	}
+
+	SECTION("too old payloads are not carried")
+	{
+		encoder.SetFractionLost(100);
+
+		REQUIRE(encoder.Encode(RtpPacketOverlay(packets[0])));
+
+		packets[1]->SetTimestamp(960 + RedEncoder::MaxTimestampOffset + 1);
+
+		auto* redPacket = encoder.Encode(RtpPacketOverlay(packets[1]));
+
+		REQUIRE(redPacket);
+		REQUIRE(redPacket->GetPayloadLength() == 1 + 20);
+		REQUIRE(redPacket->GetPayload()[0] == 100);
+	}
+
+	for (auto* packet : packets)
+	{
+		delete packet;
+	}
+}
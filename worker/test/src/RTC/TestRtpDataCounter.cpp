@@ -78,4 +78,64 @@ SCENARIO("Bitrate calculator", "[rtp][bitrate]")
 
 		REQUIRE(rate.GetRate(now + 3000) == 0);
 	}
+
+	SECTION("slide with 100 ms items")
+	{
+		RateCalculator rate(1000, RateCalculator::BpsScale, 100);
+
+		// Base time in the beginning of an item.
+		now -= now % 100;
+
+		// clang-format off
+		std::vector<data> input =
+		{
+			{ 0,    5, 44 },
+			{ 50,   2, 59 },
+			{ 99,   1, 64 },
+			{ 100,  1, 80 },
+			{ 999,  2, 88 },
+			// Item started at 0 leaves the window.
+			{ 1000, 1, 36 },
+			{ 1099, 1, 40 },
+			// Item started at 100 leaves the window.
+			{ 1100, 1, 44 },
+			// Items started at 900 and 1000 leave the window.
+			{ 2050, 4, 42 }
+		};
+		// clang-format on
+
+		validate(rate, now, input);
+
+		REQUIRE(rate.GetRate(now + 3000) == 0);
+	}
+
+	SECTION("steady stream with 100 ms items")
+	{
+		RateCalculator rate(1000, RateCalculator::BpsScale, 100);
+
+		// 10 bytes every 10 ms is 8000 bps.
+		for (uint64_t offset{ 0 }; offset < 3000; offset += 10)
+		{
+			rate.Update(10, now + offset);
+
+			if (offset < 1000)
+				continue;
+
+			auto bitrate = rate.GetRate(now + offset);
+
+			REQUIRE(bitrate >= 7900);
+			REQUIRE(bitrate <= 8100);
+		}
+	}
+
+	SECTION("reset")
+	{
+		RateCalculator rate;
+
+		rate.Update(5, now);
+		REQUIRE(rate.GetRate(now) == 40);
+
+		rate.Reset();
+		REQUIRE(rate.GetRate(now) == 0);
+	}
 }
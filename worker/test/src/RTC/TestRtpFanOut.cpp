@@ -0,0 +1,254 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "RTC/Consumer.hpp"
+#include "RTC/RtpFanOut.hpp"
+#include "RTC/RtpPacket.hpp"
+#include <vector>
+
+using namespace RTC;
+
+class TestFanOutConsumerListener : public Consumer::Listener
+{
+public:
+	void OnConsumerSendRtpPacket(
+	  RTC::Consumer* /*consumer*/, const RTC::RtpPacketOverlay& /*overlay*/) override
+	{
+	}
+	void OnConsumerKeyFrameRequested(RTC::Consumer* /*consumer*/, uint32_t /*mappedSsrc*/) override
+	{
+	}
+	void OnConsumerSubscriptionChanged(RTC::Consumer* /*consumer*/) override
+	{
+	}
+	void onConsumerProducerClosed(RTC::Consumer* /*consumer*/) override
+	{
+	}
+};
+
+static TestFanOutConsumerListener consumerListener;
+
+class TestFanOutConsumer : public Consumer
+{
+public:
+	TestFanOutConsumer(const std::string& id, json& data, std::vector<uint32_t> subscribedMappedSsrcs, bool allStreams)
+	  : Consumer(id, &consumerListener, data, RtpParameters::Type::SIMPLE),
+	    subscribedMappedSsrcs(std::move(subscribedMappedSsrcs)), allStreams(allStreams)
+	{
+		TransportConnected();
+	}
+
+public:
+	bool GetSubscribedMappedSsrcs(std::vector<uint32_t>& mappedSsrcs) const override
+	{
+		if (this->allStreams)
+			return false;
+
+		mappedSsrcs = this->subscribedMappedSsrcs;
+
+		return true;
+	}
+
+	void SendRtpPacket(const RTC::RtpPacket* packet) override
+	{
+		this->receivedSsrcs.push_back(packet->GetSsrc());
+
+		// Simulate a layer switch while the packet is being dispatched.
+		if (this->fanOut && this->switchToSsrc != 0u && packet->GetSsrc() == this->switchToSsrc)
+		{
+			this->subscribedMappedSsrcs = { this->switchToSsrc };
+			this->switchToSsrc          = 0u;
+
+			this->fanOut->UpdateConsumer(this);
+		}
+	}
+
+	void FillJsonStats(json& /*jsonArray*/) const override
+	{
+	}
+	void FillJsonScore(json& /*jsonObject*/) const override
+	{
+	}
+	void WriteStats(RTC::StatsWriter& /*writer*/) const override
+	{
+	}
+	void ProducerNewRtpStream(RTC::RtpStream* /*rtpStream*/, uint32_t /*mappedSsrc*/) override
+	{
+	}
+	void ProducerRtpStreamScore(RTC::RtpStream* /*rtpStream*/, uint8_t /*score*/) override
+	{
+	}
+	void GetRtcp(RTC::RTCP::CompoundPacket* /*packet*/, uint64_t /*now*/) override
+	{
+	}
+	void NeedWorstRemoteFractionLost(uint32_t /*mappedSsrc*/, uint8_t& /*worstRemoteFractionLost*/) override
+	{
+	}
+	void ReceiveNack(RTC::RTCP::FeedbackRtpNackPacket* /*nackPacket*/) override
+	{
+	}
+	void ReceiveKeyFrameRequest(RTC::RTCP::FeedbackPs::MessageType /*messageType*/) override
+	{
+	}
+	void ReceiveRtcpReceiverReport(RTC::RTCP::ReceiverReport* /*report*/) override
+	{
+	}
+	uint32_t GetTransmissionRate(uint64_t /*now*/) override
+	{
+		return 0u;
+	}
+	float GetLossPercentage() const override
+	{
+		return 0;
+	}
+
+protected:
+	void Paused(bool /*wasProducer*/) override
+	{
+	}
+	void Resumed(bool /*wasProducer*/) override
+	{
+	}
+	void UserOnTransportConnected() override
+	{
+	}
+
+public:
+	std::vector<uint32_t> subscribedMappedSsrcs;
+	bool allStreams{ false };
+	std::vector<uint32_t> receivedSsrcs;
+	RtpFanOut* fanOut{ nullptr };
+	uint32_t switchToSsrc{ 0u };
+};
+
+SCENARIO("RtpFanOut", "[rtp][fanout]")
+{
+	json data = json::parse(R"({
+		"kind"          : "video",
+		"rtpParameters" :
+		{
+			"codecs"    : [ { "mimeType": "video/VP8", "payloadType": 101, "clockRate": 90000 } ],
+			"encodings" : [ { "ssrc": 1234 } ]
+		},
+		"consumableRtpEncodings" : [ { "ssrc": 1001 }, { "ssrc": 1002 }, { "ssrc": 1003 } ]
+	})");
+
+	// clang-format off
+	uint8_t buffer[] =
+	{
+		0x80, 0x65, 0x00, 0x01,
+		0x00, 0x00, 0x00, 0x01,
+		0x00, 0x00, 0x00, 0x00
+	};
+	// clang-format on
+
+	auto sendPacket = [&](RtpFanOut& fanOut, uint32_t ssrc) {
+		RtpPacket* packet = RtpPacket::Parse(buffer, sizeof(buffer));
+
+		packet->SetSsrc(ssrc);
+		fanOut.SendRtpPacket(packet);
+
+		delete packet;
+	};
+
+	SECTION("packets are just dispatched to consumers of their stream")
+	{
+		RtpFanOut fanOut;
+		TestFanOutConsumer consumer1("c1", data, { 1001 }, false);
+		TestFanOutConsumer consumer2("c2", data, { 1002, 1003 }, false);
+		TestFanOutConsumer consumer3("c3", data, {}, true);
+
+		fanOut.AddConsumer(&consumer1);
+		fanOut.AddConsumer(&consumer2);
+		fanOut.AddConsumer(&consumer3);
+
+		REQUIRE(fanOut.GetNumConsumers(1001) == 2);
+		REQUIRE(fanOut.GetNumConsumers(1002) == 2);
+		REQUIRE(fanOut.GetNumConsumers(9999) == 1);
+
+		sendPacket(fanOut, 1001);
+		sendPacket(fanOut, 1002);
+		sendPacket(fanOut, 1003);
+
+		REQUIRE(consumer1.receivedSsrcs == std::vector<uint32_t>({ 1001 }));
+		REQUIRE(consumer2.receivedSsrcs == std::vector<uint32_t>({ 1002, 1003 }));
+		REQUIRE(consumer3.receivedSsrcs == std::vector<uint32_t>({ 1001, 1002, 1003 }));
+
+		fanOut.RemoveConsumer(&consumer2);
+
+		REQUIRE(fanOut.GetNumConsumers(1002) == 1);
+
+		sendPacket(fanOut, 1002);
+
+		REQUIRE(consumer2.receivedSsrcs.size() == 2);
+		REQUIRE(consumer3.receivedSsrcs.size() == 4);
+	}
+
+	SECTION("subscription changes are applied")
+	{
+		RtpFanOut fanOut;
+		TestFanOutConsumer consumer("c1", data, { 1001 }, false);
+
+		fanOut.AddConsumer(&consumer);
+
+		consumer.subscribedMappedSsrcs = { 1003 };
+		fanOut.UpdateConsumer(&consumer);
+
+		sendPacket(fanOut, 1001);
+		sendPacket(fanOut, 1003);
+
+		REQUIRE(consumer.receivedSsrcs == std::vector<uint32_t>({ 1003 }));
+		REQUIRE(fanOut.GetNumConsumers(1001) == 0);
+	}
+
+	SECTION("subscription changes while dispatching are deferred")
+	{
+		RtpFanOut fanOut;
+		TestFanOutConsumer consumer1("c1", data, { 1001, 1002 }, false);
+		TestFanOutConsumer consumer2("c2", data, { 1002 }, false);
+
+		consumer1.fanOut       = &fanOut;
+		consumer1.switchToSsrc = 1002;
+
+		fanOut.AddConsumer(&consumer1);
+		fanOut.AddConsumer(&consumer2);
+
+		sendPacket(fanOut, 1002);
+
+		REQUIRE(consumer1.receivedSsrcs == std::vector<uint32_t>({ 1002 }));
+		REQUIRE(consumer2.receivedSsrcs == std::vector<uint32_t>({ 1002 }));
+		REQUIRE(fanOut.GetNumConsumers(1001) == 0);
+		REQUIRE(fanOut.GetNumConsumers(1002) == 2);
+	}
+
+	SECTION("consumers of disconnected transports don't get packets")
+	{
+		RtpFanOut fanOut;
+		TestFanOutConsumer consumer1("c1", data, { 1001 }, false);
+		TestFanOutConsumer consumer2("c2", data, {}, true);
+
+		fanOut.AddConsumer(&consumer1);
+		fanOut.AddConsumer(&consumer2);
+
+		consumer1.TransportDisconnected();
+		consumer2.TransportDisconnected();
+		fanOut.UpdateConsumer(&consumer1);
+		fanOut.UpdateConsumer(&consumer2);
+
+		REQUIRE(fanOut.GetNumConsumers(1001) == 0);
+
+		sendPacket(fanOut, 1001);
+
+		REQUIRE(consumer1.receivedSsrcs.empty());
+		REQUIRE(consumer2.receivedSsrcs.empty());
+
+		consumer1.TransportConnected();
+		consumer2.TransportConnected();
+		fanOut.UpdateConsumer(&consumer1);
+		fanOut.UpdateConsumer(&consumer2);
+
+		sendPacket(fanOut, 1001);
+
+		REQUIRE(consumer1.receivedSsrcs == std::vector<uint32_t>({ 1001 }));
+		REQUIRE(consumer2.receivedSsrcs == std::vector<uint32_t>({ 1001 }));
+	}
+}
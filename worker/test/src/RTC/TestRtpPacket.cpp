@@ -187,6 +187,11 @@ SCENARIO("parse RTP packets", "[parser][rtp]")
 		REQUIRE(clonedPacket->ReadAbsSendTime(absSendTime) == true);
 		REQUIRE(absSendTime == 0x65341e);
 
+		// 1.5 seconds in 6.18 fixed point.
+		REQUIRE(clonedPacket->UpdateAbsSendTime(1500) == true);
+		REQUIRE(clonedPacket->ReadAbsSendTime(absSendTime) == true);
+		REQUIRE(absSendTime == 0x060000);
+
 		REQUIRE(
 		  std::memcmp(clonedPacket->GetPayload(), packet->GetPayload(), packet->GetPayloadLength()) == 0);
 
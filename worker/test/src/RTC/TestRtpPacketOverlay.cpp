@@ -0,0 +1,164 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "RTC/RtpPacket.hpp"
+#include "RTC/RtpPacketOverlay.hpp"
+#include <cstring> // std::memcmp(), std::memcpy()
+
+using namespace RTC;
+
+class TestOverlayPayloadDescriptorHandler : public Codecs::PayloadDescriptorHandler
+{
+public:
+	explicit TestOverlayPayloadDescriptorHandler(bool drop) : drop(drop){};
+	~TestOverlayPayloadDescriptorHandler() = default;
+	void Dump() const
+	{
+		return;
+	};
+	bool Encode(Codecs::EncodingContext* /*context*/, uint8_t* data)
+	{
+		if (this->drop)
+			return false;
+
+		data[0] = 0xAB;
+		data[1] = 0xCD;
+
+		return true;
+	};
+	bool IsKeyFrame() const
+	{
+		return false;
+	};
+
+private:
+	bool drop{ false };
+};
+
+static void concatBuffers(const uv_buf_t* buffers, size_t count, uint8_t* data)
+{
+	for (size_t i{ 0 }; i < count; ++i)
+	{
+		std::memcpy(data, buffers[i].base, buffers[i].len);
+
+		data += buffers[i].len;
+	}
+}
+
+SCENARIO("RtpPacketOverlay", "[rtp][overlay]")
+{
+	// clang-format off
+	uint8_t buffer[] =
+	{
+		0x90, 0x01, 0x00, 0x08,
+		0x00, 0x00, 0x00, 0x04,
+		0x00, 0x00, 0x00, 0x05,
+		0xBE, 0xDE, 0x00, 0x01, // Header extension.
+		0x10, 0xFF, 0x00, 0x00,
+		0x11, 0x22, 0x33, 0x44, // Payload.
+		0x55, 0x66, 0x77, 0x88,
+		0x99, 0xAA
+	};
+	// clang-format on
+
+	uint8_t originalBuffer[sizeof(buffer)];
+
+	std::memcpy(originalBuffer, buffer, sizeof(buffer));
+
+	RtpPacket* packet = RtpPacket::Parse(buffer, sizeof(buffer));
+
+	REQUIRE(packet);
+	REQUIRE(packet->GetPayloadLength() == 10);
+
+	uint8_t result[sizeof(buffer)];
+	uv_buf_t buffers[RtpPacketOverlay::MaxBuffers];
+
+	SECTION("rewritten header fields do not modify the packet")
+	{
+		RtpPacketOverlay overlay(packet);
+
+		REQUIRE(overlay.GetSequenceNumber() == 8);
+		REQUIRE(overlay.GetTimestamp() == 4);
+		REQUIRE(overlay.GetSsrc() == 5);
+
+		overlay.SetSequenceNumber(1000);
+		overlay.SetTimestamp(2000);
+		overlay.SetSsrc(3000);
+
+		REQUIRE(overlay.GetSequenceNumber() == 1000);
+		REQUIRE(overlay.GetTimestamp() == 2000);
+		REQUIRE(overlay.GetSsrc() == 3000);
+		REQUIRE(overlay.GetPayloadType() == 1);
+		REQUIRE(overlay.GetSize() == sizeof(buffer));
+		REQUIRE(std::memcmp(buffer, originalBuffer, sizeof(buffer)) == 0);
+
+		size_t count = overlay.FillBuffers(buffers);
+
+		REQUIRE(count == 2);
+
+		concatBuffers(buffers, count, result);
+
+		auto* resultPacket = RtpPacket::Parse(result, sizeof(result));
+
+		REQUIRE(resultPacket);
+		REQUIRE(resultPacket->GetSequenceNumber() == 1000);
+		REQUIRE(resultPacket->GetTimestamp() == 2000);
+		REQUIRE(resultPacket->GetSsrc() == 3000);
+		REQUIRE(std::memcmp(result + 12, buffer + 12, sizeof(buffer) - 12) == 0);
+
+		delete resultPacket;
+	}
+
+	SECTION("encoded payload descriptor does not modify the packet")
+	{
+		packet->SetPayloadDescriptorHandler(new TestOverlayPayloadDescriptorHandler(false));
+
+		RtpPacketOverlay overlay(packet);
+
+		overlay.SetSequenceNumber(1000);
+
+		REQUIRE(overlay.EncodePayload(nullptr));
+		REQUIRE(std::memcmp(buffer, originalBuffer, sizeof(buffer)) == 0);
+
+		size_t count = overlay.FillBuffers(buffers);
+
+		REQUIRE(count == 4);
+
+		concatBuffers(buffers, count, result);
+
+		REQUIRE(result[20] == 0xAB);
+		REQUIRE(result[21] == 0xCD);
+		REQUIRE(std::memcmp(result + 12, buffer + 12, 8) == 0);
+		REQUIRE(std::memcmp(result + 22, buffer + 22, sizeof(buffer) - 22) == 0);
+
+		uint8_t serialized[sizeof(buffer)];
+
+		overlay.Serialize(serialized);
+
+		REQUIRE(std::memcmp(serialized, result, sizeof(result)) == 0);
+
+		uint8_t store[sizeof(buffer) + 100];
+		auto* clonedPacket = overlay.Clone(store);
+
+		REQUIRE(clonedPacket->GetSequenceNumber() == 1000);
+		REQUIRE(clonedPacket->GetSize() == sizeof(buffer));
+		REQUIRE(std::memcmp(clonedPacket->GetData(), result, sizeof(result)) == 0);
+		REQUIRE(packet->GetSequenceNumber() == 8);
+
+		delete clonedPacket;
+	}
+
+	SECTION("dropped payload keeps the original payload")
+	{
+		packet->SetPayloadDescriptorHandler(new TestOverlayPayloadDescriptorHandler(true));
+
+		RtpPacketOverlay overlay(packet);
+
+		REQUIRE(!overlay.EncodePayload(nullptr));
+
+		overlay.Serialize(result);
+
+		REQUIRE(std::memcmp(result, originalBuffer, sizeof(buffer)) == 0);
+	}
+
+	delete packet;
+}
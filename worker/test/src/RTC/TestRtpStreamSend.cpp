@@ -152,4 +152,65 @@ SCENARIO("NACK and RTP packets retransmission", "[rtp][rtcp]")
 		delete packet5;
 		delete stream;
 	}
+
+	SECTION("the most recent requested packets are retransmitted if the budget is exceeded")
+	{
+		// clang-format off
+		uint8_t rtpBuffer[1212] =
+		{
+			0b10000000, 0b01111011, 0b01010010, 0b00001110,
+			0b01011011, 0b01101011, 0b11001010, 0b10110101,
+			0, 0, 0, 2
+		};
+		// clang-format on
+
+		RtpPacket* packet = RtpPacket::Parse(rtpBuffer, sizeof(rtpBuffer));
+
+		REQUIRE(packet);
+
+		RtpStream::Params params;
+
+		params.ssrc      = packet->GetSsrc();
+		params.clockRate = 90000;
+		params.useNack   = true;
+
+		RtpStreamSend* stream = new RtpStreamSend(&testRtpStreamListener, params, 200);
+
+		for (uint16_t seq{ 21006 }; seq < 21006 + 17; ++seq)
+		{
+			packet->SetSequenceNumber(seq);
+			stream->ReceivePacket(packet);
+		}
+
+		// Request all the packets.
+		RTCP::FeedbackRtpNackPacket nackPacket(0, params.ssrc);
+		auto* nackItem = new RTCP::FeedbackRtpNackItem(21006, 0b1111111111111111);
+
+		nackPacket.AddItem(nackItem);
+
+		stream->ReceiveNack(&nackPacket);
+
+		// The budget of a low bitrate stream allows this number of packets.
+		size_t allowedPackets =
+		  RetransmissionBudget::MinBitrate * RetransmissionBudget::Window / 8000 / sizeof(rtpBuffer);
+
+		REQUIRE(allowedPackets < 17);
+		REQUIRE(testRtpStreamListener.retransmittedPackets.size() == allowedPackets);
+
+		uint16_t seq = 21006 + 17 - allowedPackets;
+
+		for (auto* rtxPacket : testRtpStreamListener.retransmittedPackets)
+		{
+			REQUIRE(rtxPacket->GetSequenceNumber() == seq++);
+		}
+
+		json stats = json::object();
+
+		stream->FillJsonStats(stats);
+
+		REQUIRE(stats["retransmissionPacketsDropped"] == 17 - allowedPackets);
+
+		delete packet;
+		delete stream;
+	}
 }
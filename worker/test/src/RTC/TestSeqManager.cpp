@@ -282,4 +282,123 @@ SCENARIO("SeqManager", "[rtc]")
 		SeqManager<uint16_t> seqManager;
 		validate(seqManager, inputs);
 	}
+
+	SECTION("drop every other input (temporal layer filtering)")
+	{
+		SeqManager<uint16_t> seqManager;
+		uint16_t output;
+		uint16_t expected{ 0 };
+
+		// Spans several windows and a wrap of the input.
+		for (uint32_t i{ 0 }; i < 200000; ++i)
+		{
+			auto input = static_cast<uint16_t>(i);
+
+			if (i % 2 == 1)
+			{
+				seqManager.Drop(input);
+
+				continue;
+			}
+
+			REQUIRE(seqManager.Input(input, output));
+			REQUIRE(output == expected);
+
+			++expected;
+		}
+	}
+
+	SECTION("drop long runs of inputs")
+	{
+		SeqManager<uint16_t> seqManager;
+		uint16_t output;
+		uint16_t expected{ 0 };
+
+		for (uint32_t i{ 0 }; i < 100000; ++i)
+		{
+			auto input = static_cast<uint16_t>(i);
+
+			// Runs of 3000 dropped inputs, longer than the drop window.
+			if ((i / 3000) % 2 == 1)
+			{
+				seqManager.Drop(input);
+
+				continue;
+			}
+
+			REQUIRE(seqManager.Input(input, output));
+			REQUIRE(output == expected);
+
+			++expected;
+		}
+	}
+
+	SECTION("dropped inputs are rejected and late inputs keep their output")
+	{
+		SeqManager<uint16_t> seqManager;
+		uint16_t output;
+
+		REQUIRE(seqManager.Input(0, output));
+		REQUIRE(output == 0);
+
+		seqManager.Drop(2);
+		seqManager.Drop(3);
+
+		REQUIRE(seqManager.Input(4, output));
+		REQUIRE(output == 2);
+		REQUIRE(!seqManager.Input(3, output));
+
+		// Late input lower than the dropped ones.
+		REQUIRE(seqManager.Input(1, output));
+		REQUIRE(output == 1);
+
+		REQUIRE(seqManager.Input(5, output));
+		REQUIRE(output == 3);
+	}
+
+	SECTION("no output jump after many inputs beyond a drop")
+	{
+		SeqManager<uint16_t> seqManager;
+		uint16_t output;
+
+		REQUIRE(seqManager.Input(0, output));
+
+		seqManager.Drop(1);
+
+		for (uint32_t i{ 2 }; i < 100000; ++i)
+		{
+			REQUIRE(seqManager.Input(static_cast<uint16_t>(i), output));
+			REQUIRE(output == static_cast<uint16_t>(i - 1));
+		}
+	}
+
+	SECTION("drop every other input with uint8_t and uint32_t")
+	{
+		SeqManager<uint8_t> seqManager8;
+		SeqManager<uint32_t> seqManager32;
+		uint8_t output8;
+		uint32_t output32;
+		uint32_t expected{ 0 };
+
+		for (uint32_t i{ 0 }; i < 2000; ++i)
+		{
+			// Timestamp like gaps, bigger than the drop window.
+			uint32_t timestamp = 2000000000u + i * 3000;
+
+			if (i % 2 == 1)
+			{
+				seqManager8.Drop(static_cast<uint8_t>(i));
+				seqManager32.Drop(timestamp);
+
+				continue;
+			}
+
+			REQUIRE(seqManager8.Input(static_cast<uint8_t>(i), output8));
+			REQUIRE(output8 == static_cast<uint8_t>(expected));
+			REQUIRE(seqManager32.Input(timestamp, output32));
+			REQUIRE(output32 == timestamp - i / 2);
+
+			++expected;
+		}
+	}
 }
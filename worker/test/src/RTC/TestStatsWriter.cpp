@@ -0,0 +1,242 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "json.hpp"
+#include "MediaSoupErrors.hpp"
+#include "RTC/StatsWriter.hpp"
+#include <string>
+#include <vector>
+
+using namespace RTC;
+using json = nlohmann::json;
+
+class TestStatsWriterListener : public StatsWriter::Listener
+{
+public:
+	void OnStatsWriterChunk(StatsWriter* /*writer*/, const std::string& chunk) override
+	{
+		this->chunks.push_back(chunk);
+	}
+
+public:
+	std::vector<std::string> chunks;
+};
+
+SCENARIO("Stats writer", "[stats]")
+{
+	SECTION("no field mask writes all fields")
+	{
+		json data = json::object();
+
+		StatsWriter writer(StatsWriter::GetFieldMask(data), 1234);
+
+		writer.BeginTable(StatsWriter::Table::TRANSPORTS);
+		writer.BeginRow("transport1");
+		writer.AddValue(StatsWriter::Field::BYTES_RECEIVED, 100);
+		writer.AddValue(StatsWriter::Field::BYTES_SENT, 200);
+		writer.AddValue(StatsWriter::Field::AVAILABLE_INCOMING_BITRATE, 300);
+		writer.AddValue(StatsWriter::Field::AVAILABLE_OUTGOING_BITRATE, 400);
+		writer.EndRow();
+		writer.EndTable();
+
+		writer.BeginTable(StatsWriter::Table::PRODUCERS);
+		writer.EndTable();
+
+		auto stats = json::parse(writer.Close());
+
+		REQUIRE(stats["timestamp"] == 1234);
+		REQUIRE(
+		  stats["transports"]["fields"] ==
+		  json({ "id", "bytesReceived", "bytesSent", "availableIncomingBitrate", "availableOutgoingBitrate" }));
+		REQUIRE(stats["transports"]["rows"] == json({ { "transport1", 100, 200, 300, 400 } }));
+		REQUIRE(stats["producers"]["fields"].size() == 14);
+		REQUIRE(stats["producers"]["rows"].empty());
+	}
+
+	SECTION("field mask filters values and always keeps ssrc")
+	{
+		json data = json::parse(R"({ "fields": [ "packetCount", "score" ] })");
+
+		StatsWriter writer(StatsWriter::GetFieldMask(data), 0);
+
+		writer.BeginTable(StatsWriter::Table::CONSUMERS);
+
+		for (uint32_t ssrc : { 1111, 2222 })
+		{
+			writer.BeginRow("consumer1");
+			writer.AddValue(StatsWriter::Field::SSRC, ssrc);
+			writer.AddValue(StatsWriter::Field::PACKET_COUNT, 10);
+			writer.AddValue(StatsWriter::Field::BYTE_COUNT, 1000);
+			writer.AddValue(StatsWriter::Field::SCORE, 10);
+			writer.EndRow();
+		}
+
+		writer.EndTable();
+
+		auto stats = json::parse(writer.Close());
+
+		REQUIRE(stats["consumers"]["fields"] == json({ "id", "ssrc", "packetCount", "score" }));
+		REQUIRE(
+		  stats["consumers"]["rows"] ==
+		  json({ { "consumer1", 1111, 10, 10 }, { "consumer1", 2222, 10, 10 } }));
+	}
+
+	SECTION("snapshot writes only changed values")
+	{
+		json data = json::parse(R"({ "fields": [ "packetCount", "byteCount" ] })");
+		uint32_t fieldMask = StatsWriter::GetFieldMask(data);
+		StatsWriter::Snapshot snapshot;
+
+		auto write = [&](uint64_t packetCount, uint64_t byteCount, bool withSecondRow) {
+			StatsWriter writer(fieldMask, 0, &snapshot);
+
+			writer.BeginTable(StatsWriter::Table::PRODUCERS);
+			writer.BeginRow("producer1");
+			writer.AddValue(StatsWriter::Field::SSRC, 1111);
+			writer.AddValue(StatsWriter::Field::PACKET_COUNT, packetCount);
+			writer.AddValue(StatsWriter::Field::BYTE_COUNT, byteCount);
+			writer.EndRow();
+
+			if (withSecondRow)
+			{
+				writer.BeginRow("producer2");
+				writer.AddValue(StatsWriter::Field::SSRC, 2222);
+				writer.AddValue(StatsWriter::Field::PACKET_COUNT, 1);
+				writer.AddValue(StatsWriter::Field::BYTE_COUNT, 1);
+				writer.EndRow();
+			}
+
+			writer.EndTable();
+
+			return json::parse(writer.Close());
+		};
+
+		// First write contains everything.
+		auto stats = write(10, 1000, true);
+
+		REQUIRE(stats["producers"]["fields"] == json({ "id", "ssrc", "packetCount", "byteCount" }));
+		REQUIRE(
+		  stats["producers"]["rows"] ==
+		  json({ { "producer1", 1, 1111, 2, 10, 3, 1000 }, { "producer2", 1, 2222, 2, 1, 3, 1 } }));
+
+		// Only changed values (plus ssrc) are written and unchanged rows are omitted.
+		stats = write(11, 1000, true);
+
+		REQUIRE(stats["producers"]["rows"] == json({ { "producer1", 1, 1111, 2, 11 } }));
+
+		// Nothing changed.
+		stats = write(11, 1000, true);
+
+		REQUIRE(stats["producers"]["rows"].empty());
+
+		// Removed rows are forgotten so they are fully written if they appear again.
+		write(11, 1000, false);
+
+		REQUIRE(snapshot.entries.size() == 1);
+
+		stats = write(11, 1000, true);
+
+		REQUIRE(stats["producers"]["rows"] == json({ { "producer2", 1, 2222, 2, 1, 3, 1 } }));
+	}
+
+	SECTION("listener gets the stats in chunks")
+	{
+		json data = json::object();
+		uint32_t fieldMask = StatsWriter::GetFieldMask(data);
+		StatsWriter::Snapshot snapshot;
+		TestStatsWriterListener listener;
+
+		auto write = [&](uint64_t packetCount) {
+			StatsWriter writer(fieldMask, 1234, &snapshot, &listener);
+
+			writer.BeginTable(StatsWriter::Table::TRANSPORTS);
+			writer.BeginRow("transport1");
+			writer.AddValue(StatsWriter::Field::BYTES_RECEIVED, 1);
+			writer.EndRow();
+			writer.EndTable();
+
+			writer.BeginTable(StatsWriter::Table::CONSUMERS);
+
+			for (uint32_t idx{ 0 }; idx < 2000; ++idx)
+			{
+				writer.BeginRow("consumer-" + std::to_string(idx));
+				writer.AddValue(StatsWriter::Field::SSRC, idx);
+				writer.AddValue(StatsWriter::Field::PACKET_COUNT, packetCount);
+				writer.AddValue(StatsWriter::Field::BYTE_COUNT, 123456789);
+				writer.EndRow();
+			}
+
+			writer.EndTable();
+			writer.Close();
+		};
+
+		write(10);
+
+		REQUIRE(listener.chunks.size() > 1);
+
+		size_t consumerRows{ 0 };
+
+		for (size_t idx{ 0 }; idx < listener.chunks.size(); ++idx)
+		{
+			auto& chunk = listener.chunks[idx];
+			auto stats  = json::parse(chunk);
+			bool isLast = idx == listener.chunks.size() - 1;
+
+			REQUIRE(chunk.length() < StatsWriter::MaxChunkSize + 1000);
+			REQUIRE(stats["timestamp"] == 1234);
+			REQUIRE(stats.count("more") == (isLast ? 0 : 1));
+			REQUIRE(stats.count("transports") == (idx == 0 ? 1 : 0));
+			REQUIRE(stats["consumers"]["fields"].size() == 14);
+
+			consumerRows += stats["consumers"]["rows"].size();
+		}
+
+		REQUIRE(consumerRows == 2000);
+
+		// Nothing changed so nothing is given.
+		listener.chunks.clear();
+		write(10);
+
+		REQUIRE(listener.chunks.empty());
+
+		// Just changed values (and ssrc) are written.
+		write(11);
+
+		REQUIRE(!listener.chunks.empty());
+
+		for (auto& chunk : listener.chunks)
+		{
+			auto stats = json::parse(chunk);
+
+			for (auto& row : stats["consumers"]["rows"])
+			{
+				REQUIRE(row.size() == 5);
+				REQUIRE(row[4] == 11);
+			}
+		}
+	}
+
+	SECTION("ids are escaped")
+	{
+		json data = json::object();
+
+		StatsWriter writer(StatsWriter::GetFieldMask(data), 0);
+
+		writer.BeginTable(StatsWriter::Table::TRANSPORTS);
+		writer.BeginRow("a\"b\\c\n");
+		writer.EndRow();
+		writer.EndTable();
+
+		auto stats = json::parse(writer.Close());
+
+		REQUIRE(stats["transports"]["rows"][0][0] == "a\"b\\c\n");
+	}
+
+	SECTION("invalid field mask throws")
+	{
+		json data1 = json::parse(R"({ "fields": "bitrate" })");
+		json data2 = json::parse(R"({ "fields": [ "foo" ] })");
+
+		REQUIRE_THROWS_AS(StatsWriter::GetFieldMask(data1), MediaSoupTypeError);
+		REQUIRE_THROWS_AS(StatsWriter::GetFieldMask(data2), MediaSoupTypeError);
+	}
+}
@@ -0,0 +1,251 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "json.hpp"
+#include "RTC/Consumer.hpp"
+#include "RTC/Transport.hpp"
+#include <string>
+#include <vector>
+
+using namespace RTC;
+using json = nlohmann::json;
+
+class TestConsumerListener : public Consumer::Listener
+{
+public:
+	void OnConsumerSendRtpPacket(Consumer* /*consumer*/, const RtpPacketOverlay& /*overlay*/) override
+	{
+	}
+	void OnConsumerKeyFrameRequested(Consumer* /*consumer*/, uint32_t /*mappedSsrc*/) override
+	{
+	}
+	void OnConsumerSubscriptionChanged(Consumer* /*consumer*/) override
+	{
+	}
+	void onConsumerProducerClosed(Consumer* /*consumer*/) override
+	{
+	}
+};
+
+// Consumer needing a fixed bitrate. If allowed, it stops sending if the given
+// bitrate is not enough.
+class TestConsumer : public Consumer
+{
+public:
+	TestConsumer(
+	  Consumer::Listener* listener,
+	  json& data,
+	  RtpParameters::Type type,
+	  uint32_t neededBitrate)
+	  : Consumer("test", listener, data, type), neededBitrate(neededBitrate)
+	{
+	}
+
+public:
+	void FillJsonStats(json& /*jsonArray*/) const override
+	{
+	}
+	void FillJsonScore(json& /*jsonObject*/) const override
+	{
+	}
+	void WriteStats(StatsWriter& /*writer*/) const override
+	{
+	}
+	void ProducerNewRtpStream(RtpStream* /*rtpStream*/, uint32_t /*mappedSsrc*/) override
+	{
+	}
+	void ProducerRtpStreamScore(RtpStream* /*rtpStream*/, uint8_t /*score*/) override
+	{
+	}
+	void SendRtpPacket(const RtpPacket* /*packet*/) override
+	{
+	}
+	void GetRtcp(RTCP::CompoundPacket* /*packet*/, uint64_t /*now*/) override
+	{
+	}
+	void NeedWorstRemoteFractionLost(
+	  uint32_t /*mappedSsrc*/, uint8_t& /*worstRemoteFractionLost*/) override
+	{
+	}
+	void ReceiveNack(RTCP::FeedbackRtpNackPacket* /*nackPacket*/) override
+	{
+	}
+	void ReceiveKeyFrameRequest(RTCP::FeedbackPs::MessageType /*messageType*/) override
+	{
+	}
+	void ReceiveRtcpReceiverReport(RTCP::ReceiverReport* /*report*/) override
+	{
+	}
+	uint32_t GetTransmissionRate(uint64_t /*now*/) override
+	{
+		return IsActive() ? this->neededBitrate : 0u;
+	}
+	float GetLossPercentage() const override
+	{
+		return 0;
+	}
+	uint32_t UseAvailableBitrate(uint32_t bitrate, bool canPause) override
+	{
+		this->calls++;
+		this->givenBitrate = bitrate;
+		this->givenCanPause = canPause;
+
+		if (GetType() != RtpParameters::Type::SIMULCAST)
+			return Consumer::UseAvailableBitrate(bitrate, canPause);
+
+		this->sending = IsActive() && (!canPause || this->neededBitrate <= bitrate);
+
+		return this->sending ? this->neededBitrate : 0u;
+	}
+
+protected:
+	void Paused(bool /*wasProducer*/) override
+	{
+	}
+	void Resumed(bool /*wasProducer*/) override
+	{
+	}
+	void UserOnTransportConnected() override
+	{
+	}
+
+public:
+	uint32_t neededBitrate{ 0 };
+	size_t calls{ 0 };
+	uint32_t givenBitrate{ 0 };
+	bool givenCanPause{ false };
+	bool sending{ false };
+};
+
+static json createConsumerData(const std::string& kind, uint8_t priority, bool paused)
+{
+	json data = json::parse(R"({
+		"rtpParameters" :
+		{
+			"codecs" :
+			[
+				{ "mimeType": "video/VP8", "payloadType": 101, "clockRate": 90000 }
+			],
+			"encodings" : [ { "ssrc": 11111111 } ]
+		},
+		"consumableRtpEncodings" : [ { "ssrc": 22222222 } ]
+	})");
+
+	data["kind"]     = kind;
+	data["priority"] = priority;
+	data["paused"]   = paused;
+
+	if (kind == "audio")
+	{
+		data["rtpParameters"]["codecs"][0] = json::parse(
+		  R"({ "mimeType": "audio/opus", "payloadType": 100, "clockRate": 48000, "channels": 2 })");
+	}
+
+	return data;
+}
+
+SCENARIO("Transport bitrate distribution", "[transport][bitrate]")
+{
+	TestConsumerListener listener;
+
+	auto createConsumer =
+	  [&listener](const std::string& kind, uint8_t priority, bool paused, uint32_t neededBitrate) {
+		  json data = createConsumerData(kind, priority, paused);
+		  auto type = kind == "audio" ? RtpParameters::Type::SIMPLE : RtpParameters::Type::SIMULCAST;
+
+		  return new TestConsumer(&listener, data, type, neededBitrate);
+	  };
+
+	SECTION("simulcast Consumers get the bitrate in priority order")
+	{
+		auto* thumbnail = createConsumer("video", 1, false, 300000);
+		auto* speaker   = createConsumer("video", 2, false, 300000);
+		auto* screen    = createConsumer("video", 3, false, 300000);
+
+		std::vector<Consumer*> consumers{ thumbnail, speaker, screen };
+
+		REQUIRE(Transport::DistributeBitrate(700000, consumers) == 100000);
+
+		REQUIRE(screen->givenBitrate == 700000);
+		REQUIRE(!screen->givenCanPause);
+		REQUIRE(screen->sending);
+
+		REQUIRE(speaker->givenBitrate == 400000);
+		REQUIRE(speaker->givenCanPause);
+		REQUIRE(speaker->sending);
+
+		// Not enough bitrate for the lowest priority one.
+		REQUIRE(thumbnail->givenBitrate == 100000);
+		REQUIRE(thumbnail->givenCanPause);
+		REQUIRE(!thumbnail->sending);
+
+		for (auto* consumer : consumers)
+		{
+			delete consumer;
+		}
+	}
+
+	SECTION("the first Consumer never stops sending")
+	{
+		auto* speaker   = createConsumer("video", 2, false, 300000);
+		auto* thumbnail = createConsumer("video", 1, false, 300000);
+
+		std::vector<Consumer*> consumers{ thumbnail, speaker };
+
+		REQUIRE(Transport::DistributeBitrate(100000, consumers) == 0);
+
+		REQUIRE(!speaker->givenCanPause);
+		REQUIRE(speaker->sending);
+		REQUIRE(thumbnail->givenBitrate == 0);
+		REQUIRE(!thumbnail->sending);
+
+		delete speaker;
+		delete thumbnail;
+	}
+
+	SECTION("non simulcast Consumers take their part first")
+	{
+		auto* screen = createConsumer("video", 3, false, 300000);
+		auto* audio  = createConsumer("audio", 1, false, 50000);
+
+		std::vector<Consumer*> consumers{ screen, audio };
+
+		REQUIRE(Transport::DistributeBitrate(1000000, consumers) == 650000);
+
+		REQUIRE(audio->givenBitrate == 1000000);
+		REQUIRE(!audio->givenCanPause);
+		REQUIRE(screen->givenBitrate == 950000);
+
+		delete screen;
+		delete audio;
+	}
+
+	SECTION("paused Consumers use no bitrate")
+	{
+		auto* screen    = createConsumer("video", 3, true, 300000);
+		auto* speaker   = createConsumer("video", 2, false, 300000);
+		auto* thumbnail = createConsumer("video", 1, false, 300000);
+		auto* audio     = createConsumer("audio", 1, true, 50000);
+
+		std::vector<Consumer*> consumers{ screen, speaker, thumbnail, audio };
+
+		REQUIRE(Transport::DistributeBitrate(400000, consumers) == 100000);
+
+		REQUIRE(audio->calls == 1);
+		REQUIRE(screen->givenBitrate == 400000);
+		REQUIRE(!screen->sending);
+
+		// The paused one does not count as the first Consumer.
+		REQUIRE(speaker->givenBitrate == 400000);
+		REQUIRE(!speaker->givenCanPause);
+		REQUIRE(speaker->sending);
+
+		REQUIRE(thumbnail->givenBitrate == 100000);
+		REQUIRE(thumbnail->givenCanPause);
+		REQUIRE(!thumbnail->sending);
+
+		delete screen;
+		delete speaker;
+		delete thumbnail;
+		delete audio;
+	}
+}
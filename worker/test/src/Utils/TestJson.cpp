@@ -0,0 +1,21 @@
+#include "common.hpp"
+#include "json.hpp"
+#include "Utils.hpp"
+#include "catch.hpp"
+#include <string>
+
+using namespace Utils;
+using json = nlohmann::json;
+
+SCENARIO("Json::AppendString()")
+{
+	std::string buffer;
+
+	Json::AppendString(buffer, "a\"b\\c\n\x01");
+	REQUIRE(buffer == "\"a\\\"b\\\\c\\u000a\\u0001\"");
+	REQUIRE(json::parse(buffer) == "a\"b\\c\n\x01");
+
+	buffer.clear();
+	Json::AppendString(buffer, "foo!œ");
+	REQUIRE(json::parse(buffer) == "foo!œ");
+}
@@ -16,3 +16,14 @@ SCENARIO("String::ToLowerCase()")
 	String::ToLowerCase(str);
 	REQUIRE(str == "foo!œ");
 }
+
+SCENARIO("String::Base64Encode()")
+{
+	auto* data = reinterpret_cast<const uint8_t*>("foobar");
+
+	REQUIRE(String::Base64Encode(data, 0) == "");
+	REQUIRE(String::Base64Encode(data, 1) == "Zg==");
+	REQUIRE(String::Base64Encode(data, 2) == "Zm8=");
+	REQUIRE(String::Base64Encode(data, 3) == "Zm9v");
+	REQUIRE(String::Base64Encode(data, 6) == "Zm9vYmFy");
+}
@@ -0,0 +1,184 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "DepLibUV.hpp"
+#include "handles/FileWriter.hpp"
+#include <unistd.h> // usleep(), getpid(), unlink()
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+class TestFileWriterListener : public FileWriter::Listener
+{
+public:
+	void OnFileWriterError(FileWriter* /*fileWriter*/, const std::string& error) override
+	{
+		this->errors.push_back(error);
+	}
+
+public:
+	std::vector<std::string> errors;
+};
+
+static void runLoopUntil(const std::function<bool()>& condition)
+{
+	for (int i{ 0 }; i < 2000 && !condition(); ++i)
+	{
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+		usleep(500);
+	}
+}
+
+static std::string readFile(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+SCENARIO("FileWriter", "[handles][filewriter]")
+{
+	std::string path = "/tmp/mediasoup-test-filewriter-" + std::to_string(getpid());
+	TestFileWriterListener listener;
+
+	SECTION("records are written in order")
+	{
+		auto* writer = new FileWriter(&listener, path, 4);
+		std::string expected;
+
+		for (size_t i{ 0 }; i < 1000; ++i)
+		{
+			std::string record(100 + i % 400, static_cast<char>('a' + i % 26));
+
+			REQUIRE(writer->Write(reinterpret_cast<const uint8_t*>(record.data()), record.size()));
+
+			expected.append(record);
+
+			// Let the threadpool complete some writes.
+			if (i % 100 == 0)
+				runLoopUntil([&]() { return writer->GetPendingWrites() == 0; });
+		}
+
+		REQUIRE(writer->GetOffset() == expected.size());
+
+		writer->Flush();
+
+		runLoopUntil([&]() { return writer->GetPendingWrites() == 0; });
+
+		REQUIRE(writer->GetBytesWritten() == expected.size());
+		REQUIRE(writer->GetDroppedWrites() == 0);
+		REQUIRE(writer->GetWriteErrors() == 0);
+		REQUIRE(readFile(path) == expected);
+
+		delete writer;
+	}
+
+	SECTION("records are dropped when no block is free")
+	{
+		auto* writer = new FileWriter(&listener, path, 1);
+		std::string full(FileWriter::BlockSize, 'x');
+		uint8_t byte{ 'y' };
+
+		REQUIRE(writer->Write(reinterpret_cast<const uint8_t*>(full.data()), full.size()));
+		// The only block is being written.
+		REQUIRE(!writer->Write(&byte, 1));
+		REQUIRE(writer->GetPendingWrites() == 1);
+		REQUIRE(writer->GetDroppedWrites() == 1);
+		REQUIRE(writer->GetOffset() == size_t{ FileWriter::BlockSize });
+
+		runLoopUntil([&]() { return writer->GetPendingWrites() == 0; });
+
+		REQUIRE(writer->Write(&byte, 1));
+
+		// Records bigger than a block are never written.
+		std::string tooBig(FileWriter::BlockSize + 1, 'z');
+
+		REQUIRE(!writer->Write(reinterpret_cast<const uint8_t*>(tooBig.data()), tooBig.size()));
+		REQUIRE(writer->GetDroppedWrites() == 2);
+
+		// Pending data is written when deleting the writer.
+		delete writer;
+
+		runLoopUntil([&]() { return readFile(path).size() == FileWriter::BlockSize + 1; });
+
+		REQUIRE(readFile(path) == full + "y");
+	}
+
+	SECTION("nothing else is written after a write error")
+	{
+		// Writes into /dev/full fail with ENOSPC.
+		auto* writer = new FileWriter(&listener, "/dev/full", 2);
+		std::string full(FileWriter::BlockSize, 'x');
+		uint8_t byte{ 'y' };
+
+		REQUIRE(writer->Write(reinterpret_cast<const uint8_t*>(full.data()), full.size()));
+		REQUIRE(writer->Write(&byte, 1));
+
+		runLoopUntil([&]() { return writer->GetPendingWrites() == 0; });
+
+		REQUIRE(writer->HasFailed());
+		REQUIRE(listener.errors.size() == 1);
+		REQUIRE(writer->GetWriteErrors() == 1);
+		REQUIRE(writer->GetBytesWritten() == 0);
+
+		// The offset does not advance anymore.
+		REQUIRE(!writer->Write(&byte, 1));
+		REQUIRE(writer->GetDroppedWrites() == 1);
+		REQUIRE(writer->GetOffset() == size_t{ FileWriter::BlockSize + 1 });
+
+		writer->Flush();
+
+		REQUIRE(writer->GetPendingWrites() == 0);
+
+		delete writer;
+
+		REQUIRE(listener.errors.size() == 1);
+	}
+
+	SECTION("records are written once the file is open")
+	{
+		auto* writer = new FileWriter(&listener, path, 2);
+		std::string full(FileWriter::BlockSize, 'x');
+		uint8_t byte{ 'y' };
+
+		// The first block is queued until the file is open.
+		REQUIRE(writer->Write(reinterpret_cast<const uint8_t*>(full.data()), full.size()));
+		REQUIRE(writer->Write(&byte, 1));
+		REQUIRE(writer->GetPendingWrites() == 1);
+
+		// Queued blocks are written even if the writer is deleted meanwhile.
+		delete writer;
+
+		runLoopUntil([&]() { return readFile(path).size() == FileWriter::BlockSize + 1; });
+
+		REQUIRE(readFile(path) == full + "y");
+		REQUIRE(listener.errors.empty());
+	}
+
+	SECTION("nothing is written if the file cannot be opened")
+	{
+		auto* writer = new FileWriter(&listener, "/nonexistent-dir/file", 1);
+		std::string full(FileWriter::BlockSize, 'x');
+		uint8_t byte{ 'y' };
+
+		REQUIRE(writer->Write(reinterpret_cast<const uint8_t*>(full.data()), full.size()));
+		REQUIRE(!writer->Write(&byte, 1));
+		REQUIRE(writer->GetPendingWrites() == 1);
+
+		runLoopUntil([&]() { return writer->HasFailed(); });
+
+		REQUIRE(writer->HasFailed());
+		REQUIRE(listener.errors.size() == 1);
+		REQUIRE(listener.errors[0].find("uv_fs_open() failed") == 0);
+		REQUIRE(writer->GetPendingWrites() == 0);
+		REQUIRE(writer->GetBytesWritten() == 0);
+
+		// The queued block is free again, but nothing is written anymore.
+		REQUIRE(!writer->Write(&byte, 1));
+
+		delete writer;
+	}
+
+	unlink(path.c_str());
+}
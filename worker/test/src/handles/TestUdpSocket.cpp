@@ -0,0 +1,223 @@
+#include "common.hpp"
+#include "catch.hpp"
+#include "DepIoUring.hpp"
+#include "DepLibUV.hpp"
+#include "Settings.hpp"
+#include "handles/UdpSocket.hpp"
+#include <unistd.h> // usleep()
+#include <functional>
+#include <string>
+#include <vector>
+
+class TestUdpSocket : public UdpSocket
+{
+public:
+	explicit TestUdpSocket(uv_udp_t* uvHandle) : UdpSocket(uvHandle)
+	{
+	}
+
+protected:
+	void UserOnUdpDatagramRecv(
+	  const uint8_t* data, size_t len, const struct sockaddr* /*addr*/, uint64_t arrivalTime) override
+	{
+		this->received.emplace_back(reinterpret_cast<const char*>(data), len);
+		this->arrivalTimes.push_back(arrivalTime);
+	}
+
+public:
+	std::vector<std::string> received;
+	std::vector<uint64_t> arrivalTimes;
+};
+
+static TestUdpSocket* createSocket()
+{
+	auto* uvHandle = new uv_udp_t;
+	struct sockaddr_in addr; // NOLINT(cppcoreguidelines-pro-type-member-init)
+
+	uv_udp_init(DepLibUV::GetLoop(), uvHandle);
+	uv_ip4_addr("127.0.0.1", 0, &addr);
+	uv_udp_bind(uvHandle, reinterpret_cast<const struct sockaddr*>(&addr), 0);
+
+	return new TestUdpSocket(uvHandle);
+}
+
+static void runLoopUntil(const std::function<bool()>& condition)
+{
+	for (int i{ 0 }; i < 2000 && !condition(); ++i)
+	{
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+		usleep(500);
+	}
+}
+
+static void exchangeDatagrams()
+{
+	auto* socket1 = createSocket();
+	auto* socket2 = createSocket();
+	std::vector<std::string> datagrams;
+
+	// Include datagrams too big for io_uring send slots.
+	for (size_t i{ 0 }; i < 200; ++i)
+	{
+		datagrams.emplace_back(i % 50 == 0 ? 3000 : 100 + i, static_cast<char>('a' + i % 26));
+	}
+
+	// Send them in batches so the socket receive buffer does not overflow.
+	for (size_t i{ 0 }; i < datagrams.size(); ++i)
+	{
+		socket1->Send(datagrams[i], socket2->GetLocalAddress());
+
+		if ((i + 1) % 20 == 0)
+			runLoopUntil([&]() { return socket2->received.size() == i + 1; });
+	}
+
+	runLoopUntil([&]() { return socket2->received.size() == datagrams.size(); });
+
+	REQUIRE(socket2->received.size() == datagrams.size());
+
+	// Loopback keeps the order of datagrams.
+	for (size_t i{ 0 }; i < datagrams.size(); ++i)
+	{
+		REQUIRE(socket2->received[i] == datagrams[i]);
+	}
+
+	REQUIRE(socket2->GetRecvBytes() == socket1->GetSentBytes());
+
+	// Arrival times do not go backwards (besides rounding) nor beyond the loop
+	// time.
+	for (size_t i{ 1 }; i < socket2->arrivalTimes.size(); ++i)
+	{
+		REQUIRE(socket2->arrivalTimes[i] + 1 >= socket2->arrivalTimes[i - 1]);
+		REQUIRE(socket2->arrivalTimes[i] <= DepLibUV::GetTime());
+	}
+
+	socket1->Close();
+	socket2->Close();
+
+	delete socket1;
+	delete socket2;
+
+	uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+}
+
+SCENARIO("UDP socket", "[handles][udpsocket]")
+{
+	SECTION("libuv backend sends and receives datagrams")
+	{
+		exchangeDatagrams();
+	}
+
+	SECTION("libuv backend with receive timestamps sends and receives datagrams")
+	{
+		Settings::configuration.udpRecvTimestamps = true;
+
+		exchangeDatagrams();
+
+		Settings::configuration.udpRecvTimestamps = false;
+	}
+
+	SECTION("buffer sizes can be set and kernel drops are counted")
+	{
+		auto* sender   = createSocket();
+		auto* receiver = createSocket();
+		std::string datagram(1000, 'x');
+
+		sender->SetSendBufferSize(262144);
+		receiver->SetRecvBufferSize(8192);
+
+		REQUIRE(sender->GetSendBufferSize() >= 262144);
+		REQUIRE(receiver->GetRecvBufferSize() >= 8192);
+		REQUIRE(receiver->GetRecvBufferSize() < 262144);
+		REQUIRE(receiver->GetRecvDrops() == 0);
+
+		// Don't run the loop, so the receive buffer overflows.
+		for (size_t i{ 0 }; i < 100; ++i)
+		{
+			sender->Send(datagram, receiver->GetLocalAddress());
+		}
+
+#ifdef MS_RECV_DROPS
+		REQUIRE(receiver->GetRecvDrops() > 0);
+#endif
+		REQUIRE(sender->GetSendEagains() == 0);
+
+		sender->Close();
+		receiver->Close();
+
+		delete sender;
+		delete receiver;
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+	}
+
+	SECTION("the same datagram is sent to many addresses")
+	{
+		auto* sender = createSocket();
+		std::vector<TestUdpSocket*> receivers;
+		std::vector<const struct sockaddr*> addrs;
+		std::string part1(100, 'a');
+		std::string part2(50, 'b');
+		uv_buf_t buffers[2];
+		bool sent[4];
+
+		for (size_t i{ 0 }; i < 4; ++i)
+		{
+			receivers.push_back(createSocket());
+			addrs.push_back(receivers.back()->GetLocalAddress());
+		}
+
+		buffers[0] = uv_buf_init(const_cast<char*>(part1.data()), part1.size());
+		buffers[1] = uv_buf_init(const_cast<char*>(part2.data()), part2.size());
+
+		sender->Send(buffers, 2, addrs.data(), addrs.size(), sent);
+
+		for (auto* receiver : receivers)
+		{
+			runLoopUntil([&]() { return receiver->received.size() == 1; });
+
+			REQUIRE(receiver->received.size() == 1);
+			REQUIRE(receiver->received[0] == part1 + part2);
+		}
+
+		for (auto isSent : sent)
+		{
+			REQUIRE(isSent);
+		}
+
+		REQUIRE(sender->GetSentBytes() == 4 * (part1.size() + part2.size()));
+
+		sender->Close();
+		delete sender;
+
+		for (auto* receiver : receivers)
+		{
+			receiver->Close();
+			delete receiver;
+		}
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+	}
+
+	SECTION("io_uring backend sends and receives datagrams")
+	{
+		Settings::configuration.udpBackend = "io_uring";
+
+		DepIoUring::ClassInit();
+
+		// It falls back to libuv if io_uring is not available.
+		exchangeDatagrams();
+
+		if (DepIoUring::IsActive())
+		{
+			REQUIRE(DepIoUring::GetStats().recvCompletions == 200);
+			REQUIRE(DepIoUring::GetStats().sendCompletions > 0);
+			REQUIRE(DepIoUring::GetStats().sendFallbacks >= 4);
+		}
+
+		DepIoUring::ClassDestroy();
+
+		uv_run(DepLibUV::GetLoop(), UV_RUN_NOWAIT);
+
+		Settings::configuration.udpBackend = "libuv";
+	}
+}